@@ -0,0 +1,153 @@
+// AccessBenchmark.cpp : What each access policy adds to a cell access through
+// GetCell, operator[] and the iterators.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "Grid.h"
+
+#include <random>
+#include <vector>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	template<typename Access_Policy>
+	using PolicyGrid = Grid<int, RowMajorLayout, std::allocator<int>, std::uint16_t, Access_Policy>;
+
+	void AccessSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+
+	template<typename Grid_Type>
+	Grid_Type MakeAccessGrid(benchmark::State& state)
+	{
+		typedef typename Grid_Type::dimension_type dimension_type;
+
+		Grid_Type grid(dimension_type(state.range(0)), dimension_type(state.range(1)), 0);
+		int value = 0;
+
+		for (int& cell : grid)
+			cell = value++ & 0xFF;
+
+		return grid;
+	}
+}
+
+template<typename Access_Policy>
+static void BM_GetCellSum(benchmark::State& state)
+{
+	typedef PolicyGrid<Access_Policy> grid_type;
+	typedef typename grid_type::dimension_type dimension_type;
+
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	const grid_type grid = MakeAccessGrid<grid_type>(state);
+
+	for (auto _ : state)
+	{
+		long long sum = 0;
+
+		for (dimension_type row = 0; row < grid.GetRowCount(); row++)
+		{
+			for (dimension_type column = 0; column < grid.GetColumnCount(); column++)
+				sum += grid.GetCell(column, row);
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(grid.size()));
+}
+
+///Coordinates the compiler cannot prove in range, so checks cannot be hoisted
+template<typename Access_Policy>
+static void BM_GatherGetCell(benchmark::State& state)
+{
+	typedef PolicyGrid<Access_Policy> grid_type;
+	typedef typename grid_type::dimension_type dimension_type;
+
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	const grid_type grid = MakeAccessGrid<grid_type>(state);
+	std::minstd_rand random(2);
+	std::vector<std::pair<dimension_type, dimension_type>> coordinates(4096);
+
+	for (std::pair<dimension_type, dimension_type>& coordinate : coordinates)
+		coordinate = { dimension_type(random() % grid.GetColumnCount()), dimension_type(random() % grid.GetRowCount()) };
+
+	for (auto _ : state)
+	{
+		long long sum = 0;
+
+		for (const std::pair<dimension_type, dimension_type>& coordinate : coordinates)
+			sum += grid.GetCell(coordinate.first, coordinate.second);
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(coordinates.size()));
+}
+
+///Column by column through operator[], the pattern of grid[column][row] code
+template<typename Access_Policy>
+static void BM_IndexerWrite(benchmark::State& state)
+{
+	typedef PolicyGrid<Access_Policy> grid_type;
+	typedef typename grid_type::dimension_type dimension_type;
+
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	grid_type grid = MakeAccessGrid<grid_type>(state);
+
+	for (auto _ : state)
+	{
+		for (dimension_type row = 0; row < grid.GetRowCount(); row++)
+		{
+			for (dimension_type column = 0; column < grid.GetColumnCount(); column++)
+				grid[column][row] += 1;
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(grid.size()));
+}
+
+template<typename Access_Policy>
+static void BM_IteratorSum(benchmark::State& state)
+{
+	typedef PolicyGrid<Access_Policy> grid_type;
+
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	const grid_type grid = MakeAccessGrid<grid_type>(state);
+
+	for (auto _ : state)
+	{
+		long long sum = 0;
+
+		for (int cell : grid)
+			sum += cell;
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(grid.size()));
+}
+
+BENCHMARK_TEMPLATE(BM_GetCellSum, GridUncheckedAccess)->Apply(AccessSizes);
+BENCHMARK_TEMPLATE(BM_GetCellSum, GridAssertedAccess)->Apply(AccessSizes);
+BENCHMARK_TEMPLATE(BM_GetCellSum, GridCheckedAccess)->Apply(AccessSizes);
+BENCHMARK_TEMPLATE(BM_GatherGetCell, GridUncheckedAccess)->Apply(AccessSizes);
+BENCHMARK_TEMPLATE(BM_GatherGetCell, GridCheckedAccess)->Apply(AccessSizes);
+BENCHMARK_TEMPLATE(BM_IndexerWrite, GridUncheckedAccess)->Apply(AccessSizes);
+BENCHMARK_TEMPLATE(BM_IndexerWrite, GridCheckedAccess)->Apply(AccessSizes);
+BENCHMARK_TEMPLATE(BM_IteratorSum, GridUncheckedAccess)->Apply(AccessSizes);
+BENCHMARK_TEMPLATE(BM_IteratorSum, GridCheckedAccess)->Apply(AccessSizes);
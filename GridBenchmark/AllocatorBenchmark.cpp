@@ -0,0 +1,127 @@
+// AllocatorBenchmark.cpp : Allocator and row pitch choices for Grid.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "Grid.h"
+#include "GridAllocators.h"
+
+#include <memory_resource>
+#include <vector>
+
+using namespace GridBenchmark;
+
+///Short lived grids built from a reused arena versus the global heap
+static void BM_TransientGrid_StdAllocator(benchmark::State& state)
+{
+	Grid<int>::dimension_type size = Grid<int>::dimension_type(state.range(0));
+
+	for (auto _ : state)
+	{
+		Grid<int> grid(size, size, 1);
+		benchmark::DoNotOptimize(grid.GetCell(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(size) * size);
+}
+
+static void BM_TransientGrid_PmrArena(benchmark::State& state)
+{
+	Grid<int>::dimension_type size = Grid<int>::dimension_type(state.range(0));
+
+	std::vector<unsigned char> arena(std::size_t(size) * size * sizeof(int) + 4096);
+
+	for (auto _ : state)
+	{
+		std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size(), std::pmr::null_memory_resource());
+
+		PmrGrid<int> grid(size, size, 1, &resource);
+		benchmark::DoNotOptimize(grid.GetCell(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(size) * size);
+}
+
+BENCHMARK(BM_TransientGrid_StdAllocator)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK(BM_TransientGrid_PmrArena)->Arg(16)->Arg(64)->Arg(256);
+
+///Row by row sums over an odd width grid, where only the padded layout keeps
+///every row start aligned
+template<typename Grid_Type>
+static void BM_RowSum(benchmark::State& state)
+{
+	typedef typename Grid_Type::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<float>(state, columns, rows))
+		return;
+
+	Grid_Type grid(columns, rows, 1.0f);
+
+	for (auto _ : state)
+	{
+		float total = 0.0f;
+
+		for (dimension_type row = 0; row < rows; row++)
+		{
+			const float* rowStart = &grid.GetCell(0, row);
+			float rowSum = 0.0f;
+
+			for (dimension_type column = 0; column < columns; column++)
+				rowSum += rowStart[column];
+
+			total += rowSum;
+		}
+
+		benchmark::DoNotOptimize(total);
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(columns) * rows * std::int64_t(sizeof(float)));
+}
+
+BENCHMARK_TEMPLATE(BM_RowSum, Grid<float>)->Args({ 1023, 1024 })->Args({ 4095, 4096 });
+BENCHMARK_TEMPLATE(BM_RowSum, Grid<float, PaddedRowMajorLayout<64>, AlignedAllocator<float, 64>>)
+	->Args({ 1023, 1024 })->Args({ 4095, 4096 });
+
+///Random reads over a grid much larger than the TLB reach of 4 KiB pages
+template<typename Grid_Type>
+static void BM_RandomRead(benchmark::State& state)
+{
+	typedef typename Grid_Type::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows))
+		return;
+
+	Grid_Type grid(columns, rows, 1);
+
+	std::vector<std::size_t> indices(1 << 16);
+	std::uint64_t seed = 88172645463325252ull;
+
+	for (std::size_t& index : indices)
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		index = std::size_t(seed % grid.GetStorageSize());
+	}
+
+	for (auto _ : state)
+	{
+		std::int64_t total = 0;
+
+		for (std::size_t index : indices)
+			total += grid.GetCell(index);
+
+		benchmark::DoNotOptimize(total);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(indices.size()));
+}
+
+BENCHMARK_TEMPLATE(BM_RandomRead, LargeGrid<int>)->Args({ 4096, 4096 })->Args({ 16384, 8192 });
+BENCHMARK_TEMPLATE(BM_RandomRead, LargeGrid<int, RowMajorLayout, HugePageAllocator<int>>)
+	->Args({ 4096, 4096 })->Args({ 16384, 8192 });
@@ -0,0 +1,140 @@
+// BitGridBenchmark.cpp : Occupancy mask passes, a byte per cell Grid<bool>
+// against a word packed BitGrid.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "BitGrid.h"
+#include "Grid.h"
+
+#include <random>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void MaskSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+
+	template<typename Mask_Type>
+	void Scatter(Mask_Type& mask)
+	{
+		std::minstd_rand random(1);
+
+		for (std::uint32_t row = 0; row < mask.GetRowCount(); row++)
+		{
+			for (std::uint32_t column = 0; column < mask.GetColumnCount(); column++)
+				mask.GetCell(column, row) = random() % 4 == 0;
+		}
+	}
+}
+
+static void BM_BoolGridCount(benchmark::State& state)
+{
+	Grid<bool>::dimension_type columns = Grid<bool>::dimension_type(state.range(0));
+	Grid<bool>::dimension_type rows = Grid<bool>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<bool>(state, columns, rows))
+		return;
+
+	Grid<bool> mask(columns, rows, false);
+	Scatter(mask);
+
+	for (auto _ : state)
+	{
+		std::size_t count = 0;
+
+		for (bool cell : mask)
+			count += cell;
+
+		benchmark::DoNotOptimize(count);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(mask.size()));
+}
+
+static void BM_BitGridCount(benchmark::State& state)
+{
+	BitGrid<>::dimension_type columns = BitGrid<>::dimension_type(state.range(0));
+	BitGrid<>::dimension_type rows = BitGrid<>::dimension_type(state.range(1));
+
+	BitGrid<> mask(columns, rows);
+	Scatter(mask);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(mask.Count());
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(mask.size()));
+}
+
+static void BM_BoolGridAnd(benchmark::State& state)
+{
+	Grid<bool>::dimension_type columns = Grid<bool>::dimension_type(state.range(0));
+	Grid<bool>::dimension_type rows = Grid<bool>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<bool>(state, columns, rows, 2))
+		return;
+
+	Grid<bool> mask(columns, rows, false);
+	Grid<bool> visible(columns, rows, true);
+	Scatter(mask);
+
+	for (auto _ : state)
+	{
+		Grid<bool>::const_iterator source = visible.cbegin();
+
+		for (bool& cell : mask)
+		{
+			cell = cell && *source;
+			++source;
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(mask.size()));
+}
+
+static void BM_BitGridAnd(benchmark::State& state)
+{
+	BitGrid<>::dimension_type columns = BitGrid<>::dimension_type(state.range(0));
+	BitGrid<>::dimension_type rows = BitGrid<>::dimension_type(state.range(1));
+
+	BitGrid<> mask(columns, rows);
+	BitGrid<> visible(columns, rows, true);
+	Scatter(mask);
+
+	for (auto _ : state)
+	{
+		mask.And(visible);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(mask.size()));
+}
+
+static void BM_BitGridDilate(benchmark::State& state)
+{
+	BitGrid<>::dimension_type columns = BitGrid<>::dimension_type(state.range(0));
+	BitGrid<>::dimension_type rows = BitGrid<>::dimension_type(state.range(1));
+
+	BitGrid<> mask(columns, rows);
+	Scatter(mask);
+
+	for (auto _ : state)
+	{
+		mask.Dilate();
+		mask.Erode();
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(mask.size()) * 2);
+}
+
+BENCHMARK(BM_BoolGridCount)->Apply(MaskSizes);
+BENCHMARK(BM_BitGridCount)->Apply(MaskSizes);
+BENCHMARK(BM_BoolGridAnd)->Apply(MaskSizes);
+BENCHMARK(BM_BitGridAnd)->Apply(MaskSizes);
+BENCHMARK(BM_BitGridDilate)->Apply(MaskSizes);
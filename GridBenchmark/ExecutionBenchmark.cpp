@@ -0,0 +1,94 @@
+// ExecutionBenchmark.cpp : Scaling of Grid's bulk operations from one thread to
+// every hardware thread. Arguments are threads / columns / rows.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "Grid.h"
+
+#include <thread>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void ScalingArguments(benchmark::internal::Benchmark* benchmark)
+	{
+		std::int64_t hardwareThreads = std::max<std::int64_t>(1, std::thread::hardware_concurrency());
+
+		for (std::int64_t size : { 16, 1024, 4096 })
+		{
+			for (std::int64_t threads = 1; threads < hardwareThreads; threads *= 2)
+				benchmark->Args({ threads, size, size });
+
+			benchmark->Args({ hardwareThreads, size, size });
+		}
+	}
+}
+
+static void BM_ParallelFill(benchmark::State& state)
+{
+	GridThreadPool pool(std::size_t(state.range(0)));
+	Grid<float>::dimension_type columns = Grid<float>::dimension_type(state.range(1));
+	Grid<float>::dimension_type rows = Grid<float>::dimension_type(state.range(2));
+
+	if (!FitsMemoryBudget<float>(state, columns, rows))
+		return;
+
+	Grid<float> grid(columns, rows, GridNoInit);
+	float value = 0.0f;
+
+	for (auto _ : state)
+	{
+		grid.Fill(GridExecution::par.On(pool), value);
+		value += 1.0f;
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(columns) * rows * std::int64_t(sizeof(float)));
+}
+
+///A per cell update of the kind run on simulation fields every tick
+static void BM_ParallelForEach(benchmark::State& state)
+{
+	GridThreadPool pool(std::size_t(state.range(0)));
+	Grid<float>::dimension_type columns = Grid<float>::dimension_type(state.range(1));
+	Grid<float>::dimension_type rows = Grid<float>::dimension_type(state.range(2));
+
+	if (!FitsMemoryBudget<float>(state, columns, rows))
+		return;
+
+	Grid<float> grid(columns, rows, 1.0f);
+
+	for (auto _ : state)
+	{
+		grid.ForEach(GridExecution::par_unseq.On(pool), [](float& cell) { cell = cell * 0.99f + 0.5f; });
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(columns) * rows);
+}
+
+static void BM_ParallelReduce(benchmark::State& state)
+{
+	GridThreadPool pool(std::size_t(state.range(0)));
+	Grid<float>::dimension_type columns = Grid<float>::dimension_type(state.range(1));
+	Grid<float>::dimension_type rows = Grid<float>::dimension_type(state.range(2));
+
+	if (!FitsMemoryBudget<float>(state, columns, rows))
+		return;
+
+	Grid<float> grid(columns, rows, 0.25f);
+
+	for (auto _ : state)
+	{
+		double sum = grid.Reduce(GridExecution::par.On(pool), 0.0,
+			[](double left, double right) { return left + right; });
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(columns) * rows * std::int64_t(sizeof(float)));
+}
+
+BENCHMARK(BM_ParallelFill)->Apply(ScalingArguments)->UseRealTime();
+BENCHMARK(BM_ParallelForEach)->Apply(ScalingArguments)->UseRealTime();
+BENCHMARK(BM_ParallelReduce)->Apply(ScalingArguments)->UseRealTime();
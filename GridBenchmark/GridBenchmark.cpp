@@ -0,0 +1,385 @@
+// GridBenchmark.cpp : Micro benchmarks for the core Grid operations.
+//
+// Every benchmark is registered for int, double and a 64 byte cell across square
+// sizes from 16x16 to 65535x65535. Run with
+//   GridBenchmark --benchmark_format=json --benchmark_out=grid.json
+// to get machine readable results to diff release over release.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "Grid.h"
+
+#include <string>
+#include <utility>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	template<typename Data_Type>
+	Grid<Data_Type> MakeFilledGrid(typename Grid<Data_Type>::dimension_type columns,
+		typename Grid<Data_Type>::dimension_type rows)
+	{
+		Grid<Data_Type> grid(columns, rows);
+
+		std::int64_t value = 0;
+
+		for (auto iter = grid.begin(); iter != grid.end(); ++iter)
+			*iter = MakeCell<Data_Type>(value++);
+
+		return grid;
+	}
+
+	template<typename Data_Type>
+	void SetCellCounters(benchmark::State& state, std::int64_t cellsPerIteration)
+	{
+		state.SetItemsProcessed(state.iterations() * cellsPerIteration);
+		state.SetBytesProcessed(state.iterations() * cellsPerIteration * std::int64_t(sizeof(Data_Type)));
+	}
+}
+
+template<typename Data_Type>
+static void BM_ResizeGrid(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows))
+		return;
+
+	Grid<Data_Type> grid;
+	Data_Type filler = MakeCell<Data_Type>(7);
+
+	for (auto _ : state)
+	{
+		grid.ResizeGrid(columns, rows, filler);
+		benchmark::DoNotOptimize(grid.GetCell(0));
+		benchmark::ClobberMemory();
+	}
+
+	SetCellCounters<Data_Type>(state, std::int64_t(columns) * rows);
+}
+
+///Construction without touching the cells, for trivial cell types
+template<typename Data_Type>
+static void BM_ResizeGridNoInit(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows))
+		return;
+
+	Grid<Data_Type> grid;
+
+	for (auto _ : state)
+	{
+		grid.ResizeGrid(columns, rows, GridNoInit);
+		benchmark::DoNotOptimize(grid.GetCell(0));
+		benchmark::ClobberMemory();
+	}
+
+	SetCellCounters<Data_Type>(state, std::int64_t(columns) * rows);
+}
+
+///Cells with a non trivial constructor, where constructing then assigning
+///every cell used to cost twice
+static void BM_ResizeGridString(benchmark::State& state)
+{
+	Grid<std::string>::dimension_type size = Grid<std::string>::dimension_type(state.range(0));
+
+	Grid<std::string> grid;
+	std::string filler(40, 'x');
+
+	for (auto _ : state)
+	{
+		grid.ResizeGrid(size, size, filler);
+		benchmark::DoNotOptimize(grid.GetCell(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(size) * size);
+}
+
+static void BM_CopyConstructString(benchmark::State& state)
+{
+	Grid<std::string>::dimension_type size = Grid<std::string>::dimension_type(state.range(0));
+
+	const Grid<std::string> grid(size, size, std::string(40, 'x'));
+
+	for (auto _ : state)
+	{
+		Grid<std::string> copy(grid);
+		benchmark::DoNotOptimize(copy.GetCell(0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(size) * size);
+}
+
+///Grows a half sized grid to full size and back again, both keeping data
+template<typename Data_Type>
+static void BM_ResizeGridPreserveData(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows, 2))
+		return;
+
+	Grid<Data_Type> grid = MakeFilledGrid<Data_Type>(columns / 2, rows / 2);
+	Data_Type filler = MakeCell<Data_Type>(7);
+
+	for (auto _ : state)
+	{
+		grid.ResizeGridPreserveData(columns, rows, filler);
+		grid.ResizeGridPreserveData(columns / 2, rows / 2, filler);
+		benchmark::ClobberMemory();
+	}
+
+	SetCellCounters<Data_Type>(state, std::int64_t(columns) * rows + std::int64_t(columns / 2) * (rows / 2));
+}
+
+template<typename Data_Type>
+static void BM_GetCell(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows))
+		return;
+
+	const Grid<Data_Type> grid = MakeFilledGrid<Data_Type>(columns, rows);
+
+	for (auto _ : state)
+	{
+		double sum = 0.0;
+
+		for (dimension_type row = 0; row < rows; row++)
+		{
+			for (dimension_type column = 0; column < columns; column++)
+			{
+				sum += CellValue(grid.GetCell(column, row));
+			}
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	SetCellCounters<Data_Type>(state, std::int64_t(columns) * rows);
+}
+
+template<typename Data_Type>
+static void BM_IndexerAccess(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows))
+		return;
+
+	const Grid<Data_Type> grid = MakeFilledGrid<Data_Type>(columns, rows);
+
+	for (auto _ : state)
+	{
+		double sum = 0.0;
+
+		for (dimension_type row = 0; row < rows; row++)
+		{
+			for (dimension_type column = 0; column < columns; column++)
+			{
+				sum += CellValue(grid[column][row]);
+			}
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	SetCellCounters<Data_Type>(state, std::int64_t(columns) * rows);
+}
+
+template<typename Data_Type>
+static void BM_IteratorTraversal(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows))
+		return;
+
+	const Grid<Data_Type> grid = MakeFilledGrid<Data_Type>(columns, rows);
+
+	for (auto _ : state)
+	{
+		double sum = 0.0;
+
+		for (auto iter = grid.begin(); iter != grid.end(); ++iter)
+			sum += CellValue(*iter);
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	SetCellCounters<Data_Type>(state, std::int64_t(columns) * rows);
+}
+
+template<typename Data_Type>
+static void BM_CopyConstruct(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows, 2))
+		return;
+
+	const Grid<Data_Type> grid = MakeFilledGrid<Data_Type>(columns, rows);
+
+	for (auto _ : state)
+	{
+		Grid<Data_Type> copy(grid);
+		benchmark::DoNotOptimize(copy.GetCell(0));
+	}
+
+	SetCellCounters<Data_Type>(state, std::int64_t(columns) * rows);
+}
+
+///Moves the grid out and back so every iteration starts from the same state
+template<typename Data_Type>
+static void BM_MoveConstruct(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows))
+		return;
+
+	Grid<Data_Type> grid = MakeFilledGrid<Data_Type>(columns, rows);
+
+	for (auto _ : state)
+	{
+		Grid<Data_Type> moved(std::move(grid));
+		benchmark::DoNotOptimize(moved.GetCell(0));
+		grid = std::move(moved);
+	}
+
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template<typename Data_Type>
+static void BM_Swap(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows, 2))
+		return;
+
+	Grid<Data_Type> first = MakeFilledGrid<Data_Type>(columns, rows);
+	Grid<Data_Type> second = MakeFilledGrid<Data_Type>(columns, rows);
+
+	for (auto _ : state)
+	{
+		first.swap(second);
+		benchmark::DoNotOptimize(first.GetCell(0));
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+///Builds the grid one row at a time, the way map grids grow while streaming in
+template<typename Data_Type>
+static void BM_AppendRows(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows, 3))
+		return;
+
+	Data_Type filler = MakeCell<Data_Type>(7);
+
+	for (auto _ : state)
+	{
+		Grid<Data_Type> grid(columns, 1, filler);
+
+		for (dimension_type row = 1; row < rows; row++)
+			grid.AppendRows(1, filler);
+
+		benchmark::DoNotOptimize(grid.GetCell(0));
+	}
+
+	SetCellCounters<Data_Type>(state, std::int64_t(columns) * rows);
+}
+
+///The same growth through ResizeGridPreserveData, which sizes the storage exactly
+///and so reallocates on every row. Quadratic, hence the smaller sizes.
+template<typename Data_Type>
+static void BM_GrowPreserveData(benchmark::State& state)
+{
+	typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<Data_Type>(state, columns, rows, 2))
+		return;
+
+	Data_Type filler = MakeCell<Data_Type>(7);
+
+	for (auto _ : state)
+	{
+		Grid<Data_Type> grid(columns, 1, filler);
+
+		for (dimension_type row = 1; row < rows; row++)
+			grid.ResizeGridPreserveData(columns, row + 1, filler);
+
+		benchmark::DoNotOptimize(grid.GetCell(0));
+	}
+
+	SetCellCounters<Data_Type>(state, std::int64_t(columns) * rows);
+}
+
+static void GrowthSizes(benchmark::internal::Benchmark* benchmark)
+{
+	for (std::int64_t size : { 16, 64, 256, 1024 })
+		benchmark->Args({ size, size });
+}
+
+#define GRID_BENCHMARK_ALL_TYPES(function) \
+	BENCHMARK_TEMPLATE(function, int)->Apply(SquareSizes); \
+	BENCHMARK_TEMPLATE(function, double)->Apply(SquareSizes); \
+	BENCHMARK_TEMPLATE(function, Cell64)->Apply(SquareSizes)
+
+GRID_BENCHMARK_ALL_TYPES(BM_ResizeGrid);
+GRID_BENCHMARK_ALL_TYPES(BM_ResizeGridPreserveData);
+BENCHMARK_TEMPLATE(BM_ResizeGridNoInit, int)->Apply(SquareSizes);
+BENCHMARK_TEMPLATE(BM_ResizeGridNoInit, double)->Apply(SquareSizes);
+BENCHMARK(BM_ResizeGridString)->Arg(16)->Arg(256)->Arg(1024);
+BENCHMARK(BM_CopyConstructString)->Arg(16)->Arg(256)->Arg(1024);
+GRID_BENCHMARK_ALL_TYPES(BM_GetCell);
+GRID_BENCHMARK_ALL_TYPES(BM_IndexerAccess);
+GRID_BENCHMARK_ALL_TYPES(BM_IteratorTraversal);
+GRID_BENCHMARK_ALL_TYPES(BM_CopyConstruct);
+GRID_BENCHMARK_ALL_TYPES(BM_MoveConstruct);
+GRID_BENCHMARK_ALL_TYPES(BM_Swap);
+GRID_BENCHMARK_ALL_TYPES(BM_AppendRows);
+BENCHMARK_TEMPLATE(BM_GrowPreserveData, int)->Apply(GrowthSizes);
+BENCHMARK_TEMPLATE(BM_GrowPreserveData, double)->Apply(GrowthSizes);
+BENCHMARK_TEMPLATE(BM_GrowPreserveData, Cell64)->Apply(GrowthSizes);
@@ -0,0 +1,96 @@
+#pragma once
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+///Shared element types, sizes and helpers for the Grid benchmark suites.
+namespace GridBenchmark
+{
+	///A cache line sized cell, used to see how Grid behaves with fat elements
+	struct Cell64
+	{
+		double values[8];
+
+		Cell64()
+			:values()
+		{
+
+		}
+
+		explicit Cell64(double value)
+			:values()
+		{
+			for (double& element : values)
+				element = value;
+		}
+	};
+
+	static_assert(sizeof(Cell64) == 64, "Cell64 must stay 64 bytes wide");
+
+	inline double CellValue(int value)
+	{
+		return value;
+	}
+
+	inline double CellValue(double value)
+	{
+		return value;
+	}
+
+	inline double CellValue(const Cell64& value)
+	{
+		return value.values[0];
+	}
+
+	template<typename Data_Type>
+	inline Data_Type MakeCell(std::int64_t value)
+	{
+		return Data_Type(static_cast<double>(value % 251));
+	}
+
+	template<>
+	inline int MakeCell<int>(std::int64_t value)
+	{
+		return static_cast<int>(value % 251);
+	}
+
+	///Largest footprint a single benchmark may allocate. Defaults to 1 GiB and can
+	///be raised with GRID_BENCHMARK_MAX_BYTES for the 65535 x 65535 macro runs
+	inline std::uint64_t GetMemoryBudget()
+	{
+		static const std::uint64_t budget = []
+		{
+			const char* setting = std::getenv("GRID_BENCHMARK_MAX_BYTES");
+			return setting ? std::strtoull(setting, nullptr, 10) : (std::uint64_t(1) << 30);
+		}();
+
+		return budget;
+	}
+
+	///Skips the benchmark when gridCount grids of the requested size would not fit
+	///the memory budget. Returns false if the benchmark was skipped.
+	template<typename Data_Type>
+	inline bool FitsMemoryBudget(benchmark::State& state, std::uint64_t columns, std::uint64_t rows,
+		std::uint64_t gridCount = 1)
+	{
+		std::uint64_t required = columns * rows * sizeof(Data_Type) * gridCount;
+
+		if (required > GetMemoryBudget())
+		{
+			state.SkipWithError(("needs " + std::to_string(required >> 20) +
+				" MiB, raise GRID_BENCHMARK_MAX_BYTES to run").c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	///Square sizes from 16x16 up to the 16 bit dimension limit
+	inline void SquareSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 64, 256, 1024, 4096, 16384, 65535 })
+			benchmark->Args({ size, size });
+	}
+}
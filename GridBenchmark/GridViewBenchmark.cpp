@@ -0,0 +1,94 @@
+// GridViewBenchmark.cpp : Blitting and clearing a quarter of a grid, cell by
+// cell through GetCell against CopyRegion / FillRegion on views.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "GridView.h"
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void ViewSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+}
+
+static void BM_CellByCellBlit(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows, 2))
+		return;
+
+	Grid<int> source(columns, rows, 1);
+	Grid<int> destination(columns, rows, 0);
+	Grid<int>::dimension_type half = Grid<int>::dimension_type(columns / 2);
+	Grid<int>::dimension_type halfRows = Grid<int>::dimension_type(rows / 2);
+
+	for (auto _ : state)
+	{
+		for (Grid<int>::dimension_type row = 0; row < halfRows; row++)
+		{
+			for (Grid<int>::dimension_type column = 0; column < half; column++)
+				destination.GetCell(Grid<int>::dimension_type(column + half), Grid<int>::dimension_type(row + halfRows)) =
+					source.GetCell(column, row);
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(half) * halfRows * std::int64_t(sizeof(int)));
+}
+
+static void BM_CopyRegion(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows, 2))
+		return;
+
+	Grid<int> source(columns, rows, 1);
+	Grid<int> destination(columns, rows, 0);
+	std::size_t half = columns / 2;
+	std::size_t halfRows = rows / 2;
+
+	GridView<const int> from(source, 0, 0, half, halfRows);
+	GridView<int> to(destination, half, halfRows, half, halfRows);
+
+	for (auto _ : state)
+	{
+		CopyRegion(from, to);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(half * halfRows * sizeof(int)));
+}
+
+static void BM_FillRegion(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows))
+		return;
+
+	Grid<int> grid(columns, rows, 0);
+	GridView<int> quarter(grid, columns / 4, rows / 4, columns / 2, rows / 2);
+
+	for (auto _ : state)
+	{
+		FillRegion(quarter, 3);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(quarter.size() * sizeof(int)));
+}
+
+BENCHMARK(BM_CellByCellBlit)->Apply(ViewSizes);
+BENCHMARK(BM_CopyRegion)->Apply(ViewSizes);
+BENCHMARK(BM_FillRegion)->Apply(ViewSizes);
@@ -0,0 +1,128 @@
+// IteratorBenchmark.cpp : Standard algorithms over Grid iterators, which take
+// the memmove and memset paths only when the iterators are plain pointers.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "Grid.h"
+
+#include <algorithm>
+#include <random>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	typedef Grid<int, RowMajorLayout, std::allocator<int>, std::uint16_t, GridCheckedAccess> CheckedIntGrid;
+	typedef Grid<int, PaddedRowMajorLayout<64>, std::allocator<int>, std::uint16_t, GridUncheckedAccess> PaddedIntGrid;
+
+	void IteratorSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+
+	template<typename Grid_Type>
+	Grid_Type MakeIteratorGrid(benchmark::State& state)
+	{
+		typedef typename Grid_Type::dimension_type dimension_type;
+
+		Grid_Type grid(dimension_type(state.range(0)), dimension_type(state.range(1)), 0);
+		std::mt19937 random(7);
+
+		for (int& cell : grid)
+			cell = int(random());
+
+		return grid;
+	}
+}
+
+template<typename Grid_Type>
+static void BM_CopyGrid(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1), 2))
+		return;
+
+	const Grid_Type source = MakeIteratorGrid<Grid_Type>(state);
+	Grid_Type target = MakeIteratorGrid<Grid_Type>(state);
+
+	for (auto _ : state)
+	{
+		std::copy(source.begin(), source.end(), target.begin());
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(source.size() * sizeof(int)));
+}
+
+template<typename Grid_Type>
+static void BM_FillGrid(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	Grid_Type grid = MakeIteratorGrid<Grid_Type>(state);
+
+	for (auto _ : state)
+	{
+		std::fill(grid.begin(), grid.end(), 0);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size() * sizeof(int)));
+}
+
+///Row by row through GetRow, pointer ranges even on the padded layout
+template<typename Grid_Type>
+static void BM_CopyRows(benchmark::State& state)
+{
+	typedef typename Grid_Type::dimension_type dimension_type;
+
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1), 2))
+		return;
+
+	const Grid_Type source = MakeIteratorGrid<Grid_Type>(state);
+	Grid_Type target = MakeIteratorGrid<Grid_Type>(state);
+
+	for (auto _ : state)
+	{
+		for (dimension_type row = 0; row < source.GetRowCount(); row++)
+		{
+			auto sourceRow = source.GetRow(row);
+			std::copy(sourceRow.begin(), sourceRow.end(), target.GetRow(row).begin());
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(source.size() * sizeof(int)));
+}
+
+///Each iteration sorts a fresh copy, the copy is timed too
+template<typename Grid_Type>
+static void BM_SortGrid(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1), 2))
+		return;
+
+	const Grid_Type source = MakeIteratorGrid<Grid_Type>(state);
+	Grid_Type grid = MakeIteratorGrid<Grid_Type>(state);
+
+	for (auto _ : state)
+	{
+		std::copy(source.begin(), source.end(), grid.begin());
+		std::sort(grid.begin(), grid.end());
+		benchmark::DoNotOptimize(grid.GetCell(0, 0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(grid.size()));
+}
+
+BENCHMARK_TEMPLATE(BM_CopyGrid, UncheckedGrid<int>)->Apply(IteratorSizes);
+BENCHMARK_TEMPLATE(BM_CopyGrid, CheckedIntGrid)->Apply(IteratorSizes);
+BENCHMARK_TEMPLATE(BM_CopyGrid, PaddedIntGrid)->Apply(IteratorSizes);
+BENCHMARK_TEMPLATE(BM_CopyRows, PaddedIntGrid)->Apply(IteratorSizes);
+BENCHMARK_TEMPLATE(BM_FillGrid, UncheckedGrid<int>)->Apply(IteratorSizes);
+BENCHMARK_TEMPLATE(BM_FillGrid, CheckedIntGrid)->Apply(IteratorSizes);
+BENCHMARK_TEMPLATE(BM_FillGrid, PaddedIntGrid)->Apply(IteratorSizes);
+BENCHMARK_TEMPLATE(BM_SortGrid, UncheckedGrid<int>)->Apply(IteratorSizes);
+BENCHMARK_TEMPLATE(BM_SortGrid, CheckedIntGrid)->Apply(IteratorSizes);
@@ -0,0 +1,78 @@
+// LayeredGridBenchmark.cpp : A pass touching one field of a 12 byte cell,
+// array of structs Grid<Cell> against the field's own LayeredGrid plane.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "LayeredGrid.h"
+
+using namespace GridBenchmark;
+
+namespace
+{
+	struct TerrainCell
+	{
+		float height;
+		float cost;
+		std::uint8_t owner;
+		std::uint8_t flags;
+	};
+
+	typedef LayeredGrid<TerrainCell, RowMajorLayout,
+		&TerrainCell::height, &TerrainCell::cost, &TerrainCell::owner, &TerrainCell::flags> TerrainLayers;
+
+	void LayeredSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+}
+
+static void BM_StructFieldSum(benchmark::State& state)
+{
+	Grid<TerrainCell>::dimension_type columns = Grid<TerrainCell>::dimension_type(state.range(0));
+	Grid<TerrainCell>::dimension_type rows = Grid<TerrainCell>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<TerrainCell>(state, columns, rows))
+		return;
+
+	Grid<TerrainCell> grid(columns, rows, TerrainCell{ 1.0f, 2.0f, 0, 0 });
+
+	for (auto _ : state)
+	{
+		float total = 0.0f;
+
+		for (const TerrainCell& cell : grid)
+			total += cell.cost;
+
+		benchmark::DoNotOptimize(total);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(grid.size()));
+}
+
+static void BM_LayerFieldSum(benchmark::State& state)
+{
+	TerrainLayers::dimension_type columns = TerrainLayers::dimension_type(state.range(0));
+	TerrainLayers::dimension_type rows = TerrainLayers::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<TerrainCell>(state, columns, rows))
+		return;
+
+	TerrainLayers grid(columns, rows, TerrainCell{ 1.0f, 2.0f, 0, 0 });
+	GridLayer<Grid<float>> costs = grid.GetLayer<&TerrainCell::cost>();
+
+	for (auto _ : state)
+	{
+		float total = 0.0f;
+
+		for (float cost : costs)
+			total += cost;
+
+		benchmark::DoNotOptimize(total);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(grid.size()));
+}
+
+BENCHMARK(BM_StructFieldSum)->Apply(LayeredSizes);
+BENCHMARK(BM_LayerFieldSum)->Apply(LayeredSizes);
@@ -0,0 +1,113 @@
+// LayoutBenchmark.cpp : Neighbourhood and vertical access patterns across the
+// Grid storage layouts.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "Grid.h"
+
+using namespace GridBenchmark;
+
+namespace
+{
+	template<typename Grid_Type>
+	Grid_Type MakeLayoutGrid(benchmark::State& state)
+	{
+		typedef typename Grid_Type::dimension_type dimension_type;
+
+		Grid_Type grid(dimension_type(state.range(0)), dimension_type(state.range(1)), 0);
+
+		for (dimension_type row = 0; row < grid.GetRowCount(); row++)
+			for (dimension_type column = 0; column < grid.GetColumnCount(); column++)
+				grid.GetCell(column, row) = MakeCell<typename Grid_Type::value_type>(column ^ row);
+
+		return grid;
+	}
+
+	void LayoutSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 256, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+}
+
+///Sums a Radius window around every interior cell
+template<typename Grid_Type, int Radius>
+static void WindowSum(benchmark::State& state)
+{
+	typedef typename Grid_Type::dimension_type dimension_type;
+
+	if (!FitsMemoryBudget<typename Grid_Type::value_type>(state, state.range(0), state.range(1)))
+		return;
+
+	const Grid_Type grid = MakeLayoutGrid<Grid_Type>(state);
+
+	dimension_type columns = grid.GetColumnCount();
+	dimension_type rows = grid.GetRowCount();
+
+	for (auto _ : state)
+	{
+		double sum = 0.0;
+
+		for (dimension_type row = Radius; row < rows - Radius; row++)
+		{
+			for (dimension_type column = Radius; column < columns - Radius; column++)
+			{
+				for (int y = -Radius; y <= Radius; y++)
+					for (int x = -Radius; x <= Radius; x++)
+						sum += CellValue(grid[dimension_type(column + x)][dimension_type(row + y)]);
+			}
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(columns - 2 * Radius) * (rows - 2 * Radius));
+}
+
+template<typename Grid_Type>
+static void BM_WindowSum3x3(benchmark::State& state)
+{
+	WindowSum<Grid_Type, 1>(state);
+}
+
+template<typename Grid_Type>
+static void BM_WindowSum5x5(benchmark::State& state)
+{
+	WindowSum<Grid_Type, 2>(state);
+}
+
+///Walks the grid column by column
+template<typename Grid_Type>
+static void BM_VerticalScan(benchmark::State& state)
+{
+	typedef typename Grid_Type::dimension_type dimension_type;
+
+	if (!FitsMemoryBudget<typename Grid_Type::value_type>(state, state.range(0), state.range(1)))
+		return;
+
+	const Grid_Type grid = MakeLayoutGrid<Grid_Type>(state);
+
+	for (auto _ : state)
+	{
+		double sum = 0.0;
+
+		for (dimension_type column = 0; column < grid.GetColumnCount(); column++)
+			for (dimension_type row = 0; row < grid.GetRowCount(); row++)
+				sum += CellValue(grid.GetCell(column, row));
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(grid.size()));
+}
+
+#define GRID_BENCHMARK_ALL_LAYOUTS(function) \
+	BENCHMARK_TEMPLATE(function, Grid<double, RowMajorLayout>)->Apply(LayoutSizes); \
+	BENCHMARK_TEMPLATE(function, Grid<double, ColumnMajorLayout>)->Apply(LayoutSizes); \
+	BENCHMARK_TEMPLATE(function, Grid<double, TiledLayout<8>>)->Apply(LayoutSizes); \
+	BENCHMARK_TEMPLATE(function, Grid<double, TiledLayout<32>>)->Apply(LayoutSizes); \
+	BENCHMARK_TEMPLATE(function, Grid<double, MortonLayout<16>>)->Apply(LayoutSizes)
+
+GRID_BENCHMARK_ALL_LAYOUTS(BM_WindowSum3x3);
+GRID_BENCHMARK_ALL_LAYOUTS(BM_WindowSum5x5);
+GRID_BENCHMARK_ALL_LAYOUTS(BM_VerticalScan);
@@ -0,0 +1,85 @@
+// MappedGridBenchmark.cpp : Opening a file backed MappedGrid, with and without
+// checksum verification, against copying the same cells into a fresh Grid.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "MappedGrid.h"
+
+#include <filesystem>
+#include <string>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	///Writes a size x size grid once per size and hands back its path
+	std::string PrepareGridFile(Grid<int>::dimension_type size)
+	{
+		std::string path = (std::filesystem::temp_directory_path() /
+			("MappedGridBenchmark_" + std::to_string(size) + ".grid")).string();
+
+		if (!std::filesystem::exists(path))
+			MappedGrid<int>::Create(path, size, size, 1);
+
+		return path;
+	}
+}
+
+///O(1): only the header is read, the cells are paged in when touched
+static void BM_MappedOpen(benchmark::State& state)
+{
+	Grid<int>::dimension_type size = Grid<int>::dimension_type(state.range(0));
+
+	if (!FitsMemoryBudget<int>(state, size, size))
+		return;
+
+	std::string path = PrepareGridFile(size);
+
+	for (auto _ : state)
+	{
+		MappedGrid<int> mapped = MappedGrid<int>::Open(path, MappedGridMode::ReadOnly);
+		benchmark::DoNotOptimize(mapped.GetGrid().GetCell(0));
+	}
+}
+
+static void BM_MappedOpenVerified(benchmark::State& state)
+{
+	Grid<int>::dimension_type size = Grid<int>::dimension_type(state.range(0));
+
+	if (!FitsMemoryBudget<int>(state, size, size))
+		return;
+
+	std::string path = PrepareGridFile(size);
+
+	for (auto _ : state)
+	{
+		MappedGrid<int> mapped = MappedGrid<int>::Open(path, MappedGridMode::ReadOnly, true);
+		benchmark::DoNotOptimize(mapped.GetGrid().GetCell(0));
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(size) * size * std::int64_t(sizeof(int)));
+}
+
+///What loading used to cost: every cell copied into a heap Grid
+static void BM_MappedCopyToGrid(benchmark::State& state)
+{
+	Grid<int>::dimension_type size = Grid<int>::dimension_type(state.range(0));
+
+	if (!FitsMemoryBudget<int>(state, size, size, 2))
+		return;
+
+	std::string path = PrepareGridFile(size);
+
+	for (auto _ : state)
+	{
+		MappedGrid<int> mapped = MappedGrid<int>::Open(path, MappedGridMode::ReadOnly);
+		Grid<int> copy(mapped.GetGrid());
+		benchmark::DoNotOptimize(copy.GetCell(0));
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(size) * size * std::int64_t(sizeof(int)));
+}
+
+BENCHMARK(BM_MappedOpen)->Arg(256)->Arg(4096);
+BENCHMARK(BM_MappedOpenVerified)->Arg(256)->Arg(4096);
+BENCHMARK(BM_MappedCopyToGrid)->Arg(256)->Arg(4096);
@@ -0,0 +1,207 @@
+// OccupancyPyramidBenchmark.cpp : Nearest match, k nearest and area queries
+// answered by scanning the grid against a GridOccupancyPyramid, at a few
+// densities of matching cells.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "GridOccupancyPyramid.h"
+
+#include <random>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void PyramidSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+
+	const int QueriesPerIteration = 64;
+	const std::uint32_t AreaSide = 200;
+
+	///Matching cells per million
+	const unsigned Sparse = 100;
+	const unsigned Medium = 10000;
+	const unsigned Dense = 300000;
+
+	Grid<int> MakeScattered(benchmark::State& state, unsigned perMillion)
+	{
+		std::minstd_rand random(7);
+		Grid<int> grid(Grid<int>::dimension_type(state.range(0)), Grid<int>::dimension_type(state.range(1)), 0);
+
+		for (int& cell : grid)
+			cell = random() % 1000000 < perMillion;
+
+		return grid;
+	}
+
+	///The query cells, the same for every run
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> MakeQueries(const Grid<int>& grid)
+	{
+		std::minstd_rand random(11);
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> queries;
+
+		for (int query = 0; query < QueriesPerIteration; query++)
+			queries.emplace_back(std::uint32_t(random() % grid.GetColumnCount()), std::uint32_t(random() % grid.GetRowCount()));
+
+		return queries;
+	}
+}
+
+static void BM_ScanNearest(benchmark::State& state, unsigned perMillion)
+{
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	Grid<int> grid = MakeScattered(state, perMillion);
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> queries = MakeQueries(grid);
+
+	for (auto _ : state)
+	{
+		for (const std::pair<std::uint32_t, std::uint32_t>& query : queries)
+		{
+			std::uint64_t best = UINT64_MAX;
+
+			for (Grid<int>::dimension_type row = 0; row < grid.GetRowCount(); row++)
+			{
+				for (Grid<int>::dimension_type column = 0; column < grid.GetColumnCount(); column++)
+				{
+					if (grid.GetCell(column, row) != 0)
+					{
+						std::int64_t columnDistance = std::int64_t(column) - query.first;
+						std::int64_t rowDistance = std::int64_t(row) - query.second;
+						best = std::min(best, std::uint64_t(columnDistance * columnDistance + rowDistance * rowDistance));
+					}
+				}
+			}
+
+			benchmark::DoNotOptimize(best);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * QueriesPerIteration);
+}
+
+static void BM_PyramidNearest(benchmark::State& state, unsigned perMillion)
+{
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	GridOccupancyPyramid<Grid<int>> pyramid(MakeScattered(state, perMillion));
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> queries = MakeQueries(pyramid.GetGrid());
+
+	for (auto _ : state)
+	{
+		for (const std::pair<std::uint32_t, std::uint32_t>& query : queries)
+			benchmark::DoNotOptimize(pyramid.FindNearest(query.first, query.second));
+	}
+
+	state.SetItemsProcessed(state.iterations() * QueriesPerIteration);
+}
+
+static void BM_PyramidKNearest(benchmark::State& state, unsigned perMillion)
+{
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	GridOccupancyPyramid<Grid<int>> pyramid(MakeScattered(state, perMillion));
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> queries = MakeQueries(pyramid.GetGrid());
+	std::vector<GridOccupancyHit> found;
+
+	for (auto _ : state)
+	{
+		for (const std::pair<std::uint32_t, std::uint32_t>& query : queries)
+		{
+			pyramid.FindKNearest(query.first, query.second, 16, found);
+			benchmark::DoNotOptimize(found.data());
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * QueriesPerIteration);
+}
+
+static void BM_ScanAreaAny(benchmark::State& state, unsigned perMillion)
+{
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	Grid<int> grid = MakeScattered(state, perMillion);
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> queries = MakeQueries(grid);
+
+	for (auto _ : state)
+	{
+		for (const std::pair<std::uint32_t, std::uint32_t>& query : queries)
+		{
+			std::uint32_t lastColumn = std::min<std::uint32_t>(query.first + AreaSide, grid.GetColumnCount()) - 1;
+			std::uint32_t lastRow = std::min<std::uint32_t>(query.second + AreaSide, grid.GetRowCount()) - 1;
+			bool any = false;
+
+			for (std::uint32_t row = query.second; row <= lastRow && !any; row++)
+			{
+				for (std::uint32_t column = query.first; column <= lastColumn && !any; column++)
+					any = grid.GetCell(Grid<int>::dimension_type(column), Grid<int>::dimension_type(row)) != 0;
+			}
+
+			benchmark::DoNotOptimize(any);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * QueriesPerIteration);
+}
+
+static void BM_PyramidAreaAny(benchmark::State& state, unsigned perMillion)
+{
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	GridOccupancyPyramid<Grid<int>> pyramid(MakeScattered(state, perMillion));
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> queries = MakeQueries(pyramid.GetGrid());
+
+	for (auto _ : state)
+	{
+		for (const std::pair<std::uint32_t, std::uint32_t>& query : queries)
+		{
+			benchmark::DoNotOptimize(pyramid.Any(query.first, query.second,
+				std::min<std::uint32_t>(query.first + AreaSide, pyramid.GetColumnCount()) - 1,
+				std::min<std::uint32_t>(query.second + AreaSide, pyramid.GetRowCount()) - 1));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * QueriesPerIteration);
+}
+
+///What keeping the pyramid current adds to each write
+static void BM_PyramidWrites(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<int>(state, state.range(0), state.range(1)))
+		return;
+
+	GridOccupancyPyramid<Grid<int>> pyramid(MakeScattered(state, Medium));
+	std::minstd_rand random(3);
+
+	for (auto _ : state)
+	{
+		for (int write = 0; write < 1000; write++)
+		{
+			pyramid.SetCell(Grid<int>::dimension_type(random() % pyramid.GetColumnCount()),
+				Grid<int>::dimension_type(random() % pyramid.GetRowCount()), write & 1);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+BENCHMARK_CAPTURE(BM_ScanNearest, sparse, Sparse)->Apply(PyramidSizes);
+BENCHMARK_CAPTURE(BM_PyramidNearest, sparse, Sparse)->Apply(PyramidSizes);
+BENCHMARK_CAPTURE(BM_ScanNearest, medium, Medium)->Apply(PyramidSizes);
+BENCHMARK_CAPTURE(BM_PyramidNearest, medium, Medium)->Apply(PyramidSizes);
+BENCHMARK_CAPTURE(BM_PyramidNearest, dense, Dense)->Apply(PyramidSizes);
+BENCHMARK_CAPTURE(BM_PyramidKNearest, sparse, Sparse)->Apply(PyramidSizes);
+BENCHMARK_CAPTURE(BM_PyramidKNearest, medium, Medium)->Apply(PyramidSizes);
+BENCHMARK_CAPTURE(BM_ScanAreaAny, sparse, Sparse)->Apply(PyramidSizes);
+BENCHMARK_CAPTURE(BM_PyramidAreaAny, sparse, Sparse)->Apply(PyramidSizes);
+BENCHMARK_CAPTURE(BM_ScanAreaAny, medium, Medium)->Apply(PyramidSizes);
+BENCHMARK_CAPTURE(BM_PyramidAreaAny, medium, Medium)->Apply(PyramidSizes);
+BENCHMARK(BM_PyramidWrites)->Apply(PyramidSizes);
@@ -0,0 +1,65 @@
+// PathfinderBenchmark.cpp : Batches of random path queries over a cost grid
+// with scattered walls, A* against Jump Point Search, one thread and all.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "GridPathfinder.h"
+
+#include <random>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void PathSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 256, 1024 })
+			benchmark->Args({ size, size });
+	}
+
+	float WallCost(std::uint8_t cell)
+	{
+		return cell == 0 ? GridPathBlocked : 1.0f;
+	}
+
+	const std::size_t QueriesPerBatch = 256;
+}
+
+template<typename Policy_Type>
+static void BM_PathBatch(benchmark::State& state, GridPathAlgorithm algorithm, Policy_Type policy)
+{
+	Grid<std::uint8_t>::dimension_type columns = Grid<std::uint8_t>::dimension_type(state.range(0));
+	Grid<std::uint8_t>::dimension_type rows = Grid<std::uint8_t>::dimension_type(state.range(1));
+
+	std::mt19937 random(1);
+	Grid<std::uint8_t> grid(columns, rows);
+
+	for (std::uint8_t& cell : grid)
+		cell = random() % 5 == 0 ? 0 : 1;
+
+	std::vector<GridPathQuery> queries(QueriesPerBatch);
+
+	for (GridPathQuery& query : queries)
+	{
+		query.start = GridPathPoint{ std::uint32_t(random() % columns), std::uint32_t(random() % rows) };
+		query.goal = GridPathPoint{ std::uint32_t(random() % columns), std::uint32_t(random() % rows) };
+	}
+
+	GridPathfinder<Grid<std::uint8_t>, float(*)(std::uint8_t)> pathfinder(grid, &WallCost);
+	std::vector<GridPath> results;
+
+	for (auto _ : state)
+	{
+		pathfinder.FindPaths(policy, queries, results, algorithm);
+		benchmark::DoNotOptimize(results.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(QueriesPerBatch));
+}
+
+BENCHMARK_CAPTURE(BM_PathBatch, AStar, GridPathAlgorithm::AStar, GridExecution::seq)->Apply(PathSizes);
+BENCHMARK_CAPTURE(BM_PathBatch, JumpPoint, GridPathAlgorithm::JumpPointSearch, GridExecution::seq)->Apply(PathSizes);
+BENCHMARK_CAPTURE(BM_PathBatch, AStarParallel, GridPathAlgorithm::AStar, GridExecution::par)
+	->Apply(PathSizes)->UseRealTime();
+BENCHMARK_CAPTURE(BM_PathBatch, JumpPointParallel, GridPathAlgorithm::JumpPointSearch, GridExecution::par)
+	->Apply(PathSizes)->UseRealTime();
@@ -0,0 +1,122 @@
+// PyramidBenchmark.cpp : Building a GridPyramid against a plain GetCell
+// downsampling loop, and refreshing a small changed area against rebuilding.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "GridPyramid.h"
+
+#include <random>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void PyramidSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+
+	template<typename Data_Type>
+	Grid<Data_Type> MakeField(benchmark::State& state)
+	{
+		typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+		std::minstd_rand random(5);
+		Grid<Data_Type> grid{ dimension_type(state.range(0)), dimension_type(state.range(1)) };
+
+		for (Data_Type& cell : grid)
+			cell = Data_Type(random() % 256);
+
+		return grid;
+	}
+}
+
+///Every level built with nested GetCell loops, halving as GridPyramid does
+static void BM_NaiveMeanLevels(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<float>(state, state.range(0), state.range(1), 2))
+		return;
+
+	Grid<float> base = MakeField<float>(state);
+
+	for (auto _ : state)
+	{
+		Grid<float> level = base;
+
+		while (level.GetColumnCount() > 1 || level.GetRowCount() > 1)
+		{
+			Grid<float> next(Grid<float>::dimension_type((level.GetColumnCount() + 1) / 2),
+				Grid<float>::dimension_type((level.GetRowCount() + 1) / 2));
+
+			for (Grid<float>::dimension_type row = 0; row < next.GetRowCount(); row++)
+			{
+				for (Grid<float>::dimension_type column = 0; column < next.GetColumnCount(); column++)
+				{
+					Grid<float>::dimension_type left = 2 * column, top = 2 * row;
+					Grid<float>::dimension_type right = std::min<Grid<float>::dimension_type>(left + 1, level.GetColumnCount() - 1);
+					Grid<float>::dimension_type bottom = std::min<Grid<float>::dimension_type>(top + 1, level.GetRowCount() - 1);
+
+					next.GetCell(column, row) = (level.GetCell(left, top) + level.GetCell(right, top) +
+						level.GetCell(left, bottom) + level.GetCell(right, bottom)) * 0.25f;
+				}
+			}
+
+			level = std::move(next);
+		}
+
+		benchmark::DoNotOptimize(level.GetCell(0, 0));
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(base.size() * sizeof(float)));
+}
+
+template<typename Data_Type, typename Reduction_Type, typename Policy_Type>
+static void BM_BuildPyramid(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1), 2))
+		return;
+
+	Grid<Data_Type> base = MakeField<Data_Type>(state);
+	GridPyramid<Data_Type, Reduction_Type> pyramid;
+
+	for (auto _ : state)
+	{
+		pyramid.Build(Policy_Type(), base);
+		benchmark::DoNotOptimize(pyramid.GetTop());
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(base.size() * sizeof(Data_Type)));
+}
+
+///A 16 x 16 brush stroke at a different place each time
+static void BM_RefreshPyramid(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<float>(state, state.range(0), state.range(1), 2))
+		return;
+
+	Grid<float> base = MakeField<float>(state);
+	GridPyramid<float> pyramid(base);
+	std::minstd_rand random(8);
+	std::uint32_t side = std::min<std::uint32_t>(16, base.GetColumnCount());
+
+	for (auto _ : state)
+	{
+		std::uint32_t column = random() % (base.GetColumnCount() - side + 1);
+		std::uint32_t row = random() % (base.GetRowCount() - side + 1);
+
+		pyramid.Refresh(base, column, row, column + side - 1, row + side - 1);
+		benchmark::DoNotOptimize(pyramid.GetTop());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+
+BENCHMARK(BM_NaiveMeanLevels)->Apply(PyramidSizes);
+BENCHMARK_TEMPLATE(BM_BuildPyramid, float, GridReduceMean, GridExecution::SequencedPolicy)->Apply(PyramidSizes);
+BENCHMARK_TEMPLATE(BM_BuildPyramid, float, GridReduceMean, GridExecution::ParallelPolicy)->Apply(PyramidSizes);
+BENCHMARK_TEMPLATE(BM_BuildPyramid, float, GridReduceMax, GridExecution::SequencedPolicy)->Apply(PyramidSizes);
+BENCHMARK_TEMPLATE(BM_BuildPyramid, int, GridReduceMean, GridExecution::SequencedPolicy)->Apply(PyramidSizes);
+BENCHMARK_TEMPLATE(BM_BuildPyramid, int, GridReduceMode, GridExecution::SequencedPolicy)->Apply(PyramidSizes);
+BENCHMARK(BM_RefreshPyramid)->Apply(PyramidSizes);
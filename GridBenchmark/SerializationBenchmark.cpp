@@ -0,0 +1,93 @@
+// SerializationBenchmark.cpp : SaveGrid and LoadGrid through memory streams,
+// raw and with the LZ band codec, on a map like grid of long runs.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "GridSerializer.h"
+
+#include <sstream>
+#include <string>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void SerializationSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 256, 2048 })
+			benchmark->Args({ size, size });
+	}
+
+	///Terrain ids changing every 37 columns and 23 rows, what tile maps look like
+	void FillTerrain(Grid<int>& grid)
+	{
+		for (Grid<int>::dimension_type row = 0; row < grid.GetRowCount(); row++)
+		{
+			for (Grid<int>::dimension_type column = 0; column < grid.GetColumnCount(); column++)
+				grid.GetCell(column, row) = column / 37 + (row / 23) * 5;
+		}
+	}
+}
+
+template<typename Codec_Type>
+static void BM_SaveToMemory(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows, 2))
+		return;
+
+	Grid<int> grid(columns, rows);
+	FillTerrain(grid);
+
+	Codec_Type codec;
+	std::size_t savedBytes = 0;
+
+	for (auto _ : state)
+	{
+		std::ostringstream stream;
+		SaveGrid(grid, stream, codec);
+		savedBytes = stream.tellp();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(columns) * rows * std::int64_t(sizeof(int)));
+	state.counters["Ratio"] = double(columns) * rows * sizeof(int) / double(savedBytes);
+}
+
+template<typename Codec_Type>
+static void BM_LoadFromMemory(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows, 3))
+		return;
+
+	std::string saved;
+
+	{
+		Grid<int> grid(columns, rows);
+		FillTerrain(grid);
+
+		std::ostringstream stream;
+		SaveGrid(grid, stream, Codec_Type());
+		saved = stream.str();
+	}
+
+	Grid<int> loaded;
+
+	for (auto _ : state)
+	{
+		std::istringstream stream(saved);
+		LoadGrid(loaded, stream);
+		benchmark::DoNotOptimize(loaded.GetCell(0));
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(columns) * rows * std::int64_t(sizeof(int)));
+}
+
+BENCHMARK_TEMPLATE(BM_SaveToMemory, GridRawCodec)->Apply(SerializationSizes);
+BENCHMARK_TEMPLATE(BM_SaveToMemory, GridLzCodec)->Apply(SerializationSizes);
+BENCHMARK_TEMPLATE(BM_LoadFromMemory, GridRawCodec)->Apply(SerializationSizes);
+BENCHMARK_TEMPLATE(BM_LoadFromMemory, GridLzCodec)->Apply(SerializationSizes);
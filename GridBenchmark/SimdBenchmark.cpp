@@ -0,0 +1,202 @@
+// SimdBenchmark.cpp : GridSimd kernels on each instruction set against a plain
+// loop over the grid iterators.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "GridSimd.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void SimdSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+
+	template<typename Data_Type>
+	UncheckedGrid<Data_Type> MakeSimdGrid(benchmark::State& state, unsigned seed)
+	{
+		typedef typename UncheckedGrid<Data_Type>::dimension_type dimension_type;
+
+		UncheckedGrid<Data_Type> grid(dimension_type(state.range(0)), dimension_type(state.range(1)));
+		std::mt19937 random(seed);
+
+		for (Data_Type& cell : grid)
+			cell = Data_Type(random() % 251);
+
+		return grid;
+	}
+
+	///Selects isa for the benchmark, false when the CPU lacks it
+	inline bool UseIsa(benchmark::State& state, GridSimd::Isa isa)
+	{
+		if (GridSimd::SetActiveIsa(isa) != isa)
+		{
+			state.SkipWithError((std::string(GridSimd::GetIsaName(isa)) + " not supported").c_str());
+			return false;
+		}
+
+		state.SetLabel(GridSimd::GetIsaName(isa));
+		return true;
+	}
+}
+
+template<typename Data_Type>
+static void BM_LoopSum(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1)))
+		return;
+
+	const UncheckedGrid<Data_Type> grid = MakeSimdGrid<Data_Type>(state, 1);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(std::accumulate(grid.begin(), grid.end(), GridSimd::SumType<Data_Type>(0)));
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size() * sizeof(Data_Type)));
+}
+
+template<typename Data_Type, GridSimd::Isa isa>
+static void BM_SimdSum(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1)) || !UseIsa(state, isa))
+		return;
+
+	const UncheckedGrid<Data_Type> grid = MakeSimdGrid<Data_Type>(state, 1);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(GridSimd::Sum(grid));
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size() * sizeof(Data_Type)));
+	GridSimd::SetActiveIsa(GridSimd::GetSupportedIsa());
+}
+
+template<typename Data_Type>
+static void BM_LoopMinMax(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1)))
+		return;
+
+	const UncheckedGrid<Data_Type> grid = MakeSimdGrid<Data_Type>(state, 2);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(std::minmax_element(grid.begin(), grid.end()));
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size() * sizeof(Data_Type)));
+}
+
+template<typename Data_Type, GridSimd::Isa isa>
+static void BM_SimdMinMax(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1)) || !UseIsa(state, isa))
+		return;
+
+	const UncheckedGrid<Data_Type> grid = MakeSimdGrid<Data_Type>(state, 2);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(GridSimd::MinMax(grid));
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size() * sizeof(Data_Type)));
+	GridSimd::SetActiveIsa(GridSimd::GetSupportedIsa());
+}
+
+///Clamp then threshold in place, the usual per frame image pass
+template<typename Data_Type>
+static void BM_LoopClampThreshold(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1)))
+		return;
+
+	UncheckedGrid<Data_Type> grid = MakeSimdGrid<Data_Type>(state, 3);
+
+	for (auto _ : state)
+	{
+		for (Data_Type& cell : grid)
+		{
+			cell = std::max(std::min(cell, Data_Type(200)), Data_Type(20));
+			cell = cell >= Data_Type(100) ? Data_Type(1) : Data_Type(0);
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size() * sizeof(Data_Type)));
+}
+
+template<typename Data_Type, GridSimd::Isa isa>
+static void BM_SimdClampThreshold(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1)) || !UseIsa(state, isa))
+		return;
+
+	UncheckedGrid<Data_Type> grid = MakeSimdGrid<Data_Type>(state, 3);
+
+	for (auto _ : state)
+	{
+		GridSimd::Clamp(grid, Data_Type(20), Data_Type(200));
+		GridSimd::Threshold(grid, Data_Type(100), Data_Type(0), Data_Type(1));
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size() * sizeof(Data_Type)));
+	GridSimd::SetActiveIsa(GridSimd::GetSupportedIsa());
+}
+
+template<typename Data_Type, GridSimd::Isa isa>
+static void BM_SimdMultiply(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1), 3) || !UseIsa(state, isa))
+		return;
+
+	const UncheckedGrid<Data_Type> left = MakeSimdGrid<Data_Type>(state, 4), right = MakeSimdGrid<Data_Type>(state, 5);
+	UncheckedGrid<Data_Type> target = MakeSimdGrid<Data_Type>(state, 6);
+
+	for (auto _ : state)
+	{
+		GridSimd::Multiply(left, right, target);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(target.size() * sizeof(Data_Type) * 3));
+	GridSimd::SetActiveIsa(GridSimd::GetSupportedIsa());
+}
+
+static void BM_Histogram(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<std::uint8_t>(state, state.range(0), state.range(1)))
+		return;
+
+	const UncheckedGrid<std::uint8_t> grid = MakeSimdGrid<std::uint8_t>(state, 7);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(GridSimd::Histogram(grid));
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size()));
+}
+
+//One benchmark per instruction set, skipped on CPUs without it
+#define GRID_SIMD_BENCHMARKS(name, type) \
+	BENCHMARK_TEMPLATE(name, type, GridSimd::Isa::Scalar)->Apply(SimdSizes); \
+	BENCHMARK_TEMPLATE(name, type, GridSimd::Isa::Sse2)->Apply(SimdSizes); \
+	BENCHMARK_TEMPLATE(name, type, GridSimd::Isa::Avx2)->Apply(SimdSizes); \
+	BENCHMARK_TEMPLATE(name, type, GridSimd::Isa::Avx512)->Apply(SimdSizes);
+
+BENCHMARK_TEMPLATE(BM_LoopSum, float)->Apply(SimdSizes);
+GRID_SIMD_BENCHMARKS(BM_SimdSum, float)
+BENCHMARK_TEMPLATE(BM_LoopSum, std::uint8_t)->Apply(SimdSizes);
+GRID_SIMD_BENCHMARKS(BM_SimdSum, std::uint8_t)
+BENCHMARK_TEMPLATE(BM_LoopMinMax, float)->Apply(SimdSizes);
+GRID_SIMD_BENCHMARKS(BM_SimdMinMax, float)
+BENCHMARK_TEMPLATE(BM_LoopMinMax, std::int32_t)->Apply(SimdSizes);
+GRID_SIMD_BENCHMARKS(BM_SimdMinMax, std::int32_t)
+BENCHMARK_TEMPLATE(BM_LoopClampThreshold, std::uint8_t)->Apply(SimdSizes);
+GRID_SIMD_BENCHMARKS(BM_SimdClampThreshold, std::uint8_t)
+BENCHMARK_TEMPLATE(BM_LoopClampThreshold, double)->Apply(SimdSizes);
+GRID_SIMD_BENCHMARKS(BM_SimdClampThreshold, double)
+GRID_SIMD_BENCHMARKS(BM_SimdMultiply, std::int32_t)
+BENCHMARK(BM_Histogram)->Apply(SimdSizes);
@@ -0,0 +1,93 @@
+// SnapshotGridBenchmark.cpp : Handing a copy of the grid to readers every
+// tick, a deep Grid copy against a SnapshotGrid snapshot, and what the writes
+// after a snapshot cost once they start cloning chunks.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "SnapshotGrid.h"
+
+#include <random>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void SnapshotSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+
+	const int WritesPerTick = 1000;
+}
+
+static void BM_GridCopy(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows, 2))
+		return;
+
+	Grid<int> grid(columns, rows, 1);
+
+	for (auto _ : state)
+	{
+		Grid<int> copy(grid);
+		benchmark::DoNotOptimize(copy.GetCell(0, 0));
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size() * sizeof(int)));
+}
+
+static void BM_Snapshot(benchmark::State& state)
+{
+	SnapshotGrid<int>::dimension_type columns = SnapshotGrid<int>::dimension_type(state.range(0));
+	SnapshotGrid<int>::dimension_type rows = SnapshotGrid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows, 2))
+		return;
+
+	SnapshotGrid<int> grid(columns, rows, 1);
+	grid.ForEach(GridExecution::seq, [](int& cell) { cell = 2; });
+
+	for (auto _ : state)
+	{
+		SnapshotGrid<int>::snapshot_type snapshot = grid.Snapshot();
+		benchmark::DoNotOptimize(snapshot.GetCell(0, 0));
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size() * sizeof(int)));
+}
+
+///A snapshot per tick followed by scattered writes, each first write to a
+///chunk cloning it
+static void BM_SnapshotTick(benchmark::State& state)
+{
+	SnapshotGrid<int>::dimension_type columns = SnapshotGrid<int>::dimension_type(state.range(0));
+	SnapshotGrid<int>::dimension_type rows = SnapshotGrid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows, 2))
+		return;
+
+	SnapshotGrid<int> grid(columns, rows, 1);
+	grid.ForEach(GridExecution::seq, [](int& cell) { cell = 2; });
+
+	std::minstd_rand random(1);
+
+	for (auto _ : state)
+	{
+		SnapshotGrid<int>::snapshot_type snapshot = grid.Snapshot();
+
+		for (int write = 0; write < WritesPerTick; write++)
+			grid.SetCell(SnapshotGrid<int>::dimension_type(random() % columns), SnapshotGrid<int>::dimension_type(random() % rows), write);
+
+		benchmark::DoNotOptimize(snapshot.GetCell(0, 0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * WritesPerTick);
+}
+
+BENCHMARK(BM_GridCopy)->Apply(SnapshotSizes);
+BENCHMARK(BM_Snapshot)->Apply(SnapshotSizes);
+BENCHMARK(BM_SnapshotTick)->Apply(SnapshotSizes);
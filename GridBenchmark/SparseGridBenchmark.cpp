@@ -0,0 +1,137 @@
+// SparseGridBenchmark.cpp : Chunked SparseGrid against a dense Grid of the
+// populated region.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "Grid.h"
+#include "SparseGrid.h"
+
+using namespace GridBenchmark;
+
+namespace
+{
+	///Where the populated region sits in the million cell wide world
+	const std::uint32_t RegionOrigin = 500000;
+
+	void RegionSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 256, 1024 })
+			benchmark->Args({ size, size });
+	}
+}
+
+///Writes every cell of a region, creating its chunks on the way
+template<std::size_t Chunk_Size>
+static void BM_SparseFillRegion(benchmark::State& state)
+{
+	std::uint32_t columns = std::uint32_t(state.range(0));
+	std::uint32_t rows = std::uint32_t(state.range(1));
+
+	for (auto _ : state)
+	{
+		SparseGrid<int, Chunk_Size> grid(1000000, 1000000, 0);
+
+		for (std::uint32_t row = 0; row < rows; row++)
+		{
+			for (std::uint32_t column = 0; column < columns; column++)
+				grid.GetCell(RegionOrigin + column, RegionOrigin + row) = int(column + row);
+		}
+
+		benchmark::DoNotOptimize(grid.GetChunkCount());
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(columns) * rows);
+}
+
+///Reads a populated region cell by cell, one chunk lookup per read
+template<std::size_t Chunk_Size>
+static void BM_SparseReadRegion(benchmark::State& state)
+{
+	std::uint32_t columns = std::uint32_t(state.range(0));
+	std::uint32_t rows = std::uint32_t(state.range(1));
+
+	SparseGrid<int, Chunk_Size> grid(1000000, 1000000, 0);
+
+	for (std::uint32_t row = 0; row < rows; row++)
+	{
+		for (std::uint32_t column = 0; column < columns; column++)
+			grid.GetCell(RegionOrigin + column, RegionOrigin + row) = int(column + row);
+	}
+
+	const SparseGrid<int, Chunk_Size>& readOnly = grid;
+
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+
+		for (std::uint32_t row = 0; row < rows; row++)
+		{
+			for (std::uint32_t column = 0; column < columns; column++)
+				sum += readOnly.GetCell(RegionOrigin + column, RegionOrigin + row);
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(columns) * rows);
+}
+
+///Visits the populated cells through the chunk iterator
+template<std::size_t Chunk_Size>
+static void BM_SparseIterate(benchmark::State& state)
+{
+	std::uint32_t columns = std::uint32_t(state.range(0));
+	std::uint32_t rows = std::uint32_t(state.range(1));
+
+	SparseGrid<int, Chunk_Size> grid(1000000, 1000000, 0);
+
+	for (std::uint32_t row = 0; row < rows; row++)
+	{
+		for (std::uint32_t column = 0; column < columns; column++)
+			grid.GetCell(RegionOrigin + column, RegionOrigin + row) = int(column + row);
+	}
+
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+
+		for (int cell : grid)
+			sum += cell;
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(columns) * rows);
+}
+
+///The same region read from a dense Grid, the lower bound for the sparse reads
+static void BM_DenseReadRegion(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	Grid<int> grid(columns, rows, 1);
+
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+
+		for (Grid<int>::dimension_type row = 0; row < rows; row++)
+		{
+			for (Grid<int>::dimension_type column = 0; column < columns; column++)
+				sum += grid.GetCell(column, row);
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(columns) * rows);
+}
+
+BENCHMARK_TEMPLATE(BM_SparseFillRegion, 16)->Apply(RegionSizes);
+BENCHMARK_TEMPLATE(BM_SparseFillRegion, 64)->Apply(RegionSizes);
+BENCHMARK_TEMPLATE(BM_SparseReadRegion, 16)->Apply(RegionSizes);
+BENCHMARK_TEMPLATE(BM_SparseReadRegion, 64)->Apply(RegionSizes);
+BENCHMARK_TEMPLATE(BM_SparseIterate, 16)->Apply(RegionSizes);
+BENCHMARK_TEMPLATE(BM_SparseIterate, 64)->Apply(RegionSizes);
+BENCHMARK(BM_DenseReadRegion)->Apply(RegionSizes);
@@ -0,0 +1,80 @@
+// StaticGridBenchmark.cpp : Small fixed boards, a heap allocated Grid against a
+// StaticGrid, built fresh and read through GetCell.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "StaticGrid.h"
+
+using namespace GridBenchmark;
+
+namespace
+{
+	const int Side = 8;
+}
+
+///Builds a board, marks its diagonals and scores it, as a board game search
+///does for every position
+static void BM_GridBoard(benchmark::State& state)
+{
+	//Opaque to the optimiser, so only the indexing can be folded away
+	int opaque = 1;
+	benchmark::DoNotOptimize(opaque);
+	const int mark = opaque;
+
+	for (auto _ : state)
+	{
+		Grid<int> board(Side, Side, 0);
+
+		for (int cell = 0; cell < Side; cell++)
+		{
+			board.GetCell(Grid<int>::dimension_type(cell), Grid<int>::dimension_type(cell)) = mark;
+			board.GetCell(Grid<int>::dimension_type(Side - 1 - cell), Grid<int>::dimension_type(cell)) = mark + 1;
+		}
+
+		int score = 0;
+
+		for (Grid<int>::dimension_type row = 0; row < Side; row++)
+		{
+			for (Grid<int>::dimension_type column = 0; column < Side; column++)
+				score += board.GetCell(column, row) * int(column + 1);
+		}
+
+		benchmark::DoNotOptimize(score);
+	}
+
+	state.SetItemsProcessed(state.iterations() * Side * Side);
+}
+
+static void BM_StaticGridBoard(benchmark::State& state)
+{
+	//Opaque to the optimiser, so only the indexing can be folded away
+	int opaque = 1;
+	benchmark::DoNotOptimize(opaque);
+	const int mark = opaque;
+
+	for (auto _ : state)
+	{
+		StaticGrid<int, Side, Side> board;
+
+		for (int cell = 0; cell < Side; cell++)
+		{
+			board.GetCell(std::size_t(cell), std::size_t(cell)) = mark;
+			board.GetCell(std::size_t(Side - 1 - cell), std::size_t(cell)) = mark + 1;
+		}
+
+		int score = 0;
+
+		for (std::size_t row = 0; row < Side; row++)
+		{
+			for (std::size_t column = 0; column < Side; column++)
+				score += board.GetCell(column, row) * int(column + 1);
+		}
+
+		benchmark::DoNotOptimize(score);
+	}
+
+	state.SetItemsProcessed(state.iterations() * Side * Side);
+}
+
+BENCHMARK(BM_GridBoard);
+BENCHMARK(BM_StaticGridBoard);
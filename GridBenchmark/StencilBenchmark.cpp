@@ -0,0 +1,105 @@
+// StencilBenchmark.cpp : One 3x3 diffusion step written as a GetCell loop with
+// edge checks and a copied back buffer, against GridStencil.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "GridStencil.h"
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void StencilSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 256, 2048 })
+			benchmark->Args({ size, size });
+	}
+
+	const float Diffusion[3][3] = { { 0.05f, 0.2f, 0.05f }, { 0.2f, 0.0f, 0.2f }, { 0.05f, 0.2f, 0.05f } };
+}
+
+///How the simulations were written before GridStencil
+static void BM_NaiveDiffusion(benchmark::State& state)
+{
+	typedef Grid<float>::dimension_type dimension_type;
+
+	dimension_type columns = dimension_type(state.range(0));
+	dimension_type rows = dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<float>(state, columns, rows, 2))
+		return;
+
+	Grid<float> field(columns, rows, 1.0f);
+
+	for (auto _ : state)
+	{
+		Grid<float> previous(field);
+
+		for (int row = 0; row < rows; row++)
+		{
+			for (int column = 0; column < columns; column++)
+			{
+				float sum = 0.0f;
+
+				for (int rowOffset = -1; rowOffset <= 1; rowOffset++)
+				{
+					for (int columnOffset = -1; columnOffset <= 1; columnOffset++)
+					{
+						int x = std::min(std::max(column + columnOffset, 0), columns - 1);
+						int y = std::min(std::max(row + rowOffset, 0), rows - 1);
+
+						sum += Diffusion[rowOffset + 1][columnOffset + 1] * previous.GetCell(dimension_type(x), dimension_type(y));
+					}
+				}
+
+				field.GetCell(dimension_type(column), dimension_type(row)) = sum;
+			}
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(columns) * rows);
+}
+
+static void BM_StencilDiffusion(benchmark::State& state)
+{
+	GridStencil<float>::dimension_type columns = GridStencil<float>::dimension_type(state.range(0));
+	GridStencil<float>::dimension_type rows = GridStencil<float>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<float>(state, columns, rows, 2))
+		return;
+
+	GridStencil<float> field(columns, rows, GridBorder::Clamp, 1.0f);
+
+	for (auto _ : state)
+	{
+		field.Convolve(GridExecution::seq, Diffusion);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(columns) * rows);
+}
+
+static void BM_StencilDiffusionParallel(benchmark::State& state)
+{
+	GridStencil<float>::dimension_type columns = GridStencil<float>::dimension_type(state.range(0));
+	GridStencil<float>::dimension_type rows = GridStencil<float>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<float>(state, columns, rows, 2))
+		return;
+
+	GridStencil<float> field(columns, rows, GridBorder::Clamp, 1.0f);
+
+	for (auto _ : state)
+	{
+		field.Convolve(GridExecution::par, Diffusion);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(columns) * rows);
+}
+
+BENCHMARK(BM_NaiveDiffusion)->Apply(StencilSizes);
+BENCHMARK(BM_StencilDiffusion)->Apply(StencilSizes);
+BENCHMARK(BM_StencilDiffusionParallel)->Apply(StencilSizes);
@@ -0,0 +1,85 @@
+// SummedAreaTableBenchmark.cpp : Building a SummedAreaTable and answering
+// rectangle sums from it, against summing the rectangle cell by cell.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "SummedAreaTable.h"
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void TableSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 256, 4096 })
+			benchmark->Args({ size, size });
+	}
+}
+
+template<typename Policy_Type>
+static void BM_SummedAreaBuild(benchmark::State& state, Policy_Type policy)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<std::int64_t>(state, columns, rows, 2))
+		return;
+
+	Grid<int> grid(columns, rows, 3);
+	SummedAreaTable<int> table;
+
+	for (auto _ : state)
+	{
+		table.Build(policy, grid);
+		benchmark::DoNotOptimize(table.Total());
+	}
+
+	state.SetItemsProcessed(state.iterations() * std::int64_t(columns) * rows);
+}
+
+///A quarter of the grid summed per query, the loop grows with the rectangle
+static void BM_RectangleSumLoop(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows))
+		return;
+
+	Grid<int> grid(columns, rows, 3);
+
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+
+		for (Grid<int>::dimension_type row = rows / 4; row < rows / 4 * 3; row++)
+		{
+			for (Grid<int>::dimension_type column = columns / 4; column < columns / 4 * 3; column++)
+				sum += grid.GetCell(column, row);
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+}
+
+static void BM_RectangleSumTable(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<std::int64_t>(state, columns, rows, 2))
+		return;
+
+	Grid<int> grid(columns, rows, 3);
+	SummedAreaTable<int> table(grid);
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(table.Sum(columns / 4, rows / 4, columns / 4 * 3 - 1, rows / 4 * 3 - 1));
+	}
+}
+
+BENCHMARK_CAPTURE(BM_SummedAreaBuild, Sequential, GridExecution::seq)->Apply(TableSizes);
+BENCHMARK_CAPTURE(BM_SummedAreaBuild, Parallel, GridExecution::par)->Apply(TableSizes);
+BENCHMARK(BM_RectangleSumLoop)->Apply(TableSizes);
+BENCHMARK(BM_RectangleSumTable)->Apply(TableSizes);
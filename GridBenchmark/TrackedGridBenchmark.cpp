@@ -0,0 +1,96 @@
+// TrackedGridBenchmark.cpp : What recording writes in a TrackedGrid costs, and
+// draining the dirty rectangles after a frame of scattered writes.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "TrackedGrid.h"
+
+#include <random>
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void TrackedSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+
+	const int WritesPerFrame = 1000;
+}
+
+static void BM_UntrackedWrites(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows))
+		return;
+
+	Grid<int> grid(columns, rows, 0);
+	std::minstd_rand random(1);
+
+	for (auto _ : state)
+	{
+		for (int write = 0; write < WritesPerFrame; write++)
+			grid.GetCell(Grid<int>::dimension_type(random() % columns), Grid<int>::dimension_type(random() % rows)) = write;
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * WritesPerFrame);
+}
+
+static void BM_TrackedWrites(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows))
+		return;
+
+	TrackedGrid<Grid<int>> grid(columns, rows, 0);
+	std::minstd_rand random(1);
+
+	for (auto _ : state)
+	{
+		for (int write = 0; write < WritesPerFrame; write++)
+			grid.SetCell(Grid<int>::dimension_type(random() % columns), Grid<int>::dimension_type(random() % rows), write);
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetItemsProcessed(state.iterations() * WritesPerFrame);
+}
+
+///One frame of scattered writes, then ConsumeDirty
+static void BM_ConsumeDirty(benchmark::State& state)
+{
+	Grid<int>::dimension_type columns = Grid<int>::dimension_type(state.range(0));
+	Grid<int>::dimension_type rows = Grid<int>::dimension_type(state.range(1));
+
+	if (!FitsMemoryBudget<int>(state, columns, rows))
+		return;
+
+	TrackedGrid<Grid<int>> grid(columns, rows, 0);
+	std::minstd_rand random(1);
+	std::vector<GridDirtyRect> dirty;
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		for (int write = 0; write < WritesPerFrame; write++)
+			grid.SetCell(Grid<int>::dimension_type(random() % columns), Grid<int>::dimension_type(random() % rows), write);
+		state.ResumeTiming();
+
+		grid.ConsumeDirty(dirty);
+		benchmark::DoNotOptimize(dirty.data());
+	}
+
+	state.counters["Rectangles"] = double(dirty.size());
+}
+
+BENCHMARK(BM_UntrackedWrites)->Apply(TrackedSizes);
+BENCHMARK(BM_TrackedWrites)->Apply(TrackedSizes);
+BENCHMARK(BM_ConsumeDirty)->Apply(TrackedSizes);
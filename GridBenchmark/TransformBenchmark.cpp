@@ -0,0 +1,120 @@
+// TransformBenchmark.cpp : Transposing and rotating, a naive GetCell loop
+// against the blocked GridTransforms versions.
+//
+
+#include "GridBenchmarkCommon.h"
+#include "GridTransforms.h"
+
+using namespace GridBenchmark;
+
+namespace
+{
+	void TransformSizes(benchmark::internal::Benchmark* benchmark)
+	{
+		for (std::int64_t size : { 16, 1024, 4096 })
+			benchmark->Args({ size, size });
+	}
+
+	template<typename Data_Type>
+	Grid<Data_Type> MakeSource(benchmark::State& state)
+	{
+		typedef typename Grid<Data_Type>::dimension_type dimension_type;
+
+		Grid<Data_Type> grid{ dimension_type(state.range(0)), dimension_type(state.range(1)) };
+		Data_Type value = 0;
+
+		for (Data_Type& cell : grid)
+			cell = value++;
+
+		return grid;
+	}
+}
+
+template<typename Data_Type>
+static void BM_NaiveTranspose(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1), 2))
+		return;
+
+	Grid<Data_Type> source = MakeSource<Data_Type>(state);
+	Grid<Data_Type> target(source.GetRowCount(), source.GetColumnCount());
+
+	for (auto _ : state)
+	{
+		for (typename Grid<Data_Type>::dimension_type row = 0; row < source.GetRowCount(); row++)
+		{
+			for (typename Grid<Data_Type>::dimension_type column = 0; column < source.GetColumnCount(); column++)
+				target.GetCell(row, column) = source.GetCell(column, row);
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(source.size() * sizeof(Data_Type)));
+}
+
+template<typename Data_Type>
+static void BM_BlockedTranspose(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1), 2))
+		return;
+
+	Grid<Data_Type> source = MakeSource<Data_Type>(state);
+	Grid<Data_Type> target(source.GetRowCount(), source.GetColumnCount());
+
+	for (auto _ : state)
+	{
+		CopyTransposed(GridView<const Data_Type>(source), GridView<Data_Type>(target));
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(source.size() * sizeof(Data_Type)));
+}
+
+template<typename Data_Type>
+static void BM_NaiveRotate90(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1), 2))
+		return;
+
+	Grid<Data_Type> source = MakeSource<Data_Type>(state);
+	Grid<Data_Type> target(source.GetRowCount(), source.GetColumnCount());
+	typename Grid<Data_Type>::dimension_type rows = source.GetRowCount();
+
+	for (auto _ : state)
+	{
+		for (typename Grid<Data_Type>::dimension_type row = 0; row < rows; row++)
+		{
+			for (typename Grid<Data_Type>::dimension_type column = 0; column < source.GetColumnCount(); column++)
+				target.GetCell(typename Grid<Data_Type>::dimension_type(rows - 1 - row), column) = source.GetCell(column, row);
+		}
+
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(source.size() * sizeof(Data_Type)));
+}
+
+template<typename Data_Type>
+static void BM_InPlaceRotate90(benchmark::State& state)
+{
+	if (!FitsMemoryBudget<Data_Type>(state, state.range(0), state.range(1)))
+		return;
+
+	Grid<Data_Type> grid = MakeSource<Data_Type>(state);
+
+	for (auto _ : state)
+	{
+		Rotate90(grid);
+		benchmark::ClobberMemory();
+	}
+
+	state.SetBytesProcessed(state.iterations() * std::int64_t(grid.size() * sizeof(Data_Type)));
+}
+
+BENCHMARK_TEMPLATE(BM_NaiveTranspose, int)->Apply(TransformSizes);
+BENCHMARK_TEMPLATE(BM_BlockedTranspose, int)->Apply(TransformSizes);
+BENCHMARK_TEMPLATE(BM_NaiveTranspose, std::uint8_t)->Apply(TransformSizes);
+BENCHMARK_TEMPLATE(BM_BlockedTranspose, std::uint8_t)->Apply(TransformSizes);
+BENCHMARK_TEMPLATE(BM_NaiveRotate90, int)->Apply(TransformSizes);
+BENCHMARK_TEMPLATE(BM_InPlaceRotate90, int)->Apply(TransformSizes);
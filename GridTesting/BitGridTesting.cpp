@@ -0,0 +1,141 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "BitGrid.h"
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(BitGridTesting)
+	{
+	public:
+		TEST_METHOD(CellsPackIntoWords)
+		{
+			BitGrid<> mask(130, 3);
+
+			Assert::AreEqual(std::size_t(3), mask.GetWordsPerRow());
+			Assert::IsFalse(mask.GetCell(129, 2));
+
+			mask[129][2] = true;
+			mask.SetCell(64, 0, true);
+			mask.GetCell(0, 1) = mask.GetCell(64, 0);
+
+			Assert::IsTrue(mask.GetCell(129, 2));
+			Assert::IsTrue(mask[0][1]);
+			Assert::AreEqual(std::uint64_t(1), mask.GetWords()[1]);
+			Assert::AreEqual(std::uint64_t(3), mask.Count());
+
+			BitGrid<4> counters(20, 2, 9);
+			counters.SetCell(3, 1, 0x1F);
+
+			Assert::AreEqual(15, int(counters.GetCell(3, 1)));
+			Assert::AreEqual(9, int(counters[4][1]));
+			Assert::AreEqual(2, int(counters.GetWordsPerRow()));
+
+			Assert::ExpectException<std::out_of_range>([&]() { mask.GetCell(130, 0); });
+			Assert::ExpectException<std::invalid_argument>([&]() { mask.ResizeGrid(4, 0); });
+		}
+
+		TEST_METHOD(WordOperationsMatchCellByCell)
+		{
+			std::mt19937 random(3);
+			BitGrid<> left(100, 9);
+			BitGrid<> right(100, 9);
+
+			for (unsigned row = 0; row < 9; row++)
+			{
+				for (unsigned column = 0; column < 100; column++)
+				{
+					left.SetCell(column, row, random() % 2 == 0);
+					right.SetCell(column, row, random() % 3 == 0);
+				}
+			}
+
+			BitGrid<> both(left);
+			BitGrid<> either(left);
+			BitGrid<> difference(left);
+			BitGrid<> inverse(left);
+
+			both.And(right);
+			either.Or(right);
+			difference.Xor(right);
+			inverse.Not();
+
+			std::uint64_t expectedBoth = 0;
+
+			for (unsigned row = 0; row < 9; row++)
+			{
+				for (unsigned column = 0; column < 100; column++)
+				{
+					bool a = left.GetCell(column, row);
+					bool b = right.GetCell(column, row);
+
+					Assert::AreEqual(a && b, bool(both.GetCell(column, row)));
+					Assert::AreEqual(a || b, bool(either.GetCell(column, row)));
+					Assert::AreEqual(a != b, bool(difference.GetCell(column, row)));
+					Assert::AreEqual(!a, bool(inverse.GetCell(column, row)));
+
+					expectedBoth += a && b;
+				}
+			}
+
+			Assert::AreEqual(expectedBoth, both.Count());
+			Assert::AreEqual(std::uint64_t(900) - left.Count(), inverse.Count(), L"Not must leave the row tails clear");
+
+			Assert::ExpectException<std::invalid_argument>([&]() { both.And(BitGrid<>(99, 9)); });
+		}
+
+		TEST_METHOD(FindFirstSetAndShift)
+		{
+			BitGrid<2> grid(70, 5);
+			Assert::AreEqual(std::uint64_t(350), grid.size());
+
+			BitGrid<2>::dimension_type column = 0;
+			BitGrid<2>::dimension_type row = 0;
+			Assert::IsFalse(grid.FindFirstSet(column, row));
+
+			grid.SetCell(66, 2, 2);
+			grid.SetCell(10, 3, 1);
+			Assert::AreEqual(std::uint64_t(2), grid.Count());
+
+			Assert::IsTrue(grid.FindFirstSet(column, row));
+			Assert::AreEqual(66, int(column));
+			Assert::AreEqual(2, int(row));
+
+			grid.Shift(-40, 1);
+			Assert::AreEqual(2, int(grid.GetCell(26, 3)));
+			Assert::AreEqual(std::uint64_t(1), grid.Count(), L"The cell at column 10 left the grid");
+
+			grid.Shift(43, -3);
+			Assert::AreEqual(2, int(grid.GetCell(69, 0)));
+
+			grid.Shift(1, 0);
+			Assert::AreEqual(std::uint64_t(0), grid.Count());
+		}
+
+		TEST_METHOD(DilateAndErode)
+		{
+			BitGrid<> mask(80, 6);
+			mask.SetCell(63, 2, true);
+			mask.Dilate();
+
+			Assert::AreEqual(std::uint64_t(9), mask.Count());
+			Assert::IsTrue(mask.GetCell(64, 3) && mask.GetCell(62, 1));
+
+			mask.Erode();
+			Assert::AreEqual(std::uint64_t(1), mask.Count());
+			Assert::IsTrue(mask.GetCell(63, 2));
+
+			//Outside the grid counts as clear, so a full grid loses its border
+			mask.Fill(true);
+			mask.Erode();
+			Assert::AreEqual(std::uint64_t(78 * 4), mask.Count());
+			Assert::IsFalse(mask.GetCell(79, 3));
+			Assert::IsTrue(mask.GetCell(78, 4));
+		}
+	};
+}
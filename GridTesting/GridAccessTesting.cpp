@@ -0,0 +1,86 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "GridView.h"
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridAccessTesting)
+	{
+	public:
+		typedef Grid<int, RowMajorLayout, std::allocator<int>, std::uint16_t, GridCheckedAccess> CheckedGrid;
+		typedef Grid<int, PaddedRowMajorLayout<64>, std::allocator<int>, std::uint16_t, GridCheckedAccess> CheckedPaddedGrid;
+
+		TEST_METHOD(CheckedAccessCatchesEveryPath)
+		{
+			CheckedGrid grid(4, 6, 1);
+			const CheckedGrid& constGrid = grid;
+
+			//One past the last column or row used to slip through GetCell
+			Assert::ExpectException<std::out_of_range>([&]() { grid.GetCell(4, 0); });
+			Assert::ExpectException<std::out_of_range>([&]() { grid.GetCell(0, 6); });
+			Assert::ExpectException<std::out_of_range>([&]() { constGrid.GetCell(4, 5); });
+			Assert::ExpectException<std::out_of_range>([&]() { grid[4][0]; });
+			Assert::ExpectException<std::out_of_range>([&]() { constGrid[0][6]; });
+			Assert::ExpectException<std::out_of_range>([&]() { grid.GetCell(std::size_t(24)); });
+			Assert::ExpectException<std::out_of_range>([&]() { *grid.end(); });
+			Assert::ExpectException<std::out_of_range>([&]() { *constGrid.cend(); });
+
+			grid[3][5] = 7;
+			Assert::AreEqual(7, constGrid.GetCell(3, 5));
+			Assert::AreEqual(7, *--grid.end());
+
+			CheckedPaddedGrid padded(5, 3, 2);
+			Assert::AreEqual(2, *padded.begin());
+			Assert::ExpectException<std::out_of_range>([&]() { *padded.end(); });
+
+			GridView<int, GridCheckedAccess> view = MakeGridView(grid, 1, 1, 2, 2);
+			Assert::ExpectException<std::out_of_range>([&]() { view.GetCell(2, 0); });
+			Assert::ExpectException<std::out_of_range>([&]() { view[0][2]; });
+			Assert::ExpectException<std::out_of_range>([&]() { view.GetRow(1)[2]; });
+			Assert::ExpectException<std::out_of_range>([&]() { view.GetRow(2); });
+			Assert::ExpectException<std::out_of_range>([&]() { view.GetColumn(2); });
+
+			//Line iterators check too, flipped views walk towards lower addresses
+			Assert::ExpectException<std::out_of_range>([&]() { *view.GetRow(0).end(); });
+			Assert::ExpectException<std::out_of_range>([&]() { view.GetColumn(1).begin()[2]; });
+
+			GridView<int, GridCheckedAccess> flipped = view.FlippedHorizontally();
+			*(flipped.GetColumn(0).begin() + 1) = 7;
+			Assert::AreEqual(7, grid.GetCell(2, 2));
+			Assert::ExpectException<std::out_of_range>([&]() { *flipped.GetRow(0).end(); });
+		}
+
+		TEST_METHOD(UncheckedAccessIsBare)
+		{
+			UncheckedGrid<int> grid(4, 6, 1);
+			grid[3][5] = 7;
+
+			Assert::AreEqual(7, grid.GetCell(3, 5));
+			Assert::AreEqual(7, *--grid.end());
+			Assert::IsTrue(sizeof(UncheckedGrid<int>::iterator) == sizeof(int*));
+
+			//Views copy between policies, the cells stay shared
+			GridView<int, GridUncheckedAccess> view(grid);
+			GridView<const int, GridCheckedAccess> checkedView(view);
+
+			Assert::AreEqual(7, checkedView.GetCell(3, 5));
+			Assert::ExpectException<std::out_of_range>([&]() { checkedView.GetCell(4, 5); });
+			Assert::IsTrue(view.GetRow(6).size() == 0);
+			Assert::IsTrue(sizeof(GridView<int, GridUncheckedAccess>::line_iterator) == sizeof(GridStrideIterator<int>));
+
+			typedef Grid<int, RowMajorLayout, std::allocator<int>, std::uint16_t, GridAssertedAccess> AssertedGrid;
+			AssertedGrid asserted(4, 6, 3);
+			Assert::AreEqual(3, asserted[3][5]);
+
+			//Debug and release objects must agree on the iterator layout
+			static_assert(sizeof(AssertedGrid::iterator) == sizeof(CheckedGrid::iterator),
+				"Asserted iterators carry their bounds whether or not NDEBUG is defined");
+		}
+	};
+}
@@ -0,0 +1,174 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Grid.h"
+#include "GridAllocators.h"
+#include <cstdint>
+#include <memory_resource>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	///Forwards to the default resource and keeps count of what is outstanding
+	class CountingResource : public std::pmr::memory_resource
+	{
+	public:
+		std::size_t outstandingBytes = 0;
+		std::size_t allocationCount = 0;
+
+	protected:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			outstandingBytes += bytes;
+			allocationCount++;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+		{
+			outstandingBytes -= bytes;
+			std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	struct Cell24
+	{
+		std::int64_t values[3];
+	};
+
+	TEST_CLASS(GridAllocatorTesting)
+	{
+	public:
+		typedef Grid<float, PaddedRowMajorLayout<64>, AlignedAllocator<float, 64>> AlignedFloatGrid;
+
+		TEST_METHOD(PaddedRowsStartAligned)
+		{
+			AlignedFloatGrid grid(13, 5, 1.0f);
+
+			Assert::AreEqual(std::size_t(16), grid.GetLayout().GetRowPitch());
+			Assert::AreEqual(std::size_t(16 * 5), grid.GetStorageSize());
+
+			for (AlignedFloatGrid::dimension_type row = 0; row < grid.GetRowCount(); row++)
+			{
+				std::uintptr_t address = reinterpret_cast<std::uintptr_t>(&grid.GetCell(0, row));
+				Assert::AreEqual(std::uintptr_t(0), address % 64);
+			}
+
+			//Pitch is a whole number of elements and a whole number of cache lines
+			Grid<Cell24, PaddedRowMajorLayout<64>, AlignedAllocator<Cell24, 64>> wideGrid(3, 4, Cell24());
+
+			Assert::AreEqual(std::size_t(8), wideGrid.GetLayout().GetRowPitch());
+
+			for (Grid<int>::dimension_type row = 0; row < wideGrid.GetRowCount(); row++)
+			{
+				std::uintptr_t address = reinterpret_cast<std::uintptr_t>(&wideGrid.GetCell(0, row));
+				Assert::AreEqual(std::uintptr_t(0), address % 64);
+			}
+		}
+
+		TEST_METHOD(PaddedIteratorsSkipPadding)
+		{
+			AlignedFloatGrid grid(13, 5, 0.0f);
+
+			for (AlignedFloatGrid::dimension_type row = 0; row < grid.GetRowCount(); row++)
+				for (AlignedFloatGrid::dimension_type column = 0; column < grid.GetColumnCount(); column++)
+					grid[column][row] = float(column + row * 13);
+
+			float expected = 0.0f;
+
+			for (auto iter = grid.begin(); iter != grid.end(); ++iter)
+			{
+				Assert::AreEqual(expected, *iter);
+				expected += 1.0f;
+			}
+
+			Assert::AreEqual(float(grid.size()), expected);
+			Assert::AreEqual(AlignedFloatGrid::difference_type(grid.size()), grid.end() - grid.begin());
+
+			auto iter = grid.begin() + 27;
+			Assert::AreEqual(27.0f, *iter);
+			Assert::AreEqual(12.0f, iter[-15]);
+
+			iter -= 14;
+			Assert::AreEqual(13.0f, *iter);
+
+			--iter;
+			Assert::AreEqual(12.0f, *iter);
+
+			Assert::IsTrue(grid.begin() < iter);
+			Assert::IsTrue(grid.end() - 1 > iter);
+			Assert::AreEqual(64.0f, *(grid.end() - 1));
+		}
+
+		TEST_METHOD(PaddedResizePreservesCells)
+		{
+			AlignedFloatGrid grid(13, 5, 0.0f);
+
+			for (AlignedFloatGrid::dimension_type row = 0; row < grid.GetRowCount(); row++)
+				for (AlignedFloatGrid::dimension_type column = 0; column < grid.GetColumnCount(); column++)
+					grid[column][row] = float(column + row * 100);
+
+			grid.ResizeGridPreserveData(20, 7, -1.0f);
+
+			Assert::AreEqual(std::size_t(32), grid.GetLayout().GetRowPitch());
+
+			for (AlignedFloatGrid::dimension_type row = 0; row < grid.GetRowCount(); row++)
+			{
+				for (AlignedFloatGrid::dimension_type column = 0; column < grid.GetColumnCount(); column++)
+				{
+					float expected = column < 13 && row < 5 ? float(column + row * 100) : -1.0f;
+					Assert::AreEqual(expected, grid.GetCell(column, row));
+				}
+			}
+
+			AlignedFloatGrid copy(grid);
+			Assert::AreEqual(grid.GetCell(12, 4), copy.GetCell(12, 4));
+		}
+
+		TEST_METHOD(PmrGridUsesMemoryResource)
+		{
+			CountingResource resource;
+
+			{
+				PmrGrid<double> grid(8, 4, 2.5, &resource);
+
+				Assert::AreEqual(std::size_t(1), resource.allocationCount);
+				Assert::AreEqual(sizeof(double) * 32, resource.outstandingBytes);
+
+				//Copies fall back to the default resource, as pmr containers do
+				PmrGrid<double> copy(grid);
+				Assert::AreEqual(std::size_t(1), resource.allocationCount);
+
+				grid.ResizeGridPreserveData(16, 4, 1.0);
+				Assert::AreEqual(sizeof(double) * 64, resource.outstandingBytes);
+			}
+
+			Assert::AreEqual(std::size_t(0), resource.outstandingBytes);
+		}
+
+		TEST_METHOD(PmrMoveAcrossResources)
+		{
+			CountingResource first;
+			CountingResource second;
+
+			PmrGrid<int> source(5, 5, 9, &first);
+			PmrGrid<int> destination{ std::pmr::polymorphic_allocator<int>(&second) };
+
+			destination = std::move(source);
+
+			Assert::IsTrue(destination.get_allocator().resource() == &second);
+			Assert::AreEqual(std::size_t(0), first.outstandingBytes);
+			Assert::AreEqual(sizeof(int) * 25, second.outstandingBytes);
+			Assert::IsTrue(source.isEmpty());
+
+			for (auto value : destination)
+				Assert::AreEqual(9, value);
+		}
+	};
+}
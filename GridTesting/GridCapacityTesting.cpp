@@ -0,0 +1,217 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Grid.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	///Rows of columns, edited alongside a Grid to know what it should hold
+	typedef std::vector<std::vector<int>> ReferenceGrid;
+
+	template<typename Grid_Type>
+	void FillFromCoordinates(Grid_Type& grid, ReferenceGrid& reference)
+	{
+		reference.assign(grid.GetRowCount(), std::vector<int>(grid.GetColumnCount()));
+
+		for (unsigned short row = 0; row < grid.GetRowCount(); row++)
+		{
+			for (unsigned short column = 0; column < grid.GetColumnCount(); column++)
+			{
+				grid.GetCell(column, row) = column * 100 + row;
+				reference[row][column] = column * 100 + row;
+			}
+		}
+	}
+
+	template<typename Grid_Type>
+	bool MatchesReference(const Grid_Type& grid, const ReferenceGrid& reference)
+	{
+		if (grid.GetRowCount() != reference.size())
+			return false;
+
+		for (unsigned short row = 0; row < grid.GetRowCount(); row++)
+		{
+			if (grid.GetColumnCount() != reference[row].size())
+				return false;
+
+			for (unsigned short column = 0; column < grid.GetColumnCount(); column++)
+			{
+				if (grid.GetCell(column, row) != reference[row][column])
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	///Runs every growth function on a layout, checking the cells after each step
+	template<typename Layout_Type>
+	void CheckShapeChanges()
+	{
+		Grid<int, Layout_Type> grid(5, 4, 0);
+		ReferenceGrid reference;
+
+		FillFromCoordinates(grid, reference);
+
+		grid.AppendRows(3, -1);
+		reference.resize(7, std::vector<int>(5, -1));
+		Assert::IsTrue(MatchesReference(grid, reference), L"AppendRows");
+
+		grid.AppendColumns(2, -2);
+		for (std::vector<int>& row : reference)
+			row.resize(7, -2);
+		Assert::IsTrue(MatchesReference(grid, reference), L"AppendColumns");
+
+		grid.InsertRow(2, -3);
+		reference.insert(reference.begin() + 2, std::vector<int>(7, -3));
+		Assert::IsTrue(MatchesReference(grid, reference), L"InsertRow");
+
+		grid.InsertColumn(1, -4);
+		for (std::vector<int>& row : reference)
+			row.insert(row.begin() + 1, -4);
+		Assert::IsTrue(MatchesReference(grid, reference), L"InsertColumn");
+
+		grid.EraseColumn(3);
+		for (std::vector<int>& row : reference)
+			row.erase(row.begin() + 3);
+		Assert::IsTrue(MatchesReference(grid, reference), L"EraseColumn");
+
+		grid.EraseRow(0);
+		reference.erase(reference.begin());
+		Assert::IsTrue(MatchesReference(grid, reference), L"EraseRow");
+
+		grid.ResizeGridPreserveData(3, 9, -5);
+		reference.resize(9, std::vector<int>(7, -5));
+		for (std::vector<int>& row : reference)
+			row.resize(3);
+		Assert::IsTrue(MatchesReference(grid, reference), L"ResizeGridPreserveData");
+
+		grid.shrink_to_fit();
+		Assert::AreEqual(grid.GetStorageSize(), grid.capacity(), L"shrink_to_fit");
+		Assert::IsTrue(MatchesReference(grid, reference), L"shrink_to_fit");
+	}
+
+	TEST_CLASS(GridCapacityTesting)
+	{
+	public:
+
+		TEST_METHOD(ShapeChangesKeepCells)
+		{
+			CheckShapeChanges<RowMajorLayout>();
+			CheckShapeChanges<ColumnMajorLayout>();
+			CheckShapeChanges<PaddedRowMajorLayout<16>>();
+			CheckShapeChanges<TiledLayout<4>>();
+			CheckShapeChanges<MortonLayout<4>>();
+		}
+
+		TEST_METHOD(AppendRowsUsesReservedCapacity)
+		{
+			Grid<int> grid(8, 2, 7);
+			grid.reserve(8, 10);
+
+			const int* storage = &grid.GetCell(0, 0);
+
+			Assert::AreEqual(size_t(80), grid.capacity());
+
+			grid.AppendRows(8, 1);
+
+			Assert::IsTrue(storage == &grid.GetCell(0, 0), L"Appending inside the capacity must not reallocate");
+			Assert::AreEqual(7, grid.GetCell(7, 1));
+			Assert::AreEqual(1, grid.GetCell(7, 9));
+		}
+
+		TEST_METHOD(AppendRowsGrowsGeometrically)
+		{
+			Grid<int> grid(16, 1, 0);
+			int reallocations = 0;
+
+			for (int row = 1; row < 1024; row++)
+			{
+				size_t capacity = grid.capacity();
+
+				grid.AppendRows(1, row);
+
+				if (grid.capacity() != capacity)
+					reallocations++;
+			}
+
+			Assert::IsTrue(reallocations <= 11, L"Capacity should double on each reallocation");
+
+			for (unsigned short row = 0; row < 1024; row++)
+				Assert::AreEqual(int(row), grid.GetCell(15, row));
+		}
+
+		TEST_METHOD(PaddedAppendColumnsUsesReservedPitch)
+		{
+			Grid<int, PaddedRowMajorLayout<64>> grid(3, 4, 2);
+			grid.reserve(40, 4);
+
+			Assert::AreEqual(size_t(48), grid.GetLayout().GetRowPitch());
+
+			const int* storage = &grid.GetCell(0, 0);
+
+			for (int column = 3; column < 40; column++)
+				grid.AppendColumns(1, column);
+
+			Assert::IsTrue(storage == &grid.GetCell(0, 0), L"Columns inside the reserved pitch must not reallocate");
+			Assert::AreEqual(2, grid.GetCell(2, 3));
+			Assert::AreEqual(39, grid.GetCell(39, 3));
+		}
+
+		TEST_METHOD(RelocationMovesCells)
+		{
+			//Long enough to live on the heap, a move keeps the same buffer
+			Grid<std::string> grid(4, 3, std::string(64, 'x'));
+			const char* text = grid.GetCell(3, 2).data();
+
+			grid.InsertRow(0);
+			Assert::IsTrue(text == grid.GetCell(3, 3).data(), L"Reallocation must move the cells");
+
+			grid.EraseColumn(0);
+			text = grid.GetCell(2, 3).data();
+
+			grid.InsertColumn(0);
+			Assert::IsTrue(text == grid.GetCell(3, 3).data(), L"Shifting in place must move the cells");
+			Assert::AreEqual(std::string(), grid.GetCell(0, 3));
+		}
+
+		TEST_METHOD(ResizeInsideCapacityKeepsStorage)
+		{
+			Grid<int> grid(10, 10, 3);
+			const int* storage = &grid.GetCell(0, 0);
+
+			grid.ResizeGridPreserveData(5, 5);
+			grid.ResizeGridPreserveData(10, 10, 4);
+
+			Assert::IsTrue(storage == &grid.GetCell(0, 0));
+			Assert::AreEqual(3, grid.GetCell(4, 4));
+			Assert::AreEqual(4, grid.GetCell(5, 4));
+			Assert::AreEqual(size_t(100), grid.capacity());
+
+			grid.ResizeGrid(8, 8, 6);
+
+			Assert::IsTrue(storage == &grid.GetCell(0, 0));
+			Assert::AreEqual(6, grid.GetCell(7, 7));
+		}
+
+		TEST_METHOD(EraseAndInsertBounds)
+		{
+			Grid<int> grid(2, 1, 0);
+
+			Assert::ExpectException<std::out_of_range>([&]() { grid.InsertRow(2); });
+			Assert::ExpectException<std::out_of_range>([&]() { grid.EraseColumn(2); });
+
+			grid.EraseColumn(0);
+			grid.EraseColumn(0);
+
+			Assert::IsTrue(grid.isEmpty());
+			Assert::AreEqual(size_t(0), grid.capacity());
+			Assert::ExpectException<std::logic_error>([&]() { grid.AppendRows(1); });
+		}
+	};
+}
@@ -0,0 +1,82 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Grid.h"
+#include "GridAllocators.h"
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridDimensionTesting)
+	{
+	public:
+
+		TEST_METHOD(SizeTypeFollowsDimensionType)
+		{
+			Assert::IsTrue(std::is_same<Grid<int>::size_type, std::uint32_t>::value);
+			Assert::IsTrue(std::is_same<LargeGrid<int>::dimension_type, std::uint32_t>::value);
+			Assert::IsTrue(std::is_same<LargeGrid<int>::size_type, std::uint64_t>::value);
+		}
+
+		TEST_METHOD(DimensionsPastSixteenBits)
+		{
+			LargeGrid<std::uint8_t> grid(100000, 3, std::uint8_t(1));
+
+			grid.GetCell(99999, 2) = 7;
+
+			Assert::AreEqual(std::uint32_t(100000), grid.GetColumnCount());
+			Assert::AreEqual(LargeGrid<std::uint8_t>::size_type(300000), grid.size());
+			Assert::AreEqual(std::size_t(299999), grid.GetOneDimensionIndex(99999, 2));
+			Assert::AreEqual(std::uint8_t(7), grid[99999][2]);
+
+			grid.AppendColumns(2, std::uint8_t(4));
+			Assert::AreEqual(std::uint8_t(7), grid.GetCell(99999, 2));
+			Assert::AreEqual(std::uint8_t(4), grid.GetCell(100001, 2));
+		}
+
+		TEST_METHOD(OversizedGridsThrow)
+		{
+			Grid<char, RowMajorLayout, std::allocator<char>, std::uint64_t> grid;
+
+			auto cellCountOverflow = [&grid] { grid.ResizeGrid(std::uint64_t(1) << 40, std::uint64_t(1) << 40); };
+			Assert::ExpectException<std::length_error>(cellCountOverflow);
+
+			auto beyondAllocator = [&grid] { grid.ResizeGrid(std::uint64_t(1) << 32, std::uint64_t(1) << 31); };
+			Assert::ExpectException<std::length_error>(beyondAllocator);
+
+			Grid<char, PaddedRowMajorLayout<64>, std::allocator<char>, std::uint64_t> padded;
+
+			auto paddingOverflow = [&padded]
+			{
+				padded.ResizeGrid(std::numeric_limits<std::uint64_t>::max(), 1);
+			};
+			Assert::ExpectException<std::length_error>(paddingOverflow);
+
+			Assert::IsTrue(grid.isEmpty());
+		}
+
+		TEST_METHOD(HugePageBackedGrid)
+		{
+			typedef HugePageAllocator<int, std::size_t(1) << 20> Allocator;
+
+			LargeGrid<int, RowMajorLayout, Allocator> large(1024, 512, 3);
+			LargeGrid<int, RowMajorLayout, Allocator> small(16, 16, 4);
+
+			std::uintptr_t address = reinterpret_cast<std::uintptr_t>(&large.GetCell(0, 0));
+
+			Assert::IsTrue(Allocator::UsesHugePages(large.GetStorageSize() * sizeof(int)));
+			Assert::AreEqual(std::uintptr_t(0), address % Allocator::huge_page_size);
+			Assert::AreEqual(3, large.GetCell(1023, 511));
+			Assert::AreEqual(4, small.GetCell(15, 15));
+
+			large.ResizeGridPreserveData(2048, 512, 5);
+			Assert::AreEqual(3, large.GetCell(1023, 511));
+			Assert::AreEqual(5, large.GetCell(2047, 511));
+		}
+	};
+}
@@ -0,0 +1,153 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Grid.h"
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridExecutionTesting)
+	{
+	public:
+		///Dimensions that leave partial bands, tiles and padding everywhere
+		template<typename Grid_Type>
+		static void CheckFillAndForEach(GridThreadPool& pool)
+		{
+			Grid_Type grid(1031, 67, 9);
+
+			grid.Fill(GridExecution::par.On(pool), 3);
+			grid.ForEach(GridExecution::par_unseq.On(pool), [](int& cell) { cell++; });
+			grid.Transform(GridExecution::seq, [](int cell) { return cell * 2; });
+
+			std::atomic<std::size_t> visited(0);
+			const Grid_Type& readOnly = grid;
+
+			readOnly.ForEach(GridExecution::par.On(pool), [&](const int& cell)
+			{
+				Assert::AreEqual(8, cell);
+				visited++;
+			});
+
+			Assert::AreEqual(std::size_t(grid.size()), visited.load());
+
+			for (unsigned row = 0; row < grid.GetRowCount(); row++)
+			{
+				for (unsigned column = 0; column < grid.GetColumnCount(); column++)
+					Assert::AreEqual(8, grid.GetCell(column, row));
+			}
+		}
+
+		TEST_METHOD(BulkOperationsCoverEveryLayout)
+		{
+			GridThreadPool pool(4);
+
+			CheckFillAndForEach<Grid<int>>(pool);
+			CheckFillAndForEach<Grid<int, PaddedRowMajorLayout<64>>>(pool);
+			CheckFillAndForEach<Grid<int, ColumnMajorLayout>>(pool);
+			CheckFillAndForEach<Grid<int, TiledLayout<16>>>(pool);
+			CheckFillAndForEach<Grid<int, MortonLayout<>>>(pool);
+		}
+
+		TEST_METHOD(ReduceIsDeterministic)
+		{
+			Grid<double> grid(1500, 700);
+
+			for (unsigned row = 0; row < grid.GetRowCount(); row++)
+			{
+				for (unsigned column = 0; column < grid.GetColumnCount(); column++)
+					grid.GetCell(column, row) = 1.0 / (1.0 + column * 3 + row * 7);
+			}
+
+			auto add = [](double left, double right) { return left + right; };
+
+			double sequential = grid.Reduce(GridExecution::seq, 0.0, add);
+
+			for (std::size_t threads : { 1, 2, 3, 8 })
+			{
+				GridThreadPool pool(threads);
+
+				Assert::IsTrue(sequential == grid.Reduce(GridExecution::par.On(pool), 0.0, add),
+					L"Parallel sums must match bit for bit");
+			}
+
+			std::int64_t positive = grid.Reduce(GridExecution::par, std::int64_t(0),
+				[](std::int64_t left, std::int64_t right) { return left + right; },
+				[](double cell) { return std::int64_t(cell > 0.01); });
+
+			Assert::IsTrue(positive > 0 && positive < std::int64_t(grid.size()));
+
+			Grid<double> empty;
+			Assert::AreEqual(5.0, empty.Reduce(GridExecution::par, 5.0, add));
+		}
+
+		TEST_METHOD(TransformFromAnotherGrid)
+		{
+			Grid<int, TiledLayout<8>> source(300, 200);
+
+			for (unsigned row = 0; row < source.GetRowCount(); row++)
+			{
+				for (unsigned column = 0; column < source.GetColumnCount(); column++)
+					source.GetCell(column, row) = int(column + row * 1000);
+			}
+
+			Grid<float> target(300, 200);
+			target.Transform(GridExecution::par, source, [](int cell) { return float(cell) * 0.5f; });
+
+			Assert::AreEqual(float(299 + 199 * 1000) * 0.5f, target.GetCell(299, 199));
+			Assert::AreEqual(float(5 + 7 * 1000) * 0.5f, target.GetCell(5, 7));
+
+			Grid<float> wrongSize(300, 201);
+			Assert::ExpectException<std::invalid_argument>([&]()
+			{
+				wrongSize.Transform(GridExecution::par, source, [](int cell) { return float(cell); });
+			});
+		}
+
+		TEST_METHOD(ForEachRowVisitsEveryRowOnce)
+		{
+			Grid<std::uint8_t> grid(60000, 50, 0);
+			std::vector<std::atomic<int>> visits(grid.GetRowCount());
+
+			grid.ForEachRow(GridExecution::par, [&](Grid<std::uint8_t>::dimension_type row)
+			{
+				visits[row]++;
+				grid.GetCell(0, row) = 1;
+			});
+
+			for (std::atomic<int>& count : visits)
+				Assert::AreEqual(1, count.load());
+
+			Assert::AreEqual(std::size_t(50), std::size_t(grid.Reduce(GridExecution::seq, 0,
+				[](int left, int right) { return left + right; })));
+		}
+
+		TEST_METHOD(PoolRethrowsAndKeepsWorking)
+		{
+			GridThreadPool pool(4);
+			Assert::AreEqual(std::size_t(4), pool.GetThreadCount());
+
+			Assert::ExpectException<std::runtime_error>([&]()
+			{
+				pool.ParallelFor(100, [](std::size_t index)
+				{
+					if (index == 37)
+						throw std::runtime_error("band failed");
+				});
+			});
+
+			//Nested jobs run on the thread that starts them
+			std::atomic<int> calls(0);
+			pool.ParallelFor(10, [&](std::size_t)
+			{
+				pool.ParallelFor(10, [&](std::size_t) { calls++; });
+			});
+
+			Assert::AreEqual(100, calls.load());
+		}
+	};
+}
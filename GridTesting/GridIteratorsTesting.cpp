@@ -0,0 +1,163 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Grid.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridIteratorsTesting)
+	{
+	public:
+		typedef Grid<int, RowMajorLayout, std::allocator<int>, std::uint16_t, GridCheckedAccess> CheckedGrid;
+		typedef Grid<int, PaddedRowMajorLayout<64>, std::allocator<int>, std::uint16_t, GridCheckedAccess> CheckedPaddedGrid;
+
+		static_assert(sizeof(UncheckedGrid<int>::iterator) == sizeof(int*) &&
+			std::is_trivially_copyable<UncheckedGrid<int>::iterator>::value,
+			"Unchecked iterators carry no bounds");
+		static_assert(std::is_same<std::iterator_traits<CheckedGrid::iterator>::iterator_category,
+			std::random_access_iterator_tag>::value, "Grid iterators are random access");
+		static_assert(std::is_convertible<CheckedGrid::iterator, CheckedGrid::const_iterator>::value &&
+			std::is_convertible<CheckedPaddedGrid::iterator, CheckedPaddedGrid::const_iterator>::value,
+			"An iterator converts to a const_iterator");
+#if defined(__cpp_lib_concepts)
+		static_assert(std::contiguous_iterator<CheckedGrid::iterator> &&
+			std::contiguous_iterator<UncheckedGrid<int>::const_iterator> &&
+			std::random_access_iterator<CheckedPaddedGrid::const_iterator>, "C++20 iterator concepts");
+#endif
+
+		TEST_METHOD(IteratorsWorkWithStandardAlgorithms)
+		{
+			CheckedGrid grid(5, 4);
+			CheckedPaddedGrid padded(5, 4);
+
+			for (size_t i = 0; i < grid.size(); i++)
+			{
+				grid.GetCell(i) = int((i * 7) % 20);
+				padded.GetCell(dimension(i % 5), dimension(i / 5)) = int((i * 7) % 20);
+			}
+
+			std::sort(grid.begin(), grid.end());
+			std::sort(padded.begin(), padded.end());
+
+			std::vector<int> expected(20);
+			std::iota(expected.begin(), expected.end(), 0);
+			Assert::IsTrue(std::equal(expected.begin(), expected.end(), grid.cbegin(), grid.cend()));
+			Assert::IsTrue(std::equal(expected.begin(), expected.end(), padded.cbegin(), padded.cend()));
+
+			Assert::AreEqual(std::ptrdiff_t(13), std::lower_bound(padded.cbegin(), padded.cend(), 13) - padded.cbegin());
+			Assert::AreEqual(std::ptrdiff_t(20), padded.end() - padded.begin());
+			Assert::AreEqual(11, padded.begin()[11]);
+			Assert::AreEqual(6, *(2 + (padded.end() - 16)));
+			Assert::AreEqual(4, *(padded.end() - 16));
+
+			//Postfix returns the position before the step
+			CheckedGrid::iterator it = grid.begin();
+			Assert::AreEqual(0, *it++);
+			Assert::AreEqual(1, *it);
+			CheckedPaddedGrid::iterator paddedIt = padded.begin() + 5;
+			Assert::AreEqual(5, *paddedIt--);
+			Assert::AreEqual(4, *paddedIt);
+
+			CheckedGrid::const_iterator constIt = it;
+			Assert::IsTrue(constIt == grid.cbegin() + 1 && grid.cbegin() < constIt);
+
+			std::fill(padded.begin(), padded.end(), 3);
+			std::copy(padded.cbegin(), padded.cend(), grid.begin());
+			Assert::AreEqual(60, std::accumulate(grid.cbegin(), grid.cend(), 0));
+
+			UncheckedGrid<int> unchecked(5, 4);
+			std::copy(grid.cbegin(), grid.cend(), unchecked.begin());
+			Assert::IsTrue(unchecked.data() == &*unchecked.begin());
+			Assert::AreEqual(60, std::accumulate(unchecked.data(), unchecked.data() + unchecked.size(), 0));
+		}
+
+#if defined(__cpp_lib_ranges)
+		TEST_METHOD(GridsAreContiguousRanges)
+		{
+			static_assert(std::ranges::contiguous_range<UncheckedGrid<int>> &&
+				std::ranges::random_access_range<const CheckedPaddedGrid> &&
+				std::ranges::borrowed_range<decltype(std::declval<CheckedGrid&>().GetRow(0))>, "C++20 range concepts");
+
+			UncheckedGrid<int> grid(6, 3);
+			std::iota(grid.begin(), grid.end(), 0);
+			std::ranges::reverse(grid);
+			Assert::AreEqual(17, *grid.begin());
+			Assert::AreEqual(0, *--grid.end());
+
+			CheckedPaddedGrid padded(6, 3);
+			std::ranges::copy(grid, padded.begin());
+			std::ranges::sort(padded);
+			Assert::AreEqual(0, *padded.begin());
+			Assert::IsTrue(std::to_address(grid.begin()) == grid.data());
+		}
+#endif
+
+		TEST_METHOD(RowColumnAndTileRanges)
+		{
+			CheckedPaddedGrid padded(5, 4);
+			Grid<int, ColumnMajorLayout> columnMajor(5, 4);
+
+			for (dimension row = 0; row < 4; row++)
+			{
+				for (dimension column = 0; column < 5; column++)
+				{
+					padded.GetCell(column, row) = row * 10 + column;
+					columnMajor.GetCell(column, row) = row * 10 + column;
+				}
+			}
+
+			auto row = padded.GetRow(2);
+			static_assert(std::is_same<decltype(row.begin()), int*>::value, "Contiguous rows are pointer ranges");
+			Assert::AreEqual(size_t(5), row.size());
+			Assert::AreEqual(24, row[4]);
+
+			auto column = padded.GetColumn(3);
+			Assert::AreEqual(size_t(4), column.size());
+			Assert::AreEqual(33, column[3]);
+
+			const auto& constMajor = columnMajor;
+			std::vector<int> rowCells(constMajor.GetRow(1).begin(), constMajor.GetRow(1).end());
+			Assert::IsTrue(rowCells == std::vector<int>({ 10, 11, 12, 13, 14 }));
+			std::fill(columnMajor.GetColumn(4).begin(), columnMajor.GetColumn(4).end(), -1);
+			Assert::AreEqual(-1, columnMajor.GetCell(4, 3));
+			Assert::AreEqual(32, columnMajor.GetCell(2, 3));
+
+			Assert::ExpectException<std::out_of_range>([&]() { padded.GetRow(4); });
+			Assert::ExpectException<std::out_of_range>([&]() { padded.GetColumn(5); });
+
+			Grid<int, TiledLayout<4>, std::allocator<int>, std::uint16_t, GridCheckedAccess> tiled(6, 5);
+
+			for (dimension r = 0; r < 5; r++)
+			{
+				for (dimension c = 0; c < 6; c++)
+					tiled.GetCell(c, r) = r * 10 + c;
+			}
+
+			Assert::AreEqual(size_t(2), tiled.GetTileColumnCount());
+			Assert::AreEqual(size_t(2), tiled.GetTileRowCount());
+			Assert::AreEqual(size_t(16), tiled.GetTile(0, 0).size());
+			Assert::AreEqual(size_t(2), tiled.GetTile(1, 1).size());
+
+			auto corner = tiled.GetTile(1, 1);
+			Assert::IsTrue(std::vector<int>(corner.begin(), corner.end()) == std::vector<int>({ 44, 45 }));
+
+			std::fill(tiled.GetTile(1, 0).begin(), tiled.GetTile(1, 0).end(), 0);
+			Assert::AreEqual(0, tiled.GetCell(5, 3));
+			Assert::AreEqual(33, tiled.GetCell(3, 3));
+			Assert::AreEqual(40, tiled.GetCell(0, 4));
+			Assert::ExpectException<std::out_of_range>([&]() { tiled.GetTile(2, 0); });
+		}
+
+	private:
+		typedef std::uint16_t dimension;
+	};
+}
@@ -0,0 +1,169 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Grid.h"
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	///Fills every cell with a value unique to its coordinates
+	template<typename Grid_Type>
+	void FillWithCoordinates(Grid_Type& grid)
+	{
+		for (typename Grid_Type::dimension_type row = 0; row < grid.GetRowCount(); row++)
+		{
+			for (typename Grid_Type::dimension_type column = 0; column < grid.GetColumnCount(); column++)
+			{
+				grid.GetCell(column, row) = column + row * 1000;
+			}
+		}
+	}
+
+	///Every cell must land on its own storage slot, and every slot must be used
+	template<typename Layout_Type>
+	void AssertLayoutIsPermutation(std::size_t columnCount, std::size_t rowCount)
+	{
+		Layout_Type layout;
+		layout.SetDimensions(columnCount, rowCount, sizeof(int));
+
+		Assert::AreEqual(columnCount * rowCount, layout.GetStorageSize());
+
+		std::vector<bool> used(layout.GetStorageSize(), false);
+
+		for (std::size_t row = 0; row < rowCount; row++)
+		{
+			for (std::size_t column = 0; column < columnCount; column++)
+			{
+				std::size_t index = layout.GetOneDimensionIndex(column, row);
+
+				Assert::IsTrue(index < used.size());
+				Assert::IsFalse(used[index]);
+
+				used[index] = true;
+			}
+		}
+
+		std::size_t expectedIndex = 0;
+
+		layout.ForEachCell([&](std::size_t column, std::size_t row, std::size_t index)
+		{
+			Assert::AreEqual(expectedIndex++, index);
+			Assert::AreEqual(layout.GetOneDimensionIndex(column, row), index);
+		});
+
+		Assert::AreEqual(columnCount * rowCount, expectedIndex);
+	}
+
+	template<typename Layout_Type>
+	void AssertResizeKeepsData()
+	{
+		Grid<int, Layout_Type> testGrid(37, 21, 0);
+		FillWithCoordinates(testGrid);
+
+		testGrid.ResizeGridPreserveData(45, 17, -1);
+
+		for (Grid<int>::dimension_type row = 0; row < testGrid.GetRowCount(); row++)
+		{
+			for (Grid<int>::dimension_type column = 0; column < testGrid.GetColumnCount(); column++)
+			{
+				int expected = column < 37 ? column + row * 1000 : -1;
+
+				Assert::AreEqual(expected, testGrid.GetCell(column, row));
+				Assert::AreEqual(expected, testGrid[column][row]);
+			}
+		}
+	}
+
+	TEST_CLASS(GridLayoutTesting)
+	{
+	public:
+
+		TEST_METHOD(LayoutsArePermutations)
+		{
+			AssertLayoutIsPermutation<RowMajorLayout>(13, 7);
+			AssertLayoutIsPermutation<ColumnMajorLayout>(13, 7);
+			AssertLayoutIsPermutation<TiledLayout<8>>(8, 8);
+			AssertLayoutIsPermutation<TiledLayout<8>>(29, 19);
+			AssertLayoutIsPermutation<TiledLayout<32>>(5, 70);
+			AssertLayoutIsPermutation<MortonLayout<16>>(64, 32);
+			AssertLayoutIsPermutation<MortonLayout<16>>(53, 41);
+			AssertLayoutIsPermutation<MortonLayout<4>>(3, 3);
+		}
+
+		TEST_METHOD(MortonBlocksAreZOrdered)
+		{
+			MortonLayout<4> layout;
+			layout.SetDimensions(8, 8, sizeof(int));
+
+			Assert::AreEqual(std::size_t(0), layout.GetOneDimensionIndex(0, 0));
+			Assert::AreEqual(std::size_t(1), layout.GetOneDimensionIndex(1, 0));
+			Assert::AreEqual(std::size_t(2), layout.GetOneDimensionIndex(0, 1));
+			Assert::AreEqual(std::size_t(3), layout.GetOneDimensionIndex(1, 1));
+			Assert::AreEqual(std::size_t(4), layout.GetOneDimensionIndex(2, 0));
+			Assert::AreEqual(std::size_t(15), layout.GetOneDimensionIndex(3, 3));
+			Assert::AreEqual(std::size_t(16), layout.GetOneDimensionIndex(4, 0));
+		}
+
+		TEST_METHOD(AccessorsAgreeAcrossLayouts)
+		{
+			Grid<int, TiledLayout<8>> tiled(19, 11, 0);
+			Grid<int, MortonLayout<8>> morton(19, 11, 0);
+			Grid<int, ColumnMajorLayout> columnMajor(19, 11, 0);
+
+			FillWithCoordinates(tiled);
+			FillWithCoordinates(morton);
+			FillWithCoordinates(columnMajor);
+
+			for (Grid<int>::dimension_type row = 0; row < 11; row++)
+			{
+				for (Grid<int>::dimension_type column = 0; column < 19; column++)
+				{
+					Assert::AreEqual(column + row * 1000, tiled[column][row]);
+					Assert::AreEqual(column + row * 1000, morton[column][row]);
+					Assert::AreEqual(column + row * 1000, columnMajor[column][row]);
+				}
+			}
+
+			//Iterators walk storage order, but still visit every cell once
+			long long expectedSum = 0;
+			long long iteratedSum = 0;
+
+			for (int value : std::vector<int>(tiled.begin(), tiled.end()))
+				iteratedSum += value;
+
+			for (Grid<int>::dimension_type row = 0; row < 11; row++)
+				for (Grid<int>::dimension_type column = 0; column < 19; column++)
+					expectedSum += column + row * 1000;
+
+			Assert::AreEqual(expectedSum, iteratedSum);
+		}
+
+		TEST_METHOD(ResizeGridPreserveDataKeepsCoordinates)
+		{
+			AssertResizeKeepsData<RowMajorLayout>();
+			AssertResizeKeepsData<ColumnMajorLayout>();
+			AssertResizeKeepsData<TiledLayout<8>>();
+			AssertResizeKeepsData<MortonLayout<8>>();
+		}
+
+		TEST_METHOD(CopyKeepsLayout)
+		{
+			Grid<int, MortonLayout<4>> original(10, 9, 0);
+			FillWithCoordinates(original);
+
+			Grid<int, MortonLayout<4>> copy(original);
+			Grid<int, MortonLayout<4>> moved(std::move(original));
+
+			for (Grid<int>::dimension_type row = 0; row < 9; row++)
+			{
+				for (Grid<int>::dimension_type column = 0; column < 10; column++)
+				{
+					Assert::AreEqual(column + row * 1000, copy.GetCell(column, row));
+					Assert::AreEqual(column + row * 1000, moved.GetCell(column, row));
+				}
+			}
+		}
+	};
+}
@@ -0,0 +1,173 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "GridOccupancyPyramid.h"
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridOccupancyPyramidTesting)
+	{
+	public:
+		struct IsResource
+		{
+			bool operator()(int cell) const
+			{
+				return cell > 0;
+			}
+		};
+
+		typedef GridOccupancyPyramid<Grid<int>, IsResource> ResourcePyramid;
+
+		static Grid<int> MakeScattered(Grid<int>::dimension_type columns, Grid<int>::dimension_type rows,
+			unsigned percent, unsigned seed)
+		{
+			std::mt19937 random(seed);
+			Grid<int> grid(columns, rows, 0);
+
+			for (int& cell : grid)
+				cell = random() % 100 < percent ? 1 + int(random() % 9) : -int(random() % 3);
+
+			return grid;
+		}
+
+		///Every match ordered by distance, then row, then column
+		static std::vector<GridOccupancyHit> NaiveNearest(const ResourcePyramid& pyramid,
+			std::uint32_t column, std::uint32_t row, std::uint64_t maxDistanceSquared)
+		{
+			std::vector<GridOccupancyHit> hits;
+
+			for (std::uint32_t cellRow = 0; cellRow < pyramid.GetRowCount(); cellRow++)
+			{
+				for (std::uint32_t cellColumn = 0; cellColumn < pyramid.GetColumnCount(); cellColumn++)
+				{
+					std::int64_t columnDistance = std::int64_t(cellColumn) - column;
+					std::int64_t rowDistance = std::int64_t(cellRow) - row;
+					std::uint64_t distanceSquared = std::uint64_t(columnDistance * columnDistance + rowDistance * rowDistance);
+
+					if (pyramid.GetCell(cellColumn, cellRow) > 0 && distanceSquared <= maxDistanceSquared)
+						hits.push_back(GridOccupancyHit{ cellColumn, cellRow, distanceSquared });
+				}
+			}
+
+			std::stable_sort(hits.begin(), hits.end(), [](const GridOccupancyHit& left, const GridOccupancyHit& right)
+			{
+				return left.distanceSquared < right.distanceSquared;
+			});
+
+			return hits;
+		}
+
+		static void AssertQueriesMatchLoops(const ResourcePyramid& pyramid, unsigned seed)
+		{
+			std::mt19937 random(seed);
+			std::uint32_t columns = pyramid.GetColumnCount();
+			std::uint32_t rows = pyramid.GetRowCount();
+
+			for (int query = 0; query < 40; query++)
+			{
+				std::uint32_t firstColumn = random() % columns, lastColumn = random() % columns;
+				std::uint32_t firstRow = random() % rows, lastRow = random() % rows;
+
+				if (firstColumn > lastColumn)
+					std::swap(firstColumn, lastColumn);
+
+				if (firstRow > lastRow)
+					std::swap(firstRow, lastRow);
+
+				std::uint32_t expected = 0;
+
+				for (std::uint32_t row = firstRow; row <= lastRow; row++)
+				{
+					for (std::uint32_t column = firstColumn; column <= lastColumn; column++)
+						expected += pyramid.GetCell(column, row) > 0;
+				}
+
+				Assert::AreEqual(expected, pyramid.Count(firstColumn, firstRow, lastColumn, lastRow));
+				Assert::AreEqual(expected > 0, pyramid.Any(firstColumn, firstRow, lastColumn, lastRow));
+
+				std::uint32_t column = random() % columns, row = random() % rows;
+				std::uint32_t radius = query % 2 ? 9 : ResourcePyramid::unlimited_distance;
+				std::vector<GridOccupancyHit> expectedHits = NaiveNearest(pyramid, column, row,
+					query % 2 ? 81 : UINT64_MAX);
+				std::vector<GridOccupancyHit> hits = pyramid.FindKNearest(column, row, 5, radius);
+
+				Assert::AreEqual(std::min<std::size_t>(5, expectedHits.size()), hits.size());
+
+				for (std::size_t hit = 0; hit < hits.size(); hit++)
+					Assert::IsTrue(hits[hit] == expectedHits[hit]);
+
+				std::optional<GridOccupancyHit> nearest = pyramid.FindNearest(column, row, radius);
+				Assert::AreEqual(!expectedHits.empty(), nearest.has_value());
+
+				if (nearest)
+					Assert::IsTrue(*nearest == expectedHits.front());
+			}
+		}
+
+		TEST_METHOD(QueriesMatchLoopsAtEveryDensity)
+		{
+			for (unsigned percent : { 0u, 1u, 20u, 100u })
+			{
+				ResourcePyramid pyramid(MakeScattered(131, 77, percent, percent));
+
+				Assert::AreEqual(std::size_t(6), pyramid.GetLevelCount());
+				AssertQueriesMatchLoops(pyramid, percent + 100);
+			}
+
+			//Smaller than one block, and a single row
+			AssertQueriesMatchLoops(ResourcePyramid(MakeScattered(5, 3, 30, 1)), 2);
+			AssertQueriesMatchLoops(ResourcePyramid(GridExecution::par, MakeScattered(300, 1, 5, 3)), 4);
+		}
+
+		TEST_METHOD(WritesKeepThePyramidCurrent)
+		{
+			std::mt19937 random(5);
+			ResourcePyramid pyramid(MakeScattered(90, 70, 3, 6));
+
+			for (int write = 0; write < 2000; write++)
+			{
+				Grid<int>::dimension_type column = random() % 90, row = random() % 70;
+
+				if (write % 2)
+					pyramid.SetCell(column, row, int(random() % 3) - 1);
+				else
+					pyramid.Modify(column, row, [](int& cell) { cell = -cell; });
+			}
+
+			ResourcePyramid rebuilt(pyramid.GetGrid());
+
+			for (std::size_t level = 0; level < pyramid.GetLevelCount(); level++)
+			{
+				std::uint32_t side = 8u << level;
+
+				for (std::uint32_t row = 0; row * side < 70; row++)
+				{
+					for (std::uint32_t column = 0; column * side < 90; column++)
+						Assert::AreEqual(rebuilt.GetBlockCount(level, column, row), pyramid.GetBlockCount(level, column, row));
+				}
+			}
+
+			AssertQueriesMatchLoops(pyramid, 7);
+
+			pyramid.Fill(GridExecution::par, 0);
+			Assert::AreEqual(std::uint32_t(0), pyramid.Count());
+			Assert::IsFalse(pyramid.FindNearest(4, 4).has_value());
+
+			pyramid.SetCell(89, 69, 2);
+			Assert::IsTrue(pyramid.IsOccupied(89, 69));
+			Assert::IsTrue(*pyramid.FindNearest(0, 0) == GridOccupancyHit{ 89, 69, 89 * 89 + 69 * 69 });
+			Assert::IsFalse(pyramid.FindNearest(0, 0, 100).has_value());
+
+			Assert::ExpectException<std::out_of_range>([&]() { pyramid.SetCell(90, 0, 1); });
+			Assert::ExpectException<std::out_of_range>([&]() { pyramid.Any(0, 0, 90, 1); });
+			Assert::ExpectException<std::invalid_argument>([&]() { pyramid.Count(5, 0, 4, 1); });
+			Assert::ExpectException<std::out_of_range>([&]() { pyramid.FindNearest(0, 70); });
+		}
+	};
+}
@@ -0,0 +1,196 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "GridPathfinder.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridPathfinderTesting)
+	{
+	public:
+		///0 is a wall, anything else costs its value
+		static float CellCost(std::uint8_t cell)
+		{
+			return cell == 0 ? GridPathBlocked : float(cell);
+		}
+
+		typedef GridPathfinder<Grid<std::uint8_t>, float(*)(std::uint8_t)> CostPathfinder;
+
+		///Steps are adjacent, enter no wall, cut no corner, and add up to the cost
+		static void AssertValidPath(const Grid<std::uint8_t>& grid, const GridPath& path)
+		{
+			float cost = 0.0f;
+
+			for (std::size_t point = 1; point < path.points.size(); point++)
+			{
+				const GridPathPoint& from = path.points[point - 1];
+				const GridPathPoint& to = path.points[point];
+
+				int columnStep = int(to.column) - int(from.column);
+				int rowStep = int(to.row) - int(from.row);
+
+				Assert::IsTrue(std::abs(columnStep) <= 1 && std::abs(rowStep) <= 1 && (columnStep || rowStep));
+				Assert::AreNotEqual(0, int(grid.GetCell(to.column, to.row)));
+
+				if (columnStep && rowStep)
+				{
+					Assert::AreNotEqual(0, int(grid.GetCell(to.column, from.row)), L"Cut a corner");
+					Assert::AreNotEqual(0, int(grid.GetCell(from.column, to.row)), L"Cut a corner");
+					cost += CellCost(grid.GetCell(to.column, to.row)) * CostPathfinder::diagonal_cost;
+				}
+				else
+				{
+					cost += CellCost(grid.GetCell(to.column, to.row));
+				}
+			}
+
+			Assert::AreEqual(double(cost), double(path.cost), 1e-3);
+		}
+
+		TEST_METHOD(OpenGridPaths)
+		{
+			Grid<std::uint8_t> grid(10, 10, 1);
+			CostPathfinder pathfinder(grid, &CellCost);
+
+			for (GridPathAlgorithm algorithm : { GridPathAlgorithm::AStar, GridPathAlgorithm::JumpPointSearch })
+			{
+				GridPath path;
+
+				Assert::IsTrue(pathfinder.FindPath(GridPathQuery{ { 0, 0 }, { 9, 9 } }, path, algorithm));
+				Assert::AreEqual(std::size_t(10), path.points.size());
+				Assert::AreEqual(9.0 * CostPathfinder::diagonal_cost, double(path.cost), 1e-4);
+
+				Assert::IsTrue(pathfinder.FindPath(GridPathQuery{ { 2, 3 }, { 9, 3 } }, path, algorithm));
+				Assert::AreEqual(std::size_t(8), path.points.size());
+				Assert::IsTrue(path.points.front() == GridPathPoint{ 2, 3 } && path.points.back() == GridPathPoint{ 9, 3 });
+
+				Assert::IsTrue(pathfinder.FindPath(GridPathQuery{ { 4, 4 }, { 4, 4 } }, path, algorithm));
+				Assert::AreEqual(std::size_t(1), path.points.size());
+			}
+
+			Assert::ExpectException<std::out_of_range>([&]()
+			{
+				GridPath path;
+				pathfinder.FindPath(GridPathQuery{ { 0, 0 }, { 10, 0 } }, path);
+			});
+		}
+
+		TEST_METHOD(WallsAndCorners)
+		{
+			Grid<std::uint8_t> grid(5, 5, 1);
+			grid.GetCell(1, 0) = 0;
+			grid.GetCell(0, 1) = 0;
+
+			CostPathfinder pathfinder(grid, &CellCost);
+			GridPath path;
+
+			//Boxed in: the only way out is diagonal between two walls
+			Assert::IsFalse(pathfinder.FindPath(GridPathQuery{ { 0, 0 }, { 4, 4 } }, path));
+			Assert::IsFalse(path.IsFound());
+			Assert::IsFalse(pathfinder.FindPath(GridPathQuery{ { 0, 0 }, { 4, 4 } }, path, GridPathAlgorithm::JumpPointSearch));
+
+			Assert::IsFalse(pathfinder.FindPath(GridPathQuery{ { 2, 2 }, { 1, 0 } }, path), L"Goal inside a wall");
+		}
+
+		TEST_METHOD(AStarAvoidsExpensiveCells)
+		{
+			//A swamp across the middle costing 20 per cell with a cheap gap at the bottom
+			Grid<std::uint8_t> grid(20, 10, 1);
+
+			for (unsigned row = 0; row < 9; row++)
+				grid.GetCell(10, row) = 20;
+
+			CostPathfinder pathfinder(grid, &CellCost);
+			GridPath path;
+
+			Assert::IsTrue(pathfinder.FindPath(GridPathQuery{ { 0, 0 }, { 19, 0 } }, path));
+			AssertValidPath(grid, path);
+
+			for (const GridPathPoint& point : path.points)
+				Assert::AreNotEqual(20, int(grid.GetCell(point.column, point.row)));
+		}
+
+		TEST_METHOD(JumpPointSearchMatchesAStar)
+		{
+			std::mt19937 random(21);
+			Grid<std::uint8_t> grid(80, 60, 1);
+
+			for (std::uint8_t& cell : grid)
+				cell = random() % 4 == 0 ? 0 : 1;
+
+			CostPathfinder pathfinder(grid, &CellCost);
+			GridPath aStar;
+			GridPath jumpPoints;
+			std::size_t aStarExpanded = 0;
+			std::size_t jumpPointExpanded = 0;
+
+			for (int query = 0; query < 200; query++)
+			{
+				GridPathQuery request{ { std::uint32_t(random() % 80), std::uint32_t(random() % 60) },
+					{ std::uint32_t(random() % 80), std::uint32_t(random() % 60) } };
+
+				bool found = pathfinder.FindPath(request, aStar);
+				Assert::AreEqual(found, pathfinder.FindPath(request, jumpPoints, GridPathAlgorithm::JumpPointSearch));
+
+				if (!found)
+					continue;
+
+				AssertValidPath(grid, aStar);
+				AssertValidPath(grid, jumpPoints);
+				Assert::AreEqual(double(aStar.cost), double(jumpPoints.cost), 1e-3);
+
+				aStarExpanded += aStar.expandedNodes;
+				jumpPointExpanded += jumpPoints.expandedNodes;
+			}
+
+			Assert::IsTrue(jumpPointExpanded < aStarExpanded);
+		}
+
+		TEST_METHOD(BatchesReuseScratch)
+		{
+			std::mt19937 random(4);
+			Grid<std::uint8_t> grid(64, 64, 1);
+
+			for (std::uint8_t& cell : grid)
+				cell = random() % 5 == 0 ? 0 : std::uint8_t(1 + random() % 3);
+
+			std::vector<GridPathQuery> queries;
+			for (int query = 0; query < 100; query++)
+			{
+				queries.push_back(GridPathQuery{ { std::uint32_t(random() % 64), std::uint32_t(random() % 64) },
+					{ std::uint32_t(random() % 64), std::uint32_t(random() % 64) } });
+			}
+
+			CostPathfinder pathfinder(grid, &CellCost);
+
+			//The first search sizes this thread's scratch to the grid, later ones only
+			//move the generation on
+			std::vector<GridPath> sequential;
+			pathfinder.FindPaths(GridExecution::seq, queries, sequential);
+
+			std::uint32_t generation = GridPathScratch::ForThisThread().GetGeneration();
+			pathfinder.FindPaths(GridExecution::seq, queries, sequential);
+
+			std::uint32_t searches = GridPathScratch::ForThisThread().GetGeneration() - generation;
+			Assert::IsTrue(searches > 0 && searches <= 100, L"One generation per searched query");
+
+			GridThreadPool pool(4);
+			std::vector<GridPath> parallel;
+			pathfinder.FindPaths(GridExecution::par.On(pool), queries, parallel);
+
+			for (std::size_t query = 0; query < queries.size(); query++)
+			{
+				Assert::AreEqual(sequential[query].IsFound(), parallel[query].IsFound());
+				Assert::AreEqual(double(sequential[query].cost), double(parallel[query].cost), 1e-4);
+			}
+		}
+	};
+}
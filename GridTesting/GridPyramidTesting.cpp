@@ -0,0 +1,145 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "GridPyramid.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridPyramidTesting)
+	{
+	public:
+		///Level 0 worked out from the base one block at a time
+		template<typename Pyramid_Type, typename Base_Grid>
+		static void AssertFirstLevel(const Pyramid_Type& pyramid, const Base_Grid& base)
+		{
+			typedef typename Base_Grid::dimension_type base_dimension;
+			typename Pyramid_Type::reduction_type reduction;
+			const typename Pyramid_Type::level_type& level = pyramid.GetLevel(0);
+
+			Assert::AreEqual(std::uint32_t((base.GetColumnCount() + 1) / 2), level.GetColumnCount());
+			Assert::AreEqual(std::uint32_t((base.GetRowCount() + 1) / 2), level.GetRowCount());
+
+			for (std::uint32_t row = 0; row < level.GetRowCount(); row++)
+			{
+				for (std::uint32_t column = 0; column < level.GetColumnCount(); column++)
+				{
+					base_dimension left = base_dimension(2 * column), top = base_dimension(2 * row);
+					bool wide = left + 1 < base.GetColumnCount(), tall = top + 1 < base.GetRowCount();
+					typename Pyramid_Type::value_type expected = base.GetCell(left, top);
+
+					if (wide && tall)
+						expected = reduction(base.GetCell(left, top), base.GetCell(left + 1, top),
+							base.GetCell(left, top + 1), base.GetCell(left + 1, top + 1));
+					else if (wide)
+						expected = reduction(base.GetCell(left, top), base.GetCell(left + 1, top));
+					else if (tall)
+						expected = reduction(base.GetCell(left, top), base.GetCell(left, top + 1));
+
+					Assert::IsTrue(expected == level.GetCell(column, row));
+				}
+			}
+		}
+
+		template<typename Pyramid_Type>
+		static void AssertSameLevels(const Pyramid_Type& expected, const Pyramid_Type& actual)
+		{
+			Assert::AreEqual(expected.GetLevelCount(), actual.GetLevelCount());
+
+			for (std::size_t level = 0; level < expected.GetLevelCount(); level++)
+			{
+				Assert::IsTrue(std::equal(expected.GetLevel(level).begin(), expected.GetLevel(level).end(),
+					actual.GetLevel(level).begin(), actual.GetLevel(level).end()));
+			}
+		}
+
+		TEST_METHOD(ReductionsMatchBlockByBlock)
+		{
+			std::mt19937 random(4);
+			Grid<float> heights(67, 41);
+			Grid<int, TiledLayout<8>> costs(30, 17);
+
+			for (float& cell : heights)
+				cell = float(random() % 10000) / 64.0f - 50.0f;
+
+			for (int& cell : costs)
+				cell = int(random() % 5) - 2;
+
+			AssertFirstLevel(GridPyramid<float>(heights), heights);
+			AssertFirstLevel(GridPyramid<float, GridReduceMin>(heights), heights);
+			AssertFirstLevel(GridPyramid<float, GridReduceMax>(heights), heights);
+			AssertFirstLevel(GridPyramid<int>(costs), costs);
+			AssertFirstLevel(GridPyramid<int, GridReduceMode>(costs), costs);
+
+			GridPyramid<float, GridReduceMax> maxima(GridExecution::par, heights);
+			Assert::AreEqual(std::size_t(7), maxima.GetLevelCount());
+			Assert::AreEqual(*std::max_element(heights.begin(), heights.end()), maxima.GetTop());
+
+			//Each level is the one below reduced again
+			for (std::size_t level = 1; level < maxima.GetLevelCount(); level++)
+				AssertFirstLevel(GridPyramid<float, GridReduceMax>(maxima.GetLevel(level - 1)), maxima.GetLevel(level - 1));
+
+			AssertSameLevels(GridPyramid<float, GridReduceMax>(heights), maxima);
+
+			Assert::AreEqual(std::size_t(0), GridPyramid<int>(Grid<int>(1, 1, 3)).GetLevelCount());
+			Assert::AreEqual(std::size_t(3), GridPyramid<int>(Grid<int>(1, 5, 3)).GetLevelCount());
+			Assert::AreEqual(std::size_t(0), GridPyramid<int>(Grid<int>()).GetLevelCount());
+
+			GridReduceMode mode;
+			Assert::AreEqual(2, mode(3, 2, 3, 2));
+			Assert::AreEqual(7, mode(7, 1, 7, 2));
+			Assert::AreEqual(-1, GridReduceMean()(-1, -2));
+		}
+
+		TEST_METHOD(RefreshMatchesRebuild)
+		{
+			std::mt19937 random(9);
+			Grid<float> heights(53, 70, 1.0f);
+			GridPyramid<float> means(heights);
+			GridPyramid<int, GridReduceMode> modes;
+
+			Grid<int> terrain(53, 70, 0);
+			modes.Build(GridExecution::seq, terrain);
+
+			for (int change = 0; change < 50; change++)
+			{
+				std::uint32_t firstColumn = random() % 53, lastColumn = random() % 53;
+				std::uint32_t firstRow = random() % 70, lastRow = random() % 70;
+
+				if (firstColumn > lastColumn)
+					std::swap(firstColumn, lastColumn);
+
+				if (firstRow > lastRow)
+					std::swap(firstRow, lastRow);
+
+				if (change % 3 == 0)
+					lastRow = firstRow, lastColumn = firstColumn;
+
+				for (std::uint32_t row = firstRow; row <= lastRow; row++)
+				{
+					for (std::uint32_t column = firstColumn; column <= lastColumn; column++)
+					{
+						heights.GetCell(column, row) = float(random() % 1000) * 0.5f;
+						terrain.GetCell(column, row) = int(random() % 4);
+					}
+				}
+
+				means.Refresh(heights, firstColumn, firstRow, lastColumn, lastRow);
+				modes.Refresh(terrain, firstColumn, firstRow, lastColumn, lastRow);
+			}
+
+			AssertSameLevels(GridPyramid<float>(heights), means);
+			AssertSameLevels(GridPyramid<int, GridReduceMode>(terrain), modes);
+
+			Assert::ExpectException<std::out_of_range>([&]() { means.Refresh(heights, 0, 0, 53, 0); });
+			Assert::ExpectException<std::invalid_argument>([&]() { means.Refresh(heights, 2, 0, 1, 0); });
+			Assert::ExpectException<std::invalid_argument>([&]() { means.Refresh(Grid<float>(5, 5), 0, 0, 1, 1); });
+			Assert::ExpectException<std::out_of_range>([&]() { means.GetLevel(means.GetLevelCount()); });
+		}
+	};
+}
@@ -0,0 +1,271 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "GridSerializer.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	///Flips every byte, stands in for a codec the serializer does not know
+	class InvertingCodec : public GridCodec
+	{
+	public:
+		std::uint32_t GetId() const override
+		{
+			return 42;
+		}
+
+		void Compress(const unsigned char* input, std::size_t inputSize,
+			std::vector<unsigned char>& output) const override
+		{
+			output.resize(inputSize);
+
+			for (std::size_t index = 0; index < inputSize; index++)
+				output[index] = static_cast<unsigned char>(~input[index]);
+		}
+
+		void Decompress(const unsigned char* input, std::size_t inputSize,
+			unsigned char* output, std::size_t outputSize) const override
+		{
+			Assert::AreEqual(outputSize, inputSize);
+
+			for (std::size_t index = 0; index < inputSize; index++)
+				output[index] = static_cast<unsigned char>(~input[index]);
+		}
+	};
+
+	TEST_CLASS(GridSerializationTesting)
+	{
+	public:
+		template<typename Grid_Type>
+		static void FillPattern(Grid_Type& grid)
+		{
+			for (unsigned row = 0; row < grid.GetRowCount(); row++)
+			{
+				for (unsigned column = 0; column < grid.GetColumnCount(); column++)
+					grid.GetCell(column, row) = int(column * 7 + row * 1000);
+			}
+		}
+
+		template<typename Grid_Type>
+		static void AssertPattern(const Grid_Type& grid)
+		{
+			for (unsigned row = 0; row < grid.GetRowCount(); row++)
+			{
+				for (unsigned column = 0; column < grid.GetColumnCount(); column++)
+					Assert::AreEqual(int(column * 7 + row * 1000), grid.GetCell(column, row));
+			}
+		}
+
+		TEST_METHOD(RoundTripAcrossLayouts)
+		{
+			//Wide enough that a band holds a single row
+			Grid<int, PaddedRowMajorLayout<64>> padded(70000 / 4 + 3, 5);
+			FillPattern(padded);
+
+			std::stringstream stream;
+			SaveGrid(padded, stream, GridLzCodec());
+
+			Grid<int, TiledLayout<8>> tiled;
+			LoadGrid(tiled, stream);
+
+			Assert::AreEqual(padded.GetColumnCount(), tiled.GetColumnCount());
+			Assert::AreEqual(padded.GetRowCount(), tiled.GetRowCount());
+			AssertPattern(tiled);
+
+			std::stringstream secondStream;
+			SaveGrid(tiled, secondStream);
+
+			Grid<int, MortonLayout<>> morton(3, 3, 9);
+			LoadGrid(morton, secondStream);
+			AssertPattern(morton);
+		}
+
+		TEST_METHOD(LzCodecRoundTrip)
+		{
+			GridLzCodec codec;
+			std::mt19937 random(5);
+
+			std::vector<std::vector<unsigned char>> inputs;
+			inputs.push_back({});
+			inputs.push_back({ 1, 2, 3 });
+			inputs.push_back(std::vector<unsigned char>(100000, 7));
+
+			//Literal and match lengths both past the 15 + 255 extension
+			std::vector<unsigned char> mixed;
+			for (int block = 0; block < 20; block++)
+			{
+				for (int index = 0; index < 300; index++)
+					mixed.push_back(static_cast<unsigned char>(random()));
+
+				mixed.insert(mixed.end(), mixed.end() - 300, mixed.end());
+			}
+			inputs.push_back(mixed);
+
+			for (const std::vector<unsigned char>& input : inputs)
+			{
+				std::vector<unsigned char> compressed;
+				codec.Compress(input.data(), input.size(), compressed);
+
+				std::vector<unsigned char> output(input.size());
+				codec.Decompress(compressed.data(), compressed.size(), output.data(), output.size());
+
+				Assert::IsTrue(output == input);
+			}
+
+			std::vector<unsigned char> compressed;
+			codec.Compress(inputs[2].data(), inputs[2].size(), compressed);
+			Assert::IsTrue(compressed.size() < 1000, L"A run compresses to almost nothing");
+
+			std::vector<unsigned char> output(inputs[2].size() + 1);
+			Assert::ExpectException<std::runtime_error>([&]()
+			{
+				codec.Decompress(compressed.data(), compressed.size(), output.data(), output.size());
+			});
+		}
+
+		TEST_METHOD(CompressionShrinksRepetitiveGrids)
+		{
+			Grid<int> grid(512, 512, 3);
+			grid.GetCell(100, 100) = 4;
+
+			std::stringstream raw;
+			SaveGrid(grid, raw);
+
+			std::stringstream compressed;
+			SaveGrid(grid, compressed, GridLzCodec());
+
+			Assert::IsTrue(compressed.str().size() * 20 < raw.str().size());
+
+			Grid<int> loaded;
+			LoadGrid(loaded, compressed);
+			Assert::AreEqual(4, loaded.GetCell(100, 100));
+			Assert::AreEqual(3, loaded.GetCell(101, 100));
+		}
+
+		TEST_METHOD(CorruptDataLeavesGridUnchanged)
+		{
+			Grid<int> source(40, 40);
+			FillPattern(source);
+
+			std::stringstream stream;
+			SaveGrid(source, stream, GridLzCodec());
+			std::string bytes = stream.str();
+
+			Grid<int> grid(2, 2, 8);
+
+			std::istringstream truncated(bytes.substr(0, bytes.size() - 10));
+			Assert::ExpectException<std::runtime_error>([&]() { LoadGrid(grid, truncated); });
+
+			std::string badMagic = bytes;
+			badMagic[0] = 'X';
+			std::istringstream badMagicStream(badMagic);
+			Assert::ExpectException<std::runtime_error>([&]() { LoadGrid(grid, badMagicStream); });
+
+			std::istringstream wrongType(bytes);
+			Grid<double> doubles;
+			Assert::ExpectException<std::runtime_error>([&]() { LoadGrid(doubles, wrongType); });
+
+			Assert::AreEqual(Grid<int>::dimension_type(2), grid.GetColumnCount());
+			Assert::AreEqual(8, grid.GetCell(1, 1));
+
+			Assert::ExpectException<std::runtime_error>([&]() { LoadGrid(grid, std::string("/nonexistent/grid.bin")); });
+
+			//A stored size past the raw one is rejected before anything is allocated for it
+			std::string hugeBand = bytes;
+			hugeBand[40 + 8 + 6] = 1;
+			std::istringstream hugeBandStream(hugeBand);
+			Assert::ExpectException<std::runtime_error>([&]() { LoadGrid(grid, hugeBandStream); });
+
+			//Dimensions far past what the stream holds are rejected before the grid is allocated
+			std::string hugeRows = bytes;
+			hugeRows[20 + 3] = 0x10;
+			std::istringstream hugeRowsStream(hugeRows);
+			Assert::ExpectException<std::runtime_error>([&]() { LoadGrid(grid, hugeRowsStream); });
+
+			std::string oneEmptyDimension = bytes;
+			oneEmptyDimension[12] = 0;
+			std::istringstream oneEmptyDimensionStream(oneEmptyDimension);
+			Assert::ExpectException<std::runtime_error>([&]() { LoadGrid(grid, oneEmptyDimensionStream); });
+
+			std::string wrongBandRows = bytes;
+			wrongBandRows[36] = 1;
+			wrongBandRows[37] = 0;
+			std::istringstream wrongBandRowsStream(wrongBandRows);
+			Assert::ExpectException<std::runtime_error>([&]() { LoadGrid(grid, wrongBandRowsStream); });
+
+			Assert::AreEqual(Grid<int>::dimension_type(2), grid.GetColumnCount());
+		}
+
+		TEST_METHOD(EmptyGridRoundTrips)
+		{
+			Grid<int> empty;
+
+			std::stringstream stream;
+			SaveGrid(empty, stream, GridLzCodec());
+
+			Grid<int> loaded(3, 3, 1);
+			LoadGrid(loaded, stream);
+
+			Assert::IsTrue(loaded.isEmpty());
+			Assert::AreEqual(Grid<int>::dimension_type(0), loaded.GetRowCount());
+		}
+
+		TEST_METHOD(VersionOneFilesStillLoad)
+		{
+			Grid<int> source(9, 4);
+			FillPattern(source);
+
+			std::stringstream stream;
+			SaveGrid(source, stream);
+			std::string bytes = stream.str();
+
+			//Same file with the u32 band sizes of version 1
+			std::string versionOne = bytes.substr(0, 40);
+			versionOne[8] = 1;
+			versionOne += bytes.substr(40, 4) + bytes.substr(48, 4) + bytes.substr(56, 4) + bytes.substr(60);
+
+			std::istringstream versionOneStream(versionOne);
+			Grid<int> loaded;
+			LoadGrid(loaded, versionOneStream);
+			AssertPattern(loaded);
+		}
+
+		TEST_METHOD(CustomCodecIsRequiredToLoad)
+		{
+			Grid<int> source(30, 20);
+			FillPattern(source);
+
+			std::string path = (std::filesystem::temp_directory_path() / "GridSerializationTesting.grid").string();
+			SaveGrid(source, path, InvertingCodec());
+
+			Grid<int> grid;
+			Assert::ExpectException<std::runtime_error>([&]() { LoadGrid(grid, path); });
+
+			InvertingCodec codec;
+			LoadGrid(grid, path, &codec);
+			AssertPattern(grid);
+
+			std::remove(path.c_str());
+		}
+
+		TEST_METHOD(StreamOperatorWritesToItsStream)
+		{
+			Grid<int> grid(2, 2, 5);
+
+			std::ostringstream stream;
+			stream << grid;
+
+			Assert::IsTrue(stream.str().find("[1,1(3) = 5]") != std::string::npos);
+		}
+	};
+}
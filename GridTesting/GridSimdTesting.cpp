@@ -0,0 +1,222 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "GridSimd.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridSimdTesting)
+	{
+	public:
+		///Puts the instruction set found at startup back whatever a test selected
+		struct IsaRestorer
+		{
+			~IsaRestorer()
+			{
+				GridSimd::SetActiveIsa(GridSimd::GetSupportedIsa());
+			}
+		};
+
+		///Everything GridSimd computes over one span, compared bit for bit
+		template<typename T>
+		struct Results
+		{
+			std::vector<T> scaled, clamped, thresholded, added, multiplied;
+			std::vector<unsigned char> reductions;
+
+			bool operator==(const Results& other) const
+			{
+				return SameBits(this->scaled, other.scaled) && SameBits(this->clamped, other.clamped) &&
+					SameBits(this->thresholded, other.thresholded) && SameBits(this->added, other.added) &&
+					SameBits(this->multiplied, other.multiplied) && this->reductions == other.reductions;
+			}
+		};
+
+		template<typename T>
+		static bool SameBits(const std::vector<T>& a, const std::vector<T>& b)
+		{
+			return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+		}
+
+		template<typename T>
+		static void AppendBits(std::vector<unsigned char>& bytes, const T& value)
+		{
+			const unsigned char* first = reinterpret_cast<const unsigned char*>(&value);
+			bytes.insert(bytes.end(), first, first + sizeof(T));
+		}
+
+		template<typename T>
+		static Results<T> Compute(const std::vector<T>& cells, const std::vector<T>& others, T low, T high)
+		{
+			Results<T> results;
+			results.scaled = results.clamped = results.thresholded = cells;
+			results.added.resize(cells.size());
+			results.multiplied.resize(cells.size());
+
+			GridSimd::Scale(results.scaled.data(), cells.size(), T(3));
+			GridSimd::Clamp(results.clamped.data(), cells.size(), low, high);
+			GridSimd::Threshold(results.thresholded.data(), cells.size(), low, T(0), T(1));
+			GridSimd::Add(cells.data(), others.data(), results.added.data(), cells.size());
+			GridSimd::Multiply(cells.data(), others.data(), results.multiplied.data(), cells.size());
+
+			GridSimd::MinMaxResult<T> minMax = GridSimd::MinMax(cells.data(), cells.size());
+			AppendBits(results.reductions, minMax.min);
+			AppendBits(results.reductions, minMax.max);
+
+			//NaN cells are only there for MinMax
+			std::vector<T> finite(cells);
+			for (T& cell : finite)
+				cell = cell == cell ? cell : T(1);
+
+			AppendBits(results.reductions, GridSimd::Sum(finite.data(), finite.size()));
+			return results;
+		}
+
+		template<typename T, typename Random_Function>
+		static void AssertIsasAgree(Random_Function random, T low, T high)
+		{
+			IsaRestorer restorer;
+
+			for (std::size_t count : { 0, 1, 3, 15, 16, 17, 31, 63, 64, 65, 127, 200, 1001 })
+			{
+				std::vector<T> cells(count), others(count);
+
+				for (std::size_t i = 0; i < count; i++)
+				{
+					cells[i] = random();
+					others[i] = random();
+				}
+
+				GridSimd::SetActiveIsa(GridSimd::Isa::Scalar);
+				Results<T> expected = Compute(cells, others, low, high);
+
+				for (int isa = int(GridSimd::Isa::Sse2); isa <= int(GridSimd::GetSupportedIsa()); isa++)
+				{
+					GridSimd::SetActiveIsa(GridSimd::Isa(isa));
+					Assert::IsTrue(expected == Compute(cells, others, low, high));
+				}
+			}
+		}
+
+		TEST_METHOD(EveryIsaMatchesTheScalarPath)
+		{
+			std::mt19937 random(11);
+
+			//Signed zeros and NaN decide which of two equal or unordered cells wins
+			AssertIsasAgree<float>([&]()
+			{
+				std::uint32_t pick = random() % 40;
+				return pick == 0 ? std::numeric_limits<float>::quiet_NaN() : pick == 1 ? -0.0f : pick == 2 ? 0.0f :
+					std::uniform_real_distribution<float>(-1000.0f, 1000.0f)(random);
+			}, -10.0f, 500.0f);
+
+			AssertIsasAgree<double>([&]()
+			{
+				std::uint32_t pick = random() % 40;
+				return pick == 0 ? std::numeric_limits<double>::quiet_NaN() : pick == 1 ? -0.0 :
+					std::uniform_real_distribution<double>(-1e6, 1e6)(random);
+			}, -10.0, 5e5);
+
+			AssertIsasAgree<std::int32_t>([&]() { return std::int32_t(random()); }, -1000, 1 << 30);
+			AssertIsasAgree<std::uint8_t>([&]() { return std::uint8_t(random()); }, std::uint8_t(20), std::uint8_t(200));
+		}
+
+		TEST_METHOD(GridOperationsMatchPlainLoops)
+		{
+			IsaRestorer restorer;
+			std::mt19937 random(5);
+
+			for (int isa = int(GridSimd::Isa::Scalar); isa <= int(GridSimd::GetSupportedIsa()); isa++)
+			{
+				GridSimd::SetActiveIsa(GridSimd::Isa(isa));
+
+				//Padded rows are separate runs, each starting again at lane 0
+				Grid<float, PaddedRowMajorLayout<64>> floats(37, 5);
+				std::vector<float> lanes(16, 0.0f);
+
+				for (std::uint16_t row = 0; row < 5; row++)
+				{
+					for (std::uint16_t column = 0; column < 37; column++)
+					{
+						float cell = std::uniform_real_distribution<float>(-1.0f, 1.0f)(random);
+						floats.GetCell(column, row) = cell;
+						lanes[column % 16] += cell;
+					}
+				}
+
+				for (std::size_t width = 8; width > 0; width /= 2)
+				{
+					for (std::size_t i = 0; i < width; i++)
+						lanes[i] += lanes[i + width];
+				}
+
+				Assert::IsTrue(lanes[0] == GridSimd::Sum(floats));
+
+				GridSimd::Clamp(floats, -0.5f, 0.5f);
+				Assert::IsTrue(std::all_of(floats.begin(), floats.end(), [](float cell) { return cell >= -0.5f && cell <= 0.5f; }));
+
+				Grid<std::int32_t, RowMajorLayout> ints(61, 3), others(61, 3), products(61, 3);
+				std::int64_t total = 0;
+
+				for (std::size_t i = 0; i < ints.size(); i++)
+				{
+					ints.GetCell(i) = std::int32_t(random());
+					others.GetCell(i) = std::int32_t(random() % 1000);
+					total += ints.GetCell(i);
+				}
+
+				Assert::AreEqual(total, GridSimd::Sum(ints));
+				Assert::AreEqual(*std::min_element(ints.begin(), ints.end()), GridSimd::MinMax(ints).min);
+				Assert::AreEqual(*std::max_element(ints.begin(), ints.end()), GridSimd::MinMax(ints).max);
+
+				GridSimd::Multiply(ints, others, products);
+				for (std::size_t i = 0; i < ints.size(); i++)
+					Assert::AreEqual(std::int32_t(std::uint32_t(ints.GetCell(i)) * std::uint32_t(others.GetCell(i))), products.GetCell(i));
+
+				GridSimd::Add(products, others, products);
+				Assert::AreEqual(std::int32_t(std::uint32_t(ints.GetCell(7)) * std::uint32_t(others.GetCell(7)) +
+					std::uint32_t(others.GetCell(7))), products.GetCell(7));
+
+				Grid<std::int32_t, RowMajorLayout> narrow(60, 3);
+				Assert::ExpectException<std::invalid_argument>([&]() { GridSimd::Add(ints, others, narrow); });
+
+				Grid<std::uint8_t, PaddedRowMajorLayout<64>> bytes(70, 9);
+				std::array<std::uint64_t, 256> bins = {};
+				std::uint64_t byteTotal = 0;
+
+				for (std::uint8_t& cell : bytes)
+				{
+					cell = std::uint8_t(random());
+					bins[cell]++;
+					byteTotal += cell;
+				}
+
+				Assert::IsTrue(bins == GridSimd::Histogram(bytes));
+				Assert::AreEqual(byteTotal, GridSimd::Sum(bytes));
+
+				GridSimd::Threshold(bytes, std::uint8_t(128), std::uint8_t(0), std::uint8_t(255));
+				Assert::AreEqual(std::uint64_t(std::count(bytes.begin(), bytes.end(), std::uint8_t(255))),
+					std::uint64_t(std::accumulate(bins.begin() + 128, bins.end(), std::uint64_t(0))));
+
+				GridSimd::Scale(bytes, std::uint8_t(3));
+				Assert::IsTrue(std::all_of(bytes.begin(), bytes.end(), [](std::uint8_t cell) { return cell == 0 || cell == 253; }));
+			}
+
+			Grid<double> empty;
+			Assert::IsTrue(GridSimd::Sum(empty) == 0.0);
+			Assert::IsTrue(std::isinf(GridSimd::MinMax(empty).min));
+		}
+	};
+}
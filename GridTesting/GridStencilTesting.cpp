@@ -0,0 +1,178 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "GridStencil.h"
+#include <random>
+#include <stdexcept>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridStencilTesting)
+	{
+	public:
+		///The neighbour sum of radius Radius written the slow way, with the border
+		///rules applied to every read
+		template<std::size_t Radius>
+		static int NaiveNeighbourSum(const Grid<int>& grid, GridBorder border, int borderValue, int column, int row)
+		{
+			int columns = grid.GetColumnCount();
+			int rows = grid.GetRowCount();
+			int sum = 0;
+
+			for (int rowOffset = -int(Radius); rowOffset <= int(Radius); rowOffset++)
+			{
+				for (int columnOffset = -int(Radius); columnOffset <= int(Radius); columnOffset++)
+				{
+					int x = column + columnOffset;
+					int y = row + rowOffset;
+
+					if (x < 0 || y < 0 || x >= columns || y >= rows)
+					{
+						if (border == GridBorder::Constant)
+						{
+							sum += borderValue;
+							continue;
+						}
+
+						if (border == GridBorder::Clamp)
+						{
+							x = std::min(std::max(x, 0), columns - 1);
+							y = std::min(std::max(y, 0), rows - 1);
+						}
+						else
+						{
+							x = ((x % columns) + columns) % columns;
+							y = ((y % rows) + rows) % rows;
+						}
+					}
+
+					sum += grid.GetCell(Grid<int>::dimension_type(x), Grid<int>::dimension_type(y));
+				}
+			}
+
+			return sum;
+		}
+
+		template<std::size_t Radius>
+		static void CheckAgainstNaive(Grid<int>::dimension_type columns, Grid<int>::dimension_type rows, GridBorder border)
+		{
+			std::mt19937 random(columns * 31 + rows);
+			Grid<int> grid(columns, rows);
+
+			for (int& cell : grid)
+				cell = int(random() % 100);
+
+			GridStencil<int, Radius> stencil(grid, border, -7);
+
+			//Every window read summed, the weights of an all ones kernel
+			int weights[2 * Radius + 1][2 * Radius + 1];
+			for (auto& weightRow : weights)
+			{
+				for (int& weight : weightRow)
+					weight = 1;
+			}
+
+			stencil.Convolve(GridExecution::seq, weights);
+
+			for (int row = 0; row < rows; row++)
+			{
+				for (int column = 0; column < columns; column++)
+				{
+					Assert::AreEqual(NaiveNeighbourSum<Radius>(grid, border, -7, column, row),
+						stencil.GetCell(column, row));
+				}
+			}
+		}
+
+		TEST_METHOD(BordersMatchNaiveLoops)
+		{
+			for (GridBorder border : { GridBorder::Clamp, GridBorder::Wrap, GridBorder::Constant })
+			{
+				CheckAgainstNaive<1>(23, 17, border);
+				CheckAgainstNaive<2>(23, 17, border);
+
+				//Narrower than the radius, the halo wraps or clamps more than once
+				CheckAgainstNaive<2>(1, 3, border);
+				CheckAgainstNaive<3>(2, 1, border);
+			}
+		}
+
+		TEST_METHOD(GliderCrossesTheWrappedEdge)
+		{
+			GridStencil<std::uint8_t> life(8, 8, GridBorder::Wrap);
+
+			//A glider heading down and right
+			life.GetCell(1, 0) = 1;
+			life.GetCell(2, 1) = 1;
+			life.GetCell(0, 2) = 1;
+			life.GetCell(1, 2) = 1;
+			life.GetCell(2, 2) = 1;
+
+			auto rule = [](const GridStencil<std::uint8_t>::window_type& window)
+			{
+				int neighbours = -int(window.Center());
+
+				for (int rowOffset = -1; rowOffset <= 1; rowOffset++)
+				{
+					for (int columnOffset = -1; columnOffset <= 1; columnOffset++)
+						neighbours += window(columnOffset, rowOffset);
+				}
+
+				return std::uint8_t(neighbours == 3 || (neighbours == 2 && window.Center()));
+			};
+
+			//Every 4 generations the glider moves one cell diagonally, 32 bring it home
+			const std::uint8_t* frontCells = &life.GetFrontBuffer().GetCell(std::size_t(0));
+
+			for (int generation = 0; generation < 32; generation++)
+				life.Step(GridExecution::seq, rule);
+
+			Assert::IsTrue(frontCells == &life.GetFrontBuffer().GetCell(std::size_t(0)),
+				L"The buffers swap without reallocating");
+
+			int alive = 0;
+			for (unsigned row = 0; row < 8; row++)
+			{
+				for (unsigned column = 0; column < 8; column++)
+					alive += life.GetCell(column, row);
+			}
+
+			Assert::AreEqual(5, alive);
+			Assert::AreEqual(std::uint8_t(1), life.GetCell(1, 0));
+			Assert::AreEqual(std::uint8_t(1), life.GetCell(2, 2));
+		}
+
+		TEST_METHOD(ParallelStepMatchesSequential)
+		{
+			Grid<float, TiledLayout<8>> field(700, 300, 0.0f);
+			field.GetCell(350, 150) = 1000.0f;
+
+			GridStencil<float> sequential(field, GridBorder::Clamp);
+			GridStencil<float> parallel(field, GridBorder::Clamp);
+
+			const float diffusion[3][3] = { { 0.0f, 0.2f, 0.0f }, { 0.2f, 0.2f, 0.2f }, { 0.0f, 0.2f, 0.0f } };
+
+			GridThreadPool pool(4);
+
+			for (int step = 0; step < 10; step++)
+			{
+				sequential.Convolve(GridExecution::seq, diffusion);
+				parallel.Convolve(GridExecution::par.On(pool), diffusion);
+			}
+
+			Grid<float> result(700, 300);
+			parallel.CopyTo(result);
+
+			for (unsigned row = 0; row < 300; row++)
+			{
+				for (unsigned column = 0; column < 700; column++)
+					Assert::IsTrue(sequential.GetCell(column, row) == result.GetCell(column, row));
+			}
+
+			Assert::IsTrue(result.GetCell(350, 150) < 1000.0f && result.GetCell(355, 150) > 0.0f);
+			Assert::ExpectException<std::invalid_argument>([&]() { parallel.Assign(Grid<float>(5, 5)); });
+		}
+	};
+}
@@ -0,0 +1,245 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Grid.h"
+#include "GridAllocators.h"
+#include <stdexcept>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	///Counts how it is constructed and destroyed, and can throw on a chosen copy
+	struct TrackedCell
+	{
+		static int liveCount;
+		static int defaultConstructions;
+		static int copyConstructions;
+		static int copyAssignments;
+		static int copiesUntilThrow;
+
+		int value;
+
+		TrackedCell()
+			:value(0)
+		{
+			defaultConstructions++;
+			liveCount++;
+		}
+
+		explicit TrackedCell(int _value)
+			:value(_value)
+		{
+			liveCount++;
+		}
+
+		TrackedCell(const TrackedCell& source)
+			:value(source.value)
+		{
+			if (copiesUntilThrow > 0 && --copiesUntilThrow == 0)
+				throw std::runtime_error("TrackedCell copy failed");
+
+			copyConstructions++;
+			liveCount++;
+		}
+
+		TrackedCell& operator=(const TrackedCell& source)
+		{
+			copyAssignments++;
+			value = source.value;
+			return *this;
+		}
+
+		~TrackedCell()
+		{
+			liveCount--;
+		}
+
+		static void Reset()
+		{
+			liveCount = defaultConstructions = copyConstructions = copyAssignments = copiesUntilThrow = 0;
+		}
+	};
+
+	int TrackedCell::liveCount = 0;
+	int TrackedCell::defaultConstructions = 0;
+	int TrackedCell::copyConstructions = 0;
+	int TrackedCell::copyAssignments = 0;
+	int TrackedCell::copiesUntilThrow = 0;
+
+	///Moves without throwing, like std::string, but can throw on a chosen copy.
+	///A moved from cell reads -1.
+	struct MovableCell
+	{
+		static int copiesUntilThrow;
+
+		int value;
+
+		explicit MovableCell(int _value = 0)
+			:value(_value)
+		{
+
+		}
+
+		MovableCell(const MovableCell& source)
+			:value(source.value)
+		{
+			if (copiesUntilThrow > 0 && --copiesUntilThrow == 0)
+				throw std::runtime_error("MovableCell copy failed");
+		}
+
+		MovableCell(MovableCell&& source) noexcept
+			:value(source.value)
+		{
+			source.value = -1;
+		}
+
+		MovableCell& operator=(const MovableCell&) = default;
+		MovableCell& operator=(MovableCell&&) noexcept = default;
+	};
+
+	int MovableCell::copiesUntilThrow = 0;
+
+	TEST_CLASS(GridStorageTesting)
+	{
+	public:
+
+		TEST_METHOD(CellsAreConstructedOnce)
+		{
+			TrackedCell::Reset();
+
+			{
+				Grid<TrackedCell> grid(6, 4, TrackedCell(3));
+
+				//The fill value itself is passed by value, everything else is cells
+				Assert::AreEqual(24, TrackedCell::liveCount);
+				Assert::IsTrue(TrackedCell::copyConstructions >= 24 && TrackedCell::copyConstructions <= 26);
+				Assert::AreEqual(0, TrackedCell::defaultConstructions);
+				Assert::AreEqual(0, TrackedCell::copyAssignments);
+
+				Grid<TrackedCell> copy(grid);
+
+				Assert::AreEqual(48, TrackedCell::liveCount);
+				Assert::AreEqual(0, TrackedCell::copyAssignments);
+
+				grid.ResizeGridPreserveData(8, 5, TrackedCell(1));
+
+				Assert::AreEqual(24 + 40, TrackedCell::liveCount);
+				Assert::AreEqual(0, TrackedCell::copyAssignments);
+				Assert::AreEqual(3, grid.GetCell(5, 3).value);
+				Assert::AreEqual(1, grid.GetCell(6, 3).value);
+			}
+
+			Assert::AreEqual(0, TrackedCell::liveCount);
+		}
+
+		TEST_METHOD(PaddingIsNeverConstructed)
+		{
+			TrackedCell::Reset();
+
+			{
+				Grid<TrackedCell, PaddedRowMajorLayout<64>, AlignedAllocator<TrackedCell, 64>> grid(3, 5, TrackedCell(2));
+
+				Assert::AreEqual(std::size_t(16 * 5), grid.GetStorageSize());
+				Assert::AreEqual(15, TrackedCell::liveCount);
+
+				grid.ResizeGridPreserveData(17, 2, TrackedCell(4));
+				Assert::AreEqual(34, TrackedCell::liveCount);
+			}
+
+			Assert::AreEqual(0, TrackedCell::liveCount);
+		}
+
+		TEST_METHOD(FailedConstructionLeaksNothing)
+		{
+			TrackedCell::Reset();
+
+			Grid<TrackedCell> grid(4, 4, TrackedCell(1));
+			TrackedCell::copiesUntilThrow = 10;
+
+			auto f1 = [&grid] { grid.ResizeGrid(5, 5, TrackedCell(2)); };
+			Assert::ExpectException<std::runtime_error>(f1);
+
+			Assert::IsTrue(grid.isEmpty());
+			Assert::AreEqual(0, TrackedCell::liveCount);
+
+			grid.ResizeGrid(3, 3, TrackedCell(1));
+			TrackedCell::copiesUntilThrow = 5;
+
+			auto f2 = [&grid] { Grid<TrackedCell> copy(grid); };
+			Assert::ExpectException<std::runtime_error>(f2);
+			Assert::AreEqual(9, TrackedCell::liveCount);
+
+			//Copy construction of the cells is not noexcept, so a failed resize
+			//leaves the original cells in place
+			TrackedCell::copiesUntilThrow = 12;
+
+			auto f3 = [&grid] { grid.ResizeGridPreserveData(6, 6, TrackedCell(7)); };
+			Assert::ExpectException<std::runtime_error>(f3);
+			Assert::AreEqual(9, TrackedCell::liveCount);
+			Assert::AreEqual(1, grid.GetCell(2, 2).value);
+		}
+
+		TEST_METHOD(FailedGrowthLeaksNothing)
+		{
+			TrackedCell::Reset();
+
+			Grid<TrackedCell> grid(4, 4, TrackedCell(1));
+			TrackedCell::copiesUntilThrow = 18;
+
+			//The cells are copied into the new storage, so the grid keeps its shape
+			auto f1 = [&grid] { grid.AppendRows(2, TrackedCell(2)); };
+			Assert::ExpectException<std::runtime_error>(f1);
+			Assert::AreEqual(16, TrackedCell::liveCount);
+			Assert::AreEqual(4, int(grid.GetRowCount()));
+
+			TrackedCell::copiesUntilThrow = 0;
+			grid.EraseColumn(1);
+			grid.InsertColumn(3, TrackedCell(3));
+
+			Assert::AreEqual(16, TrackedCell::liveCount);
+			Assert::AreEqual(3, grid.GetCell(3, 3).value);
+		}
+
+		TEST_METHOD(FailedFillKeepsMovableCells)
+		{
+			Grid<MovableCell> grid(4, 4, MovableCell(1));
+
+			//The new cells are copies of the filler, so once one of them throws the
+			//old cells must still be there rather than moved out
+			MovableCell::copiesUntilThrow = 3;
+			Assert::ExpectException<std::runtime_error>([&grid] { grid.ResizeGridPreserveData(6, 6, MovableCell(7)); });
+
+			MovableCell::copiesUntilThrow = 2;
+			Assert::ExpectException<std::runtime_error>([&grid] { grid.AppendColumns(1, MovableCell(7)); });
+
+			MovableCell::copiesUntilThrow = 0;
+			Assert::AreEqual(4, int(grid.GetColumnCount()));
+
+			for (const MovableCell& cell : grid)
+				Assert::AreEqual(1, cell.value);
+
+			grid.ResizeGridPreserveData(6, 6, MovableCell(7));
+			Assert::AreEqual(1, grid.GetCell(3, 3).value);
+			Assert::AreEqual(7, grid.GetCell(5, 5).value);
+		}
+
+		TEST_METHOD(NoInitGridIsWritable)
+		{
+			Grid<double> grid(7, 9, GridNoInit);
+
+			Assert::AreEqual(Grid<double>::dimension_type(7), grid.GetColumnCount());
+			Assert::AreEqual(Grid<double>::dimension_type(9), grid.GetRowCount());
+
+			double value = 0.0;
+
+			for (auto iter = grid.begin(); iter != grid.end(); ++iter)
+				*iter = value++;
+
+			Assert::AreEqual(62.0, grid.GetCell(6, 8));
+
+			grid.ResizeGrid(2, 2, GridNoInit);
+			Assert::AreEqual(Grid<double>::size_type(4), grid.size());
+		}
+	};
+}
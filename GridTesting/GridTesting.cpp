@@ -2,7 +2,9 @@
 #include "CppUnitTest.h"
 
 #include "Grid.h"
+#if defined(_MSC_VER)
 #include <cstringt.h>
+#endif
 #include <random>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -12,14 +14,14 @@ namespace Microsoft
 	{
 		namespace CppUnitTestFramework
 		{
-			std::wstring ToString(unsigned __int16 const& value)
+			std::wstring ToString(std::uint16_t const& value)
 			{
 				return std::to_wstring(value);
 			}
 
 			std::wstring ToString(Grid<int> const& value)
 			{
-				return std::to_wstring(value.grid_data[0]);
+				return std::to_wstring(value.GetCell(0));
 			}
 		}
 	}
@@ -72,8 +74,8 @@ namespace GridTesting
 			Grid<double> originalGrid(2, 5, 0.5);
 			Grid<double> clonedGrid(originalGrid);
 
-			Assert::AreEqual(clonedGrid.columnCount, originalGrid.columnCount);
-			Assert::AreEqual(clonedGrid.rowCount, originalGrid.rowCount);
+			Assert::AreEqual(clonedGrid.GetColumnCount(), originalGrid.GetColumnCount());
+			Assert::AreEqual(clonedGrid.GetRowCount(), originalGrid.GetRowCount());
 
 			for (Grid<double>::dimension_type rowIndex = 0; rowIndex < originalGrid.GetRowCount(); rowIndex++)
 			{
@@ -90,9 +92,9 @@ namespace GridTesting
 			Grid<int> destination(GetGridForMoveTest());
 
 			for (Grid<int>::dimension_type columnIndex = 0;
-			columnIndex < destination.columnCount; columnIndex++)
+			columnIndex < destination.GetColumnCount(); columnIndex++)
 			{
-				for (Grid<int>::dimension_type rowIndex = 0; rowIndex < destination.rowCount; rowIndex++)
+				for (Grid<int>::dimension_type rowIndex = 0; rowIndex < destination.GetRowCount(); rowIndex++)
 				{
 					Assert::AreEqual(destination.GetCell(columnIndex, rowIndex), 5);
 				}
@@ -115,7 +117,9 @@ namespace GridTesting
 			///[] Read Operator
 			Assert::AreEqual(testGrid[3][3], 1024);
 
-			auto f1 = [&testGrid] { return testGrid.GetCell(4,7); };
+			//Default grids only assert, a checked one throws in release builds too
+			Grid<int, RowMajorLayout, std::allocator<int>, std::uint16_t, GridCheckedAccess> checkedGrid(4, 6, 21);
+			auto f1 = [&checkedGrid] { return checkedGrid.GetCell(4,7); };
 
 			Assert::ExpectException<std::out_of_range>(f1);
 		}
@@ -243,23 +247,23 @@ namespace GridTesting
 
 			auto iter = testGrid.begin();
 
-			Assert::AreEqual(*iter, testGrid.grid_data[0]);
+			Assert::AreEqual(*iter, testGrid.GetCell(0));
 
 			++iter;
 
-			Assert::AreEqual(*iter, testGrid.grid_data[1]);
+			Assert::AreEqual(*iter, testGrid.GetCell(1));
 
-			Assert::AreEqual(iter[6], testGrid.grid_data[7]);
+			Assert::AreEqual(iter[6], testGrid.GetCell(7));
 
 			--iter;
 
-			Assert::AreEqual(*iter, testGrid.grid_data[0]);
+			Assert::AreEqual(*iter, testGrid.GetCell(0));
 
 			iter = testGrid.end();
 
 			iter--;
 
-			Assert::AreEqual(*iter, testGrid.grid_data[testGrid.size() - 1]);
+			Assert::AreEqual(*iter, testGrid.GetCell(testGrid.size() - 1));
 
 			Assert::IsTrue(testGrid.begin() < testGrid.end());
 
@@ -267,7 +271,7 @@ namespace GridTesting
 
 			for (auto i = testGrid.begin(); i < testGrid.end(); i++)
 			{
-				Assert::AreEqual(*i, testGrid.grid_data[index]);
+				Assert::AreEqual(*i, testGrid.GetCell(index));
 				index++;
 			}
 
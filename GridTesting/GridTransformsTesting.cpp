@@ -0,0 +1,157 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "GridTransforms.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridTransformsTesting)
+	{
+	public:
+		template<typename Value_Type>
+		static Value_Type Number(unsigned value)
+		{
+			if constexpr (std::is_same<Value_Type, std::string>::value)
+				return std::to_string(value);
+			else
+				return Value_Type(value);
+		}
+
+		template<typename Grid_Type>
+		static Grid_Type MakeNumbered(unsigned columns, unsigned rows)
+		{
+			Grid_Type grid{ typename Grid_Type::dimension_type(columns), typename Grid_Type::dimension_type(rows) };
+
+			for (unsigned row = 0; row < rows; row++)
+			{
+				for (unsigned column = 0; column < columns; column++)
+					grid.GetCell(column, row) = Number<typename Grid_Type::value_type>(row * 1000 + column);
+			}
+
+			return grid;
+		}
+
+		///expected(column, row) gives the source coordinate each result cell comes from
+		template<typename Grid_Type, typename Source_Function>
+		static void AssertMapped(const Grid_Type& source, const Grid_Type& result, unsigned columns, unsigned rows,
+			Source_Function sourceOf)
+		{
+			Assert::AreEqual(columns, unsigned(result.GetColumnCount()));
+			Assert::AreEqual(rows, unsigned(result.GetRowCount()));
+
+			for (unsigned row = 0; row < rows; row++)
+			{
+				for (unsigned column = 0; column < columns; column++)
+				{
+					std::pair<unsigned, unsigned> from = sourceOf(column, row);
+					Assert::IsTrue(result.GetCell(column, row) == source.GetCell(from.first, from.second));
+				}
+			}
+		}
+
+		template<typename Grid_Type>
+		static void CheckOutOfPlace(unsigned columns, unsigned rows)
+		{
+			Grid_Type source = MakeNumbered<Grid_Type>(columns, rows);
+
+			AssertMapped(source, Transposed(source), rows, columns,
+				[](unsigned c, unsigned r) { return std::make_pair(r, c); });
+			AssertMapped(source, Rotated90(source), rows, columns,
+				[&](unsigned c, unsigned r) { return std::make_pair(r, rows - 1 - c); });
+			AssertMapped(source, Rotated180(source), columns, rows,
+				[&](unsigned c, unsigned r) { return std::make_pair(columns - 1 - c, rows - 1 - r); });
+			AssertMapped(source, Rotated270(source), rows, columns,
+				[&](unsigned c, unsigned r) { return std::make_pair(columns - 1 - r, c); });
+			AssertMapped(source, FlippedHorizontally(source), columns, rows,
+				[&](unsigned c, unsigned r) { return std::make_pair(columns - 1 - c, r); });
+			AssertMapped(source, FlippedVertically(source), columns, rows,
+				[&](unsigned c, unsigned r) { return std::make_pair(c, rows - 1 - r); });
+		}
+
+		TEST_METHOD(OutOfPlaceMatchesTheDefinition)
+		{
+			//Odd sizes past the 32 cell blocks and the 4 x 4 SSE tiles
+			CheckOutOfPlace<Grid<int>>(70, 45);
+			CheckOutOfPlace<Grid<int>>(1, 9);
+			CheckOutOfPlace<Grid<std::uint8_t>>(37, 66);
+			CheckOutOfPlace<Grid<double, ColumnMajorLayout>>(40, 33);
+			CheckOutOfPlace<Grid<int, PaddedRowMajorLayout<64>>>(13, 50);
+			CheckOutOfPlace<Grid<std::string>>(35, 3);
+		}
+
+		template<typename Grid_Type>
+		static void CheckInPlace(unsigned columns, unsigned rows)
+		{
+			Grid_Type source = MakeNumbered<Grid_Type>(columns, rows);
+			Grid_Type grid = source;
+
+			Transpose(grid);
+			Assert::IsTrue(std::equal(grid.begin(), grid.end(), Transposed(source).begin()));
+
+			grid = source;
+			Rotate90(grid);
+			Assert::IsTrue(std::equal(grid.begin(), grid.end(), Rotated90(source).begin()));
+
+			grid = source;
+			Rotate180(grid);
+			Assert::IsTrue(std::equal(grid.begin(), grid.end(), Rotated180(source).begin()));
+
+			grid = source;
+			Rotate270(grid);
+			Assert::IsTrue(std::equal(grid.begin(), grid.end(), Rotated270(source).begin()));
+
+			grid = source;
+			FlipHorizontal(grid);
+			FlipVertical(grid);
+			Rotate180(grid);
+			Assert::IsTrue(std::equal(grid.begin(), grid.end(), source.begin()));
+		}
+
+		TEST_METHOD(InPlaceMatchesOutOfPlace)
+		{
+			CheckInPlace<Grid<int>>(67, 67);
+			CheckInPlace<Grid<int>>(20, 7);
+			CheckInPlace<Grid<std::uint16_t, ColumnMajorLayout>>(33, 33);
+			CheckInPlace<Grid<std::string>>(5, 5);
+
+			//Four quarter turns come back round
+			Grid<int> grid = MakeNumbered<Grid<int>>(9, 4);
+			Grid<int> source = grid;
+
+			for (int turn = 0; turn < 4; turn++)
+				Rotate90(grid);
+
+			Assert::AreEqual(9, int(grid.GetColumnCount()));
+			Assert::IsTrue(std::equal(grid.begin(), grid.end(), source.begin()));
+
+			Assert::ExpectException<std::invalid_argument>([&]()
+			{
+				Grid<int> wrong(9, 9);
+				CopyTransposed(GridView<const int>(source), GridView<int>(wrong));
+			});
+		}
+
+		TEST_METHOD(EmptyGridsStayEmpty)
+		{
+			Grid<int> empty;
+
+			Assert::IsTrue(Transposed(empty).isEmpty());
+			Assert::IsTrue(Rotated90(empty).isEmpty());
+			Assert::IsTrue(Rotated180(empty).isEmpty());
+			Assert::IsTrue(Rotated270(empty).isEmpty());
+			Assert::IsTrue(FlippedHorizontally(empty).isEmpty());
+			Assert::IsTrue(FlippedVertically(empty).isEmpty());
+
+			Grid<std::string> strings;
+			Rotate90(strings);
+			Transpose(strings);
+			Assert::IsTrue(strings.isEmpty());
+		}
+	};
+}
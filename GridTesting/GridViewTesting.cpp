@@ -0,0 +1,117 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "GridView.h"
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(GridViewTesting)
+	{
+	public:
+		template<typename Grid_Type>
+		static void Number(Grid_Type& grid)
+		{
+			for (unsigned row = 0; row < grid.GetRowCount(); row++)
+			{
+				for (unsigned column = 0; column < grid.GetColumnCount(); column++)
+					grid.GetCell(column, row) = int(row * 100 + column);
+			}
+		}
+
+		TEST_METHOD(ViewsAddressTheRectangle)
+		{
+			Grid<int> grid(10, 8);
+			Number(grid);
+
+			GridView<int> view(grid, 2, 3, 4, 3);
+			Assert::AreEqual(302, view.GetCell(0, 0));
+			Assert::AreEqual(505, view[3][2]);
+
+			view.GetCell(1, 1) = -1;
+			Assert::AreEqual(-1, grid.GetCell(3, 4));
+
+			//Row by row, skipping the rest of each grid row
+			std::vector<int> cells(view.begin(), view.end());
+			Assert::AreEqual(std::size_t(12), cells.size());
+			Assert::AreEqual(305, cells[3]);
+			Assert::AreEqual(402, cells[4]);
+
+			GridView<int>::Line column = view.GetColumn(2);
+			Assert::AreEqual(std::size_t(3), column.size());
+			Assert::AreEqual(504, column[2]);
+
+			GridView<int> inner = view.SubView(1, 1, 2, 2);
+			Assert::AreEqual(-1, inner.GetCell(0, 0));
+			Assert::AreEqual(504, inner.GetCell(1, 1));
+
+			GridView<const int> readOnly = inner;
+			Assert::AreEqual(404, readOnly.GetRow(0)[1]);
+
+			GridView<int, GridCheckedAccess> checkedView(view);
+			Assert::ExpectException<std::out_of_range>([&]() { checkedView.GetCell(4, 0); });
+			Assert::ExpectException<std::out_of_range>([&]() { checkedView.SubView(3, 0, 2, 1); });
+			Assert::ExpectException<std::out_of_range>([&]() { GridView<int, GridCheckedAccess>(grid, 8, 0, 3, 1); });
+		}
+
+		TEST_METHOD(ViewsOfOtherLayouts)
+		{
+			Grid<int, ColumnMajorLayout> columns(6, 5);
+			Number(columns);
+
+			GridView<int> view = MakeGridView(columns, 1, 1, 3, 2);
+			Assert::IsFalse(view.HasContiguousRows());
+			Assert::AreEqual(203, view.GetCell(2, 1));
+			Assert::AreEqual(101 + 102 + 103 + 201 + 202 + 203, std::accumulate(view.begin(), view.end(), 0));
+
+			Grid<std::uint8_t, PaddedRowMajorLayout<64>> padded(10, 4, 0);
+			GridView<std::uint8_t> paddedView(padded);
+			FillRegion(paddedView.SubView(2, 1, 3, 2), std::uint8_t(7));
+
+			int sevens = 0;
+			for (std::uint8_t cell : padded)
+				sevens += cell == 7;
+
+			Assert::AreEqual(6, sevens);
+			Assert::AreEqual(7, int(padded.GetCell(4, 2)));
+		}
+
+		TEST_METHOD(CopyRegionBlitsAndScrolls)
+		{
+			Grid<int> source(10, 8);
+			Number(source);
+			Grid<int> target(5, 5, 0);
+
+			CopyRegion(GridView<const int>(source, 3, 2, 4, 3), GridView<int>(target, 1, 1, 4, 3));
+			Assert::AreEqual(203, target.GetCell(1, 1));
+			Assert::AreEqual(406, target.GetCell(4, 3));
+			Assert::AreEqual(0, target.GetCell(0, 0));
+
+			//Scroll down and right inside one grid
+			CopyRegion(GridView<int>(source, 0, 0, 8, 6), GridView<int>(source, 2, 2, 8, 6));
+			Assert::AreEqual(0, source.GetCell(2, 2));
+			Assert::AreEqual(507, source.GetCell(9, 7));
+
+			//And back up and left
+			CopyRegion(GridView<int>(source, 2, 2, 8, 6), GridView<int>(source, 0, 0, 8, 6));
+			Assert::AreEqual(507, source.GetCell(7, 5));
+
+			//Non trivial cells and a column major source
+			Grid<std::string, ColumnMajorLayout> names(3, 3, "a");
+			names.GetCell(2, 1) = "b";
+			Grid<std::string> copies(3, 3);
+			CopyRegion(GridView<const std::string>(names), GridView<std::string>(copies));
+			Assert::AreEqual(std::string("b"), copies.GetCell(2, 1));
+
+			Assert::ExpectException<std::invalid_argument>([&]()
+			{
+				CopyRegion(GridView<const int>(source, 0, 0, 2, 2), GridView<int>(target, 0, 0, 2, 3));
+			});
+		}
+	};
+}
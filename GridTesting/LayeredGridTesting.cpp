@@ -0,0 +1,100 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "LayeredGrid.h"
+#include <cstdint>
+#include <stdexcept>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(LayeredGridTesting)
+	{
+	public:
+		struct TerrainCell
+		{
+			float height;
+			float cost;
+			std::uint8_t owner;
+			std::uint8_t flags;
+		};
+
+		typedef LayeredGrid<TerrainCell, RowMajorLayout,
+			&TerrainCell::height, &TerrainCell::cost, &TerrainCell::owner, &TerrainCell::flags> TerrainGrid;
+
+		TEST_METHOD(WholeCellsAndLayersAgree)
+		{
+			TerrainGrid grid(10, 8, TerrainCell{ 1.0f, 2.0f, 3, 4 });
+
+			Assert::AreEqual(std::size_t(4), TerrainGrid::layer_count);
+			Assert::AreEqual(2.0, double(grid.GetCell(9, 7).Get<&TerrainCell::cost>()));
+
+			grid.GetCell(3, 4) = TerrainCell{ 5.0f, 6.0f, 7, 8 };
+			grid.GetCell(4, 4).Get<&TerrainCell::owner>() = 9;
+
+			TerrainCell cell = grid.GetCell(3, 4);
+			Assert::AreEqual(5.0, double(cell.height));
+			Assert::AreEqual(8, int(cell.flags));
+
+			Assert::AreEqual(5.0, double(grid.GetLayer<&TerrainCell::height>().GetCell(3, 4)));
+			Assert::AreEqual(9, int(grid.GetLayer<&TerrainCell::owner>().GetCell(4, 4)));
+			Assert::AreEqual(1.0, double(grid.GetCell(4, 4).Get<&TerrainCell::height>()));
+
+			//Cell to cell copies go through Cell_Type
+			grid.GetCell(0, 0) = grid.GetCell(3, 4);
+			const TerrainGrid& constGrid = grid;
+			Assert::AreEqual(6.0, double(constGrid.GetCell(0, 0).cost));
+
+			Assert::ExpectException<std::out_of_range>([&]() { grid.GetCell(10, 0); });
+			Assert::ExpectException<std::out_of_range>([&]() { constGrid.GetLayer<&TerrainCell::flags>().GetCell(0, 8); });
+		}
+
+		TEST_METHOD(LayersRunBulkOperations)
+		{
+			TerrainGrid grid(300, 200);
+
+			grid.GetLayer<&TerrainCell::cost>().Fill(GridExecution::par, 1.5f);
+			grid.GetLayer<&TerrainCell::height>().Transform(GridExecution::seq, grid.GetLayer<&TerrainCell::cost>().GetGrid(),
+				[](float cost) { return cost * 2.0f; });
+
+			double total = grid.GetLayer<&TerrainCell::height>().Reduce(GridExecution::par, 0.0,
+				[](double left, double right) { return left + right; });
+			Assert::AreEqual(300.0 * 200.0 * 3.0, total, 1e-6);
+
+			int flagged = 0;
+			for (std::uint8_t& flags : grid.GetLayer<&TerrainCell::flags>())
+				flags = std::uint8_t(flagged++ % 2);
+
+			Assert::AreEqual(0, int(grid.GetCell(0, 0).Get<&TerrainCell::flags>()));
+			Assert::AreEqual(1, int(grid.GetCell(1, 0).Get<&TerrainCell::flags>()));
+		}
+
+		TEST_METHOD(ResizePreservesEveryLayer)
+		{
+			//Padded rows differ per field size, each layer keeps its own pitch
+			LayeredGrid<TerrainCell, PaddedRowMajorLayout<64>, &TerrainCell::height, &TerrainCell::owner> grid(5, 5);
+
+			for (unsigned row = 0; row < 5; row++)
+			{
+				for (unsigned column = 0; column < 5; column++)
+					grid.SetCell(column, row, TerrainCell{ float(row * 5 + column), 0.0f, std::uint8_t(column), 0 });
+			}
+
+			grid.ResizeGridPreserveData(7, 3, TerrainCell{ -1.0f, 0.0f, 99, 0 });
+
+			Assert::AreEqual(7, int(grid.GetColumnCount()));
+			Assert::AreEqual(14.0, double(grid.GetCell(4, 2).Get<&TerrainCell::height>()));
+			Assert::AreEqual(4, int(grid.GetCell(4, 2).Get<&TerrainCell::owner>()));
+			Assert::AreEqual(-1.0, double(grid.GetCell(6, 1).Get<&TerrainCell::height>()));
+			Assert::AreEqual(99, int(grid.GetCell(5, 0).Get<&TerrainCell::owner>()));
+
+			//Members that are not layers read back value initialised
+			Assert::AreEqual(0.0, double(TerrainCell(grid.GetCell(4, 2)).cost));
+
+			grid.ResizeGrid(2, 2, TerrainCell{ 3.0f, 0.0f, 1, 0 });
+			Assert::AreEqual(3.0, double(grid.GetCell(1, 1).Get<&TerrainCell::height>()));
+			Assert::ExpectException<std::invalid_argument>([&]() { grid.ResizeGrid(0, 1); });
+		}
+	};
+}
@@ -0,0 +1,178 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "MappedGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	///A file in the temporary directory, removed again when the test ends
+	struct TemporaryGridFile
+	{
+		std::string path;
+
+		explicit TemporaryGridFile(const char* name)
+			:path((std::filesystem::temp_directory_path() / name).string())
+		{
+			std::remove(path.c_str());
+		}
+
+		~TemporaryGridFile()
+		{
+			std::remove(path.c_str());
+		}
+	};
+
+	TEST_CLASS(MappedGridTesting)
+	{
+	public:
+		typedef MappedGrid<int> MappedIntGrid;
+
+		TEST_METHOD(CreateFlushAndReopen)
+		{
+			TemporaryGridFile file("MappedGridTesting_Reopen.grid");
+
+			{
+				MappedIntGrid created = MappedIntGrid::Create(file.path, 40, 30, 1);
+				created.GetWritableGrid().GetCell(39, 29) = 5;
+				created.GetWritableGrid()[3][4] = 6;
+				created.Flush();
+			}
+
+			MappedIntGrid opened = MappedIntGrid::Open(file.path, MappedGridMode::ReadOnly, true);
+
+			Assert::AreEqual(MappedIntGrid::dimension_type(40), opened.GetGrid().GetColumnCount());
+			Assert::AreEqual(5, opened.GetGrid().GetCell(39, 29));
+			Assert::AreEqual(6, opened.GetGrid()[3][4]);
+			Assert::AreEqual(1, opened.GetGrid().GetCell(0, 0));
+
+			Assert::ExpectException<std::logic_error>([&]() { opened.GetWritableGrid(); });
+			Assert::ExpectException<std::logic_error>([&]() { opened.Flush(); });
+		}
+
+		TEST_METHOD(CopyOnWriteStaysPrivate)
+		{
+			TemporaryGridFile file("MappedGridTesting_CopyOnWrite.grid");
+
+			MappedIntGrid::Create(file.path, 8, 8, 2);
+
+			{
+				MappedIntGrid privateCopy = MappedIntGrid::Open(file.path, MappedGridMode::CopyOnWrite);
+				privateCopy.GetWritableGrid().GetCell(7, 7) = 9;
+				Assert::AreEqual(9, privateCopy.GetGrid().GetCell(7, 7));
+			}
+
+			MappedIntGrid opened = MappedIntGrid::Open(file.path, MappedGridMode::ReadOnly, true);
+			Assert::AreEqual(2, opened.GetGrid().GetCell(7, 7));
+		}
+
+		TEST_METHOD(SharedWritesAreVisibleToOtherMappings)
+		{
+			TemporaryGridFile file("MappedGridTesting_Shared.grid");
+
+			MappedIntGrid writer = MappedIntGrid::Create(file.path, 16, 16, 0);
+			MappedIntGrid reader = MappedIntGrid::Open(file.path, MappedGridMode::ReadOnly);
+
+			writer.GetWritableGrid().GetCell(10, 11) = 42;
+
+			Assert::AreEqual(42, reader.GetGrid().GetCell(10, 11));
+		}
+
+		TEST_METHOD(MismatchedFilesAreRejected)
+		{
+			TemporaryGridFile file("MappedGridTesting_Mismatch.grid");
+
+			MappedIntGrid::Create(file.path, 8, 8, 3);
+
+			Assert::ExpectException<std::runtime_error>([&]() { MappedGrid<double>::Open(file.path, MappedGridMode::ReadOnly); });
+			Assert::ExpectException<std::runtime_error>([&]()
+			{
+				MappedGrid<int, ColumnMajorLayout>::Open(file.path, MappedGridMode::ReadOnly);
+			});
+
+			//Flip a cell behind the header's back
+			{
+				std::fstream stream(file.path, std::ios::in | std::ios::out | std::ios::binary);
+				stream.seekp(MappedGridHeader::data_offset + 5 * sizeof(int));
+				int value = 4;
+				stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+			}
+
+			MappedIntGrid::Open(file.path, MappedGridMode::ReadOnly);
+			Assert::ExpectException<std::runtime_error>([&]() { MappedIntGrid::Open(file.path, MappedGridMode::ReadOnly, true); });
+
+			TemporaryGridFile missing("MappedGridTesting_Missing.grid");
+			Assert::ExpectException<std::system_error>([&]() { MappedIntGrid::Open(missing.path, MappedGridMode::ReadOnly); });
+		}
+
+		TEST_METHOD(CorruptOffsetsAndSizesAreRejected)
+		{
+			TemporaryGridFile file("MappedGridTesting_Corrupt.grid");
+
+			MappedIntGrid::Create(file.path, 8, 8, 3);
+
+			auto patch = [&](std::size_t offset, std::uint64_t value)
+			{
+				std::fstream stream(file.path, std::ios::in | std::ios::out | std::ios::binary);
+				stream.seekp(std::streamoff(offset));
+				stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+			};
+
+			//An offset that wraps the end of the cells around to inside the mapping
+			patch(offsetof(MappedGridHeader, dataOffset), ~std::uint64_t(0) - 255);
+			Assert::ExpectException<std::runtime_error>([&]() { MappedIntGrid::Open(file.path, MappedGridMode::ReadOnly); });
+
+			//Cells moved into the header
+			patch(offsetof(MappedGridHeader, dataOffset), 8);
+			Assert::ExpectException<std::runtime_error>([&]() { MappedIntGrid::Open(file.path, MappedGridMode::ReadOnly); });
+
+			patch(offsetof(MappedGridHeader, dataOffset), MappedGridHeader::data_offset);
+			MappedIntGrid::Open(file.path, MappedGridMode::ReadOnly);
+
+			patch(offsetof(MappedGridHeader, storageSize), std::uint64_t(1) << 62);
+			Assert::ExpectException<std::runtime_error>([&]() { MappedIntGrid::Open(file.path, MappedGridMode::ReadOnly); });
+			patch(offsetof(MappedGridHeader, storageSize), 64);
+
+			//Cut off the last cell
+			std::filesystem::resize_file(file.path, MappedGridHeader::data_offset + 63 * sizeof(int));
+			Assert::ExpectException<std::runtime_error>([&]() { MappedIntGrid::Open(file.path, MappedGridMode::ReadOnly); });
+		}
+
+		TEST_METHOD(WriteGridAndDetachOnResize)
+		{
+			typedef MappedGrid<float, PaddedRowMajorLayout<64>> MappedPaddedGrid;
+
+			TemporaryGridFile file("MappedGridTesting_Padded.grid");
+
+			MappedPaddedGrid::grid_type source(13, 7, 0.5f);
+			source.GetCell(12, 6) = 2.5f;
+
+			MappedPaddedGrid::Write(file.path, source);
+
+			MappedPaddedGrid mapped = MappedPaddedGrid::Open(file.path, MappedGridMode::CopyOnWrite, true);
+			MappedPaddedGrid::grid_type& grid = mapped.GetWritableGrid();
+
+			Assert::AreEqual(2.5f, grid.GetCell(12, 6));
+			Assert::AreEqual(0.5f, grid.GetCell(0, 0));
+
+			//Growing moves the cells into memory of the grid's own
+			const float* fileCell = &grid.GetCell(0, 0);
+			grid.ResizeGridPreserveData(20, 7, 1.0f);
+
+			Assert::IsTrue(fileCell != &grid.GetCell(0, 0));
+			Assert::AreEqual(2.5f, grid.GetCell(12, 6));
+			Assert::AreEqual(1.0f, grid.GetCell(19, 6));
+
+			MappedPaddedGrid::grid_type copy(grid);
+			Assert::AreEqual(2.5f, copy.GetCell(12, 6));
+		}
+	};
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+///Minimal stand-in for the Visual Studio CppUnitTestFramework so that the
+///TEST_CLASS / TEST_METHOD suites in GridTesting also build and run from CMake
+///on toolchains that do not ship CppUnitTest.h. Only the subset used by the
+///tests is provided. Failures throw AssertFailedException, which the runner in
+///CppUnitTestRunner.cpp reports.
+
+#include <cmath>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+	namespace VisualStudio
+	{
+		namespace CppUnitTestFramework
+		{
+			class AssertFailedException : public std::exception
+			{
+			public:
+				AssertFailedException(const std::string& Message)
+					:message(Message)
+				{
+
+				}
+
+				const char* what() const noexcept override
+				{
+					return this->message.c_str();
+				}
+
+			private:
+				std::string message;
+			};
+
+			class Assert
+			{
+			public:
+				template<typename T>
+				static void AreEqual(const T& expected, const T& actual, const wchar_t* message = nullptr)
+				{
+					if (!(expected == actual))
+						Fail("Assert::AreEqual failed", message);
+				}
+
+				static void AreEqual(double expected, double actual, double tolerance,
+					const wchar_t* message = nullptr)
+				{
+					if (std::fabs(expected - actual) > std::fabs(tolerance))
+						Fail("Assert::AreEqual failed", message);
+				}
+
+				template<typename T>
+				static void AreNotEqual(const T& notExpected, const T& actual, const wchar_t* message = nullptr)
+				{
+					if (notExpected == actual)
+						Fail("Assert::AreNotEqual failed", message);
+				}
+
+				template<typename T>
+				static void AreSame(const T& expected, const T& actual, const wchar_t* message = nullptr)
+				{
+					if (&expected != &actual)
+						Fail("Assert::AreSame failed", message);
+				}
+
+				template<typename T>
+				static void AreNotSame(const T& notExpected, const T& actual, const wchar_t* message = nullptr)
+				{
+					if (&notExpected == &actual)
+						Fail("Assert::AreNotSame failed", message);
+				}
+
+				static void IsTrue(bool condition, const wchar_t* message = nullptr)
+				{
+					if (!condition)
+						Fail("Assert::IsTrue failed", message);
+				}
+
+				static void IsFalse(bool condition, const wchar_t* message = nullptr)
+				{
+					if (condition)
+						Fail("Assert::IsFalse failed", message);
+				}
+
+				template<typename T>
+				static void IsNull(const T* actual, const wchar_t* message = nullptr)
+				{
+					if (actual != nullptr)
+						Fail("Assert::IsNull failed", message);
+				}
+
+				template<typename T>
+				static void IsNotNull(const T* actual, const wchar_t* message = nullptr)
+				{
+					if (actual == nullptr)
+						Fail("Assert::IsNotNull failed", message);
+				}
+
+				///Passes only if the functor throws Expected_Exception. Any other
+				///exception propagates to the runner and fails the test.
+				template<typename Expected_Exception, typename Functor>
+				static void ExpectException(Functor functor, const wchar_t* message = nullptr)
+				{
+					try
+					{
+						functor();
+					}
+					catch (const Expected_Exception&)
+					{
+						return;
+					}
+
+					Fail("Assert::ExpectException failed, nothing was thrown", message);
+				}
+
+				static void Fail(const wchar_t* message = nullptr)
+				{
+					Fail("Assert::Fail", message);
+				}
+
+			private:
+				static void Fail(const char* what, const wchar_t* message)
+				{
+					std::string text(what);
+
+					if (message)
+					{
+						text += ": ";
+
+						//Test messages are plain ASCII, a narrowing copy is enough
+						for (const wchar_t* character = message; *character; ++character)
+							text += static_cast<char>(*character);
+					}
+
+					throw AssertFailedException(text);
+				}
+			};
+
+			struct TestMethodInfo
+			{
+				const char* className;
+				const char* methodName;
+				void(*invoke)();
+			};
+
+			inline std::vector<TestMethodInfo>& GetRegisteredTests()
+			{
+				static std::vector<TestMethodInfo> tests;
+				return tests;
+			}
+
+			struct TestMethodRegistrar
+			{
+				TestMethodRegistrar(const char* className, const char* methodName, void(*invoke)())
+				{
+					GetRegisteredTests().push_back(TestMethodInfo{ className, methodName, invoke });
+				}
+			};
+
+			template<typename Test_Class, typename Test_Class_Name>
+			class TestClass
+			{
+			protected:
+				typedef Test_Class ThisClass;
+
+				static const char* GetTestClassName()
+				{
+					return Test_Class_Name::Get();
+				}
+			};
+		}
+	}
+}
+
+#define TEST_CLASS(className) \
+	struct className##_TestClassName { static const char* Get() { return #className; } }; \
+	class className : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className, className##_TestClassName>
+
+#define TEST_METHOD(methodName) \
+	static void methodName##_Invoke() { ThisClass instance; instance.methodName(); } \
+	inline static const ::Microsoft::VisualStudio::CppUnitTestFramework::TestMethodRegistrar methodName##_Registrar{ \
+		GetTestClassName(), #methodName, &methodName##_Invoke }; \
+	void methodName()
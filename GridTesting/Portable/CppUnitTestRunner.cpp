@@ -0,0 +1,49 @@
+// CppUnitTestRunner.cpp : Runs every TEST_METHOD registered through the portable
+// CppUnitTest.h. An optional argument restricts the run to tests whose
+// "Class::Method" name contains it.
+//
+
+#include "CppUnitTest.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+	using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+	const char* filter = argc > 1 ? argv[1] : nullptr;
+
+	int passed = 0;
+	int failed = 0;
+
+	for (const TestMethodInfo& test : GetRegisteredTests())
+	{
+		std::string name = std::string(test.className) + "::" + test.methodName;
+
+		if (filter && name.find(filter) == std::string::npos)
+			continue;
+
+		try
+		{
+			test.invoke();
+			std::cout << "[  PASSED  ] " << name << std::endl;
+			passed++;
+		}
+		catch (const std::exception& exception)
+		{
+			std::cout << "[  FAILED  ] " << name << " - " << exception.what() << std::endl;
+			failed++;
+		}
+		catch (...)
+		{
+			std::cout << "[  FAILED  ] " << name << " - unknown exception" << std::endl;
+			failed++;
+		}
+	}
+
+	std::cout << passed << " passed, " << failed << " failed" << std::endl;
+
+	return failed == 0 && passed > 0 ? 0 : 1;
+}
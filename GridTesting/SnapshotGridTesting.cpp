@@ -0,0 +1,149 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "SnapshotGrid.h"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(SnapshotGridTesting)
+	{
+	public:
+		typedef SnapshotGrid<int, 16> IntSnapshotGrid;
+
+		TEST_METHOD(SnapshotsDoNotSeeLaterWrites)
+		{
+			IntSnapshotGrid grid(100, 70, 3);
+
+			Assert::AreEqual(std::size_t(7), grid.GetChunkColumnCount());
+			Assert::AreEqual(std::size_t(5), grid.GetChunkRowCount());
+			Assert::AreEqual(3, grid.GetCell(99, 69));
+
+			grid.SetCell(20, 5, 1);
+			IntSnapshotGrid::snapshot_type before = grid.Snapshot();
+
+			grid.SetCell(20, 5, 2);
+			grid.GetCell(99, 69) = 4;
+
+			Assert::AreEqual(1, before.GetCell(20, 5));
+			Assert::AreEqual(3, before.GetCell(99, 69));
+			Assert::AreEqual(2, grid.GetCell(20, 5));
+			Assert::AreEqual(4, grid.GetCell(99, 69));
+
+			Assert::ExpectException<std::out_of_range>([&]() { grid.GetCell(100, 0); });
+			Assert::ExpectException<std::out_of_range>([&]() { before.GetCell(0, 70); });
+			Assert::ExpectException<std::invalid_argument>([&]() { grid.ResizeGrid(0, 4); });
+		}
+
+		TEST_METHOD(WritesCloneOnlyTheirChunk)
+		{
+			IntSnapshotGrid grid(64, 64, 0);
+
+			//Every chunk starts out as the same one
+			Assert::IsTrue(&grid.GetChunk(0, 0) == &grid.GetChunk(3, 3));
+
+			grid.ForEach(GridExecution::seq, [](int& cell) { cell = 5; });
+			Assert::IsFalse(grid.IsChunkShared(0, 0));
+
+			IntSnapshotGrid::snapshot_type snapshot = grid.Snapshot();
+			Assert::IsTrue(grid.IsChunkShared(1, 2));
+
+			grid.SetCell(17, 33, 9);
+
+			Assert::IsFalse(grid.IsChunkShared(1, 2));
+			Assert::IsTrue(&grid.GetChunk(1, 2) != &snapshot.GetChunk(1, 2));
+
+			for (unsigned chunkRow = 0; chunkRow < 4; chunkRow++)
+			{
+				for (unsigned chunkColumn = 0; chunkColumn < 4; chunkColumn++)
+				{
+					if (chunkColumn != 1 || chunkRow != 2)
+						Assert::IsTrue(&grid.GetChunk(chunkColumn, chunkRow) == &snapshot.GetChunk(chunkColumn, chunkRow));
+				}
+			}
+
+			//Copies of the grid share the same way
+			IntSnapshotGrid copy(grid);
+			copy.SetCell(0, 0, 1);
+			Assert::AreEqual(5, grid.GetCell(0, 0));
+			Assert::AreEqual(9, copy.GetCell(17, 33));
+		}
+
+		TEST_METHOD(ConvertsToAndFromGrid)
+		{
+			Grid<int, TiledLayout<8>> source(40, 30);
+
+			for (unsigned row = 0; row < 30; row++)
+			{
+				for (unsigned column = 0; column < 40; column++)
+					source.GetCell(column, row) = int(row * 40 + column);
+			}
+
+			IntSnapshotGrid grid(source);
+			grid.Fill(GridExecution::par, 0);
+			grid = IntSnapshotGrid(source);
+
+			Grid<int> copy;
+			grid.Snapshot().CopyTo(copy);
+
+			Assert::AreEqual(40, int(copy.GetColumnCount()));
+			Assert::AreEqual(30, int(copy.GetRowCount()));
+			Assert::AreEqual(1199, copy.GetCell(39, 29));
+			Assert::AreEqual(41, copy.GetCell(1, 1));
+		}
+
+		TEST_METHOD(ReadersSeeConsistentTicks)
+		{
+			//Every tick writes the tick number to all cells, a reader must never
+			//see two different values in one snapshot
+			IntSnapshotGrid grid(200, 150, 0);
+			std::atomic<bool> stop(false);
+			std::atomic<bool> torn(false);
+
+			GridSnapshot<int, 16> published = grid.Snapshot();
+			std::mutex publishMutex;
+
+			std::thread reader([&]()
+			{
+				while (!stop)
+				{
+					GridSnapshot<int, 16> snapshot;
+					{
+						std::lock_guard<std::mutex> lock(publishMutex);
+						snapshot = published;
+					}
+
+					int first = snapshot.GetCell(0, 0);
+
+					for (unsigned row = 0; row < 150; row += 7)
+					{
+						for (unsigned column = 0; column < 200; column += 3)
+						{
+							if (snapshot.GetCell(column, row) != first)
+								torn = true;
+						}
+					}
+				}
+			});
+
+			for (int tick = 1; tick <= 200; tick++)
+			{
+				grid.ForEach(GridExecution::seq, [tick](int& cell) { cell = tick; });
+
+				std::lock_guard<std::mutex> lock(publishMutex);
+				published = grid.Snapshot();
+			}
+
+			stop = true;
+			reader.join();
+
+			Assert::IsFalse(torn.load());
+			Assert::AreEqual(200, published.GetCell(199, 149));
+		}
+	};
+}
@@ -0,0 +1,135 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "SparseGrid.h"
+#include <cstdint>
+#include <memory_resource>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(SparseGridTesting)
+	{
+	public:
+		typedef SparseGrid<int, 16> IntSparseGrid;
+
+		TEST_METHOD(ReadsDoNotCreateChunks)
+		{
+			const IntSparseGrid grid(4000000, 3000000, -1);
+
+			Assert::AreEqual(-1, grid.GetCell(3999999, 2999999));
+			Assert::AreEqual(-1, grid[123456][654321]);
+			Assert::AreEqual(std::size_t(0), grid.GetChunkCount());
+			Assert::AreEqual(IntSparseGrid::size_type(4000000) * 3000000, grid.size());
+			Assert::IsTrue(&grid.GetCell(0, 0) == &grid.GetCell(1000, 1000), L"Missing chunks share the default");
+		}
+
+		TEST_METHOD(WritesCreateOneChunk)
+		{
+			IntSparseGrid grid(1000000, 1000000, 0);
+
+			grid.GetCell(500000, 700000) = 5;
+			grid[500001][700015] = 6;
+			grid.SetCell(500015, 700000, 7);
+
+			Assert::AreEqual(std::size_t(1), grid.GetChunkCount());
+			Assert::AreEqual(5, grid.GetCell(500000, 700000));
+			Assert::AreEqual(6, grid.GetCell(500001, 700015));
+			Assert::AreEqual(7, grid.GetCell(500015, 700000));
+			Assert::AreEqual(0, grid.GetCell(500002, 700000));
+
+			grid.SetCell(16, 16, 0);
+			Assert::AreEqual(std::size_t(1), grid.GetChunkCount(), L"Writing the default must not create a chunk");
+
+			grid.SetCell(16, 16, 1);
+			Assert::AreEqual(std::size_t(2), grid.GetChunkCount());
+		}
+
+		TEST_METHOD(IterationVisitsPopulatedCellsOnly)
+		{
+			//40 x 20 leaves partial chunks on the right and bottom edges
+			IntSparseGrid grid(40, 20, 0);
+
+			grid.SetCell(39, 19, 1);
+			grid.SetCell(0, 0, 2);
+
+			std::set<std::pair<unsigned, unsigned>> visited;
+			int sum = 0;
+
+			for (auto cell = grid.begin(); cell != grid.end(); ++cell)
+			{
+				visited.insert(std::make_pair(cell.GetColumn(), cell.GetRow()));
+				sum += *cell;
+			}
+
+			//One full 16 x 16 chunk and the 8 x 4 corner of another
+			Assert::AreEqual(std::size_t(256 + 32), visited.size());
+			Assert::AreEqual(3, sum);
+			Assert::IsTrue(visited.count(std::make_pair(39u, 19u)) == 1);
+			Assert::IsTrue(visited.count(std::make_pair(40u, 19u)) == 0);
+
+			std::size_t constCount = 0;
+			const IntSparseGrid& constGrid = grid;
+
+			for (const int& cell : constGrid)
+			{
+				(void)cell;
+				constCount++;
+			}
+
+			Assert::AreEqual(visited.size(), constCount);
+		}
+
+		TEST_METHOD(ChunkManagement)
+		{
+			IntSparseGrid grid(100, 100, 0);
+
+			grid.SetCell(5, 5, 1);
+			grid.SetCell(50, 50, 2);
+			grid.SetCell(90, 90, 3);
+
+			int chunks = 0;
+			grid.ForEachChunk([&](unsigned chunkColumn, unsigned chunkRow, const IntSparseGrid::chunk_type& chunk)
+			{
+				Assert::AreEqual(chunkColumn, chunkRow);
+				Assert::AreEqual(16, int(chunk.GetColumnCount()));
+				chunks++;
+			});
+			Assert::AreEqual(3, chunks);
+
+			grid.SetCell(5, 5, 0);
+			Assert::AreEqual(std::size_t(1), grid.ReleaseDefaultChunks());
+			Assert::IsTrue(grid.EraseChunk(3, 3));
+
+			const IntSparseGrid& readOnly = grid;
+			Assert::AreEqual(0, readOnly.GetCell(50, 50));
+			Assert::IsNotNull(grid.FindChunk(5, 5));
+
+			//Shrinking drops the chunk and growing back shows the default
+			grid.ResizeGrid(60, 60);
+			Assert::AreEqual(std::size_t(0), grid.GetChunkCount());
+			grid.ResizeGrid(100, 100);
+			Assert::AreEqual(0, readOnly.GetCell(90, 90));
+
+			Assert::ExpectException<std::out_of_range>([&]() { grid.GetCell(100, 0); });
+		}
+
+		TEST_METHOD(ChunksUseTheGridAllocator)
+		{
+			std::pmr::monotonic_buffer_resource arena;
+
+			SparseGrid<double, 8, RowMajorLayout, std::pmr::polymorphic_allocator<double>> grid(
+				1 << 20, 1 << 20, 0.5, &arena);
+
+			grid.SetCell(12345, 54321, 2.0);
+
+			Assert::IsTrue(grid.FindChunk(12345 / 8, 54321 / 8)->get_allocator().resource() == &arena);
+			Assert::AreEqual(2.0, grid.GetCell(12345, 54321));
+			Assert::AreEqual(0.5, grid.GetCell(12344, 54321));
+		}
+	};
+}
@@ -0,0 +1,92 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "StaticGrid.h"
+#include <numeric>
+#include <stdexcept>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	namespace
+	{
+		constexpr StaticGrid<int, 3, 3> BlurKernel{ 1, 2, 1, 2, 4, 2, 1, 2, 1 };
+
+		constexpr int KernelTotal()
+		{
+			int total = 0;
+
+			for (int weight : BlurKernel)
+				total += weight;
+
+			return total;
+		}
+
+		constexpr StaticGrid<int, 4, 2> MakeDiagonal()
+		{
+			StaticGrid<int, 4, 2> grid(7);
+			grid.GetCell(1, 1) = 3;
+			grid[2][0] = 5;
+			return grid;
+		}
+
+		static_assert(BlurKernel.GetCell<1, 1>() == 4, "Compile time access");
+		static_assert(BlurKernel[2][1] == 2, "Compile time indexer");
+		static_assert(KernelTotal() == 16, "Compile time iteration");
+		static_assert(MakeDiagonal().GetCell(1, 1) == 3 && MakeDiagonal().GetCell(2, 0) == 5, "Compile time writes");
+		static_assert(StaticGrid<int, 4, 2>::GetOneDimensionIndex(3, 1) == 7, "Row major");
+		static_assert(sizeof(StaticGrid<std::uint8_t, 8, 8>) == 64, "Storage is inline");
+	}
+
+	TEST_CLASS(StaticGridTesting)
+	{
+	public:
+		TEST_METHOD(AccessMatchesGrid)
+		{
+			StaticGrid<int, 8, 8> board;
+			Assert::AreEqual(0, board.GetCell(7, 7));
+
+			board.GetCell(3, 4) = 12;
+			board[5][6] = 30;
+
+			Assert::AreEqual(12, board[3][4]);
+			Assert::AreEqual(30, board.GetCell<5, 6>());
+			Assert::AreEqual(42, std::accumulate(board.begin(), board.end(), 0));
+			Assert::AreEqual(std::size_t(64), board.size());
+
+			board.Fill(1);
+			Assert::AreEqual(64, std::accumulate(board.cbegin(), board.cend(), 0));
+
+			Assert::ExpectException<std::out_of_range>([&]() { board.GetCell(8, 0); });
+			Assert::ExpectException<std::out_of_range>([&]() { board.GetCell(0, 8); });
+			Assert::ExpectException<std::out_of_range>([&]() { board[8][0]; });
+			Assert::ExpectException<std::out_of_range>([&]() { board[0][8]; });
+		}
+
+		TEST_METHOD(ConvertsToAndFromGrid)
+		{
+			StaticGrid<int, 4, 2> source = MakeDiagonal();
+
+			Grid<int, ColumnMajorLayout> dynamic = source.ToGrid<Grid<int, ColumnMajorLayout>>();
+			Assert::AreEqual(4, int(dynamic.GetColumnCount()));
+			Assert::AreEqual(3, dynamic.GetCell(1, 1));
+			Assert::AreEqual(5, dynamic.GetCell(2, 0));
+
+			dynamic.GetCell(3, 1) = 9;
+			StaticGrid<int, 4, 2> back = StaticGrid<int, 4, 2>::FromGrid(dynamic);
+			Assert::AreEqual(9, back.GetCell(3, 1));
+			Assert::IsTrue(back != source);
+
+			back.GetCell(3, 1) = 7;
+			Assert::IsTrue(back == source);
+
+			//The view writes straight into the static cells
+			Grid<int> view = source.AsGrid();
+			view.GetCell(0, 1) = 11;
+			Assert::AreEqual(11, source.GetCell(0, 1));
+
+			Assert::ExpectException<std::invalid_argument>([&]() { StaticGrid<int, 3, 2>::FromGrid(dynamic); });
+		}
+	};
+}
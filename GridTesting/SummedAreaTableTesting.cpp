@@ -0,0 +1,146 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "SummedAreaTable.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(SummedAreaTableTesting)
+	{
+	public:
+		template<typename Grid_Type>
+		static std::int64_t NaiveSum(const Grid_Type& grid, unsigned firstColumn, unsigned firstRow,
+			unsigned lastColumn, unsigned lastRow)
+		{
+			std::int64_t sum = 0;
+
+			for (unsigned row = firstRow; row <= lastRow; row++)
+			{
+				for (unsigned column = firstColumn; column <= lastColumn; column++)
+					sum += grid.GetCell(column, row);
+			}
+
+			return sum;
+		}
+
+		TEST_METHOD(RectangleQueriesMatchLoops)
+		{
+			std::mt19937 random(12);
+			Grid<int, TiledLayout<8>> grid(97, 61);
+
+			for (int& cell : grid)
+				cell = int(random() % 2001) - 1000;
+
+			SummedAreaTable<int> table(grid);
+
+			for (int query = 0; query < 500; query++)
+			{
+				unsigned firstColumn = random() % 97;
+				unsigned firstRow = random() % 61;
+				unsigned lastColumn = firstColumn + random() % (97 - firstColumn);
+				unsigned lastRow = firstRow + random() % (61 - firstRow);
+
+				std::int64_t expected = NaiveSum(grid, firstColumn, firstRow, lastColumn, lastRow);
+
+				Assert::AreEqual(expected, table.Sum(firstColumn, firstRow, lastColumn, lastRow));
+				Assert::AreEqual(std::uint64_t(lastColumn - firstColumn + 1) * (lastRow - firstRow + 1),
+					table.Count(firstColumn, firstRow, lastColumn, lastRow));
+				Assert::AreEqual(double(expected) / double(table.Count(firstColumn, firstRow, lastColumn, lastRow)),
+					table.Mean(firstColumn, firstRow, lastColumn, lastRow), 1e-9);
+			}
+
+			Assert::AreEqual(NaiveSum(grid, 0, 0, 96, 60), table.Total());
+			Assert::AreEqual(grid.GetCell(5, 7), int(table.Sum(5, 7, 5, 7)));
+
+			//Row major sources are read a row at a time instead of cell by cell
+			Grid<int> rowMajor(97, 61);
+			for (unsigned row = 0; row < 61; row++)
+			{
+				for (unsigned column = 0; column < 97; column++)
+					rowMajor.GetCell(column, row) = grid.GetCell(column, row);
+			}
+
+			SummedAreaTable<int> rowMajorTable(rowMajor);
+			Assert::IsTrue(std::equal(table.GetTable().begin(), table.GetTable().end(), rowMajorTable.GetTable().begin()));
+
+			Assert::ExpectException<std::out_of_range>([&]() { table.Sum(0, 0, 97, 0); });
+			Assert::ExpectException<std::invalid_argument>([&]() { table.Sum(5, 0, 4, 0); });
+		}
+
+		TEST_METHOD(AccumulatorsDoNotOverflow)
+		{
+			Grid<int> grid(300, 200, INT_MAX);
+			SummedAreaTable<int> table(grid);
+
+			Assert::AreEqual(std::int64_t(INT_MAX) * 300 * 200, table.Total());
+
+			Grid<std::uint8_t> bytes(1000, 1000, 255);
+			Assert::AreEqual(std::uint64_t(255) * 1000 * 1000, SummedAreaTable<std::uint8_t>(bytes).Total());
+		}
+
+		TEST_METHOD(ParallelBuildMatchesSequential)
+		{
+			std::mt19937 random(3);
+			Grid<float> grid(3000, 90);
+
+			for (float& cell : grid)
+				cell = float(random() % 1000) / 7.0f;
+
+			SummedAreaTable<float> sequential(GridExecution::seq, grid);
+
+			GridThreadPool pool(4);
+			SummedAreaTable<float> parallel(GridExecution::par.On(pool), grid);
+
+			for (unsigned row = 0; row <= 90; row++)
+			{
+				for (unsigned column = 0; column <= 3000; column++)
+				{
+					Assert::IsTrue(sequential.GetTable().GetCell(column, row) == parallel.GetTable().GetCell(column, row),
+						L"Parallel construction must match bit for bit");
+				}
+			}
+		}
+
+		TEST_METHOD(UpdateMatchesRebuild)
+		{
+			std::mt19937 random(8);
+			Grid<int> grid(64, 48);
+
+			for (int& cell : grid)
+				cell = int(random() % 10);
+
+			//Counts cells above 5, a query like "how many walls in this room"
+			auto aboveFive = [](int cell) { return std::int64_t(cell > 5); };
+
+			SummedAreaTable<int> table;
+			table.Build(GridExecution::seq, grid, aboveFive);
+
+			for (unsigned row = 20; row <= 30; row++)
+			{
+				for (unsigned column = 40; column <= 50; column++)
+					grid.GetCell(column, row) = 9;
+			}
+
+			table.Update(grid, 40, 20, 50, 30, aboveFive);
+
+			SummedAreaTable<int> rebuilt;
+			rebuilt.Build(GridExecution::seq, grid, aboveFive);
+
+			for (unsigned row = 0; row <= 48; row++)
+			{
+				for (unsigned column = 0; column <= 64; column++)
+					Assert::AreEqual(rebuilt.GetTable().GetCell(column, row), table.GetTable().GetCell(column, row));
+			}
+
+			Assert::AreEqual(std::int64_t(121), table.Sum(40, 20, 50, 30));
+			Assert::ExpectException<std::invalid_argument>([&]() { table.Update(Grid<int>(10, 10), 0, 0, 1, 1); });
+		}
+	};
+}
@@ -0,0 +1,118 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "TrackedGrid.h"
+#include <stdexcept>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace GridTesting
+{
+	TEST_CLASS(TrackedGridTesting)
+	{
+	public:
+		typedef TrackedGrid<Grid<int>, 16> TrackedIntGrid;
+
+		static void AssertRect(const GridDirtyRect& rect, unsigned column, unsigned row, unsigned columns, unsigned rows)
+		{
+			Assert::IsTrue(rect == GridDirtyRect{ column, row, columns, rows });
+		}
+
+		TEST_METHOD(WritesMarkTheirTile)
+		{
+			TrackedIntGrid grid(100, 70, 0);
+			Assert::IsFalse(grid.IsDirty());
+
+			grid.SetCell(20, 5, 1);
+			grid.Modify(21, 6) += 2;
+
+			Assert::IsTrue(grid.IsTileDirty(1, 0));
+			Assert::AreEqual(2, grid.GetCell(21, 6));
+
+			std::vector<GridDirtyRect> dirty = grid.ConsumeDirty();
+
+			Assert::AreEqual(std::size_t(1), dirty.size());
+			AssertRect(dirty[0], 16, 0, 16, 16);
+
+			Assert::IsFalse(grid.IsDirty());
+			Assert::AreEqual(std::size_t(0), grid.ConsumeDirty().size());
+
+			Assert::ExpectException<std::out_of_range>([&]() { grid.SetCell(100, 0, 1); });
+			Assert::ExpectException<std::out_of_range>([&]() { grid.MarkDirty(90, 0, 11, 1); });
+		}
+
+		TEST_METHOD(TilesMergeIntoRectangles)
+		{
+			//7 x 5 tiles, the last column and row clipped to 4 and 6 cells
+			TrackedIntGrid grid(100, 70, 0);
+
+			//A 3 x 2 block of tiles, one rectangle
+			grid.MarkDirty(16, 16, 48, 32);
+
+			//An L: two tiles across, then one below the left one
+			grid.SetCell(0, 64, 1);
+			grid.SetCell(16, 64, 1);
+
+			//The clipped corner tile
+			grid.SetCell(99, 69, 1);
+
+			std::vector<GridDirtyRect> dirty;
+			grid.ConsumeDirty(dirty);
+
+			Assert::AreEqual(std::size_t(3), dirty.size());
+			AssertRect(dirty[0], 16, 16, 48, 32);
+			AssertRect(dirty[1], 0, 64, 32, 6);
+			AssertRect(dirty[2], 96, 64, 4, 6);
+
+			grid.SetCell(0, 0, 1);
+			grid.SetCell(0, 16, 1);
+			grid.SetCell(16, 16, 1);
+			grid.ConsumeDirty(dirty);
+
+			Assert::AreEqual(std::size_t(2), dirty.size());
+			AssertRect(dirty[0], 0, 0, 16, 16);
+			AssertRect(dirty[1], 0, 16, 32, 16);
+		}
+
+		TEST_METHOD(RegionAndBulkWrites)
+		{
+			TrackedGrid<Grid<int, TiledLayout<8>>> grid(300, 200, 0);
+
+			grid.ModifyRegion(40, 40, 10, 10, [](unsigned column, unsigned row, int& cell)
+			{
+				cell = int(column + row);
+			});
+
+			Assert::AreEqual(98, grid.GetCell(49, 49));
+
+			std::vector<GridDirtyRect> dirty = grid.ConsumeDirty();
+			Assert::AreEqual(std::size_t(1), dirty.size());
+			AssertRect(dirty[0], 32, 32, 32, 32);
+
+			grid.Fill(GridExecution::par, 4);
+			dirty = grid.ConsumeDirty();
+			Assert::AreEqual(std::size_t(1), dirty.size());
+			AssertRect(dirty[0], 0, 0, 300, 200);
+
+			grid.ResizeGrid(10, 10, 1);
+			dirty = grid.ConsumeDirty();
+			Assert::AreEqual(std::size_t(1), dirty.size());
+			AssertRect(dirty[0], 0, 0, 10, 10);
+		}
+
+		TEST_METHOD(WideGridsSpanSeveralWords)
+		{
+			//More than 64 tiles per tile row
+			TrackedGrid<Grid<std::uint8_t>, 1> grid(200, 3, 0);
+
+			grid.MarkDirty(60, 1, 80, 1);
+			grid.SetCell(199, 1, 1);
+
+			std::vector<GridDirtyRect> dirty = grid.ConsumeDirty();
+			Assert::AreEqual(std::size_t(2), dirty.size());
+			AssertRect(dirty[0], 60, 1, 80, 1);
+			AssertRect(dirty[1], 199, 1, 1, 1);
+		}
+	};
+}
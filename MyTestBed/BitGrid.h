@@ -0,0 +1,452 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace BitGridDetail
+{
+	inline int PopCount(std::uint64_t word)
+	{
+#if defined(_MSC_VER)
+		return int(__popcnt64(word));
+#else
+		return __builtin_popcountll(word);
+#endif
+	}
+
+	///Index of the lowest set bit, word must not be 0
+	inline int CountTrailingZeros(std::uint64_t word)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return int(index);
+#else
+		return __builtin_ctzll(word);
+#endif
+	}
+}
+
+///Grid of 1, 2 or 4 bit cells packed into 64 bit words, for masks (occupancy,
+///visibility) and small counters that would waste a byte per cell in a Grid.
+///Every row starts on a fresh word and the bits past the last column of a row
+///are always 0, so the whole grid operations below work a word, 64 / Bits_Per_Cell
+///cells, at a time.
+///
+///Cells read as value_type, bool for single bits. The non-const GetCell and the
+///indexer return a CellReference proxy; only the low Bits_Per_Cell bits of a
+///written value are kept.
+template<std::size_t Bits_Per_Cell = 1>
+class BitGrid
+{
+	static_assert(Bits_Per_Cell == 1 || Bits_Per_Cell == 2 || Bits_Per_Cell == 4,
+		"Bits_Per_Cell must be 1, 2 or 4");
+
+public:
+	typedef typename std::conditional<Bits_Per_Cell == 1, bool, std::uint8_t>::type value_type;
+	typedef std::uint32_t dimension_type;
+	typedef std::uint64_t size_type;
+	typedef std::uint64_t word_type;
+
+	static constexpr std::size_t bits_per_cell = Bits_Per_Cell;
+	static constexpr std::size_t cells_per_word = 64 / Bits_Per_Cell;
+
+	///The bits of one cell, and bit 0 of every cell of a word
+	static constexpr word_type cell_mask = (word_type(1) << Bits_Per_Cell) - 1;
+	static constexpr word_type low_bits = ~word_type(0) / cell_mask;
+
+	class CellReference
+	{
+	public:
+		CellReference(word_type& _word, unsigned _shift)
+			:word(&_word), shift(_shift)
+		{
+
+		}
+
+		operator value_type() const
+		{
+			return value_type((*this->word >> this->shift) & cell_mask);
+		}
+
+		const CellReference& operator=(value_type value) const
+		{
+			*this->word = (*this->word & ~(cell_mask << this->shift)) | ((word_type(value) & cell_mask) << this->shift);
+			return *this;
+		}
+
+		const CellReference& operator=(const CellReference& source) const
+		{
+			return *this = value_type(source);
+		}
+
+	private:
+		word_type* word;
+		unsigned shift;
+	};
+
+	typedef CellReference reference;
+
+	template <typename Grid_Type, typename Reference_Type>
+	class _Indexer
+	{
+		dimension_type columnIndex;
+		Grid_Type& data;
+
+	public:
+		_Indexer(dimension_type ColumnIndex, Grid_Type& Data)
+			: columnIndex(ColumnIndex), data(Data)
+		{
+
+		}
+
+		Reference_Type operator[](dimension_type RowIndex) const
+		{
+			return data.GetCell(columnIndex, RowIndex);
+		}
+	};
+
+	typedef _Indexer<BitGrid, reference> indexer;
+	typedef _Indexer<const BitGrid, value_type> const_indexer;
+
+	BitGrid()
+		:columnCount(0), rowCount(0), wordsPerRow(0)
+	{
+
+	}
+
+	BitGrid(dimension_type _columnCount, dimension_type _rowCount, value_type initVal = value_type())
+		:columnCount(0), rowCount(0), wordsPerRow(0)
+	{
+		ResizeGrid(_columnCount, _rowCount, initVal);
+	}
+
+	const_indexer operator [](dimension_type index)const
+	{
+		return const_indexer(index, *this);
+	}
+
+	indexer operator [](dimension_type index)
+	{
+		return indexer(index, *this);
+	}
+
+	value_type GetCell(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		CheckBounds(columnIndex, rowIndex);
+
+		return value_type((this->words[WordIndex(columnIndex, rowIndex)] >> CellShift(columnIndex)) & cell_mask);
+	}
+
+	reference GetCell(dimension_type columnIndex, dimension_type rowIndex)
+	{
+		CheckBounds(columnIndex, rowIndex);
+
+		return reference(this->words[WordIndex(columnIndex, rowIndex)], CellShift(columnIndex));
+	}
+
+	void SetCell(dimension_type columnIndex, dimension_type rowIndex, value_type value)
+	{
+		GetCell(columnIndex, rowIndex) = value;
+	}
+
+	void Fill(value_type value)
+	{
+		std::fill(this->words.begin(), this->words.end(), (word_type(value) & cell_mask) * low_bits);
+		ClearRowTails();
+	}
+
+	///Resets every cell to initVal with the new dimensions
+	void ResizeGrid(dimension_type newColumnCount, dimension_type newRowCount, value_type initVal = value_type())
+	{
+		if (newRowCount == 0 || newColumnCount == 0)
+			throw std::invalid_argument("Dimension cannot be 0");
+
+		this->columnCount = newColumnCount;
+		this->rowCount = newRowCount;
+		this->wordsPerRow = (std::size_t(newColumnCount) + cells_per_word - 1) / cells_per_word;
+
+		this->words.assign(this->wordsPerRow * newRowCount, 0);
+		Fill(initVal);
+	}
+
+	///Cell wise bitwise operations with a grid of the same dimensions
+	BitGrid& And(const BitGrid& other)
+	{
+		return CombineWith(other, [](word_type left, word_type right) { return left & right; });
+	}
+
+	BitGrid& Or(const BitGrid& other)
+	{
+		return CombineWith(other, [](word_type left, word_type right) { return left | right; });
+	}
+
+	BitGrid& Xor(const BitGrid& other)
+	{
+		return CombineWith(other, [](word_type left, word_type right) { return left ^ right; });
+	}
+
+	///Clears every cell set in other
+	BitGrid& AndNot(const BitGrid& other)
+	{
+		return CombineWith(other, [](word_type left, word_type right) { return left & ~right; });
+	}
+
+	///Flips every bit, a cell becomes cell_mask - cell
+	BitGrid& Not()
+	{
+		for (word_type& word : this->words)
+			word = ~word;
+
+		ClearRowTails();
+		return *this;
+	}
+
+	///Number of cells that are not 0
+	size_type Count() const
+	{
+		size_type count = 0;
+
+		for (word_type word : this->words)
+			count += size_type(BitGridDetail::PopCount(NonZeroCells(word)));
+
+		return count;
+	}
+
+	///Finds the first cell that is not 0, row by row. Returns false and leaves the
+	///arguments alone when there is none.
+	bool FindFirstSet(dimension_type& column, dimension_type& row) const
+	{
+		for (std::size_t index = 0; index < this->words.size(); index++)
+		{
+			word_type cells = NonZeroCells(this->words[index]);
+
+			if (cells == 0)
+				continue;
+
+			row = dimension_type(index / this->wordsPerRow);
+			column = dimension_type((index % this->wordsPerRow) * cells_per_word +
+				BitGridDetail::CountTrailingZeros(cells) / Bits_Per_Cell);
+			return true;
+		}
+
+		return false;
+	}
+
+	///Moves every cell by (columnOffset, rowOffset). Cells moved past the edge are
+	///lost, the ones uncovered become 0.
+	void Shift(std::ptrdiff_t columnOffset, std::ptrdiff_t rowOffset)
+	{
+		std::vector<word_type> shifted(this->words.size(), 0);
+		std::ptrdiff_t bitOffset = columnOffset * std::ptrdiff_t(Bits_Per_Cell);
+
+		for (std::ptrdiff_t row = 0; row < std::ptrdiff_t(this->rowCount); row++)
+		{
+			std::ptrdiff_t sourceRow = row - rowOffset;
+
+			if (sourceRow < 0 || sourceRow >= std::ptrdiff_t(this->rowCount))
+				continue;
+
+			ShiftRow(&this->words[std::size_t(sourceRow) * this->wordsPerRow],
+				&shifted[std::size_t(row) * this->wordsPerRow], bitOffset);
+		}
+
+		this->words.swap(shifted);
+		ClearRowTails();
+	}
+
+	///Sets every cell with a set cell among its 8 neighbours
+	void Dilate()
+	{
+		static_assert(Bits_Per_Cell == 1, "Dilate needs single bit cells");
+
+		ApplyNeighbourhood([](word_type left, word_type centre, word_type right) { return left | centre | right; });
+	}
+
+	///Clears every cell with a clear cell among its 8 neighbours, cells outside
+	///the grid counting as clear
+	void Erode()
+	{
+		static_assert(Bits_Per_Cell == 1, "Erode needs single bit cells");
+
+		ApplyNeighbourhood([](word_type left, word_type centre, word_type right) { return left & centre & right; });
+	}
+
+	inline dimension_type GetColumnCount()const
+	{
+		return this->columnCount;
+	}
+
+	inline dimension_type GetRowCount()const
+	{
+		return this->rowCount;
+	}
+
+	///Words per row, every row starting on a fresh one
+	inline std::size_t GetWordsPerRow()const
+	{
+		return this->wordsPerRow;
+	}
+
+	inline const word_type* GetWords()const
+	{
+		return this->words.data();
+	}
+
+	inline bool isEmpty()const
+	{
+		return !(this->rowCount > 0 && this->columnCount > 0);
+	}
+
+	inline size_type size()const
+	{
+		return size_type(this->columnCount) * this->rowCount;
+	}
+
+	inline void swap(BitGrid& inGrid)
+	{
+		std::swap(*this, inGrid);
+	}
+
+	friend bool operator==(const BitGrid& left, const BitGrid& right)
+	{
+		return left.columnCount == right.columnCount && left.rowCount == right.rowCount && left.words == right.words;
+	}
+
+	friend bool operator!=(const BitGrid& left, const BitGrid& right)
+	{
+		return !(left == right);
+	}
+
+protected:
+	dimension_type columnCount;
+	dimension_type rowCount;
+	std::size_t wordsPerRow;
+
+	std::vector<word_type> words;
+
+	inline void CheckBounds(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		if (columnIndex >= this->columnCount || rowIndex >= this->rowCount)
+			throw std::out_of_range("BitGrid-GetCell Arguments Out of Range");
+	}
+
+	inline std::size_t WordIndex(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		return std::size_t(rowIndex) * this->wordsPerRow + columnIndex / cells_per_word;
+	}
+
+	static inline unsigned CellShift(dimension_type columnIndex)
+	{
+		return unsigned(columnIndex % cells_per_word * Bits_Per_Cell);
+	}
+
+	///Bit 0 of each cell of word set when the cell is not 0
+	static inline word_type NonZeroCells(word_type word)
+	{
+		for (std::size_t shift = 1; shift < Bits_Per_Cell; shift <<= 1)
+			word |= word >> shift;
+
+		return word & low_bits;
+	}
+
+	///Bits of the last word of a row that belong to cells
+	inline word_type GetRowTailMask() const
+	{
+		std::size_t tailBits = (this->columnCount - (this->wordsPerRow - 1) * cells_per_word) * Bits_Per_Cell;
+
+		return tailBits == 64 ? ~word_type(0) : (word_type(1) << tailBits) - 1;
+	}
+
+	void ClearRowTails()
+	{
+		word_type tailMask = GetRowTailMask();
+
+		for (std::size_t row = 0; row < this->rowCount; row++)
+			this->words[(row + 1) * this->wordsPerRow - 1] &= tailMask;
+	}
+
+	template<typename Combine_Function>
+	BitGrid& CombineWith(const BitGrid& other, Combine_Function combine)
+	{
+		if (other.columnCount != this->columnCount || other.rowCount != this->rowCount)
+			throw std::invalid_argument("BitGrid dimensions differ");
+
+		for (std::size_t index = 0; index < this->words.size(); index++)
+			this->words[index] = combine(this->words[index], other.words[index]);
+
+		return *this;
+	}
+
+	///Writes source moved bitOffset bits towards the end of the row into
+	///destination, bits coming from outside the row are 0
+	void ShiftRow(const word_type* source, word_type* destination, std::ptrdiff_t bitOffset) const
+	{
+		std::ptrdiff_t words = std::ptrdiff_t(this->wordsPerRow);
+		std::ptrdiff_t wordOffset = bitOffset >= 0 ? bitOffset / 64 : -((-bitOffset + 63) / 64);
+		unsigned bitShift = unsigned(bitOffset - wordOffset * 64);
+
+		auto sourceWord = [&](std::ptrdiff_t index)
+		{
+			return index >= 0 && index < words ? source[index] : word_type(0);
+		};
+
+		for (std::ptrdiff_t index = 0; index < words; index++)
+		{
+			word_type word = sourceWord(index - wordOffset) << bitShift;
+
+			if (bitShift != 0)
+				word |= sourceWord(index - wordOffset - 1) >> (64 - bitShift);
+
+			destination[index] = word;
+		}
+	}
+
+	///Combines each cell with its left and right neighbours a row at a time, then
+	///each row with the ones above and below, through the same function
+	template<typename Combine_Function>
+	void ApplyNeighbourhood(Combine_Function combine)
+	{
+		std::vector<word_type> horizontal(this->words.size());
+		word_type tailMask = GetRowTailMask();
+
+		for (std::size_t row = 0; row < this->rowCount; row++)
+		{
+			const word_type* source = &this->words[row * this->wordsPerRow];
+			word_type* destination = &horizontal[row * this->wordsPerRow];
+
+			for (std::size_t index = 0; index < this->wordsPerRow; index++)
+			{
+				word_type previous = index > 0 ? source[index - 1] : 0;
+				word_type next = index + 1 < this->wordsPerRow ? source[index + 1] : 0;
+
+				//Cell c's left neighbour moved up into bit c, its right one down
+				word_type left = (source[index] << 1) | (previous >> 63);
+				word_type right = (source[index] >> 1) | (next << 63);
+
+				destination[index] = combine(left, source[index], right);
+			}
+
+			destination[this->wordsPerRow - 1] &= tailMask;
+		}
+
+		for (std::size_t row = 0; row < this->rowCount; row++)
+		{
+			for (std::size_t index = 0; index < this->wordsPerRow; index++)
+			{
+				word_type above = row > 0 ? horizontal[(row - 1) * this->wordsPerRow + index] : 0;
+				word_type below = row + 1 < this->rowCount ? horizontal[(row + 1) * this->wordsPerRow + index] : 0;
+
+				this->words[row * this->wordsPerRow + index] = combine(above, horizontal[row * this->wordsPerRow + index], below);
+			}
+		}
+	}
+};
@@ -1,177 +1,495 @@
 #pragma once
-#include <limits>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "GridAccess.h"
+#include "GridExecution.h"
+#include "GridIterators.h"
+#include "GridLayouts.h"
+
+///Passed to Grid's constructor or ResizeGrid to skip initialising the cells of
+///trivial types. The cells hold indeterminate values until written.
+struct GridNoInitTag
+{
+
+};
+
+inline constexpr GridNoInitTag GridNoInit{};
+
+///Passed to Grid's constructor to view cells that live in storage owned by
+///someone else, such as a file mapping (see MappedGrid.h)
+struct GridExternalStorageTag
+{
 
-template<typename Data_Type>
+};
+
+inline constexpr GridExternalStorageTag GridExternalStorage{};
+
+///Layout_Type decides where each cell lives in memory (see GridLayouts.h). Every
+///accessor, the iterators and ResizeGridPreserveData go through it, so changing
+///the layout does not change any call site. Iterators walk the cells in storage
+///order, which is only row by row for the default RowMajorLayout.
+///
+///All storage is obtained from Allocator_Type through std::allocator_traits, so
+///pool, arena and PMR allocators work (see PmrGrid below).
+///
+///Dimension_Type is the type of a column or row count. The default 16 bits caps
+///a grid at 65535 x 65535; std::uint32_t or std::uint64_t lift that (see
+///LargeGrid below) and size_type widens to 64 bits with them.
+///
+///Access_Policy decides what an out of range GetCell, operator[] or iterator
+///access does (see GridAccess.h): throw with GridCheckedAccess, assert with
+///GridAssertedAccess, nothing with GridUncheckedAccess (see UncheckedGrid below).
+///The bulk operations index their own storage and never pay for it.
+template<typename Data_Type, typename Layout_Type = RowMajorLayout,
+	typename Allocator_Type = std::allocator<Data_Type>, typename Dimension_Type = std::uint16_t,
+	typename Access_Policy = GridDefaultAccess>
 class Grid
 {
+	static_assert(!Layout_Type::has_padding || Layout_Type::contiguous_rows,
+		"Padded layouts must keep rows contiguous");
+	static_assert(std::is_integral<Dimension_Type>::value && std::is_unsigned<Dimension_Type>::value,
+		"Dimension_Type must be an unsigned integer");
+
+	typedef std::allocator_traits<Allocator_Type> allocator_traits;
+
 public:
 	///The following are required to be 'accepted' in the STL
 	typedef Data_Type value_type;
 	typedef Data_Type& reference;
 	typedef const Data_Type& const_reference;
 
-	///We specify int32 because it is just barely large enough to 
-	///hold the product of row * column if both are int16. Size_t can be
-	///different size on different architecture, so we specify here
-	typedef unsigned __int32 size_type;
-	typedef unsigned __int16 dimension_type;
+	///Wide enough to hold the product of row * column: 32 bits for 16 bit
+	///dimensions, 64 bits otherwise. Size_t can be different size on different
+	///architecture, so we specify here
+	typedef typename std::conditional<(sizeof(Dimension_Type) <= 2),
+		std::uint32_t, std::uint64_t>::type size_type;
+	typedef Dimension_Type dimension_type;
+
+	typedef std::ptrdiff_t difference_type;
+
+	typedef Layout_Type layout_type;
+	typedef Allocator_Type allocator_type;
+	typedef Access_Policy access_policy;
+
+	///Iterator over the storage of hole free layouts. Random access, and a
+	///contiguous iterator for C++20 algorithms and ranges. When Access_Policy
+	///checks, dereferencing tests the address against the storage; otherwise the
+	///bounds are an empty base and the iterator is a pointer in size and code.
+	///Moving it never checks. Bulk copies that want memmove take data() or GetRow.
+	template <typename Iterator_Data_Type>
+	class GridIterator : public GridIteratorBounds<Access_Policy, Iterator_Data_Type>
+	{
+		typedef GridIteratorBounds<Access_Policy, Iterator_Data_Type> bounds_type;
 
-	typedef ptrdiff_t difference_type;
+		template <typename Other_Data_Type>
+		friend class GridIterator;
 
-	template <typename Data_Type>
-	class GridIterator : public std::iterator<std::random_access_iterator_tag, Data_Type>
-	{
 	public:
-		GridIterator(Data_Type* val_ref)
-			:valRef(val_ref)
+		typedef std::random_access_iterator_tag iterator_category;
+#if defined(__cpp_lib_concepts)
+		typedef std::contiguous_iterator_tag iterator_concept;
+#endif
+		typedef typename std::remove_const<Iterator_Data_Type>::type value_type;
+		typedef Iterator_Data_Type element_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Iterator_Data_Type* pointer;
+		typedef Iterator_Data_Type& reference;
+
+		GridIterator()
+			:bounds_type(nullptr, nullptr), valRef(nullptr)
+		{
+
+		}
+
+		///first and last bound the storage, for policies that check
+		GridIterator(Iterator_Data_Type* val_ref, Iterator_Data_Type* first, Iterator_Data_Type* last)
+			:bounds_type(first, last), valRef(val_ref)
 		{
 
 		}
 
-		~GridIterator()
+		///An iterator converts to a const_iterator
+		template <typename Other_Data_Type, typename = typename std::enable_if<
+			std::is_same<const Other_Data_Type, Iterator_Data_Type>::value>::type>
+		GridIterator(const GridIterator<Other_Data_Type>& other)
+			:bounds_type(other), valRef(other.valRef)
 		{
-			//Nothing to delete. We are only referencing memory owned by others
+
 		}
 
-		Data_Type& operator*()const
+		reference operator*()const
 		{
+			this->CheckAddress(this->valRef);
 			return *this->valRef;
 		}
 
-		Data_Type* operator->()const
+		pointer operator->()const
 		{
+			this->CheckAddress(this->valRef);
 			return this->valRef;
 		}
 
-		reference operator[](unsigned short index)
+		reference operator[](difference_type index)const
 		{
+			this->CheckAddress(this->valRef + index);
 			return this->valRef[index];
 		}
 
-		GridIterator<Data_Type>& operator++()
+		GridIterator& operator++()
+		{
+			++this->valRef;
+			return *this;
+		}
+
+		GridIterator operator++(int)
+		{
+			GridIterator previous(*this);
+			++this->valRef;
+			return previous;
+		}
+
+		GridIterator& operator--()
+		{
+			--this->valRef;
+			return *this;
+		}
+
+		GridIterator operator--(int)
+		{
+			GridIterator previous(*this);
+			--this->valRef;
+			return previous;
+		}
+
+		GridIterator& operator+=(difference_type offset)
+		{
+			this->valRef += offset;
+			return *this;
+		}
+
+		GridIterator& operator-=(difference_type offset)
 		{
-			Increment();
+			this->valRef -= offset;
 			return *this;
 		}
 
-		const GridIterator<Data_Type> operator++(int)
+		GridIterator operator+(difference_type offset)const
+		{
+			GridIterator result(*this);
+			result.valRef += offset;
+			return result;
+		}
+
+		friend GridIterator operator+(difference_type offset, const GridIterator& iterator)
+		{
+			return iterator + offset;
+		}
+
+		GridIterator operator-(difference_type offset)const
+		{
+			GridIterator result(*this);
+			result.valRef -= offset;
+			return result;
+		}
+
+		friend difference_type operator-(const GridIterator& lhs, const GridIterator& rhs)
+		{
+			return lhs.valRef - rhs.valRef;
+		}
+
+		friend bool operator==(const GridIterator& lhs, const GridIterator& rhs)
+		{
+			return lhs.valRef == rhs.valRef;
+		}
+
+		friend bool operator!=(const GridIterator& lhs, const GridIterator& rhs)
+		{
+			return lhs.valRef != rhs.valRef;
+		}
+
+		friend bool operator<(const GridIterator& lhs, const GridIterator& rhs)
+		{
+			return lhs.valRef < rhs.valRef;
+		}
+
+		friend bool operator<=(const GridIterator& lhs, const GridIterator& rhs)
+		{
+			return lhs.valRef <= rhs.valRef;
+		}
+
+		friend bool operator>(const GridIterator& lhs, const GridIterator& rhs)
+		{
+			return lhs.valRef > rhs.valRef;
+		}
+
+		friend bool operator>=(const GridIterator& lhs, const GridIterator& rhs)
+		{
+			return lhs.valRef >= rhs.valRef;
+		}
+
+	private:
+		Iterator_Data_Type* valRef;
+	};
+
+	///Iterator for layouts with padding between rows. Walks the cells row by row
+	///and steps over the padding slots at the end of each row. Random access but
+	///not contiguous, the padding breaks the cells into one run per row.
+	template <typename Iterator_Data_Type>
+	class PaddedGridIterator : public GridIteratorBounds<Access_Policy, Iterator_Data_Type>
+	{
+		typedef GridIteratorBounds<Access_Policy, Iterator_Data_Type> bounds_type;
+
+		template <typename Other_Data_Type>
+		friend class PaddedGridIterator;
+
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef typename std::remove_const<Iterator_Data_Type>::type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Iterator_Data_Type* pointer;
+		typedef Iterator_Data_Type& reference;
+
+		PaddedGridIterator()
+			:bounds_type(nullptr, nullptr), rowStart(nullptr), column(0), columnCount(0), rowPitch(0)
+		{
+
+		}
+
+		PaddedGridIterator(Iterator_Data_Type* row_start, size_t column_index, size_t column_count, size_t row_pitch,
+			Iterator_Data_Type* first, Iterator_Data_Type* last)
+			:bounds_type(first, last), rowStart(row_start), column(column_index), columnCount(column_count), rowPitch(row_pitch)
+		{
+
+		}
+
+		template <typename Other_Data_Type, typename = typename std::enable_if<
+			std::is_same<const Other_Data_Type, Iterator_Data_Type>::value>::type>
+		PaddedGridIterator(const PaddedGridIterator<Other_Data_Type>& other)
+			:bounds_type(other), rowStart(other.rowStart), column(other.column), columnCount(other.columnCount),
+			rowPitch(other.rowPitch)
+		{
+
+		}
+
+		reference operator*()const
+		{
+			this->CheckAddress(Address());
+			return this->rowStart[this->column];
+		}
+
+		pointer operator->()const
+		{
+			this->CheckAddress(Address());
+			return this->rowStart + this->column;
+		}
+
+		reference operator[](difference_type index)const
+		{
+			return *(*this + index);
+		}
+
+		PaddedGridIterator& operator++()
 		{
-			Increment();
+			if (++this->column == this->columnCount)
+			{
+				this->column = 0;
+				this->rowStart += this->rowPitch;
+			}
+
 			return *this;
 		}
 
-		GridIterator<Data_Type> operator + (const GridIterator& rhs) const
+		PaddedGridIterator operator++(int)
+		{
+			PaddedGridIterator previous(*this);
+			++*this;
+			return previous;
+		}
+
+		PaddedGridIterator& operator--()
 		{
-			return GridIterator(this->valRef + rhs.valRef);
+			if (this->column == 0)
+			{
+				this->column = this->columnCount;
+				this->rowStart -= this->rowPitch;
+			}
+
+			--this->column;
+			return *this;
 		}
 
-		difference_type operator - (const GridIterator& rhs) const
+		PaddedGridIterator operator--(int)
 		{
-			return (this->valRef - rhs.valRef);
+			PaddedGridIterator previous(*this);
+			--*this;
+			return previous;
 		}
 
-		GridIterator<Data_Type>& operator--()
+		PaddedGridIterator& operator+=(difference_type offset)
 		{
-			Decrement();
+			Advance(offset);
 			return *this;
 		}
 
-		const GridIterator<Data_Type> operator--(int)
+		PaddedGridIterator& operator-=(difference_type offset)
 		{
-			Decrement();
+			Advance(-offset);
 			return *this;
 		}
 
-		bool operator==(const GridIterator& rhs)
+		PaddedGridIterator operator+(difference_type offset)const
+		{
+			PaddedGridIterator result(*this);
+			result.Advance(offset);
+			return result;
+		}
+
+		friend PaddedGridIterator operator+(difference_type offset, const PaddedGridIterator& iterator)
+		{
+			return iterator + offset;
+		}
+
+		PaddedGridIterator operator-(difference_type offset)const
 		{
-			return this->valRef == rhs.valRef;
+			PaddedGridIterator result(*this);
+			result.Advance(-offset);
+			return result;
 		}
 
-		bool operator!=(const GridIterator& rhs)
+		friend difference_type operator-(const PaddedGridIterator& lhs, const PaddedGridIterator& rhs)
 		{
-			return !(*this == rhs);
+			if (lhs.rowPitch == 0)
+				return 0;
+
+			difference_type rows = (lhs.rowStart - rhs.rowStart) / difference_type(lhs.rowPitch);
+
+			return rows * difference_type(lhs.columnCount) +
+				(difference_type(lhs.column) - difference_type(rhs.column));
 		}
 
-		bool operator<(const GridIterator& rhs)
+		//A cell address grows with its position, padding only widens the gaps
+		friend bool operator==(const PaddedGridIterator& lhs, const PaddedGridIterator& rhs)
 		{
-			return this->valRef < rhs.valRef;
+			return lhs.Address() == rhs.Address();
 		}
 
-		bool operator<=(const GridIterator& rhs)
+		friend bool operator!=(const PaddedGridIterator& lhs, const PaddedGridIterator& rhs)
 		{
-			return this->valRef <= rhs.valRef;
+			return !(lhs == rhs);
 		}
 
-		bool operator>(const GridIterator& rhs)
+		friend bool operator<(const PaddedGridIterator& lhs, const PaddedGridIterator& rhs)
 		{
-			return this->valRef > rhs.valRef;
+			return lhs.Address() < rhs.Address();
 		}
 
-		bool operator>=(const GridIterator& rhs)
+		friend bool operator<=(const PaddedGridIterator& lhs, const PaddedGridIterator& rhs)
 		{
-			return this->valRef >= rhs.valRef;
+			return lhs.Address() <= rhs.Address();
 		}
 
-	protected:
-		Data_Type* valRef;
+		friend bool operator>(const PaddedGridIterator& lhs, const PaddedGridIterator& rhs)
+		{
+			return lhs.Address() > rhs.Address();
+		}
 
-		inline void Increment()
+		friend bool operator>=(const PaddedGridIterator& lhs, const PaddedGridIterator& rhs)
 		{
-			++this->valRef;
+			return lhs.Address() >= rhs.Address();
+		}
+
+	private:
+		Iterator_Data_Type* rowStart;
+		size_t column;
+		size_t columnCount;
+		size_t rowPitch;
+
+		inline Iterator_Data_Type* Address()const
+		{
+			return this->rowStart + this->column;
 		}
 
-		inline void Decrement()
+		void Advance(difference_type offset)
 		{
-			--this->valRef;
+			if (this->columnCount == 0)
+				return;
+
+			difference_type position = difference_type(this->column) + offset;
+			difference_type columns = difference_type(this->columnCount);
+			difference_type rows = position / columns;
+
+			//Round towards negative infinity so the column stays positive
+			if (position % columns < 0)
+				rows--;
+
+			this->rowStart += rows * difference_type(this->rowPitch);
+			this->column = size_t(position - rows * columns);
 		}
 	};
 
-	template <typename Grid_Data_Type>
+	template <typename Grid_Type, typename Reference_Type>
 	class _Indexer
 	{
 		dimension_type columnIndex;
-		Grid<Grid_Data_Type>& data;
+		Grid_Type& data;
 
 	public:
-		_Indexer(dimension_type ColumnIndex, Grid<Grid_Data_Type>& Data)
+		_Indexer(dimension_type ColumnIndex, Grid_Type& Data)
 			: columnIndex(ColumnIndex), data(Data)
 		{
 
 		}
 
-		reference operator[](dimension_type RowIndex)
+		Reference_Type operator[](dimension_type RowIndex) const
 		{
-			return data.grid_data[data.GetOneDimensionIndex(columnIndex, RowIndex)];
-		}
+			Access_Policy::Check(columnIndex < data.columnCount && RowIndex < data.rowCount,
+				"Grid-operator[] Arguments Out of Range");
 
-		const reference operator[](dimension_type RowIndex) const
-		{
 			return data.grid_data[data.GetOneDimensionIndex(columnIndex, RowIndex)];
 		}
 	};
 
 public:
-	typedef GridIterator<value_type> iterator;
-	typedef GridIterator<const value_type> const_iterator;
+	typedef typename std::conditional<layout_type::has_padding,
+		PaddedGridIterator<value_type>, GridIterator<value_type>>::type iterator;
+	typedef typename std::conditional<layout_type::has_padding,
+		PaddedGridIterator<const value_type>, GridIterator<const value_type>>::type const_iterator;
 
-	typedef _Indexer<value_type> indexer;
-	typedef _Indexer<const value_type> const_indexer;
+	typedef _Indexer<Grid, reference> indexer;
+	typedef _Indexer<const Grid, const_reference> const_indexer;
 
 	Grid()
-		:columnCount(0), rowCount(0), grid_data(nullptr)
+		:columnCount(0), rowCount(0), grid_data(nullptr), storageCapacity(0), ownsStorage(true), layout(), allocator()
 	{
 		
 	}
 
+	explicit Grid(const allocator_type& _allocator)
+		:columnCount(0), rowCount(0), grid_data(nullptr), storageCapacity(0), ownsStorage(true), layout(), allocator(_allocator)
+	{
+
+	}
+
 	Grid(dimension_type _columnCount, dimension_type _rowCount)
-		: columnCount(_columnCount), rowCount(_rowCount), grid_data(nullptr)
+		: columnCount(_columnCount), rowCount(_rowCount), grid_data(nullptr), storageCapacity(0), ownsStorage(true), layout(), allocator()
 	{
 		ResizeGrid(this->columnCount, this->rowCount);
 	}
 
-	Grid(dimension_type _columnCount, dimension_type _rowCount, value_type initVal)
-		: columnCount(_columnCount), rowCount(_rowCount), grid_data(nullptr)
+	Grid(dimension_type _columnCount, dimension_type _rowCount, value_type initVal,
+		const allocator_type& _allocator = allocator_type())
+		: columnCount(_columnCount), rowCount(_rowCount), grid_data(nullptr), storageCapacity(0), ownsStorage(true), layout(), allocator(_allocator)
 	{
 		if (this->rowCount == 0 || this->columnCount == 0)
 			throw std::invalid_argument("Dimension cannot be 0");
@@ -179,18 +497,74 @@ public:
 		ResizeGrid(this->columnCount, this->rowCount, initVal);
 	}
 
+	Grid(dimension_type _columnCount, dimension_type _rowCount, GridNoInitTag noInit,
+		const allocator_type& _allocator = allocator_type())
+		: columnCount(0), rowCount(0), grid_data(nullptr), storageCapacity(0), ownsStorage(true), layout(), allocator(_allocator)
+	{
+		ResizeGrid(_columnCount, _rowCount, noInit);
+	}
+
 	///Copy Constructor
 	Grid(const Grid& source)
+		:columnCount(0), rowCount(0), grid_data(nullptr), storageCapacity(0), ownsStorage(true), layout(),
+		allocator(allocator_traits::select_on_container_copy_construction(source.allocator))
 	{
 		PerformCopy(source);
 	}
 
 	///Move Constructor
 	Grid(Grid&& source)
+		:columnCount(0), rowCount(0), grid_data(nullptr), storageCapacity(0), ownsStorage(true), layout(), allocator(std::move(source.allocator))
 	{
 		PerformMove(source);
 	}
 
+	///Views columns x rows cells already laid out by layout_type at storage. The
+	///grid never frees that storage and the caller keeps it alive for as long as
+	///the grid uses it. Resizing or reshaping moves the cells into storage of the
+	///grid's own first; copies always own their storage.
+	Grid(GridExternalStorageTag, value_type* storage, dimension_type _columnCount, dimension_type _rowCount,
+		const allocator_type& _allocator = allocator_type())
+		:columnCount(0), rowCount(0), grid_data(nullptr), storageCapacity(0), ownsStorage(false), layout(),
+		allocator(_allocator)
+	{
+		static_assert(std::is_trivially_copyable<value_type>::value,
+			"External storage holds raw bytes, the cell type must be trivially copyable");
+
+		if (_rowCount == 0 || _columnCount == 0)
+			throw std::invalid_argument("Dimension cannot be 0");
+
+		SetCheckedDimensions(this->layout, _columnCount, _rowCount);
+
+		this->grid_data = storage;
+		this->storageCapacity = this->layout.GetStorageSize();
+		this->columnCount = _columnCount;
+		this->rowCount = _rowCount;
+	}
+
+	///Allocator extended copy, lets containers of grids pass their allocator down
+	Grid(const Grid& source, const allocator_type& _allocator)
+		:columnCount(0), rowCount(0), grid_data(nullptr), storageCapacity(0), ownsStorage(true), layout(), allocator(_allocator)
+	{
+		PerformCopy(source);
+	}
+
+	///Allocator extended move. Storage from a different allocator cannot be
+	///adopted, so the cells are moved one by one into new storage instead.
+	Grid(Grid&& source, const allocator_type& _allocator)
+		:columnCount(0), rowCount(0), grid_data(nullptr), storageCapacity(0), ownsStorage(true), layout(), allocator(_allocator)
+	{
+		if (this->allocator == source.allocator)
+		{
+			PerformMove(source);
+		}
+		else
+		{
+			PerformCopy(source, true);
+			source.FreeGridData();
+		}
+	}
+
 	~Grid()
 	{
 		FreeGridData();
@@ -216,90 +590,333 @@ public:
 
 		//Free data if it exists
 		FreeGridData();
+
+		if constexpr (allocator_traits::propagate_on_container_copy_assignment::value)
+			this->allocator = source.allocator;
 		
 		//Deep copy
 		PerformCopy(source);
+
+		return *this;
 	}
 
 	///Move Assignment Operator
 	Grid& operator=(Grid&& source)
 	{
+		if (this == &source)
+		{
+			return *this;
+		}
+
 		FreeGridData();
 
-		PerformMove(source);
+		if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+		{
+			this->allocator = std::move(source.allocator);
+			PerformMove(source);
+		}
+		else if (this->allocator == source.allocator)
+		{
+			PerformMove(source);
+		}
+		else
+		{
+			//Memory from a different resource cannot be adopted, move cell by cell
+			PerformCopy(source, true);
+			source.FreeGridData();
+		}
 
 		return *this;
 	}
 
-	friend std::ostream& operator<<(std::ostream& os, const Grid<value_type>& grid)
+	friend std::ostream& operator<<(std::ostream& os, const Grid& grid)
 	{
 		// write obj to stream
 		for (dimension_type row = 0; row < grid.GetRowCount(); row++)
 		{
 			for (dimension_type column = 0; column < grid.GetColumnCount(); column++)
 			{
-				std::cout << "[" << column << "," << row << "(" << grid.GetOneDimensionIndex(column, row) << ") = " <<
+				os << "[" << column << "," << row << "(" << grid.GetOneDimensionIndex(column, row) << ") = " <<
 					grid.GetCell(column, row) << "]\t";
 			}
 
-			std::cout << std::endl;
+			os << std::endl;
 		}
 
-		std::cout << std::endl;
+		os << std::endl;
 
 		return os;
 	}
 
+	///Calls function(cell) for every cell. The cells are cut into bands of
+	///about GridExecution::band_bytes that run under policy (GridExecution::seq, par or
+	///par_unseq), each band in storage order.
+	template<typename Policy_Type, typename Function_Type>
+	void ForEach(const Policy_Type& policy, Function_Type function)
+	{
+		GridExecution::ForEachBand(policy, GetBandCount(), [&](size_t band)
+		{
+			ForEachSpanInBand(band, [&](value_type* cells, size_t count)
+			{
+				for (size_t index = 0; index < count; index++)
+					function(cells[index]);
+			});
+		});
+	}
+
+	template<typename Policy_Type, typename Function_Type>
+	void ForEach(const Policy_Type& policy, Function_Type function) const
+	{
+		GridExecution::ForEachBand(policy, GetBandCount(), [&](size_t band)
+		{
+			ForEachSpanInBand(band, [&](const value_type* cells, size_t count)
+			{
+				for (size_t index = 0; index < count; index++)
+					function(cells[index]);
+			});
+		});
+	}
+
+	///Calls function(row) for every row index, in bands of whole rows
+	template<typename Policy_Type, typename Function_Type>
+	void ForEachRow(const Policy_Type& policy, Function_Type function) const
+	{
+		size_t rowsPerBand = GetRowsPerBand();
+
+		GridExecution::ForEachBand(policy, GetRowBandCount(), [&](size_t band)
+		{
+			size_t lastRow = std::min<size_t>((band + 1) * rowsPerBand, this->rowCount);
+
+			for (size_t row = band * rowsPerBand; row < lastRow; row++)
+				function(dimension_type(row));
+		});
+	}
+
+	template<typename Policy_Type>
+	void Fill(const Policy_Type& policy, const value_type& value)
+	{
+		GridExecution::ForEachBand(policy, GetBandCount(), [&](size_t band)
+		{
+			ForEachSpanInBand(band, [&](value_type* cells, size_t count)
+			{
+				std::fill(cells, cells + count, value);
+			});
+		});
+	}
+
+	///Replaces every cell with function(cell)
+	template<typename Policy_Type, typename Function_Type>
+	void Transform(const Policy_Type& policy, Function_Type function)
+	{
+		GridExecution::ForEachBand(policy, GetBandCount(), [&](size_t band)
+		{
+			ForEachSpanInBand(band, [&](value_type* cells, size_t count)
+			{
+				for (size_t index = 0; index < count; index++)
+					cells[index] = function(cells[index]);
+			});
+		});
+	}
+
+	///Sets every cell to function(the cell at the same position in source).
+	///source may use another layout or cell type but must have the same
+	///dimensions, and must not be this grid.
+	template<typename Policy_Type, typename Source_Grid, typename Function_Type>
+	void Transform(const Policy_Type& policy, const Source_Grid& source, Function_Type function)
+	{
+		if (size_t(source.GetColumnCount()) != this->columnCount || size_t(source.GetRowCount()) != this->rowCount)
+			throw std::invalid_argument("Transform source dimensions differ");
+
+		size_t rowsPerBand = GetRowsPerBand();
+
+		GridExecution::ForEachBand(policy, GetRowBandCount(), [&](size_t band)
+		{
+			size_t lastRow = std::min<size_t>((band + 1) * rowsPerBand, this->rowCount);
+
+			for (size_t row = band * rowsPerBand; row < lastRow; row++)
+			{
+				if constexpr (layout_type::contiguous_rows && Source_Grid::layout_type::contiguous_rows)
+				{
+					value_type* target = this->grid_data + this->layout.GetOneDimensionIndex(0, row);
+					const auto* input = &source.GetCell(0, typename Source_Grid::dimension_type(row));
+
+					for (size_t column = 0; column < this->columnCount; column++)
+						target[column] = function(input[column]);
+				}
+				else
+				{
+					for (size_t column = 0; column < this->columnCount; column++)
+					{
+						this->grid_data[this->layout.GetOneDimensionIndex(column, row)] = function(source.GetCell(
+							typename Source_Grid::dimension_type(column), typename Source_Grid::dimension_type(row)));
+					}
+				}
+			}
+		});
+	}
+
+	///Folds transform(cell) of every cell into init with combine, which must be
+	///associative. Every band is folded on its own and the band results are
+	///combined in order, so the result is the same for every policy and thread
+	///count, floating point included.
+	template<typename Policy_Type, typename Result_Type, typename Combine_Function, typename Transform_Function>
+	Result_Type Reduce(const Policy_Type& policy, Result_Type init, Combine_Function combine,
+		Transform_Function transform) const
+	{
+		size_t bandCount = GetBandCount();
+		std::vector<Result_Type> partials(bandCount, init);
+
+		GridExecution::ForEachBand(policy, bandCount, [&](size_t band)
+		{
+			bool started = false;
+			Result_Type& partial = partials[band];
+
+			ForEachSpanInBand(band, [&](const value_type* cells, size_t count)
+			{
+				size_t index = 0;
+
+				if (!started)
+				{
+					partial = transform(cells[index++]);
+					started = true;
+				}
+
+				for (; index < count; index++)
+					partial = combine(partial, transform(cells[index]));
+			});
+		});
+
+		for (const Result_Type& partial : partials)
+			init = combine(init, partial);
+
+		return init;
+	}
+
+	///Reduce over the cells themselves, converted to Result_Type
+	template<typename Policy_Type, typename Result_Type, typename Combine_Function>
+	Result_Type Reduce(const Policy_Type& policy, Result_Type init, Combine_Function combine) const
+	{
+		return Reduce(policy, std::move(init), combine, [](const value_type& cell) { return Result_Type(cell); });
+	}
+
 	inline iterator begin()
 	{
-		return iterator(grid_data);
+		return MakeIterator<iterator>(this->grid_data, 0);
 	}
 
 	inline const_iterator begin() const
 	{
-		return const_iterator(grid_data);
+		return MakeIterator<const_iterator>(this->grid_data, 0);
 	}
 
 	inline const_iterator cbegin() const
 	{
-		return const_iterator(grid_data);
+		return MakeIterator<const_iterator>(this->grid_data, 0);
 	}
 
 	inline const_iterator cend() const
 	{
-		return const_iterator(&grid_data[size()]);
+		return MakeIterator<const_iterator>(this->grid_data, size());
 	}
 
 	inline iterator end()
 	{
-		return iterator(&grid_data[size()]);
+		return MakeIterator<iterator>(this->grid_data, size());
 	}
 
 	inline const_iterator end() const
 	{
-		return const_iterator(&grid_data[size()]);
+		return MakeIterator<const_iterator>(this->grid_data, size());
+	}
+
+	///The storage as one contiguous array of size() cells. Only for hole free
+	///layouts, the cells are in the layout's storage order.
+	inline value_type* data()
+	{
+		static_assert(!layout_type::has_padding, "Grid-data needs a layout without padding");
+		return this->grid_data;
+	}
+
+	inline const value_type* data() const
+	{
+		static_assert(!layout_type::has_padding, "Grid-data needs a layout without padding");
+		return this->grid_data;
+	}
+
+	///The cells of one row, left to right. A contiguous pointer range for layouts
+	///with contiguous_rows, a GridStrideIterator range for other strided layouts.
+	///The row index goes through Access_Policy, the cells of the range do not.
+	inline auto GetRow(dimension_type rowIndex)
+	{
+		return MakeRow(this->grid_data, rowIndex);
+	}
+
+	inline auto GetRow(dimension_type rowIndex) const
+	{
+		return MakeRow(static_cast<const value_type*>(this->grid_data), rowIndex);
+	}
+
+	///The cells of one column, top to bottom, for strided layouts
+	inline auto GetColumn(dimension_type columnIndex)
+	{
+		return MakeColumn(this->grid_data, columnIndex);
+	}
+
+	inline auto GetColumn(dimension_type columnIndex) const
+	{
+		return MakeColumn(static_cast<const value_type*>(this->grid_data), columnIndex);
+	}
+
+	///Tiles across and down the grid, for layouts with a tile_size
+	inline size_t GetTileColumnCount() const
+	{
+		return (size_t(this->columnCount) + layout_type::tile_size - 1) / layout_type::tile_size;
+	}
+
+	inline size_t GetTileRowCount() const
+	{
+		return (size_t(this->rowCount) + layout_type::tile_size - 1) / layout_type::tile_size;
+	}
+
+	///The storage of one tile of a TiledLayout or MortonLayout grid as a
+	///contiguous pointer range, in the layout's order inside the tile. Edge tiles
+	///are clipped, so their ranges are shorter.
+	inline GridRange<value_type*> GetTile(size_t tileColumn, size_t tileRow)
+	{
+		return MakeTile(this->grid_data, tileColumn, tileRow);
+	}
+
+	inline GridRange<const value_type*> GetTile(size_t tileColumn, size_t tileRow) const
+	{
+		return MakeTile(static_cast<const value_type*>(this->grid_data), tileColumn, tileRow);
 	}
 
 	inline reference GetCell(dimension_type columnIndex, dimension_type rowIndex)
 	{
-		if (columnIndex > this->columnCount || rowIndex > this->rowCount)
-			throw std::out_of_range("Grid-GetCell Arguments Out of Range");
+		Access_Policy::Check(columnIndex < this->columnCount && rowIndex < this->rowCount,
+			"Grid-GetCell Arguments Out of Range");
 
 		return this->grid_data[this->GetOneDimensionIndex(columnIndex, rowIndex)];
 	}
 
-	inline const reference GetCell(dimension_type columnIndex, dimension_type rowIndex) const
+	inline const_reference GetCell(dimension_type columnIndex, dimension_type rowIndex) const
 	{
+		Access_Policy::Check(columnIndex < this->columnCount && rowIndex < this->rowCount,
+			"Grid-GetCell Arguments Out of Range");
+
 		return this->grid_data[this->GetOneDimensionIndex(columnIndex, rowIndex)];
 	}
 
+	///Index is a storage index, as returned by GetOneDimensionIndex
 	inline reference GetCell(size_t index)
 	{
+		Access_Policy::Check(index < this->layout.GetStorageSize(), "Grid-GetCell Index Out of Range");
 		return this->grid_data[index];
 	}
 
-	inline const reference GetCell(size_t index) const
+	inline const_reference GetCell(size_t index) const
 	{
+		Access_Policy::Check(index < this->layout.GetStorageSize(), "Grid-GetCell Index Out of Range");
 		return this->grid_data[index];
 	}
 
@@ -310,96 +927,229 @@ public:
 
 	inline size_t GetOneDimensionIndex(dimension_type ColumnIndex, dimension_type RowIndex) const
 	{
-		return ColumnIndex + RowIndex * this->columnCount;
+		return this->layout.GetOneDimensionIndex(ColumnIndex, RowIndex);
 	}
 
-	inline dimension_type GetRowCount()const
+	inline const layout_type& GetLayout() const
 	{
-		return this->rowCount;
+		return this->layout;
 	}
 
-	inline bool isEmpty()const
+	///Number of elements allocated, including any row padding
+	inline size_t GetStorageSize() const
 	{
-		return !(this->rowCount > 0 && this->columnCount > 0);
+		return this->layout.GetStorageSize();
 	}
 
-	inline size_type maxSize()const
+	inline allocator_type get_allocator() const
 	{
-		return std::numeric_limits<size_type>::max();
+		return this->allocator;
+	}
+
+	inline dimension_type GetRowCount()const
+	{
+		return this->rowCount;
+	}
+
+	inline bool isEmpty()const
+	{
+		return !(this->rowCount > 0 && this->columnCount > 0);
+	}
+
+	inline size_type maxSize()const
+	{
+		return std::numeric_limits<size_type>::max();
 	}
 	
 	///Resize's the grid. If you need data passed to the new grid, use ResizeGridPreserveData instead
 	void ResizeGrid(dimension_type newColumnCount, dimension_type newRowCount,
 		value_type initVal = value_type())
 	{
-		if (newRowCount == 0 || newColumnCount == 0)
-			throw std::invalid_argument("Dimension cannot be 0");
-
-		FreeGridData();
-
-		this->columnCount = newColumnCount;
-		this->rowCount = newRowCount;
+		ReplaceStorage(newColumnCount, newRowCount, [&](value_type* cells, size_t length)
+		{
+			std::uninitialized_fill(cells, cells + length, initVal);
+		});
+	}
 
-		this->grid_data = new value_type[size()];
+	///Resize's the grid without initialising the cells, which are left with
+	///indeterminate values. Only available for trivial cell types.
+	void ResizeGrid(dimension_type newColumnCount, dimension_type newRowCount, GridNoInitTag)
+	{
+		static_assert(std::is_trivially_default_constructible<value_type>::value &&
+			std::is_trivially_destructible<value_type>::value,
+			"GridNoInit requires a trivially constructible and destructible cell type");
 
-		for (dimension_type columnIndex = 0; columnIndex < this->columnCount; columnIndex++)
+		ReplaceStorage(newColumnCount, newRowCount, [](value_type*, size_t)
 		{
-			for (dimension_type rowIndex = 0; rowIndex < this->rowCount; rowIndex++)
-			{
-				this->grid_data[this->GetOneDimensionIndex(columnIndex, rowIndex)] = initVal;
-			}
-		}
-	}
 
+		});
+	}
 
 	///Resize's the grid while maintaining any data that can fit in the new bounds
-	///Uses the empty filler if the new size is larger than old size
+	///Uses the empty filler if the new size is larger than old size. The cells
+	///are shifted inside the current storage when its capacity allows it.
 	void ResizeGridPreserveData(dimension_type newColumnCount, dimension_type newRowCount,
 		value_type emptyFiller = value_type())
 	{
 		if (newRowCount == 0 || newColumnCount == 0)
 			throw std::invalid_argument("Dimension cannot be 0");
 
-		//Used to make sure we only copy as many elements as is safe
-		size_type lowestRowCount = newRowCount <= this->rowCount ? newRowCount : this->rowCount;
-		size_type lowestColumnCount = newColumnCount <= this->columnCount ? newColumnCount : this->columnCount;
+		ChangeShape(AxisChange::Resize(this->columnCount, newColumnCount),
+			AxisChange::Resize(this->rowCount, newRowCount), &emptyFiller, false);
+	}
 
-		value_type* temporary = new value_type[newColumnCount * newRowCount];
+	///Makes room for a grid of columns x rows, so growing up to that size through
+	///ResizeGridPreserveData or the Append and Insert functions does not allocate.
+	///Layouts that can reserve row space (PaddedRowMajorLayout) also widen their
+	///rows, so columns can then be added without moving any cell. Never shrinks.
+	void reserve(dimension_type columns, dimension_type rows)
+	{
+		layout_type newLayout = this->layout;
 
-		for (size_t index = 0; index < newRowCount; index++)
+		if constexpr (LayoutReservesColumns<layout_type>::value)
 		{
-			size_t initializerStart = 0;
+			if (columns > this->layout.GetRowPitch())
+				newLayout.ReserveColumns(columns);
+		}
 
-			if (index < lowestRowCount)
-			{
-				std::copy(&grid_data[index * lowestColumnCount], 
-					&grid_data[index * lowestColumnCount + lowestColumnCount],
-					&temporary[index * newColumnCount]);
+		newLayout.SetDimensions(this->columnCount, this->rowCount, sizeof(value_type));
 
-				initializerStart = lowestColumnCount;
-			}
-			
-			for (size_t rowIndex = initializerStart; rowIndex < newColumnCount; rowIndex++)
+		layout_type reservedLayout = newLayout;
+		SetCheckedDimensions(reservedLayout, std::max(columns, this->columnCount), std::max(rows, this->rowCount));
+
+		size_t capacityNeeded = reservedLayout.GetStorageSize();
+
+		if (isEmpty())
+		{
+			if (capacityNeeded > this->storageCapacity)
 			{
-				temporary[rowIndex + index * newColumnCount] = emptyFiller;
+				value_type* data = AllocateStorage(capacityNeeded);
+
+				FreeGridData();
+
+				this->grid_data = data;
+				this->storageCapacity = capacityNeeded;
 			}
-			
+
+			this->layout = newLayout;
 		}
+		else if (capacityNeeded > this->storageCapacity || newLayout.GetStorageSize() != this->layout.GetStorageSize())
+		{
+			Relayout(newLayout, AxisChange::Resize(this->columnCount, this->columnCount),
+				AxisChange::Resize(this->rowCount, this->rowCount), nullptr, capacityNeeded);
+		}
+	}
 
-		FreeGridData();
+	///Number of elements the storage can hold, including any row padding and
+	///the room set aside by reserve or geometric growth
+	inline size_t capacity() const
+	{
+		return this->storageCapacity;
+	}
 
-		this->grid_data = temporary;
+	///Gives back the storage the current cells do not need, including any
+	///reserved row space
+	void shrink_to_fit()
+	{
+		if (isEmpty())
+		{
+			FreeGridData();
+			this->layout = layout_type();
+			return;
+		}
 
-		this->rowCount = newRowCount;
-		this->columnCount = newColumnCount;
+		layout_type newLayout;
+		newLayout.SetDimensions(this->columnCount, this->rowCount, sizeof(value_type));
+
+		if (newLayout.GetStorageSize() == this->storageCapacity)
+		{
+			this->layout = newLayout;
+			return;
+		}
+
+		RelayoutIntoNewStorage(newLayout, AxisChange::Resize(this->columnCount, this->columnCount),
+			AxisChange::Resize(this->rowCount, this->rowCount), nullptr, newLayout.GetStorageSize());
+	}
+
+	///Adds count rows below the last one. Spare capacity is used in place, otherwise
+	///the storage grows geometrically, so appending row by row is amortised
+	///O(cells added).
+	void AppendRows(dimension_type count, value_type filler = value_type())
+	{
+		if (isEmpty())
+			throw std::logic_error("Grid-AppendRows Grid has no columns");
+
+		ChangeShape(AxisChange::Resize(this->columnCount, this->columnCount),
+			AxisChange::Insert(this->rowCount, count), &filler, true);
+	}
+
+	///Adds count columns after the last one. Amortised O(cells added) when the
+	///layout keeps columns apart (ColumnMajorLayout, or PaddedRowMajorLayout whose
+	///rows are widened geometrically); RowMajorLayout has to shift every row,
+	///though still inside the spare capacity when there is some.
+	void AppendColumns(dimension_type count, value_type filler = value_type())
+	{
+		if (isEmpty())
+			throw std::logic_error("Grid-AppendColumns Grid has no rows");
+
+		ChangeShape(AxisChange::Insert(this->columnCount, count),
+			AxisChange::Resize(this->rowCount, this->rowCount), &filler, true);
+	}
+
+	///Inserts a row before rowIndex, rowIndex == GetRowCount() appends
+	void InsertRow(dimension_type rowIndex, value_type filler = value_type())
+	{
+		if (isEmpty())
+			throw std::logic_error("Grid-InsertRow Grid has no columns");
+
+		if (rowIndex > this->rowCount)
+			throw std::out_of_range("Grid-InsertRow Arguments Out of Range");
+
+		ChangeShape(AxisChange::Resize(this->columnCount, this->columnCount),
+			AxisChange::Insert(rowIndex, 1), &filler, true);
+	}
+
+	///Inserts a column before columnIndex, columnIndex == GetColumnCount() appends
+	void InsertColumn(dimension_type columnIndex, value_type filler = value_type())
+	{
+		if (isEmpty())
+			throw std::logic_error("Grid-InsertColumn Grid has no rows");
+
+		if (columnIndex > this->columnCount)
+			throw std::out_of_range("Grid-InsertColumn Arguments Out of Range");
+
+		ChangeShape(AxisChange::Insert(columnIndex, 1),
+			AxisChange::Resize(this->rowCount, this->rowCount), &filler, true);
+	}
+
+	///Removes a row, shifting the ones below it up. The capacity is kept.
+	///Erasing the only row empties the grid.
+	void EraseRow(dimension_type rowIndex)
+	{
+		if (rowIndex >= this->rowCount)
+			throw std::out_of_range("Grid-EraseRow Arguments Out of Range");
+
+		ChangeShape(AxisChange::Resize(this->columnCount, this->columnCount),
+			AxisChange::Erase(rowIndex, 1), nullptr, false);
+	}
+
+	///Removes a column, shifting the ones after it left. The capacity is kept.
+	///Erasing the only column empties the grid.
+	void EraseColumn(dimension_type columnIndex)
+	{
+		if (columnIndex >= this->columnCount)
+			throw std::out_of_range("Grid-EraseColumn Arguments Out of Range");
+
+		ChangeShape(AxisChange::Erase(columnIndex, 1),
+			AxisChange::Resize(this->rowCount, this->rowCount), nullptr, false);
 	}
 
 	inline size_type size()const
 	{
-		return this->columnCount * this->rowCount;
+		return size_type(this->columnCount) * this->rowCount;
 	}
 
-	inline void swap(Grid<value_type>& inGrid)
+	inline void swap(Grid& inGrid)
 	{
 		std::swap(*this, inGrid);
 	}
@@ -408,31 +1158,216 @@ protected:
 	dimension_type columnCount;
 	dimension_type rowCount;
 
+	///Only the cells are ever constructed, padding slots stay raw memory
 	value_type* grid_data;
 
+	///Elements allocated at grid_data, at least layout.GetStorageSize()
+	size_t storageCapacity;
+
+	///False while viewing external storage, which is then never freed or reused
+	bool ownsStorage;
+
+	layout_type layout;
+
+	allocator_type allocator;
+
+	///Sets targetLayout to columns x rows, throwing std::length_error instead of
+	///letting the cell count or the storage size wrap around
+	void SetCheckedDimensions(layout_type& targetLayout, size_t columns, size_t rows) const
+	{
+		if (rows != 0 && (columns > std::numeric_limits<size_type>::max() / rows ||
+			columns > std::numeric_limits<size_t>::max() / rows))
+			throw std::length_error("Grid cell count does not fit size_type");
+
+		targetLayout.SetDimensions(columns, rows, sizeof(value_type));
+
+		//Padding only ever adds slots, a smaller storage size means it wrapped
+		size_t storageSize = targetLayout.GetStorageSize();
+
+		if (storageSize < columns * rows || storageSize > allocator_traits::max_size(this->allocator))
+			throw std::length_error("Grid storage does not fit the allocator");
+	}
+
+	///Raw storage for count elements, nothing is constructed
+	inline value_type* AllocateStorage(size_t count)
+	{
+		return allocator_traits::allocate(this->allocator, count);
+	}
+
+	inline void DeallocateStorage(value_type* data, size_t count)
+	{
+		allocator_traits::deallocate(this->allocator, data, count);
+	}
+
+	static inline void DestroyCells(value_type* cells, size_t count)
+	{
+		if constexpr (!std::is_trivially_destructible<value_type>::value)
+			std::destroy(cells, cells + count);
+	}
+
+	///Calls function(cells, length) for every contiguous run of cells in the
+	///storage: the whole buffer for hole free layouts, otherwise each row
+	template<typename Function>
+	static void ForEachCellRun(value_type* data, const layout_type& targetLayout,
+		size_t targetColumnCount, size_t targetRowCount, Function function)
+	{
+		if constexpr (layout_type::has_padding)
+		{
+			for (size_t row = 0; row < targetRowCount; row++)
+				function(data + targetLayout.GetOneDimensionIndex(0, row), targetColumnCount);
+		}
+		else
+		{
+			function(data, targetColumnCount * targetRowCount);
+		}
+	}
+
+	///Constructs every cell of data run by run. construct(cells, length) must
+	///either construct the whole run or throw having constructed nothing, as the
+	///std::uninitialized_* algorithms do. Finished runs are destroyed on failure.
+	template<typename Construct_Function>
+	static void ConstructCells(value_type* data, const layout_type& targetLayout,
+		size_t targetColumnCount, size_t targetRowCount, Construct_Function construct)
+	{
+		size_t completedRuns = 0;
+
+		try
+		{
+			ForEachCellRun(data, targetLayout, targetColumnCount, targetRowCount, [&](value_type* cells, size_t length)
+			{
+				construct(cells, length);
+				completedRuns++;
+			});
+		}
+		catch (...)
+		{
+			ForEachCellRun(data, targetLayout, targetColumnCount, targetRowCount, [&](value_type* cells, size_t length)
+			{
+				if (completedRuns > 0)
+				{
+					DestroyCells(cells, length);
+					completedRuns--;
+				}
+			});
+
+			throw;
+		}
+	}
+
+	///Moves count cells into raw storage when that cannot throw, copies otherwise,
+	///so a failure inside this call leaves the source untouched. Once it has moved
+	///cells, anything the caller does afterwards that throws finds them moved from.
+	static void RelocateCells(value_type* source, size_t count, value_type* destination)
+	{
+		if constexpr (std::is_nothrow_move_constructible<value_type>::value)
+			std::uninitialized_move(source, source + count, destination);
+		else
+			std::uninitialized_copy(source, source + count, destination);
+	}
+
+	///Frees the current cells and builds new storage of the given size, letting
+	///construct fill each run of cells. The grid is left empty if that throws.
+	template<typename Construct_Function>
+	void ReplaceStorage(dimension_type newColumnCount, dimension_type newRowCount, Construct_Function construct)
+	{
+		if (newRowCount == 0 || newColumnCount == 0)
+			throw std::invalid_argument("Dimension cannot be 0");
+
+		layout_type newLayout = this->layout;
+		SetCheckedDimensions(newLayout, newColumnCount, newRowCount);
+
+		if (this->grid_data && this->ownsStorage && newLayout.GetStorageSize() <= this->storageCapacity)
+		{
+			//The current storage is large enough, only the cells are replaced
+			ForEachCellRun(this->grid_data, this->layout, this->columnCount, this->rowCount, DestroyCells);
+
+			this->rowCount = this->columnCount = 0;
+
+			try
+			{
+				ConstructCells(this->grid_data, newLayout, newColumnCount, newRowCount, construct);
+			}
+			catch (...)
+			{
+				FreeGridData();
+				throw;
+			}
+		}
+		else
+		{
+			FreeGridData();
+
+			value_type* data = AllocateStorage(newLayout.GetStorageSize());
+
+			try
+			{
+				ConstructCells(data, newLayout, newColumnCount, newRowCount, construct);
+			}
+			catch (...)
+			{
+				DeallocateStorage(data, newLayout.GetStorageSize());
+				throw;
+			}
+
+			this->grid_data = data;
+			this->storageCapacity = newLayout.GetStorageSize();
+		}
+
+		this->columnCount = newColumnCount;
+		this->rowCount = newRowCount;
+		this->layout = newLayout;
+	}
+
 	void FreeGridData()
 	{
 		if (this->grid_data)
 		{
-			delete[] this->grid_data;
+			if (this->ownsStorage)
+			{
+				ForEachCellRun(this->grid_data, this->layout, this->columnCount, this->rowCount, DestroyCells);
+				DeallocateStorage(this->grid_data, this->storageCapacity);
+			}
+
 			this->grid_data = nullptr;
+			this->storageCapacity = 0;
+			this->ownsStorage = true;
 
 			this->rowCount = this->columnCount = 0;
+			this->layout.SetDimensions(0, 0, sizeof(value_type));
 		}
 	}
 
-	void PerformCopy(const Grid<Data_Type>& source)
+	///Only the cells are duplicated, padding slots stay raw
+	void PerformCopy(const Grid& source, bool moveCells = false)
 	{
-		this->rowCount = source.rowCount;
-		this->columnCount = source.columnCount;
+		if (source.rowCount == 0 || source.columnCount == 0)
+			return;
 
-		if (this->rowCount > 0 && this->columnCount > 0)
+		value_type* data = AllocateStorage(source.layout.GetStorageSize());
+
+		try
 		{
-			this->grid_data = new value_type[this->columnCount * this->rowCount];
+			ConstructCells(data, source.layout, source.columnCount, source.rowCount, [&](value_type* cells, size_t length)
+			{
+				value_type* sourceCells = source.grid_data + (cells - data);
 
-			std::copy(&source.grid_data[0],
-				&source.grid_data[this->columnCount * this->rowCount], &this->grid_data[0]);
+				if (moveCells)
+					std::uninitialized_move(sourceCells, sourceCells + length, cells);
+				else
+					std::uninitialized_copy(sourceCells, sourceCells + length, cells);
+			});
 		}
+		catch (...)
+		{
+			DeallocateStorage(data, source.layout.GetStorageSize());
+			throw;
+		}
+
+		this->grid_data = data;
+		this->storageCapacity = source.layout.GetStorageSize();
+		this->rowCount = source.rowCount;
+		this->columnCount = source.columnCount;
+		this->layout = source.layout;
 	}
 
 	void PerformMove(Grid& source)
@@ -441,12 +1376,565 @@ protected:
 		this->rowCount = source.rowCount;
 		this->columnCount = source.columnCount;
 		this->grid_data = source.grid_data;
+		this->storageCapacity = source.storageCapacity;
+		this->ownsStorage = source.ownsStorage;
+		this->layout = source.layout;
 
 		//Reset the source, as per move semantics
 		source.rowCount = 0;
 		source.columnCount = 0;
 		source.grid_data = nullptr;
+		source.storageCapacity = 0;
+		source.ownsStorage = true;
+		source.layout.SetDimensions(0, 0, sizeof(value_type));
+	}
+
+	///How one axis changes shape. Old indices below position keep their index,
+	///the erased ones after it are dropped, inserted new indices open at position
+	///and the remaining old indices shift along after them.
+	struct AxisChange
+	{
+		static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+		size_t position;
+		size_t erased;
+		size_t inserted;
+
+		static AxisChange Resize(size_t oldCount, size_t newCount)
+		{
+			if (newCount >= oldCount)
+				return AxisChange{ oldCount, 0, newCount - oldCount };
+
+			return AxisChange{ newCount, oldCount - newCount, 0 };
+		}
+
+		static AxisChange Insert(size_t position, size_t count)
+		{
+			return AxisChange{ position, 0, count };
+		}
+
+		static AxisChange Erase(size_t position, size_t count)
+		{
+			return AxisChange{ position, count, 0 };
+		}
+
+		inline size_t NewCount(size_t oldCount) const
+		{
+			return oldCount - this->erased + this->inserted;
+		}
+
+		///True when every old index keeps its value
+		inline bool KeepsOldIndices(size_t oldCount) const
+		{
+			return this->erased == 0 && (this->inserted == 0 || this->position == oldCount);
+		}
+
+		///New index of an old one, npos if it is erased
+		inline size_t ToNew(size_t oldIndex) const
+		{
+			if (oldIndex < this->position)
+				return oldIndex;
+
+			if (oldIndex < this->position + this->erased)
+				return npos;
+
+			return oldIndex - this->erased + this->inserted;
+		}
+
+		///Old index of a new one, npos if it is inserted
+		inline size_t ToOld(size_t newIndex) const
+		{
+			if (newIndex < this->position)
+				return newIndex;
+
+			if (newIndex < this->position + this->inserted)
+				return npos;
+
+			return newIndex - this->inserted + this->erased;
+		}
+	};
+
+	///Checks the new dimensions and picks the layout and capacity for them. With
+	///geometricGrowth a reallocation at least doubles the capacity (and the row
+	///space of layouts that reserve columns) so repeated growth is amortised.
+	void ChangeShape(const AxisChange& columnChange, const AxisChange& rowChange,
+		const value_type* filler, bool geometricGrowth)
+	{
+		const size_t dimensionLimit = std::numeric_limits<dimension_type>::max();
+
+		size_t newColumnCount = columnChange.NewCount(this->columnCount);
+		size_t newRowCount = rowChange.NewCount(this->rowCount);
+
+		if (newColumnCount > dimensionLimit || newRowCount > dimensionLimit)
+			throw std::length_error("Grid dimensions cannot exceed dimension_type");
+
+		if (newColumnCount == 0 || newRowCount == 0)
+		{
+			FreeGridData();
+			return;
+		}
+
+		layout_type newLayout = this->layout;
+
+		if constexpr (LayoutReservesColumns<layout_type>::value)
+		{
+			if (geometricGrowth && newColumnCount > this->layout.GetRowPitch())
+				newLayout.ReserveColumns(std::min(std::max(newColumnCount, size_t(this->columnCount) * 2), dimensionLimit));
+		}
+
+		SetCheckedDimensions(newLayout, newColumnCount, newRowCount);
+
+		size_t minimumCapacity = 0;
+
+		//Only strided layouts can grow into spare capacity, the others always move
+		if (layout_type::is_strided && geometricGrowth && newLayout.GetStorageSize() > this->storageCapacity)
+			minimumCapacity = std::max(newLayout.GetStorageSize(), this->storageCapacity * 2);
+
+		Relayout(newLayout, columnChange, rowChange, filler, minimumCapacity);
+	}
+
+	///Shifts the cells inside the current storage when the layout is strided, the
+	///capacity is large enough and moving cannot throw. Otherwise moves them into
+	///new storage of at least minimumCapacity elements.
+	void Relayout(const layout_type& newLayout, const AxisChange& columnChange, const AxisChange& rowChange,
+		const value_type* filler, size_t minimumCapacity)
+	{
+		size_t capacityNeeded = std::max(newLayout.GetStorageSize(), minimumCapacity);
+
+		if constexpr (layout_type::is_strided && std::is_nothrow_move_constructible<value_type>::value)
+		{
+			if (this->grid_data && this->ownsStorage && capacityNeeded <= this->storageCapacity)
+			{
+				RelayoutInPlace(newLayout, columnChange, rowChange, filler);
+				return;
+			}
+		}
+
+		RelayoutIntoNewStorage(newLayout, columnChange, rowChange, filler, capacityNeeded);
+	}
+
+	///Calls function(column, row) for the cells of [firstColumn, lastColumn) x
+	///[firstRow, lastRow) in increasing storage order of a strided layout, or in
+	///decreasing order when reversed
+	template<typename Function>
+	static void ForEachCellInRectangle(size_t firstColumn, size_t lastColumn, size_t firstRow, size_t lastRow,
+		bool reversed, Function function)
+	{
+		if (firstColumn >= lastColumn || firstRow >= lastRow)
+			return;
+
+		//Strided layouts with contiguous rows are row major, the others column major
+		size_t outerFirst = layout_type::contiguous_rows ? firstRow : firstColumn;
+		size_t outerCount = layout_type::contiguous_rows ? lastRow - firstRow : lastColumn - firstColumn;
+		size_t innerFirst = layout_type::contiguous_rows ? firstColumn : firstRow;
+		size_t innerCount = layout_type::contiguous_rows ? lastColumn - firstColumn : lastRow - firstRow;
+
+		for (size_t outerStep = 0; outerStep < outerCount; outerStep++)
+		{
+			size_t outer = reversed ? outerFirst + outerCount - 1 - outerStep : outerFirst + outerStep;
+
+			for (size_t innerStep = 0; innerStep < innerCount; innerStep++)
+			{
+				size_t inner = reversed ? innerFirst + innerCount - 1 - innerStep : innerFirst + innerStep;
+
+				if constexpr (layout_type::contiguous_rows)
+					function(inner, outer);
+				else
+					function(outer, inner);
+			}
+		}
+	}
+
+	///Calls function(column, row) once for every cell of a columnCount x rowCount
+	///grid that lies in the column band or in the row band
+	template<typename Function>
+	static void ForEachCellInBands(size_t targetColumnCount, size_t targetRowCount, size_t bandColumn,
+		size_t bandColumns, size_t bandRow, size_t bandRows, Function function)
+	{
+		ForEachCellInRectangle(0, targetColumnCount, bandRow, bandRow + bandRows, false, function);
+		ForEachCellInRectangle(bandColumn, bandColumn + bandColumns, 0, bandRow, false, function);
+		ForEachCellInRectangle(bandColumn, bandColumn + bandColumns, bandRow + bandRows, targetRowCount, false, function);
+	}
+
+	///Padded layouts are banded by whole rows to skip the padding, all other
+	///layouts by runs of storage, which hold no holes
+	size_t GetBandCount() const
+	{
+		if (isEmpty())
+			return 0;
+
+		if constexpr (layout_type::has_padding)
+			return GetRowBandCount();
+		else
+			return (size_t(size()) + GetCellsPerBand() - 1) / GetCellsPerBand();
+	}
+
+	static constexpr size_t GetCellsPerBand()
+	{
+		return std::max<size_t>(1, GridExecution::band_bytes / sizeof(value_type));
+	}
+
+	size_t GetRowsPerBand() const
+	{
+		return std::max<size_t>(1, GridExecution::band_bytes / (std::max<size_t>(this->columnCount, 1) * sizeof(value_type)));
+	}
+
+	size_t GetRowBandCount() const
+	{
+		return (size_t(this->rowCount) + GetRowsPerBand() - 1) / GetRowsPerBand();
+	}
+
+	///Calls spanFunction(cells, count) for the contiguous runs of cells in band
+	template<typename Span_Function>
+	void ForEachSpanInBand(size_t band, Span_Function spanFunction) const
+	{
+		if constexpr (layout_type::has_padding)
+		{
+			size_t lastRow = std::min<size_t>((band + 1) * GetRowsPerBand(), this->rowCount);
+
+			for (size_t row = band * GetRowsPerBand(); row < lastRow; row++)
+				spanFunction(this->grid_data + this->layout.GetOneDimensionIndex(0, row), size_t(this->columnCount));
+		}
+		else
+		{
+			size_t first = band * GetCellsPerBand();
+			spanFunction(this->grid_data + first, std::min<size_t>(GetCellsPerBand(), size_t(size()) - first));
+		}
+	}
+
+	///Strided layouts only. Erased cells are destroyed first. Kept cells going
+	///towards the start of the storage are then moved in increasing storage order
+	///and those going towards the end in decreasing order; both layouts keep the
+	///cells in the same relative order, so no cell is overwritten before it has
+	///moved. Inserted cells are filled last. If filling throws the grid is emptied.
+	void RelayoutInPlace(const layout_type& newLayout, const AxisChange& columnChange, const AxisChange& rowChange,
+		const value_type* filler)
+	{
+		value_type* data = this->grid_data;
+		const layout_type& oldLayout = this->layout;
+
+		size_t newColumnCount = columnChange.NewCount(this->columnCount);
+		size_t newRowCount = rowChange.NewCount(this->rowCount);
+
+		if constexpr (!std::is_trivially_destructible<value_type>::value)
+		{
+			ForEachCellInBands(this->columnCount, this->rowCount, columnChange.position, columnChange.erased,
+				rowChange.position, rowChange.erased, [&](size_t column, size_t row)
+			{
+				DestroyCells(data + oldLayout.GetOneDimensionIndex(column, row), 1);
+			});
+		}
+
+		bool cellsStay = columnChange.KeepsOldIndices(this->columnCount) && rowChange.KeepsOldIndices(this->rowCount) &&
+			newLayout.GetColumnStride() == oldLayout.GetColumnStride() && newLayout.GetRowStride() == oldLayout.GetRowStride();
+
+		if (!cellsStay)
+		{
+			auto moveCell = [&](size_t column, size_t row, bool towardsStart)
+			{
+				size_t newColumn = columnChange.ToNew(column);
+				size_t newRow = rowChange.ToNew(row);
+
+				if (newColumn == AxisChange::npos || newRow == AxisChange::npos)
+					return;
+
+				size_t from = oldLayout.GetOneDimensionIndex(column, row);
+				size_t to = newLayout.GetOneDimensionIndex(newColumn, newRow);
+
+				if (towardsStart ? to < from : to > from)
+				{
+					::new (static_cast<void*>(data + to)) value_type(std::move(data[from]));
+					DestroyCells(data + from, 1);
+				}
+			};
+
+			ForEachCellInRectangle(0, this->columnCount, 0, this->rowCount, false, [&](size_t column, size_t row)
+			{
+				moveCell(column, row, true);
+			});
+
+			ForEachCellInRectangle(0, this->columnCount, 0, this->rowCount, true, [&](size_t column, size_t row)
+			{
+				moveCell(column, row, false);
+			});
+		}
+
+		size_t filled = 0;
+
+		try
+		{
+			ForEachCellInBands(newColumnCount, newRowCount, columnChange.position, columnChange.inserted,
+				rowChange.position, rowChange.inserted, [&](size_t column, size_t row)
+			{
+				::new (static_cast<void*>(data + newLayout.GetOneDimensionIndex(column, row))) value_type(*filler);
+				filled++;
+			});
+		}
+		catch (...)
+		{
+			//The old shape is already gone, so drop everything rather than leave a half built grid
+			ForEachCellInRectangle(0, newColumnCount, 0, newRowCount, false, [&](size_t column, size_t row)
+			{
+				if (columnChange.ToOld(column) != AxisChange::npos && rowChange.ToOld(row) != AxisChange::npos)
+					DestroyCells(data + newLayout.GetOneDimensionIndex(column, row), 1);
+			});
+
+			ForEachCellInBands(newColumnCount, newRowCount, columnChange.position, columnChange.inserted,
+				rowChange.position, rowChange.inserted, [&](size_t column, size_t row)
+			{
+				if (filled > 0)
+				{
+					DestroyCells(data + newLayout.GetOneDimensionIndex(column, row), 1);
+					filled--;
+				}
+			});
+
+			this->rowCount = this->columnCount = 0;
+			FreeGridData();
+			throw;
+		}
+
+		this->columnCount = dimension_type(newColumnCount);
+		this->rowCount = dimension_type(newRowCount);
+		this->layout = newLayout;
+	}
+
+	///Builds the new shape in fresh storage of the given capacity, so a failure
+	///leaves the grid as it was. Every copy of filler is made before the first old
+	///cell is relocated, so old cells are only moved out once nothing else can throw.
+	void RelayoutIntoNewStorage(const layout_type& newLayout, const AxisChange& columnChange,
+		const AxisChange& rowChange, const value_type* filler, size_t newCapacity)
+	{
+		size_t newColumnCount = columnChange.NewCount(this->columnCount);
+		size_t newRowCount = rowChange.NewCount(this->rowCount);
+
+		value_type* data = AllocateStorage(newCapacity);
+
+		//Both walks visit the runs in the same order, which is how they are cleaned up
+		size_t filled = 0;
+		size_t relocated = 0;
+
+		try
+		{
+			ForEachInsertedRun(data, newLayout, columnChange, rowChange, [&](value_type* cells, size_t count)
+			{
+				std::uninitialized_fill(cells, cells + count, *filler);
+				filled += count;
+			});
+
+			ForEachKeptRun(data, newLayout, columnChange, rowChange, [&](value_type* source, value_type* destination, size_t count)
+			{
+				RelocateCells(source, count, destination);
+				relocated += count;
+			});
+		}
+		catch (...)
+		{
+			ForEachInsertedRun(data, newLayout, columnChange, rowChange, [&](value_type* cells, size_t count)
+			{
+				count = std::min(count, filled);
+				DestroyCells(cells, count);
+				filled -= count;
+			});
+
+			ForEachKeptRun(data, newLayout, columnChange, rowChange, [&](value_type*, value_type* destination, size_t count)
+			{
+				count = std::min(count, relocated);
+				DestroyCells(destination, count);
+				relocated -= count;
+			});
+
+			DeallocateStorage(data, newCapacity);
+			throw;
+		}
+
+		FreeGridData();
+
+		this->grid_data = data;
+		this->storageCapacity = newCapacity;
+		this->columnCount = dimension_type(newColumnCount);
+		this->rowCount = dimension_type(newRowCount);
+		this->layout = newLayout;
+	}
+
+	///Calls function(cells, count) for each run of cells in data, laid out by
+	///newLayout, that have no old cell and take the filler
+	template<typename Function>
+	void ForEachInsertedRun(value_type* data, const layout_type& newLayout, const AxisChange& columnChange,
+		const AxisChange& rowChange, Function function) const
+	{
+		size_t newColumnCount = columnChange.NewCount(this->columnCount);
+		size_t newRowCount = rowChange.NewCount(this->rowCount);
+
+		if constexpr (layout_type::contiguous_rows)
+		{
+			for (size_t row = 0; row < newRowCount; row++)
+			{
+				value_type* destination = data + newLayout.GetOneDimensionIndex(0, row);
+
+				if (rowChange.ToOld(row) == AxisChange::npos)
+					function(destination, newColumnCount);
+				else if (columnChange.inserted > 0)
+					function(destination + columnChange.position, columnChange.inserted);
+			}
+		}
+		else
+		{
+			newLayout.ForEachCell([&](size_t column, size_t row, size_t index)
+			{
+				if (columnChange.ToOld(column) == AxisChange::npos || rowChange.ToOld(row) == AxisChange::npos)
+					function(data + index, 1);
+			});
+		}
+	}
+
+	///Calls function(source, destination, count) for each run of old cells that
+	///survive into data, laid out by newLayout. A kept row of a layout with
+	///contiguous rows is at most two runs, the columns before the change and the
+	///shifted columns after it.
+	template<typename Function>
+	void ForEachKeptRun(value_type* data, const layout_type& newLayout, const AxisChange& columnChange,
+		const AxisChange& rowChange, Function function) const
+	{
+		size_t newColumnCount = columnChange.NewCount(this->columnCount);
+		size_t newRowCount = rowChange.NewCount(this->rowCount);
+
+		if constexpr (layout_type::contiguous_rows)
+		{
+			size_t leading = columnChange.position;
+			size_t trailing = newColumnCount - leading - columnChange.inserted;
+
+			for (size_t row = 0; row < newRowCount; row++)
+			{
+				size_t sourceRow = rowChange.ToOld(row);
+
+				if (sourceRow == AxisChange::npos)
+					continue;
+
+				value_type* source = this->grid_data + this->layout.GetOneDimensionIndex(0, sourceRow);
+				value_type* destination = data + newLayout.GetOneDimensionIndex(0, row);
+
+				if (leading > 0)
+					function(source, destination, leading);
+
+				if (trailing > 0)
+					function(source + leading + columnChange.erased, destination + leading + columnChange.inserted, trailing);
+			}
+		}
+		else
+		{
+			newLayout.ForEachCell([&](size_t column, size_t row, size_t index)
+			{
+				size_t sourceColumn = columnChange.ToOld(column);
+				size_t sourceRow = rowChange.ToOld(row);
+
+				if (sourceColumn != AxisChange::npos && sourceRow != AxisChange::npos)
+					function(this->grid_data + this->layout.GetOneDimensionIndex(sourceColumn, sourceRow), data + index, 1);
+			});
+		}
+	}
+
+	template<typename Iterator_Type, typename Pointer_Type>
+	Iterator_Type MakeIterator(Pointer_Type storage, size_t cellIndex) const
+	{
+		Pointer_Type last = storage == nullptr ? storage : storage + this->layout.GetStorageSize();
+
+		if constexpr (layout_type::has_padding)
+		{
+			if (this->columnCount == 0)
+				return Iterator_Type(storage, 0, 0, 0, storage, last);
+
+			return Iterator_Type(storage + (cellIndex / this->columnCount) * this->layout.GetRowPitch(),
+				cellIndex % this->columnCount, this->columnCount, this->layout.GetRowPitch(), storage, last);
+		}
+		else
+		{
+			return Iterator_Type(storage + cellIndex, storage, last);
+		}
+	}
+
+	template<typename Pointer_Type>
+	auto MakeRow(Pointer_Type storage, dimension_type rowIndex) const
+	{
+		static_assert(layout_type::is_strided, "Grid-GetRow needs a strided layout");
+		Access_Policy::Check(rowIndex < this->rowCount, "Grid-GetRow Argument Out of Range");
+
+		if (rowIndex >= this->rowCount)
+			storage = nullptr;
+		else
+			storage += this->layout.GetOneDimensionIndex(0, rowIndex);
+
+		size_t length = storage == nullptr ? 0 : size_t(this->columnCount);
+
+		if constexpr (layout_type::contiguous_rows)
+		{
+			return GridRange<Pointer_Type>(storage, storage + length);
+		}
+		else
+		{
+			typedef GridStrideIterator<typename std::remove_pointer<Pointer_Type>::type> stride_iterator;
+			std::ptrdiff_t stride = std::ptrdiff_t(this->layout.GetColumnStride());
+
+			return GridRange<stride_iterator>(stride_iterator(storage, stride),
+				stride_iterator(storage + std::ptrdiff_t(length) * stride, stride));
+		}
+	}
+
+	template<typename Pointer_Type>
+	auto MakeColumn(Pointer_Type storage, dimension_type columnIndex) const
+	{
+		static_assert(layout_type::is_strided, "Grid-GetColumn needs a strided layout");
+		Access_Policy::Check(columnIndex < this->columnCount, "Grid-GetColumn Argument Out of Range");
+
+		typedef GridStrideIterator<typename std::remove_pointer<Pointer_Type>::type> stride_iterator;
+		std::ptrdiff_t stride = std::ptrdiff_t(this->layout.GetRowStride());
+
+		if (columnIndex >= this->columnCount || this->rowCount == 0)
+			return GridRange<stride_iterator>(stride_iterator(nullptr, stride), stride_iterator(nullptr, stride));
+
+		storage += this->layout.GetOneDimensionIndex(columnIndex, 0);
+
+		return GridRange<stride_iterator>(stride_iterator(storage, stride),
+			stride_iterator(storage + std::ptrdiff_t(this->rowCount) * stride, stride));
+	}
+
+	///Clipped tiles are stored compactly, so a tile is the run from its first
+	///cell with the tile's clipped width times height cells
+	template<typename Pointer_Type>
+	GridRange<Pointer_Type> MakeTile(Pointer_Type storage, size_t tileColumn, size_t tileRow) const
+	{
+		const size_t tileSize = layout_type::tile_size;
+
+		Access_Policy::Check(tileColumn < GetTileColumnCount() && tileRow < GetTileRowCount(),
+			"Grid-GetTile Arguments Out of Range");
+
+		if (tileColumn >= GetTileColumnCount() || tileRow >= GetTileRowCount())
+			return GridRange<Pointer_Type>(nullptr, nullptr);
+
+		size_t column = tileColumn * tileSize;
+		size_t row = tileRow * tileSize;
+		size_t width = std::min(tileSize, size_t(this->columnCount) - column);
+		size_t height = std::min(tileSize, size_t(this->rowCount) - row);
+
+		storage += this->layout.GetOneDimensionIndex(column, row);
+
+		return GridRange<Pointer_Type>(storage, storage + width * height);
 	}
-	
 };
 
+///Grid drawing its memory from a std::pmr::memory_resource
+template<typename Data_Type, typename Layout_Type = RowMajorLayout>
+using PmrGrid = Grid<Data_Type, Layout_Type, std::pmr::polymorphic_allocator<Data_Type>>;
+
+///Grid with 32 bit dimensions and 64 bit sizes, for dense grids past 65535 cells
+///a side. Pair it with HugePageAllocator (GridAllocators.h) once they reach
+///gigabytes.
+template<typename Data_Type, typename Layout_Type = RowMajorLayout,
+	typename Allocator_Type = std::allocator<Data_Type>>
+using LargeGrid = Grid<Data_Type, Layout_Type, Allocator_Type, std::uint32_t>;
+
+///Grid that never checks an access, whatever the build's default policy
+template<typename Data_Type, typename Layout_Type = RowMajorLayout,
+	typename Allocator_Type = std::allocator<Data_Type>>
+using UncheckedGrid = Grid<Data_Type, Layout_Type, Allocator_Type, std::uint16_t, GridUncheckedAccess>;
+
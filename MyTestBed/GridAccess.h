@@ -0,0 +1,122 @@
+#pragma once
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+
+///Access policies decide what Grid and GridView do with an out of range cell
+///access through GetCell, operator[] or an iterator. Each provides
+///
+///	static constexpr bool checks
+///		false only when Check does nothing in every build, so iterators need
+///		not carry the bounds of the storage they walk. It must not depend on
+///		NDEBUG, it decides the layout of the iterators.
+///	static void Check(bool inRange, const char* message)
+///		called with the outcome of the bounds test before every access
+///
+///The test is a plain comparison, so with GridUncheckedAccess the compiler drops
+///it and the access is a bare load.
+
+///No checks at all, for release builds of code already validated
+struct GridUncheckedAccess
+{
+	static constexpr bool checks = false;
+
+	static inline void Check(bool, const char*)
+	{
+
+	}
+};
+
+///assert in debug builds, nothing once NDEBUG is defined. checks stays true in
+///every build so iterators keep the same layout whether or not a translation
+///unit defines NDEBUG; only the body of Check changes.
+struct GridAssertedAccess
+{
+	static constexpr bool checks = true;
+
+	static inline void Check(bool inRange, const char* message)
+	{
+		assert(inRange && message);
+		(void)inRange;
+		(void)message;
+	}
+};
+
+///Throws std::out_of_range, in every build
+struct GridCheckedAccess
+{
+	static constexpr bool checks = true;
+
+	static inline void Check(bool inRange, const char* message)
+	{
+		if (!inRange)
+			throw std::out_of_range(message);
+	}
+};
+
+///The policy Grid and GridView use when none is named. GridAssertedAccess, so
+///default grids check in debug builds and are bare loads under NDEBUG. Code that
+///wants std::out_of_range names GridCheckedAccess; a build can also switch every
+///default grid with GRID_ACCESS_CHECKED or GRID_ACCESS_UNCHECKED.
+#if defined(GRID_ACCESS_CHECKED)
+typedef GridCheckedAccess GridDefaultAccess;
+#elif defined(GRID_ACCESS_UNCHECKED)
+typedef GridUncheckedAccess GridDefaultAccess;
+#else
+typedef GridAssertedAccess GridDefaultAccess;
+#endif
+
+///Bounds carried by Grid's iterators, only when the policy checks anything
+template<typename Access_Policy, typename Data_Type, bool = Access_Policy::checks>
+class GridIteratorBounds
+{
+public:
+	GridIteratorBounds(Data_Type*, Data_Type*)
+	{
+
+	}
+
+	template<typename Other_Data_Type>
+	GridIteratorBounds(const GridIteratorBounds<Access_Policy, Other_Data_Type, false>&)
+	{
+
+	}
+
+protected:
+	inline void CheckAddress(const Data_Type*) const
+	{
+
+	}
+};
+
+template<typename Access_Policy, typename Data_Type>
+class GridIteratorBounds<Access_Policy, Data_Type, true>
+{
+	template<typename, typename, bool>
+	friend class GridIteratorBounds;
+
+public:
+	GridIteratorBounds(Data_Type* _first, Data_Type* _last)
+		:first(_first), last(_last)
+	{
+
+	}
+
+	///Bounds of a mutable iterator carry over to its const form
+	template<typename Other_Data_Type>
+	GridIteratorBounds(const GridIteratorBounds<Access_Policy, Other_Data_Type, true>& other)
+		:first(other.first), last(other.last)
+	{
+
+	}
+
+protected:
+	Data_Type* first;
+	Data_Type* last;
+
+	inline void CheckAddress(const Data_Type* address) const
+	{
+		std::less<const Data_Type*> less;
+		Access_Policy::Check(!less(address, this->first) && less(address, this->last), "Grid iterator Out of Range");
+	}
+};
@@ -0,0 +1,163 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+///std::allocator compatible allocator returning memory aligned to Alignment
+///bytes (at least the natural alignment of Data_Type). Use it together with
+///PaddedRowMajorLayout so every row of a Grid starts on a cache line or SIMD
+///register boundary.
+template<typename Data_Type, std::size_t Alignment = 64>
+class AlignedAllocator
+{
+	static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0,
+		"Alignment must be a power of two");
+
+public:
+	typedef Data_Type value_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef std::true_type is_always_equal;
+	typedef std::true_type propagate_on_container_move_assignment;
+
+	static constexpr std::size_t alignment = Alignment < alignof(Data_Type) ? alignof(Data_Type) : Alignment;
+
+	template<typename Other_Type>
+	struct rebind
+	{
+		typedef AlignedAllocator<Other_Type, Alignment> other;
+	};
+
+	AlignedAllocator() noexcept
+	{
+
+	}
+
+	template<typename Other_Type>
+	AlignedAllocator(const AlignedAllocator<Other_Type, Alignment>&) noexcept
+	{
+
+	}
+
+	Data_Type* allocate(std::size_t count)
+	{
+		if (count > std::numeric_limits<std::size_t>::max() / sizeof(Data_Type))
+			throw std::bad_array_new_length();
+
+		return static_cast<Data_Type*>(::operator new(count * sizeof(Data_Type), std::align_val_t(alignment)));
+	}
+
+	void deallocate(Data_Type* pointer, std::size_t /*count*/) noexcept
+	{
+		::operator delete(pointer, std::align_val_t(alignment));
+	}
+
+	template<typename Other_Type>
+	bool operator==(const AlignedAllocator<Other_Type, Alignment>&) const noexcept
+	{
+		return true;
+	}
+
+	template<typename Other_Type>
+	bool operator!=(const AlignedAllocator<Other_Type, Alignment>&) const noexcept
+	{
+		return false;
+	}
+};
+
+///std::allocator compatible allocator that backs every allocation of at least
+///Threshold_Bytes with transparent huge pages, cutting TLB misses when walking
+///very large grids (see LargeGrid in Grid.h). Such blocks are rounded up to whole
+///2 MiB pages, aligned to them and, on Linux, marked with MADV_HUGEPAGE. Other
+///platforms only get the alignment and leave the page size to the OS. Smaller
+///allocations behave like std::allocator.
+template<typename Data_Type, std::size_t Threshold_Bytes = std::size_t(1) << 21>
+class HugePageAllocator
+{
+public:
+	typedef Data_Type value_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef std::true_type is_always_equal;
+	typedef std::true_type propagate_on_container_move_assignment;
+
+	static constexpr std::size_t huge_page_size = std::size_t(1) << 21;
+	static constexpr std::size_t threshold_bytes = Threshold_Bytes;
+
+	template<typename Other_Type>
+	struct rebind
+	{
+		typedef HugePageAllocator<Other_Type, Threshold_Bytes> other;
+	};
+
+	HugePageAllocator() noexcept
+	{
+
+	}
+
+	template<typename Other_Type>
+	HugePageAllocator(const HugePageAllocator<Other_Type, Threshold_Bytes>&) noexcept
+	{
+
+	}
+
+	Data_Type* allocate(std::size_t count)
+	{
+		if (count > std::numeric_limits<std::size_t>::max() / sizeof(Data_Type) - huge_page_size)
+			throw std::bad_array_new_length();
+
+		std::size_t bytes = count * sizeof(Data_Type);
+
+		if (!UsesHugePages(bytes))
+			return static_cast<Data_Type*>(::operator new(bytes, std::align_val_t(alignof(Data_Type))));
+
+		std::size_t pageBytes = RoundToHugePages(bytes);
+		void* pointer = ::operator new(pageBytes, std::align_val_t(huge_page_size));
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+		//Only a hint, the kernel may still use small pages if THP is disabled
+		madvise(pointer, pageBytes, MADV_HUGEPAGE);
+#endif
+
+		return static_cast<Data_Type*>(pointer);
+	}
+
+	void deallocate(Data_Type* pointer, std::size_t count) noexcept
+	{
+		if (UsesHugePages(count * sizeof(Data_Type)))
+			::operator delete(pointer, std::align_val_t(huge_page_size));
+		else
+			::operator delete(pointer, std::align_val_t(alignof(Data_Type)));
+	}
+
+	///True when an allocation of this many bytes is backed by huge pages
+	static constexpr bool UsesHugePages(std::size_t bytes)
+	{
+		return bytes >= Threshold_Bytes;
+	}
+
+	template<typename Other_Type>
+	bool operator==(const HugePageAllocator<Other_Type, Threshold_Bytes>&) const noexcept
+	{
+		return true;
+	}
+
+	template<typename Other_Type>
+	bool operator!=(const HugePageAllocator<Other_Type, Threshold_Bytes>&) const noexcept
+	{
+		return false;
+	}
+
+private:
+	static constexpr std::size_t RoundToHugePages(std::size_t bytes)
+	{
+		return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+	}
+};
@@ -0,0 +1,236 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+///Compresses the bytes of one band of a saved grid (see GridSerializer.h). Save
+///takes any codec; Load recognises the built in ones by id and needs any other
+///passed in.
+class GridCodec
+{
+public:
+	virtual ~GridCodec()
+	{
+
+	}
+
+	///Written to the file, ids below 16 are reserved for the built in codecs
+	virtual std::uint32_t GetId() const = 0;
+
+	///Replaces output with the compressed form of input
+	virtual void Compress(const unsigned char* input, std::size_t inputSize,
+		std::vector<unsigned char>& output) const = 0;
+
+	///Fills exactly outputSize bytes. Throws std::runtime_error on corrupt input.
+	virtual void Decompress(const unsigned char* input, std::size_t inputSize,
+		unsigned char* output, std::size_t outputSize) const = 0;
+};
+
+///Stores the bytes as they are
+class GridRawCodec : public GridCodec
+{
+public:
+	static constexpr std::uint32_t id = 0;
+
+	std::uint32_t GetId() const override
+	{
+		return id;
+	}
+
+	void Compress(const unsigned char* input, std::size_t inputSize,
+		std::vector<unsigned char>& output) const override
+	{
+		output.assign(input, input + inputSize);
+	}
+
+	void Decompress(const unsigned char* input, std::size_t inputSize,
+		unsigned char* output, std::size_t outputSize) const override
+	{
+		if (inputSize != outputSize)
+			throw std::runtime_error("GridRawCodec band size mismatch");
+
+		std::memcpy(output, input, inputSize);
+	}
+};
+
+///Byte oriented LZ77 in the style of an LZ4 block: sequences of literals and a
+///back reference of at least 4 bytes within the last 64 KiB, found through a
+///hash of the next 4 bytes. Fast on both sides and good on grids with runs or
+///repeated rows, which is what most map layers are.
+class GridLzCodec : public GridCodec
+{
+public:
+	static constexpr std::uint32_t id = 1;
+
+	std::uint32_t GetId() const override
+	{
+		return id;
+	}
+
+	void Compress(const unsigned char* input, std::size_t inputSize,
+		std::vector<unsigned char>& output) const override
+	{
+		output.clear();
+		output.reserve(inputSize + inputSize / 255 + 16);
+
+		//Positions are stored plus one so zero means empty
+		std::vector<std::uint32_t> table(std::size_t(1) << hash_bits, 0);
+
+		std::size_t anchor = 0;
+		std::size_t position = 0;
+
+		//The last bytes are always literals, which keeps the match search in bounds
+		std::size_t matchLimit = inputSize > last_literals ? inputSize - last_literals : 0;
+
+		while (position + min_match <= matchLimit)
+		{
+			std::uint32_t sequence = Read32(input + position);
+			std::uint32_t& slot = table[Hash(sequence)];
+			std::size_t candidate = slot;
+
+			slot = std::uint32_t(position + 1);
+
+			if (candidate == 0 || position + 1 - candidate > max_offset || Read32(input + candidate - 1) != sequence)
+			{
+				position++;
+				continue;
+			}
+
+			candidate--;
+
+			std::size_t matchLength = min_match;
+
+			while (position + matchLength < matchLimit && input[candidate + matchLength] == input[position + matchLength])
+				matchLength++;
+
+			WriteSequence(output, input + anchor, position - anchor, position - candidate, matchLength);
+
+			position += matchLength;
+			anchor = position;
+		}
+
+		WriteSequence(output, input + anchor, inputSize - anchor, 0, 0);
+	}
+
+	void Decompress(const unsigned char* input, std::size_t inputSize,
+		unsigned char* output, std::size_t outputSize) const override
+	{
+		const unsigned char* inputEnd = input + inputSize;
+		std::size_t written = 0;
+
+		while (input < inputEnd)
+		{
+			unsigned char token = *input++;
+
+			std::size_t literalLength = ReadLength(input, inputEnd, token >> 4);
+
+			if (literalLength > std::size_t(inputEnd - input) || literalLength > outputSize - written)
+				throw std::runtime_error("GridLzCodec corrupt literals");
+
+			std::memcpy(output + written, input, literalLength);
+			input += literalLength;
+			written += literalLength;
+
+			//The final sequence has no match
+			if (input == inputEnd)
+				break;
+
+			if (inputEnd - input < 2)
+				throw std::runtime_error("GridLzCodec corrupt offset");
+
+			std::size_t offset = std::size_t(input[0]) | (std::size_t(input[1]) << 8);
+			input += 2;
+
+			std::size_t matchLength = ReadLength(input, inputEnd, token & 15) + min_match;
+
+			if (offset == 0 || offset > written || matchLength > outputSize - written)
+				throw std::runtime_error("GridLzCodec corrupt match");
+
+			//Byte by byte, a match may overlap the bytes it produces
+			unsigned char* target = output + written;
+			const unsigned char* source = target - offset;
+
+			for (std::size_t index = 0; index < matchLength; index++)
+				target[index] = source[index];
+
+			written += matchLength;
+		}
+
+		if (written != outputSize)
+			throw std::runtime_error("GridLzCodec band size mismatch");
+	}
+
+private:
+	static constexpr std::size_t min_match = 4;
+	static constexpr std::size_t max_offset = 65535;
+	static constexpr std::size_t last_literals = 8;
+	static constexpr unsigned hash_bits = 14;
+
+	static inline std::uint32_t Read32(const unsigned char* data)
+	{
+		std::uint32_t value;
+		std::memcpy(&value, data, sizeof(value));
+		return value;
+	}
+
+	static inline std::size_t Hash(std::uint32_t sequence)
+	{
+		return std::size_t((sequence * 2654435761u) >> (32 - hash_bits));
+	}
+
+	///Lengths of 15 and more continue in extra bytes of 255 until a smaller one
+	static void WriteLength(std::vector<unsigned char>& output, std::size_t length)
+	{
+		for (; length >= 255; length -= 255)
+			output.push_back(255);
+
+		output.push_back(static_cast<unsigned char>(length));
+	}
+
+	static std::size_t ReadLength(const unsigned char*& input, const unsigned char* inputEnd, std::size_t nibble)
+	{
+		std::size_t length = nibble;
+
+		if (nibble == 15)
+		{
+			unsigned char extra;
+
+			do
+			{
+				if (input == inputEnd)
+					throw std::runtime_error("GridLzCodec corrupt length");
+
+				extra = *input++;
+				length += extra;
+			} while (extra == 255);
+		}
+
+		return length;
+	}
+
+	///A zero matchLength writes the closing literals only
+	static void WriteSequence(std::vector<unsigned char>& output, const unsigned char* literals,
+		std::size_t literalLength, std::size_t offset, std::size_t matchLength)
+	{
+		std::size_t matchCode = matchLength > 0 ? matchLength - min_match : 0;
+
+		output.push_back(static_cast<unsigned char>(((literalLength < 15 ? literalLength : 15) << 4) |
+			(matchCode < 15 ? matchCode : 15)));
+
+		if (literalLength >= 15)
+			WriteLength(output, literalLength - 15);
+
+		output.insert(output.end(), literals, literals + literalLength);
+
+		if (matchLength == 0)
+			return;
+
+		output.push_back(static_cast<unsigned char>(offset & 0xFF));
+		output.push_back(static_cast<unsigned char>(offset >> 8));
+
+		if (matchCode >= 15)
+			WriteLength(output, matchCode - 15);
+	}
+};
@@ -0,0 +1,313 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+///Runs index based jobs on a fixed set of threads. Every thread, the caller
+///included, starts on its own slice of the indices and steals single indices
+///from the back of other slices once its own runs out, so uneven bands still
+///balance out. Jobs run one at a time; a job started from inside a job runs on
+///the calling thread.
+class GridThreadPool
+{
+public:
+	///threadCount counts the calling thread, 1 runs everything on the caller
+	explicit GridThreadPool(std::size_t threadCount = std::thread::hardware_concurrency())
+		:currentJob(nullptr), generation(0), activeWorkers(0), stopping(false)
+	{
+		threadCount = std::max<std::size_t>(threadCount, 1);
+
+		for (std::size_t worker = 1; worker < threadCount; worker++)
+			this->workers.emplace_back([this, worker]() { WorkerLoop(worker); });
+	}
+
+	GridThreadPool(const GridThreadPool&) = delete;
+	GridThreadPool& operator=(const GridThreadPool&) = delete;
+
+	~GridThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->stopping = true;
+		}
+
+		this->wake.notify_all();
+
+		for (std::thread& worker : this->workers)
+			worker.join();
+	}
+
+	///Shared by the parallel policies unless they are given a pool of their own
+	static GridThreadPool& Default()
+	{
+		static GridThreadPool pool;
+		return pool;
+	}
+
+	inline std::size_t GetThreadCount() const
+	{
+		return this->workers.size() + 1;
+	}
+
+	///Calls task(index) once for every index below taskCount and returns when all
+	///are done. The first exception thrown is rethrown here, indices that had not
+	///started yet are skipped.
+	template<typename Task_Type>
+	void ParallelFor(std::size_t taskCount, Task_Type&& task)
+	{
+		if (taskCount <= 1 || this->workers.empty() || InsideJob())
+		{
+			for (std::size_t index = 0; index < taskCount; index++)
+				task(index);
+
+			return;
+		}
+
+		std::lock_guard<std::mutex> submitLock(this->submitMutex);
+
+		Job job(taskCount, GetThreadCount());
+		job.run = &RunTask<typename std::remove_reference<Task_Type>::type>;
+		job.task = const_cast<void*>(static_cast<const void*>(&task));
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->currentJob = &job;
+			this->generation++;
+		}
+
+		this->wake.notify_all();
+
+		RunParticipant(job, 0);
+
+		//Workers that never picked the job up must not find it after this returns
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->currentJob = nullptr;
+		this->done.wait(lock, [this]() { return this->activeWorkers == 0; });
+
+		if (job.error)
+			std::rethrow_exception(job.error);
+	}
+
+private:
+	///The not yet started indices of one thread's slice
+	struct Slice
+	{
+		std::mutex mutex;
+		std::size_t begin = 0;
+		std::size_t end = 0;
+	};
+
+	struct Job
+	{
+		Job(std::size_t taskCount, std::size_t participantCount)
+			:slices(new Slice[participantCount]), sliceCount(participantCount), failed(false)
+		{
+			for (std::size_t participant = 0; participant < participantCount; participant++)
+			{
+				this->slices[participant].begin = taskCount * participant / participantCount;
+				this->slices[participant].end = taskCount * (participant + 1) / participantCount;
+			}
+		}
+
+		void (*run)(void* task, std::size_t index);
+		void* task;
+
+		std::unique_ptr<Slice[]> slices;
+		std::size_t sliceCount;
+
+		std::atomic<bool> failed;
+		std::mutex errorMutex;
+		std::exception_ptr error;
+	};
+
+	std::vector<std::thread> workers;
+
+	std::mutex submitMutex;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+
+	Job* currentJob;
+	std::size_t generation;
+	std::size_t activeWorkers;
+	bool stopping;
+
+	template<typename Task_Type>
+	static void RunTask(void* task, std::size_t index)
+	{
+		(*static_cast<Task_Type*>(task))(index);
+	}
+
+	static bool& InsideJob()
+	{
+		thread_local bool insideJob = false;
+		return insideJob;
+	}
+
+	static bool PopFront(Slice& slice, std::size_t& index)
+	{
+		std::lock_guard<std::mutex> lock(slice.mutex);
+
+		if (slice.begin == slice.end)
+			return false;
+
+		index = slice.begin++;
+		return true;
+	}
+
+	static bool PopBack(Slice& slice, std::size_t& index)
+	{
+		std::lock_guard<std::mutex> lock(slice.mutex);
+
+		if (slice.begin == slice.end)
+			return false;
+
+		index = --slice.end;
+		return true;
+	}
+
+	static void RunParticipant(Job& job, std::size_t participant)
+	{
+		InsideJob() = true;
+
+		std::size_t index;
+
+		while (!job.failed.load(std::memory_order_relaxed))
+		{
+			bool found = PopFront(job.slices[participant], index);
+
+			for (std::size_t offset = 1; !found && offset < job.sliceCount; offset++)
+				found = PopBack(job.slices[(participant + offset) % job.sliceCount], index);
+
+			if (!found)
+				break;
+
+			try
+			{
+				job.run(job.task, index);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(job.errorMutex);
+
+				if (!job.error)
+					job.error = std::current_exception();
+
+				job.failed = true;
+			}
+		}
+
+		InsideJob() = false;
+	}
+
+	void WorkerLoop(std::size_t participant)
+	{
+		std::size_t seenGeneration = 0;
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		while (true)
+		{
+			this->wake.wait(lock, [&]() { return this->stopping || this->generation != seenGeneration; });
+
+			if (this->stopping)
+				return;
+
+			seenGeneration = this->generation;
+
+			Job* job = this->currentJob;
+
+			if (!job)
+				continue;
+
+			this->activeWorkers++;
+			lock.unlock();
+
+			RunParticipant(*job, participant);
+
+			lock.lock();
+
+			if (--this->activeWorkers == 0)
+				this->done.notify_all();
+		}
+	}
+};
+
+///Execution policies taken by Grid's bulk operations (ForEach, Fill, Reduce...).
+///The work is always cut into the same bands, whatever the policy and thread
+///count, which is what keeps Reduce deterministic.
+namespace GridExecution
+{
+	///Target length of the bands bulk operations cut a grid into. Bands depend
+	///only on the dimensions, never on the policy.
+	inline constexpr std::size_t band_bytes = 64 * 1024;
+
+	///Every band on the calling thread, in order
+	struct SequencedPolicy
+	{
+
+	};
+
+	///Bands spread over a GridThreadPool, the default one unless On is used.
+	///The function may be called from several threads at once.
+	struct ParallelPolicy
+	{
+		GridThreadPool* pool = nullptr;
+
+		ParallelPolicy On(GridThreadPool& threadPool) const
+		{
+			return ParallelPolicy{ &threadPool };
+		}
+	};
+
+	///As ParallelPolicy, and the calls within a band may also be vectorised, so
+	///the function must not take locks
+	struct ParallelUnsequencedPolicy
+	{
+		GridThreadPool* pool = nullptr;
+
+		ParallelUnsequencedPolicy On(GridThreadPool& threadPool) const
+		{
+			return ParallelUnsequencedPolicy{ &threadPool };
+		}
+	};
+
+	inline constexpr SequencedPolicy seq{};
+	inline constexpr ParallelPolicy par{};
+	inline constexpr ParallelUnsequencedPolicy par_unseq{};
+
+	template<typename Policy_Type>
+	struct IsExecutionPolicy : std::disjunction<
+		std::is_same<typename std::decay<Policy_Type>::type, SequencedPolicy>,
+		std::is_same<typename std::decay<Policy_Type>::type, ParallelPolicy>,
+		std::is_same<typename std::decay<Policy_Type>::type, ParallelUnsequencedPolicy>>
+	{
+
+	};
+
+	///Runs bandFunction(band) for every band below bandCount under policy
+	template<typename Policy_Type, typename Band_Function>
+	void ForEachBand(const Policy_Type& policy, std::size_t bandCount, Band_Function&& bandFunction)
+	{
+		static_assert(IsExecutionPolicy<Policy_Type>::value, "Expected a GridExecution policy");
+
+		if constexpr (std::is_same<Policy_Type, SequencedPolicy>::value)
+		{
+			(void)policy;
+
+			for (std::size_t band = 0; band < bandCount; band++)
+				bandFunction(band);
+		}
+		else
+		{
+			GridThreadPool& pool = policy.pool ? *policy.pool : GridThreadPool::Default();
+			pool.ParallelFor(bandCount, bandFunction);
+		}
+	}
+}
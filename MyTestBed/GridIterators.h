@@ -0,0 +1,202 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "GridAccess.h"
+
+///Iterators and ranges over parts of a Grid or GridView that do not depend on
+///the grid type. Grid's own iterators live in Grid.h as nested classes.
+
+///Random access iterator over cells a fixed number of elements apart: one row or
+///one column of a GridView, or a column of a Grid with a strided layout. When
+///Access_Policy checks, dereferencing tests the address against the lowest and
+///highest cell of the line, as Grid's iterators test it against the storage.
+template<typename Data_Type, typename Access_Policy = GridUncheckedAccess>
+class GridStrideIterator : public GridIteratorBounds<Access_Policy, Data_Type>
+{
+	typedef GridIteratorBounds<Access_Policy, Data_Type> bounds_type;
+
+public:
+	typedef std::random_access_iterator_tag iterator_category;
+	typedef typename std::remove_const<Data_Type>::type value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef Data_Type* pointer;
+	typedef Data_Type& reference;
+
+	GridStrideIterator()
+		:bounds_type(nullptr, nullptr), cell(nullptr), stride(0)
+	{
+
+	}
+
+	GridStrideIterator(Data_Type* _cell, std::ptrdiff_t _stride)
+		:bounds_type(nullptr, nullptr), cell(_cell), stride(_stride)
+	{
+
+	}
+
+	///lowest and highest bound the addresses of the line's cells, for policies
+	///that check; highest is one past the cell at the highest address
+	GridStrideIterator(Data_Type* _cell, std::ptrdiff_t _stride, Data_Type* lowest, Data_Type* highest)
+		:bounds_type(lowest, highest), cell(_cell), stride(_stride)
+	{
+
+	}
+
+	reference operator*() const
+	{
+		this->CheckAddress(this->cell);
+		return *this->cell;
+	}
+
+	pointer operator->() const
+	{
+		this->CheckAddress(this->cell);
+		return this->cell;
+	}
+
+	reference operator[](difference_type offset) const
+	{
+		this->CheckAddress(this->cell + offset * this->stride);
+		return this->cell[offset * this->stride];
+	}
+
+	GridStrideIterator& operator++()
+	{
+		this->cell += this->stride;
+		return *this;
+	}
+
+	GridStrideIterator operator++(int)
+	{
+		GridStrideIterator previous(*this);
+		this->cell += this->stride;
+		return previous;
+	}
+
+	GridStrideIterator& operator--()
+	{
+		this->cell -= this->stride;
+		return *this;
+	}
+
+	GridStrideIterator operator--(int)
+	{
+		GridStrideIterator previous(*this);
+		this->cell -= this->stride;
+		return previous;
+	}
+
+	GridStrideIterator& operator+=(difference_type offset)
+	{
+		this->cell += offset * this->stride;
+		return *this;
+	}
+
+	GridStrideIterator& operator-=(difference_type offset)
+	{
+		this->cell -= offset * this->stride;
+		return *this;
+	}
+
+	GridStrideIterator operator+(difference_type offset) const
+	{
+		GridStrideIterator result(*this);
+		result.cell += offset * this->stride;
+		return result;
+	}
+
+	friend GridStrideIterator operator+(difference_type offset, const GridStrideIterator& iterator)
+	{
+		return iterator + offset;
+	}
+
+	GridStrideIterator operator-(difference_type offset) const
+	{
+		GridStrideIterator result(*this);
+		result.cell -= offset * this->stride;
+		return result;
+	}
+
+	difference_type operator-(const GridStrideIterator& rhs) const
+	{
+		return (this->cell - rhs.cell) / this->stride;
+	}
+
+	bool operator==(const GridStrideIterator& rhs) const { return this->cell == rhs.cell; }
+	bool operator!=(const GridStrideIterator& rhs) const { return this->cell != rhs.cell; }
+	bool operator<(const GridStrideIterator& rhs) const { return (rhs - *this) > 0; }
+	bool operator>(const GridStrideIterator& rhs) const { return rhs < *this; }
+	bool operator<=(const GridStrideIterator& rhs) const { return !(rhs < *this); }
+	bool operator>=(const GridStrideIterator& rhs) const { return !(*this < rhs); }
+
+private:
+	Data_Type* cell;
+	std::ptrdiff_t stride;
+};
+
+///A [begin, end) pair of iterators, what Grid's GetRow, GetColumn and GetTile
+///return. With pointer iterators the range is contiguous and standard algorithms
+///copy and fill it with memmove and memset. The range never owns its cells, it
+///stays valid as long as the grid is not resized.
+template<typename Iterator_Type>
+class GridRange
+{
+public:
+	typedef Iterator_Type iterator;
+	typedef typename std::iterator_traits<Iterator_Type>::value_type value_type;
+	typedef typename std::iterator_traits<Iterator_Type>::reference reference;
+	typedef typename std::iterator_traits<Iterator_Type>::difference_type difference_type;
+	typedef std::size_t size_type;
+
+	GridRange()
+		:first(), last()
+	{
+
+	}
+
+	GridRange(Iterator_Type _first, Iterator_Type _last)
+		:first(_first), last(_last)
+	{
+
+	}
+
+	inline Iterator_Type begin() const
+	{
+		return this->first;
+	}
+
+	inline Iterator_Type end() const
+	{
+		return this->last;
+	}
+
+	inline size_type size() const
+	{
+		return size_type(this->last - this->first);
+	}
+
+	inline bool empty() const
+	{
+		return this->first == this->last;
+	}
+
+	///No bounds check, the index is relative to begin()
+	inline reference operator[](difference_type index) const
+	{
+		return this->first[index];
+	}
+
+private:
+	Iterator_Type first;
+	Iterator_Type last;
+};
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+
+///Ranges only refer to grid cells, so views of them outlive the range object
+template<typename Iterator_Type>
+inline constexpr bool std::ranges::enable_borrowed_range<GridRange<Iterator_Type>> = true;
+#endif
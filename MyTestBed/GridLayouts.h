@@ -0,0 +1,484 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+///Storage layout policies for Grid. A layout maps a (column, row) pair onto an
+///offset in the flat storage buffer and knows how to walk every cell in storage
+///order. All layouts except PaddedRowMajorLayout are hole free: the storage holds
+///exactly columnCount * rowCount cells.
+///
+///A layout must provide:
+///	void SetDimensions(size_t columnCount, size_t rowCount, size_t elementSize)
+///	size_t GetOneDimensionIndex(size_t column, size_t row) const
+///	size_t GetStorageSize() const
+///	void ForEachCell(Function function) const  -> function(column, row, index)
+///		called in increasing index order
+///	static constexpr bool contiguous_rows
+///		true when every row is a contiguous run, GetOneDimensionIndex(0, row) first
+///	static constexpr bool has_padding
+///		true when the storage has slots that do not belong to any cell
+///	static constexpr bool is_strided
+///		true when GetOneDimensionIndex is column * GetColumnStride() +
+///		row * GetRowStride(). Growing or shrinking such a layout never reorders
+///		the cells, so Grid can shift them inside its own buffer.
+///Layouts with contiguous_rows also provide size_t GetRowPitch() const, the
+///distance in elements between the starts of two consecutive rows.
+///
+///A layout may also provide void ReserveColumns(size_t columnCount), making
+///every later SetDimensions leave room for that many columns per row.
+
+///Row after row, the original Grid behaviour. Best for horizontal scans.
+class RowMajorLayout
+{
+public:
+	static constexpr bool contiguous_rows = true;
+	static constexpr bool has_padding = false;
+	static constexpr bool is_strided = true;
+
+	RowMajorLayout()
+		:columnCount(0), rowCount(0)
+	{
+
+	}
+
+	inline void SetDimensions(std::size_t _columnCount, std::size_t _rowCount, std::size_t /*elementSize*/)
+	{
+		this->columnCount = _columnCount;
+		this->rowCount = _rowCount;
+	}
+
+	inline std::size_t GetOneDimensionIndex(std::size_t column, std::size_t row) const
+	{
+		return column + row * this->columnCount;
+	}
+
+	inline std::size_t GetRowPitch() const
+	{
+		return this->columnCount;
+	}
+
+	inline std::size_t GetColumnStride() const
+	{
+		return 1;
+	}
+
+	inline std::size_t GetRowStride() const
+	{
+		return this->columnCount;
+	}
+
+	inline std::size_t GetStorageSize() const
+	{
+		return this->columnCount * this->rowCount;
+	}
+
+	template<typename Function>
+	void ForEachCell(Function function) const
+	{
+		std::size_t index = 0;
+
+		for (std::size_t row = 0; row < this->rowCount; row++)
+		{
+			for (std::size_t column = 0; column < this->columnCount; column++, index++)
+			{
+				function(column, row, index);
+			}
+		}
+	}
+
+protected:
+	std::size_t columnCount;
+	std::size_t rowCount;
+};
+
+///Row major with every row start rounded up to a multiple of Row_Alignment bytes,
+///so rows line up with cache lines or SIMD registers. The rounding is done in
+///whole elements (the pitch is the smallest multiple of both Row_Alignment and
+///the element size), and the slots between the last cell of a row and the start
+///of the next one are padding. Pair it with an allocator that returns
+///Row_Alignment aligned memory, such as AlignedAllocator, so the first row is
+///aligned too.
+template<std::size_t Row_Alignment = 64>
+class PaddedRowMajorLayout
+{
+	static_assert(Row_Alignment > 0 && (Row_Alignment & (Row_Alignment - 1)) == 0,
+		"Row_Alignment must be a power of two");
+
+public:
+	static constexpr bool contiguous_rows = true;
+	static constexpr bool has_padding = true;
+	static constexpr bool is_strided = true;
+	static constexpr std::size_t row_alignment = Row_Alignment;
+
+	PaddedRowMajorLayout()
+		:columnCount(0), rowCount(0), rowPitch(0), reservedColumns(0)
+	{
+
+	}
+
+	///Widens the pitch so that up to _columnCount columns fit in each row, letting
+	///a Grid add columns without moving any cell. Takes effect on SetDimensions.
+	inline void ReserveColumns(std::size_t _columnCount)
+	{
+		this->reservedColumns = _columnCount;
+	}
+
+	inline void SetDimensions(std::size_t _columnCount, std::size_t _rowCount, std::size_t elementSize)
+	{
+		this->columnCount = _columnCount;
+		this->rowCount = _rowCount;
+
+		//Smallest number of elements that spans a whole multiple of Row_Alignment
+		std::size_t pitchStep = Row_Alignment / GreatestCommonDivisor(Row_Alignment, elementSize);
+
+		std::size_t pitchColumns = _columnCount < this->reservedColumns ? this->reservedColumns : _columnCount;
+
+		this->rowPitch = (pitchColumns + pitchStep - 1) / pitchStep * pitchStep;
+	}
+
+	inline std::size_t GetOneDimensionIndex(std::size_t column, std::size_t row) const
+	{
+		return column + row * this->rowPitch;
+	}
+
+	inline std::size_t GetRowPitch() const
+	{
+		return this->rowPitch;
+	}
+
+	inline std::size_t GetColumnStride() const
+	{
+		return 1;
+	}
+
+	inline std::size_t GetRowStride() const
+	{
+		return this->rowPitch;
+	}
+
+	inline std::size_t GetStorageSize() const
+	{
+		return this->rowPitch * this->rowCount;
+	}
+
+	template<typename Function>
+	void ForEachCell(Function function) const
+	{
+		for (std::size_t row = 0; row < this->rowCount; row++)
+		{
+			std::size_t index = row * this->rowPitch;
+
+			for (std::size_t column = 0; column < this->columnCount; column++, index++)
+			{
+				function(column, row, index);
+			}
+		}
+	}
+
+protected:
+	std::size_t columnCount;
+	std::size_t rowCount;
+	std::size_t rowPitch;
+	std::size_t reservedColumns;
+
+	static std::size_t GreatestCommonDivisor(std::size_t first, std::size_t second)
+	{
+		while (second != 0)
+		{
+			std::size_t remainder = first % second;
+			first = second;
+			second = remainder;
+		}
+
+		return first;
+	}
+};
+
+///Column after column. Best for vertical scans.
+class ColumnMajorLayout
+{
+public:
+	static constexpr bool contiguous_rows = false;
+	static constexpr bool has_padding = false;
+	static constexpr bool is_strided = true;
+
+	ColumnMajorLayout()
+		:columnCount(0), rowCount(0)
+	{
+
+	}
+
+	inline void SetDimensions(std::size_t _columnCount, std::size_t _rowCount, std::size_t /*elementSize*/)
+	{
+		this->columnCount = _columnCount;
+		this->rowCount = _rowCount;
+	}
+
+	inline std::size_t GetOneDimensionIndex(std::size_t column, std::size_t row) const
+	{
+		return row + column * this->rowCount;
+	}
+
+	inline std::size_t GetColumnStride() const
+	{
+		return this->rowCount;
+	}
+
+	inline std::size_t GetRowStride() const
+	{
+		return 1;
+	}
+
+	inline std::size_t GetStorageSize() const
+	{
+		return this->columnCount * this->rowCount;
+	}
+
+	template<typename Function>
+	void ForEachCell(Function function) const
+	{
+		std::size_t index = 0;
+
+		for (std::size_t column = 0; column < this->columnCount; column++)
+		{
+			for (std::size_t row = 0; row < this->rowCount; row++, index++)
+			{
+				function(column, row, index);
+			}
+		}
+	}
+
+protected:
+	std::size_t columnCount;
+	std::size_t rowCount;
+};
+
+///Square Tile_Size x Tile_Size tiles stored one after another, tiles in row
+///major order and cells row major inside each tile. Tiles on the right and
+///bottom edges are clipped to the grid instead of padded, which keeps the
+///storage hole free for any dimensions.
+template<std::size_t Tile_Size>
+class TiledLayout
+{
+	static_assert(Tile_Size > 0 && (Tile_Size & (Tile_Size - 1)) == 0,
+		"Tile_Size must be a power of two");
+
+public:
+	static constexpr bool contiguous_rows = false;
+	static constexpr bool has_padding = false;
+	static constexpr bool is_strided = false;
+	static constexpr std::size_t tile_size = Tile_Size;
+
+	TiledLayout()
+		:columnCount(0), rowCount(0), fullTileRows(0), fullTileColumns(0)
+	{
+
+	}
+
+	inline void SetDimensions(std::size_t _columnCount, std::size_t _rowCount, std::size_t /*elementSize*/)
+	{
+		this->columnCount = _columnCount;
+		this->rowCount = _rowCount;
+
+		this->fullTileColumns = _columnCount & ~tile_mask;
+		this->fullTileRows = _rowCount & ~tile_mask;
+	}
+
+	inline std::size_t GetOneDimensionIndex(std::size_t column, std::size_t row) const
+	{
+		std::size_t tileRowStart = row & ~tile_mask;
+		std::size_t tileColumnStart = column & ~tile_mask;
+
+		std::size_t bandHeight = row < this->fullTileRows ? Tile_Size : this->rowCount - this->fullTileRows;
+		std::size_t tileWidth = column < this->fullTileColumns ? Tile_Size : this->columnCount - this->fullTileColumns;
+
+		return tileRowStart * this->columnCount + tileColumnStart * bandHeight +
+			(row & tile_mask) * tileWidth + (column & tile_mask);
+	}
+
+	inline std::size_t GetStorageSize() const
+	{
+		return this->columnCount * this->rowCount;
+	}
+
+	template<typename Function>
+	void ForEachCell(Function function) const
+	{
+		std::size_t index = 0;
+
+		for (std::size_t tileRow = 0; tileRow < this->rowCount; tileRow += Tile_Size)
+		{
+			std::size_t rowEnd = tileRow + Tile_Size < this->rowCount ? tileRow + Tile_Size : this->rowCount;
+
+			for (std::size_t tileColumn = 0; tileColumn < this->columnCount; tileColumn += Tile_Size)
+			{
+				std::size_t columnEnd = tileColumn + Tile_Size < this->columnCount ?
+					tileColumn + Tile_Size : this->columnCount;
+
+				for (std::size_t row = tileRow; row < rowEnd; row++)
+				{
+					for (std::size_t column = tileColumn; column < columnEnd; column++, index++)
+					{
+						function(column, row, index);
+					}
+				}
+			}
+		}
+	}
+
+protected:
+	static constexpr std::size_t tile_mask = Tile_Size - 1;
+
+	std::size_t columnCount;
+	std::size_t rowCount;
+
+	///Column/row where the clipped edge tiles start
+	std::size_t fullTileRows;
+	std::size_t fullTileColumns;
+};
+
+///Z-order (Morton) layout. The grid is cut into Tile_Size x Tile_Size blocks laid
+///out like TiledLayout, and cells inside every full block follow the Morton
+///curve, so any aligned power of two window is contiguous in memory. Clipped
+///edge blocks fall back to row major, which keeps the storage hole free for
+///dimensions that are not powers of two.
+template<std::size_t Tile_Size = 16>
+class MortonLayout
+{
+	static_assert(Tile_Size > 0 && (Tile_Size & (Tile_Size - 1)) == 0,
+		"Tile_Size must be a power of two");
+	//The codes of a full tile run to Tile_Size * Tile_Size, which must stay below 2^32
+	static_assert(Tile_Size <= 32768, "Morton tiles are limited to 32768 cells per axis");
+
+public:
+	static constexpr bool contiguous_rows = false;
+	static constexpr bool has_padding = false;
+	static constexpr bool is_strided = false;
+	static constexpr std::size_t tile_size = Tile_Size;
+
+	MortonLayout()
+		:columnCount(0), rowCount(0), fullTileRows(0), fullTileColumns(0)
+	{
+
+	}
+
+	inline void SetDimensions(std::size_t _columnCount, std::size_t _rowCount, std::size_t /*elementSize*/)
+	{
+		this->columnCount = _columnCount;
+		this->rowCount = _rowCount;
+
+		this->fullTileColumns = _columnCount & ~tile_mask;
+		this->fullTileRows = _rowCount & ~tile_mask;
+	}
+
+	inline std::size_t GetOneDimensionIndex(std::size_t column, std::size_t row) const
+	{
+		std::size_t tileRowStart = row & ~tile_mask;
+		std::size_t tileColumnStart = column & ~tile_mask;
+
+		if (row < this->fullTileRows && column < this->fullTileColumns)
+		{
+			return tileRowStart * this->columnCount + tileColumnStart * Tile_Size +
+				Interleave(std::uint32_t(column & tile_mask), std::uint32_t(row & tile_mask));
+		}
+
+		std::size_t bandHeight = row < this->fullTileRows ? Tile_Size : this->rowCount - this->fullTileRows;
+		std::size_t tileWidth = column < this->fullTileColumns ? Tile_Size : this->columnCount - this->fullTileColumns;
+
+		return tileRowStart * this->columnCount + tileColumnStart * bandHeight +
+			(row & tile_mask) * tileWidth + (column & tile_mask);
+	}
+
+	inline std::size_t GetStorageSize() const
+	{
+		return this->columnCount * this->rowCount;
+	}
+
+	template<typename Function>
+	void ForEachCell(Function function) const
+	{
+		std::size_t index = 0;
+
+		for (std::size_t tileRow = 0; tileRow < this->rowCount; tileRow += Tile_Size)
+		{
+			std::size_t rowEnd = tileRow + Tile_Size < this->rowCount ? tileRow + Tile_Size : this->rowCount;
+
+			for (std::size_t tileColumn = 0; tileColumn < this->columnCount; tileColumn += Tile_Size)
+			{
+				std::size_t columnEnd = tileColumn + Tile_Size < this->columnCount ?
+					tileColumn + Tile_Size : this->columnCount;
+
+				if (rowEnd - tileRow == Tile_Size && columnEnd - tileColumn == Tile_Size)
+				{
+					for (std::uint32_t code = 0; code < Tile_Size * Tile_Size; code++, index++)
+					{
+						function(tileColumn + Compact(code), tileRow + Compact(code >> 1), index);
+					}
+				}
+				else
+				{
+					for (std::size_t row = tileRow; row < rowEnd; row++)
+					{
+						for (std::size_t column = tileColumn; column < columnEnd; column++, index++)
+						{
+							function(column, row, index);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	///Interleaves the bits of x and y, x taking the even bits
+	static inline std::uint32_t Interleave(std::uint32_t x, std::uint32_t y)
+	{
+		return Spread(x) | (Spread(y) << 1);
+	}
+
+protected:
+	static constexpr std::size_t tile_mask = Tile_Size - 1;
+
+	std::size_t columnCount;
+	std::size_t rowCount;
+
+	std::size_t fullTileRows;
+	std::size_t fullTileColumns;
+
+	///Moves the low 16 bits of value to the even bit positions
+	static inline std::uint32_t Spread(std::uint32_t value)
+	{
+		value &= 0x0000FFFF;
+		value = (value | (value << 8)) & 0x00FF00FF;
+		value = (value | (value << 4)) & 0x0F0F0F0F;
+		value = (value | (value << 2)) & 0x33333333;
+		value = (value | (value << 1)) & 0x55555555;
+		return value;
+	}
+
+	///Inverse of Spread, gathers the even bits of value
+	static inline std::uint32_t Compact(std::uint32_t value)
+	{
+		value &= 0x55555555;
+		value = (value | (value >> 1)) & 0x33333333;
+		value = (value | (value >> 2)) & 0x0F0F0F0F;
+		value = (value | (value >> 4)) & 0x00FF00FF;
+		value = (value | (value >> 8)) & 0x0000FFFF;
+		return value;
+	}
+};
+
+///True when Layout_Type provides the optional ReserveColumns member
+template<typename Layout_Type, typename = void>
+struct LayoutReservesColumns : std::false_type
+{
+
+};
+
+template<typename Layout_Type>
+struct LayoutReservesColumns<Layout_Type,
+	std::void_t<decltype(std::declval<Layout_Type&>().ReserveColumns(std::size_t()))>> : std::true_type
+{
+
+};
@@ -0,0 +1,556 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "BitGrid.h"
+#include "Grid.h"
+
+///A matching cell found by a GridOccupancyPyramid query
+struct GridOccupancyHit
+{
+	std::uint32_t column;
+	std::uint32_t row;
+	///Squared euclidean distance from the query cell
+	std::uint64_t distanceSquared;
+
+	friend bool operator==(const GridOccupancyHit& left, const GridOccupancyHit& right)
+	{
+		return left.column == right.column && left.row == right.row && left.distanceSquared == right.distanceSquared;
+	}
+};
+
+///Default GridOccupancyPyramid predicate, a cell is occupied when it is not
+///value initialised
+struct GridNonDefaultCell
+{
+	template<typename Data_Type>
+	bool operator()(const Data_Type& cell) const
+	{
+		return !(cell == Data_Type());
+	}
+};
+
+///Wraps a Grid and keeps, for every cell, whether predicate(cell) holds, plus a
+///quadtree of counts over it: level 0 counts the matching cells of each 8 x 8
+///block, each level above sums 2 x 2 blocks of the one below, up to a single
+///block over the whole grid. Queries descend from the top and skip every empty
+///block whole, so a sparse grid is searched in time close to the number of
+///matches rather than the number of cells.
+///
+///	GridOccupancyPyramid<Grid<int>> resources(std::move(map));
+///	std::optional<GridOccupancyHit> nearest = resources.FindNearest(unitColumn, unitRow);
+///	bool threatened = enemies.Any(left, top, left + 199, top + 199);
+///
+///As with TrackedGrid only the const grid is exposed; writes go through SetCell,
+///Modify and the bulk operations, which keep the pyramid up to date at the cost
+///of one count per level for each cell whose match changes. Cells changed some
+///other way are brought back in with Refresh or Rebuild.
+template<typename Grid_Type, typename Predicate_Type = GridNonDefaultCell>
+class GridOccupancyPyramid
+{
+public:
+	typedef Grid_Type grid_type;
+	typedef typename Grid_Type::value_type value_type;
+	typedef typename Grid_Type::const_reference const_reference;
+	typedef typename Grid_Type::dimension_type dimension_type;
+
+	///Level 0 blocks are 8 x 8 cells, the bits of a block row within one word
+	static constexpr std::uint32_t leaf_shift = 3;
+	static constexpr std::uint32_t leaf_side = 1u << leaf_shift;
+
+	///Passed as maxDistance to search the whole grid
+	static constexpr std::uint32_t unlimited_distance = std::numeric_limits<std::uint32_t>::max();
+
+	GridOccupancyPyramid()
+		:columnCount(0), rowCount(0), wordsPerRow(0)
+	{
+
+	}
+
+	explicit GridOccupancyPyramid(Grid_Type _grid, Predicate_Type _predicate = Predicate_Type())
+		:grid(std::move(_grid)), predicate(std::move(_predicate)), columnCount(0), rowCount(0), wordsPerRow(0)
+	{
+		Rebuild(GridExecution::seq);
+	}
+
+	template<typename Policy_Type, typename = typename std::enable_if<GridExecution::IsExecutionPolicy<Policy_Type>::value>::type>
+	GridOccupancyPyramid(const Policy_Type& policy, Grid_Type _grid, Predicate_Type _predicate = Predicate_Type())
+		:grid(std::move(_grid)), predicate(std::move(_predicate)), columnCount(0), rowCount(0), wordsPerRow(0)
+	{
+		Rebuild(policy);
+	}
+
+	inline const Grid_Type& GetGrid() const
+	{
+		return this->grid;
+	}
+
+	inline const Predicate_Type& GetPredicate() const
+	{
+		return this->predicate;
+	}
+
+	inline dimension_type GetColumnCount() const
+	{
+		return this->grid.GetColumnCount();
+	}
+
+	inline dimension_type GetRowCount() const
+	{
+		return this->grid.GetRowCount();
+	}
+
+	inline const_reference GetCell(dimension_type column, dimension_type row) const
+	{
+		return this->grid.GetCell(column, row);
+	}
+
+	///Whether predicate held for the cell when last seen
+	inline bool IsOccupied(dimension_type column, dimension_type row) const
+	{
+		CheckCell(column, row);
+		return TestBit(column, row);
+	}
+
+	void SetCell(dimension_type column, dimension_type row, const value_type& value)
+	{
+		CheckCell(column, row);
+		this->grid.GetCell(this->grid.GetOneDimensionIndex(column, row)) = value;
+		Update(column, row);
+	}
+
+	///Calls function(cell) and then re-tests the cell
+	template<typename Function_Type>
+	void Modify(dimension_type column, dimension_type row, Function_Type function)
+	{
+		CheckCell(column, row);
+		function(this->grid.GetCell(this->grid.GetOneDimensionIndex(column, row)));
+		Update(column, row);
+	}
+
+	///Grid::ForEach, rebuilding the pyramid afterwards
+	template<typename Policy_Type, typename Function_Type>
+	void ForEach(const Policy_Type& policy, Function_Type function)
+	{
+		this->grid.ForEach(policy, function);
+		Rebuild(policy);
+	}
+
+	template<typename Policy_Type>
+	void Fill(const Policy_Type& policy, const value_type& value)
+	{
+		this->grid.Fill(policy, value);
+		Rebuild(policy);
+	}
+
+	void ResizeGrid(dimension_type columnCount, dimension_type rowCount, const value_type& initVal = value_type())
+	{
+		this->grid.ResizeGrid(columnCount, rowCount, initVal);
+		Rebuild(GridExecution::seq);
+	}
+
+	///Re-tests one cell after a change the pyramid did not see
+	void Refresh(dimension_type column, dimension_type row)
+	{
+		CheckCell(column, row);
+		Update(column, row);
+	}
+
+	///Re-tests every cell and recounts every level. Rows of 8 x 8 blocks are
+	///independent and split over policy; the levels above are a small fraction
+	///of the work and summed on the calling thread.
+	template<typename Policy_Type>
+	void Rebuild(const Policy_Type& policy)
+	{
+		if (std::uint64_t(this->grid.GetColumnCount()) * this->grid.GetRowCount() > std::numeric_limits<std::uint32_t>::max())
+			throw std::length_error("Grid too large for a GridOccupancyPyramid");
+
+		this->columnCount = std::uint32_t(this->grid.GetColumnCount());
+		this->rowCount = std::uint32_t(this->grid.GetRowCount());
+		this->wordsPerRow = (std::size_t(this->columnCount) + 63) / 64;
+
+		this->bits.assign(this->wordsPerRow * this->rowCount, 0);
+		this->levels.clear();
+		this->counts.clear();
+
+		if (this->columnCount == 0 || this->rowCount == 0)
+			return;
+
+		//Level dimensions, halving until one block covers the whole grid
+		std::uint32_t levelColumns = (this->columnCount + leaf_side - 1) >> leaf_shift;
+		std::uint32_t levelRows = (this->rowCount + leaf_side - 1) >> leaf_shift;
+		std::size_t offset = 0;
+
+		while (true)
+		{
+			this->levels.push_back(Level{ levelColumns, levelRows, offset });
+			offset += std::size_t(levelColumns) * levelRows;
+
+			if (levelColumns == 1 && levelRows == 1)
+				break;
+
+			levelColumns = (levelColumns + 1) / 2;
+			levelRows = (levelRows + 1) / 2;
+		}
+
+		this->counts.assign(offset, 0);
+
+		const Level& leaves = this->levels[0];
+
+		GridExecution::ForEachBand(policy, leaves.rows, [&](std::size_t blockRow)
+		{
+			std::uint32_t* blockCounts = &this->counts[leaves.offset + blockRow * leaves.columns];
+			std::size_t lastRow = std::min<std::size_t>((blockRow + 1) * leaf_side, this->rowCount);
+
+			for (std::size_t row = blockRow * leaf_side; row < lastRow; row++)
+			{
+				std::uint64_t* rowBits = &this->bits[row * this->wordsPerRow];
+
+				for (std::size_t column = 0; column < this->columnCount; column++)
+				{
+					if (this->predicate(this->grid.GetCell(this->grid.GetOneDimensionIndex(
+						dimension_type(column), dimension_type(row)))))
+						rowBits[column / 64] |= std::uint64_t(1) << (column % 64);
+				}
+
+				for (std::size_t blockColumn = 0; blockColumn < leaves.columns; blockColumn++)
+				{
+					blockCounts[blockColumn] += std::uint32_t(BitGridDetail::PopCount(
+						(rowBits[blockColumn * leaf_side / 64] >> (blockColumn * leaf_side % 64)) & 0xFF));
+				}
+			}
+		});
+
+		for (std::size_t level = 1; level < this->levels.size(); level++)
+		{
+			const Level& below = this->levels[level - 1];
+			const Level& above = this->levels[level];
+
+			for (std::size_t row = 0; row < below.rows; row++)
+			{
+				for (std::size_t column = 0; column < below.columns; column++)
+				{
+					this->counts[above.offset + (row / 2) * above.columns + column / 2] +=
+						this->counts[below.offset + row * below.columns + column];
+				}
+			}
+		}
+	}
+
+	///Number of matching cells in the whole grid
+	std::uint32_t Count() const
+	{
+		return this->levels.empty() ? 0 : this->counts[this->levels.back().offset];
+	}
+
+	///Number of matching cells in the inclusive rectangle
+	std::uint32_t Count(std::uint32_t firstColumn, std::uint32_t firstRow,
+		std::uint32_t lastColumn, std::uint32_t lastRow) const
+	{
+		CheckRectangle(firstColumn, firstRow, lastColumn, lastRow);
+		return CountRegion(Rectangle{ firstColumn, firstRow, lastColumn, lastRow },
+			this->levels.size() - 1, 0, 0, std::numeric_limits<std::uint32_t>::max());
+	}
+
+	///Whether any cell of the inclusive rectangle matches, stopping at the first
+	bool Any(std::uint32_t firstColumn, std::uint32_t firstRow,
+		std::uint32_t lastColumn, std::uint32_t lastRow) const
+	{
+		CheckRectangle(firstColumn, firstRow, lastColumn, lastRow);
+		return CountRegion(Rectangle{ firstColumn, firstRow, lastColumn, lastRow }, this->levels.size() - 1, 0, 0, 1) > 0;
+	}
+
+	///The matching cell closest to (column, row), the query cell included, no
+	///further than maxDistance. Equally distant cells go to the lowest row, then
+	///the lowest column.
+	std::optional<GridOccupancyHit> FindNearest(std::uint32_t column, std::uint32_t row,
+		std::uint32_t maxDistance = unlimited_distance) const
+	{
+		std::vector<GridOccupancyHit> found;
+		FindKNearest(column, row, 1, found, maxDistance);
+
+		if (found.empty())
+			return std::nullopt;
+
+		return found.front();
+	}
+
+	///Replaces found with up to count matching cells closest to (column, row) and
+	///no further than maxDistance, nearest first and ordered as FindNearest.
+	///Blocks are visited best first by their distance from the query cell, so the
+	///search stops as soon as count cells are certain.
+	void FindKNearest(std::uint32_t column, std::uint32_t row, std::size_t count,
+		std::vector<GridOccupancyHit>& found, std::uint32_t maxDistance = unlimited_distance) const
+	{
+		found.clear();
+
+		if (column >= this->columnCount || row >= this->rowCount)
+			throw std::out_of_range("GridOccupancyPyramid-FindKNearest Arguments Out of Range");
+
+		if (count == 0 || Count() == 0)
+			return;
+
+		std::uint64_t maxDistanceSquared = maxDistance == unlimited_distance ?
+			std::numeric_limits<std::uint64_t>::max() : std::uint64_t(maxDistance) * maxDistance;
+
+		std::priority_queue<SearchEntry, std::vector<SearchEntry>, std::greater<SearchEntry>> open;
+		open.push(SearchEntry{ 0, std::uint32_t(this->levels.size() - 1), 0, 0 });
+
+		while (!open.empty() && found.size() < count)
+		{
+			SearchEntry entry = open.top();
+			open.pop();
+
+			if (entry.level == SearchEntry::cell_level)
+			{
+				found.push_back(GridOccupancyHit{ entry.column, entry.row, entry.distanceSquared });
+				continue;
+			}
+
+			if (entry.level == 0)
+			{
+				Rectangle bounds = GetBlockBounds(0, entry.column, entry.row);
+				std::uint32_t firstColumn = bounds.firstColumn;
+
+				for (std::uint32_t cellRow = bounds.firstRow; cellRow <= bounds.lastRow; cellRow++)
+				{
+					std::uint64_t block = (this->bits[cellRow * this->wordsPerRow + firstColumn / 64] >> (firstColumn % 64)) & 0xFF;
+
+					while (block != 0)
+					{
+						std::uint32_t cellColumn = firstColumn + std::uint32_t(BitGridDetail::CountTrailingZeros(block));
+						std::uint64_t distanceSquared = DistanceSquared(column, row, cellColumn, cellColumn, cellRow, cellRow);
+
+						if (distanceSquared <= maxDistanceSquared)
+							open.push(SearchEntry{ distanceSquared, SearchEntry::cell_level, cellColumn, cellRow });
+
+						block &= block - 1;
+					}
+				}
+
+				continue;
+			}
+
+			const Level& below = this->levels[entry.level - 1];
+
+			for (std::uint32_t childRow = entry.row * 2; childRow < std::min(entry.row * 2 + 2, below.rows); childRow++)
+			{
+				for (std::uint32_t childColumn = entry.column * 2; childColumn < std::min(entry.column * 2 + 2, below.columns); childColumn++)
+				{
+					if (this->counts[below.offset + std::size_t(childRow) * below.columns + childColumn] == 0)
+						continue;
+
+					Rectangle bounds = GetBlockBounds(entry.level - 1, childColumn, childRow);
+					std::uint64_t distanceSquared = DistanceSquared(column, row,
+						bounds.firstColumn, bounds.lastColumn, bounds.firstRow, bounds.lastRow);
+
+					if (distanceSquared <= maxDistanceSquared)
+						open.push(SearchEntry{ distanceSquared, entry.level - 1, childColumn, childRow });
+				}
+			}
+		}
+	}
+
+	std::vector<GridOccupancyHit> FindKNearest(std::uint32_t column, std::uint32_t row, std::size_t count,
+		std::uint32_t maxDistance = unlimited_distance) const
+	{
+		std::vector<GridOccupancyHit> found;
+		FindKNearest(column, row, count, found, maxDistance);
+		return found;
+	}
+
+	///Number of levels above the cells, 8 x 8 blocks first
+	inline std::size_t GetLevelCount() const
+	{
+		return this->levels.size();
+	}
+
+	///Matching cells in block (column, row) of level, which covers 8 << level cells a side
+	std::uint32_t GetBlockCount(std::size_t level, std::uint32_t column, std::uint32_t row) const
+	{
+		if (level >= this->levels.size() || column >= this->levels[level].columns || row >= this->levels[level].rows)
+			throw std::out_of_range("GridOccupancyPyramid-GetBlockCount Arguments Out of Range");
+
+		return this->counts[this->levels[level].offset + std::size_t(row) * this->levels[level].columns + column];
+	}
+
+private:
+	struct Level
+	{
+		std::uint32_t columns;
+		std::uint32_t rows;
+		std::size_t offset;
+	};
+
+	struct Rectangle
+	{
+		std::uint32_t firstColumn;
+		std::uint32_t firstRow;
+		std::uint32_t lastColumn;
+		std::uint32_t lastRow;
+	};
+
+	///A block or a single cell waiting in the best first search
+	struct SearchEntry
+	{
+		static constexpr std::uint32_t cell_level = std::numeric_limits<std::uint32_t>::max();
+
+		std::uint64_t distanceSquared;
+		std::uint32_t level;
+		std::uint32_t column;
+		std::uint32_t row;
+
+		///Closest first. At equal distance blocks come before cells, so every
+		///cell at that distance is queued before the lowest row and column of
+		///them is handed out.
+		friend bool operator>(const SearchEntry& left, const SearchEntry& right)
+		{
+			if (left.distanceSquared != right.distanceSquared)
+				return left.distanceSquared > right.distanceSquared;
+
+			bool leftCell = left.level == cell_level;
+			bool rightCell = right.level == cell_level;
+
+			if (leftCell != rightCell)
+				return leftCell;
+
+			if (left.row != right.row)
+				return left.row > right.row;
+
+			return left.column > right.column;
+		}
+	};
+
+	Grid_Type grid;
+	Predicate_Type predicate;
+
+	std::uint32_t columnCount;
+	std::uint32_t rowCount;
+
+	///One bit per cell, every row starting on a fresh word
+	std::size_t wordsPerRow;
+	std::vector<std::uint64_t> bits;
+
+	///Every level's block counts, row by row, level 0 first
+	std::vector<Level> levels;
+	std::vector<std::uint32_t> counts;
+
+	inline void CheckCell(dimension_type column, dimension_type row) const
+	{
+		if (column >= this->grid.GetColumnCount() || row >= this->grid.GetRowCount())
+			throw std::out_of_range("GridOccupancyPyramid-GetCell Arguments Out of Range");
+	}
+
+	void CheckRectangle(std::uint32_t firstColumn, std::uint32_t firstRow,
+		std::uint32_t lastColumn, std::uint32_t lastRow) const
+	{
+		if (lastColumn >= this->columnCount || lastRow >= this->rowCount)
+			throw std::out_of_range("GridOccupancyPyramid rectangle outside the grid");
+
+		if (firstColumn > lastColumn || firstRow > lastRow)
+			throw std::invalid_argument("GridOccupancyPyramid rectangle corners out of order");
+	}
+
+	inline bool TestBit(std::size_t column, std::size_t row) const
+	{
+		return (this->bits[row * this->wordsPerRow + column / 64] >> (column % 64)) & 1;
+	}
+
+	///Re-tests a cell and walks a changed match up through every level
+	void Update(dimension_type column, dimension_type row)
+	{
+		bool matches = this->predicate(this->grid.GetCell(this->grid.GetOneDimensionIndex(column, row)));
+
+		if (matches == TestBit(column, row))
+			return;
+
+		this->bits[std::size_t(row) * this->wordsPerRow + column / 64] ^= std::uint64_t(1) << (column % 64);
+
+		std::uint32_t blockColumn = std::uint32_t(column) >> leaf_shift;
+		std::uint32_t blockRow = std::uint32_t(row) >> leaf_shift;
+
+		for (const Level& level : this->levels)
+		{
+			std::uint32_t& count = this->counts[level.offset + std::size_t(blockRow) * level.columns + blockColumn];
+			count = matches ? count + 1 : count - 1;
+
+			blockColumn /= 2;
+			blockRow /= 2;
+		}
+	}
+
+	///Cells covered by block (column, row) of level, clipped to the grid
+	Rectangle GetBlockBounds(std::size_t level, std::uint32_t column, std::uint32_t row) const
+	{
+		std::uint64_t side = std::uint64_t(leaf_side) << level;
+
+		return Rectangle{ std::uint32_t(column * side), std::uint32_t(row * side),
+			std::uint32_t(std::min<std::uint64_t>((column + 1) * side, this->columnCount) - 1),
+			std::uint32_t(std::min<std::uint64_t>((row + 1) * side, this->rowCount) - 1) };
+	}
+
+	static inline std::uint64_t DistanceSquared(std::uint32_t column, std::uint32_t row,
+		std::uint32_t firstColumn, std::uint32_t lastColumn, std::uint32_t firstRow, std::uint32_t lastRow)
+	{
+		std::uint64_t columnDistance = column < firstColumn ? firstColumn - column : column > lastColumn ? column - lastColumn : 0;
+		std::uint64_t rowDistance = row < firstRow ? firstRow - row : row > lastRow ? row - lastRow : 0;
+
+		return columnDistance * columnDistance + rowDistance * rowDistance;
+	}
+
+	///Matching cells of rectangle inside block (column, row) of level, giving up
+	///once limit are found. Empty blocks are skipped and blocks wholly inside the
+	///rectangle answered from their count.
+	std::uint32_t CountRegion(const Rectangle& rectangle, std::size_t level,
+		std::uint32_t column, std::uint32_t row, std::uint32_t limit) const
+	{
+		const Level& current = this->levels[level];
+		std::uint32_t count = this->counts[current.offset + std::size_t(row) * current.columns + column];
+
+		if (count == 0)
+			return 0;
+
+		Rectangle bounds = GetBlockBounds(level, column, row);
+		std::uint32_t firstColumn = std::max(bounds.firstColumn, rectangle.firstColumn);
+		std::uint32_t firstRow = std::max(bounds.firstRow, rectangle.firstRow);
+		std::uint32_t lastColumn = std::min(bounds.lastColumn, rectangle.lastColumn);
+		std::uint32_t lastRow = std::min(bounds.lastRow, rectangle.lastRow);
+
+		if (firstColumn > lastColumn || firstRow > lastRow)
+			return 0;
+
+		if (firstColumn == bounds.firstColumn && firstRow == bounds.firstRow &&
+			lastColumn == bounds.lastColumn && lastRow == bounds.lastRow)
+			return count;
+
+		std::uint32_t found = 0;
+
+		if (level == 0)
+		{
+			//The overlap of an 8 x 8 block lies within one word of each row
+			std::uint64_t mask = (~std::uint64_t(0) >> (63 - lastColumn % 64)) & (~std::uint64_t(0) << (firstColumn % 64));
+
+			for (std::uint32_t cellRow = firstRow; cellRow <= lastRow && found < limit; cellRow++)
+				found += std::uint32_t(BitGridDetail::PopCount(this->bits[cellRow * this->wordsPerRow + firstColumn / 64] & mask));
+
+			return found;
+		}
+
+		const Level& below = this->levels[level - 1];
+
+		for (std::uint32_t childRow = row * 2; childRow < std::min(row * 2 + 2, below.rows) && found < limit; childRow++)
+		{
+			for (std::uint32_t childColumn = column * 2; childColumn < std::min(column * 2 + 2, below.columns) && found < limit; childColumn++)
+				found += CountRegion(rectangle, level - 1, childColumn, childRow, limit - found);
+		}
+
+		return found;
+	}
+};
@@ -0,0 +1,527 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "Grid.h"
+
+///Cost a GridPathfinder cost function returns for cells that cannot be entered
+inline constexpr float GridPathBlocked = std::numeric_limits<float>::infinity();
+
+struct GridPathPoint
+{
+	std::uint32_t column;
+	std::uint32_t row;
+
+	friend bool operator==(const GridPathPoint& left, const GridPathPoint& right)
+	{
+		return left.column == right.column && left.row == right.row;
+	}
+
+	friend bool operator!=(const GridPathPoint& left, const GridPathPoint& right)
+	{
+		return !(left == right);
+	}
+};
+
+enum class GridPathAlgorithm
+{
+	///Weighted A*, 8 connected. Works with any cell costs.
+	AStar,
+	///Jump Point Search, 8 connected. Only tells blocked cells from open ones and
+	///treats every open cell as costing 1, but expands far fewer nodes.
+	JumpPointSearch
+};
+
+struct GridPathQuery
+{
+	GridPathPoint start;
+	GridPathPoint goal;
+};
+
+///A found path from start to goal, both included. Reusing one GridPath across
+///queries reuses its point storage.
+struct GridPath
+{
+	std::vector<GridPathPoint> points;
+	float cost = 0.0f;
+	std::size_t expandedNodes = 0;
+
+	inline bool IsFound() const
+	{
+		return !this->points.empty();
+	}
+};
+
+///Per thread search state: a g score and parent for every cell of the grid
+///last searched, and the open list. A cell's entry only counts when its
+///stamp matches the current generation, so a search starts without clearing
+///anything; the stamps are only wiped when the generation counter wraps.
+class GridPathScratch
+{
+public:
+	struct Node
+	{
+		float g;
+		std::uint32_t parent;
+		std::uint32_t stamp;
+	};
+
+	struct OpenEntry
+	{
+		float f;
+		float g;
+		std::uint32_t index;
+
+		///Heap order: lowest f first, ties to the deeper node
+		friend bool operator<(const OpenEntry& left, const OpenEntry& right)
+		{
+			return left.f > right.f || (left.f == right.f && left.g < right.g);
+		}
+	};
+
+	typedef Grid<Node, RowMajorLayout, std::allocator<Node>, std::uint32_t> node_grid;
+
+	GridPathScratch()
+		:generation(0)
+	{
+
+	}
+
+	///The scratch of the calling thread, used by every GridPathfinder
+	static GridPathScratch& ForThisThread()
+	{
+		thread_local GridPathScratch scratch;
+		return scratch;
+	}
+
+	void Begin(std::uint32_t columnCount, std::uint32_t rowCount)
+	{
+		if (this->nodes.GetColumnCount() != columnCount || this->nodes.GetRowCount() != rowCount)
+		{
+			this->nodes.ResizeGrid(columnCount, rowCount, Node{ 0.0f, 0, 0 });
+			this->generation = 0;
+		}
+
+		if (++this->generation == 0)
+		{
+			for (Node& node : this->nodes)
+				node.stamp = 0;
+
+			this->generation = 1;
+		}
+
+		this->open.clear();
+	}
+
+	inline Node& GetNode(std::uint32_t index)
+	{
+		return this->nodes.GetCell(std::size_t(index));
+	}
+
+	///Records g and parent if index is unseen or g improves on it, and queues it
+	inline void Relax(std::uint32_t index, std::uint32_t parent, float g, float h)
+	{
+		Node& node = this->nodes.GetCell(std::size_t(index));
+
+		if (node.stamp == this->generation && node.g <= g)
+			return;
+
+		node.g = g;
+		node.parent = parent;
+		node.stamp = this->generation;
+
+		this->open.push_back(OpenEntry{ g + h, g, index });
+		std::push_heap(this->open.begin(), this->open.end());
+	}
+
+	///Pops the best open entry that is not stale; false once the list is empty
+	inline bool PopBest(std::uint32_t& index, float& g)
+	{
+		while (!this->open.empty())
+		{
+			std::pop_heap(this->open.begin(), this->open.end());
+			OpenEntry entry = this->open.back();
+			this->open.pop_back();
+
+			if (entry.g <= this->nodes.GetCell(std::size_t(entry.index)).g)
+			{
+				index = entry.index;
+				g = entry.g;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline std::uint32_t GetGeneration() const
+	{
+		return this->generation;
+	}
+
+private:
+	node_grid nodes;
+	std::uint32_t generation;
+	std::vector<OpenEntry> open;
+};
+
+///Finds shortest 8 connected paths over a Grid of any layout. Cell costs come
+///from a function of the cell value, GridPathBlocked marks walls, and moving
+///diagonally costs sqrt(2) times the cell cost. Diagonal moves may not cut the
+///corner of a blocked cell.
+///
+///All search memory lives in GridPathScratch::ForThisThread, so queries do not
+///allocate once it has grown to the grid, and FindPaths can run a batch of
+///queries on several threads against the same grid.
+template<typename Grid_Type, typename Cost_Function>
+class GridPathfinder
+{
+public:
+	typedef typename Grid_Type::value_type value_type;
+
+	static constexpr float diagonal_cost = 1.41421356f;
+
+	GridPathfinder(const Grid_Type& _grid, Cost_Function _cost)
+		:grid(_grid), cost(_cost), heuristicScale(1.0f)
+	{
+		if (std::uint64_t(_grid.GetColumnCount()) * _grid.GetRowCount() >= std::numeric_limits<std::uint32_t>::max())
+			throw std::length_error("Grid too large for GridPathfinder");
+	}
+
+	///The octile distance is multiplied by this; keep it at or below the cheapest
+	///cell cost for shortest paths, raise it to trade optimality for speed
+	inline void SetHeuristicScale(float scale)
+	{
+		this->heuristicScale = scale;
+	}
+
+	///Returns false, with path emptied, when the goal cannot be reached
+	bool FindPath(const GridPathQuery& query, GridPath& path,
+		GridPathAlgorithm algorithm = GridPathAlgorithm::AStar) const
+	{
+		CheckPoint(query.start);
+		CheckPoint(query.goal);
+
+		path.points.clear();
+		path.cost = 0.0f;
+		path.expandedNodes = 0;
+
+		if (!IsOpen(query.start.column, query.start.row) || !IsOpen(query.goal.column, query.goal.row))
+			return false;
+
+		GridPathScratch& scratch = GridPathScratch::ForThisThread();
+		scratch.Begin(GetColumnCount(), GetRowCount());
+
+		if (algorithm == GridPathAlgorithm::JumpPointSearch)
+			return SearchJumpPoints(query, path, scratch);
+
+		return SearchAStar(query, path, scratch);
+	}
+
+	///Answers every query, results[i] for queries[i], spreading them over threads
+	///under policy
+	template<typename Policy_Type>
+	void FindPaths(const Policy_Type& policy, const std::vector<GridPathQuery>& queries,
+		std::vector<GridPath>& results, GridPathAlgorithm algorithm = GridPathAlgorithm::AStar) const
+	{
+		results.resize(queries.size());
+
+		GridExecution::ForEachBand(policy, queries.size(), [&](std::size_t query)
+		{
+			FindPath(queries[query], results[query], algorithm);
+		});
+	}
+
+private:
+	const Grid_Type& grid;
+	Cost_Function cost;
+	float heuristicScale;
+
+	inline std::uint32_t GetColumnCount() const
+	{
+		return std::uint32_t(this->grid.GetColumnCount());
+	}
+
+	inline std::uint32_t GetRowCount() const
+	{
+		return std::uint32_t(this->grid.GetRowCount());
+	}
+
+	inline float GetCost(std::int64_t column, std::int64_t row) const
+	{
+		if (column < 0 || row < 0 || column >= std::int64_t(GetColumnCount()) || row >= std::int64_t(GetRowCount()))
+			return GridPathBlocked;
+
+		return float(this->cost(this->grid.GetCell(typename Grid_Type::dimension_type(column),
+			typename Grid_Type::dimension_type(row))));
+	}
+
+	inline bool IsOpen(std::int64_t column, std::int64_t row) const
+	{
+		return GetCost(column, row) != GridPathBlocked;
+	}
+
+	inline std::uint32_t ToIndex(std::int64_t column, std::int64_t row) const
+	{
+		return std::uint32_t(row * GetColumnCount() + column);
+	}
+
+	inline float Heuristic(std::int64_t column, std::int64_t row, const GridPathPoint& goal) const
+	{
+		float columnDistance = float(std::abs(column - std::int64_t(goal.column)));
+		float rowDistance = float(std::abs(row - std::int64_t(goal.row)));
+
+		return this->heuristicScale * (std::max(columnDistance, rowDistance) +
+			(diagonal_cost - 1.0f) * std::min(columnDistance, rowDistance));
+	}
+
+	void CheckPoint(const GridPathPoint& point) const
+	{
+		if (point.column >= GetColumnCount() || point.row >= GetRowCount())
+			throw std::out_of_range("GridPathfinder point outside the grid");
+	}
+
+	bool SearchAStar(const GridPathQuery& query, GridPath& path, GridPathScratch& scratch) const
+	{
+		std::uint32_t goalIndex = ToIndex(query.goal.column, query.goal.row);
+		std::uint32_t startIndex = ToIndex(query.start.column, query.start.row);
+
+		scratch.Relax(startIndex, startIndex, 0.0f, Heuristic(query.start.column, query.start.row, query.goal));
+
+		std::uint32_t index;
+		float g;
+
+		while (scratch.PopBest(index, g))
+		{
+			path.expandedNodes++;
+
+			if (index == goalIndex)
+			{
+				BuildPath(scratch, startIndex, goalIndex, g, path);
+				return true;
+			}
+
+			std::int64_t column = index % GetColumnCount();
+			std::int64_t row = index / GetColumnCount();
+
+			for (int rowStep = -1; rowStep <= 1; rowStep++)
+			{
+				for (int columnStep = -1; columnStep <= 1; columnStep++)
+				{
+					if (columnStep == 0 && rowStep == 0)
+						continue;
+
+					float stepCost = GetCost(column + columnStep, row + rowStep);
+
+					if (stepCost == GridPathBlocked)
+						continue;
+
+					if (columnStep != 0 && rowStep != 0)
+					{
+						if (!IsOpen(column + columnStep, row) || !IsOpen(column, row + rowStep))
+							continue;
+
+						stepCost *= diagonal_cost;
+					}
+
+					scratch.Relax(ToIndex(column + columnStep, row + rowStep), index, g + stepCost,
+						Heuristic(column + columnStep, row + rowStep, query.goal));
+				}
+			}
+		}
+
+		return false;
+	}
+
+	///Walks from (column, row) in (columnStep, rowStep) and returns the first
+	///jump point: the goal, a cell with a forced neighbour, or for diagonal moves
+	///a cell from which a straight jump finds one. Iterative, the only nesting is
+	///the straight jumps tried from each diagonal step.
+	bool Jump(std::int64_t& column, std::int64_t& row, int columnStep, int rowStep, const GridPathPoint& goal) const
+	{
+		while (true)
+		{
+			if (columnStep != 0 && rowStep != 0 &&
+				(!IsOpen(column + columnStep, row) || !IsOpen(column, row + rowStep)))
+				return false;
+
+			column += columnStep;
+			row += rowStep;
+
+			if (!IsOpen(column, row))
+				return false;
+
+			if (column == goal.column && row == goal.row)
+				return true;
+
+			if (columnStep != 0 && rowStep != 0)
+			{
+				std::int64_t straightColumn = column, straightRow = row;
+
+				if (Jump(straightColumn, straightRow, columnStep, 0, goal))
+					return true;
+
+				straightColumn = column;
+				straightRow = row;
+
+				if (Jump(straightColumn, straightRow, 0, rowStep, goal))
+					return true;
+			}
+			else if (columnStep != 0)
+			{
+				if ((IsOpen(column, row - 1) && !IsOpen(column - columnStep, row - 1)) ||
+					(IsOpen(column, row + 1) && !IsOpen(column - columnStep, row + 1)))
+					return true;
+			}
+			else
+			{
+				if ((IsOpen(column - 1, row) && !IsOpen(column - 1, row - rowStep)) ||
+					(IsOpen(column + 1, row) && !IsOpen(column + 1, row - rowStep)))
+					return true;
+			}
+		}
+	}
+
+	///The directions worth jumping in from a node reached from parent
+	int PruneDirections(std::int64_t column, std::int64_t row, std::int64_t parentColumn, std::int64_t parentRow,
+		int (&directions)[8][2]) const
+	{
+		int count = 0;
+
+		auto add = [&](int columnStep, int rowStep)
+		{
+			directions[count][0] = columnStep;
+			directions[count][1] = rowStep;
+			count++;
+		};
+
+		int columnStep = column == parentColumn ? 0 : (column > parentColumn ? 1 : -1);
+		int rowStep = row == parentRow ? 0 : (row > parentRow ? 1 : -1);
+
+		if (columnStep == 0 && rowStep == 0)
+		{
+			for (int stepRow = -1; stepRow <= 1; stepRow++)
+			{
+				for (int stepColumn = -1; stepColumn <= 1; stepColumn++)
+				{
+					if (stepColumn != 0 || stepRow != 0)
+						add(stepColumn, stepRow);
+				}
+			}
+		}
+		else if (columnStep != 0 && rowStep != 0)
+		{
+			add(columnStep, 0);
+			add(0, rowStep);
+			add(columnStep, rowStep);
+		}
+		else if (columnStep != 0)
+		{
+			add(columnStep, 0);
+			add(0, 1);
+			add(0, -1);
+			add(columnStep, 1);
+			add(columnStep, -1);
+		}
+		else
+		{
+			add(0, rowStep);
+			add(1, 0);
+			add(-1, 0);
+			add(1, rowStep);
+			add(-1, rowStep);
+		}
+
+		return count;
+	}
+
+	bool SearchJumpPoints(const GridPathQuery& query, GridPath& path, GridPathScratch& scratch) const
+	{
+		std::uint32_t goalIndex = ToIndex(query.goal.column, query.goal.row);
+		std::uint32_t startIndex = ToIndex(query.start.column, query.start.row);
+
+		scratch.Relax(startIndex, startIndex, 0.0f, Heuristic(query.start.column, query.start.row, query.goal));
+
+		std::uint32_t index;
+		float g;
+		int directions[8][2];
+
+		while (scratch.PopBest(index, g))
+		{
+			path.expandedNodes++;
+
+			if (index == goalIndex)
+			{
+				BuildPath(scratch, startIndex, goalIndex, g, path);
+				return true;
+			}
+
+			std::int64_t column = index % GetColumnCount();
+			std::int64_t row = index / GetColumnCount();
+
+			std::uint32_t parent = scratch.GetNode(index).parent;
+			int directionCount = PruneDirections(column, row, parent % GetColumnCount(), parent / GetColumnCount(),
+				directions);
+
+			for (int direction = 0; direction < directionCount; direction++)
+			{
+				std::int64_t jumpColumn = column, jumpRow = row;
+
+				if (!Jump(jumpColumn, jumpRow, directions[direction][0], directions[direction][1], query.goal))
+					continue;
+
+				float columnDistance = float(std::abs(jumpColumn - column));
+				float rowDistance = float(std::abs(jumpRow - row));
+				float distance = std::max(columnDistance, rowDistance) +
+					(diagonal_cost - 1.0f) * std::min(columnDistance, rowDistance);
+
+				scratch.Relax(ToIndex(jumpColumn, jumpRow), index, g + distance,
+					Heuristic(jumpColumn, jumpRow, query.goal));
+			}
+		}
+
+		return false;
+	}
+
+	///Follows the parents back from the goal. Jump point parents can be several
+	///cells away in a straight or diagonal line, the cells between are filled in.
+	void BuildPath(GridPathScratch& scratch, std::uint32_t startIndex, std::uint32_t goalIndex, float g,
+		GridPath& path) const
+	{
+		path.cost = g;
+
+		std::uint32_t index = goalIndex;
+
+		while (true)
+		{
+			std::int64_t column = index % GetColumnCount();
+			std::int64_t row = index / GetColumnCount();
+
+			path.points.push_back(GridPathPoint{ std::uint32_t(column), std::uint32_t(row) });
+
+			if (index == startIndex)
+				break;
+
+			std::uint32_t parent = scratch.GetNode(index).parent;
+			std::int64_t parentColumn = parent % GetColumnCount();
+			std::int64_t parentRow = parent / GetColumnCount();
+
+			int columnStep = parentColumn == column ? 0 : (parentColumn > column ? 1 : -1);
+			int rowStep = parentRow == row ? 0 : (parentRow > row ? 1 : -1);
+
+			for (column += columnStep, row += rowStep; column != parentColumn || row != parentRow;
+				column += columnStep, row += rowStep)
+				path.points.push_back(GridPathPoint{ std::uint32_t(column), std::uint32_t(row) });
+
+			index = parent;
+		}
+
+		std::reverse(path.points.begin(), path.points.end());
+	}
+};
+
@@ -0,0 +1,436 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GRID_PYRAMID_SSE2 1
+#endif
+
+#include "Grid.h"
+
+///GridPyramid reductions. Each combines the 4 cells of a 2 x 2 block, or the
+///2 or 1 left where a level has an odd column or row count.
+
+///Mean of the cells. Integral cells are summed in 64 bits and the mean truncated.
+struct GridReduceMean
+{
+	template<typename Data_Type>
+	using sum_type = typename std::conditional<std::is_integral<Data_Type>::value,
+		typename std::conditional<std::is_signed<Data_Type>::value, std::int64_t, std::uint64_t>::type, Data_Type>::type;
+
+	template<typename Data_Type>
+	Data_Type operator()(const Data_Type& a, const Data_Type& b, const Data_Type& c, const Data_Type& d) const
+	{
+		//Pairs summed along rows first, as the SSE2 kernel does
+		if constexpr (std::is_integral<Data_Type>::value)
+			return Data_Type((sum_type<Data_Type>(a) + b + (sum_type<Data_Type>(c) + d)) / 4);
+		else
+			return Data_Type((a + b + (c + d)) * Data_Type(0.25));
+	}
+
+	template<typename Data_Type>
+	Data_Type operator()(const Data_Type& a, const Data_Type& b) const
+	{
+		if constexpr (std::is_integral<Data_Type>::value)
+			return Data_Type((sum_type<Data_Type>(a) + b) / 2);
+		else
+			return Data_Type((a + b) * Data_Type(0.5));
+	}
+};
+
+struct GridReduceMin
+{
+	template<typename Data_Type>
+	Data_Type operator()(const Data_Type& a, const Data_Type& b, const Data_Type& c, const Data_Type& d) const
+	{
+		return (*this)((*this)(a, b), (*this)(c, d));
+	}
+
+	template<typename Data_Type>
+	Data_Type operator()(const Data_Type& a, const Data_Type& b) const
+	{
+		return a < b ? a : b;
+	}
+};
+
+struct GridReduceMax
+{
+	template<typename Data_Type>
+	Data_Type operator()(const Data_Type& a, const Data_Type& b, const Data_Type& c, const Data_Type& d) const
+	{
+		return (*this)((*this)(a, b), (*this)(c, d));
+	}
+
+	template<typename Data_Type>
+	Data_Type operator()(const Data_Type& a, const Data_Type& b) const
+	{
+		return a > b ? a : b;
+	}
+};
+
+///Most frequent cell, for categories such as terrain types. Ties go to the
+///lowest value, so the result does not depend on where in the block cells are.
+struct GridReduceMode
+{
+	template<typename Data_Type>
+	Data_Type operator()(const Data_Type& a, const Data_Type& b, const Data_Type& c, const Data_Type& d) const
+	{
+		const Data_Type* values[4] = { &a, &b, &c, &d };
+		const Data_Type* best = values[0];
+		int bestCount = 0;
+
+		for (const Data_Type* value : values)
+		{
+			int count = (a == *value) + (b == *value) + (c == *value) + (d == *value);
+
+			if (count > bestCount || (count == bestCount && *value < *best))
+			{
+				best = value;
+				bestCount = count;
+			}
+		}
+
+		return *best;
+	}
+
+	template<typename Data_Type>
+	Data_Type operator()(const Data_Type& a, const Data_Type& b) const
+	{
+		return b < a ? b : a;
+	}
+};
+
+namespace GridPyramidDetail
+{
+#if defined(GRID_PYRAMID_SSE2)
+	///Whether Reduction_Type has an SSE2 kernel for 4 float outputs at a time
+	template<typename Reduction_Type, typename Data_Type>
+	struct HasFloatKernel : std::bool_constant<std::is_same<Data_Type, float>::value &&
+		(std::is_same<Reduction_Type, GridReduceMean>::value || std::is_same<Reduction_Type, GridReduceMin>::value ||
+			std::is_same<Reduction_Type, GridReduceMax>::value)>
+	{
+
+	};
+
+	template<typename Reduction_Type>
+	inline __m128 CombineFloats(__m128 left, __m128 right)
+	{
+		if constexpr (std::is_same<Reduction_Type, GridReduceMin>::value)
+			return _mm_min_ps(left, right);
+		else if constexpr (std::is_same<Reduction_Type, GridReduceMax>::value)
+			return _mm_max_ps(left, right);
+		else
+			return _mm_add_ps(left, right);
+	}
+
+	///Reduces 8 columns of two rows into 4 cells. The shuffles split even and odd
+	///columns so each lane pairs the two cells of one block row.
+	template<typename Reduction_Type>
+	inline void ReduceFloats(const float* top, const float* bottom, float* target)
+	{
+		__m128 topLeft = _mm_loadu_ps(top), topRight = _mm_loadu_ps(top + 4);
+		__m128 bottomLeft = _mm_loadu_ps(bottom), bottomRight = _mm_loadu_ps(bottom + 4);
+
+		__m128 topPairs = CombineFloats<Reduction_Type>(_mm_shuffle_ps(topLeft, topRight, _MM_SHUFFLE(2, 0, 2, 0)),
+			_mm_shuffle_ps(topLeft, topRight, _MM_SHUFFLE(3, 1, 3, 1)));
+		__m128 bottomPairs = CombineFloats<Reduction_Type>(_mm_shuffle_ps(bottomLeft, bottomRight, _MM_SHUFFLE(2, 0, 2, 0)),
+			_mm_shuffle_ps(bottomLeft, bottomRight, _MM_SHUFFLE(3, 1, 3, 1)));
+		__m128 result = CombineFloats<Reduction_Type>(topPairs, bottomPairs);
+
+		if constexpr (std::is_same<Reduction_Type, GridReduceMean>::value)
+			result = _mm_mul_ps(result, _mm_set1_ps(0.25f));
+
+		_mm_storeu_ps(target, result);
+	}
+#endif
+
+	///Reduces a pair of rows, sourceColumns wide, into one row of the level
+	///above. bottom is null for the last row of a level with an odd row count.
+	template<typename Reduction_Type, typename Data_Type>
+	void ReduceRows(const Reduction_Type& reduction, const Data_Type* top, const Data_Type* bottom,
+		std::size_t sourceColumns, Data_Type* target, std::size_t firstColumn, std::size_t lastColumn)
+	{
+		std::size_t column = firstColumn;
+		std::size_t pairedColumns = std::min(lastColumn + 1, sourceColumns / 2);
+
+		if (bottom == nullptr)
+		{
+			for (; column < pairedColumns; column++)
+				target[column] = reduction(top[2 * column], top[2 * column + 1]);
+		}
+		else
+		{
+#if defined(GRID_PYRAMID_SSE2)
+			if constexpr (HasFloatKernel<Reduction_Type, Data_Type>::value)
+			{
+				for (; column + 4 <= pairedColumns; column += 4)
+					ReduceFloats<Reduction_Type>(top + 2 * column, bottom + 2 * column, target + column);
+			}
+#endif
+
+			for (; column < pairedColumns; column++)
+				target[column] = reduction(top[2 * column], top[2 * column + 1], bottom[2 * column], bottom[2 * column + 1]);
+		}
+
+		//The lone last column of an odd width
+		if (column <= lastColumn)
+			target[column] = bottom == nullptr ? top[2 * column] : reduction(top[2 * column], bottom[2 * column]);
+	}
+}
+
+///Downsampled copies of a grid, each level half the width and height of the
+///one below (rounded up) down to a single cell, for renderers and coarse
+///planners. Level 0 is the base grid halved; the base itself is not held.
+///
+///	GridPyramid<float, GridReduceMax> heights(GridExecution::par, heightField);
+///	heightField.GetCell(10, 20) = 5.0f;
+///	heights.Refresh(heightField, 10, 20, 10, 20);
+///	const Grid<float>& quarter = heights.GetLevel(1);
+///
+///Each cell of a level combines a 2 x 2 block below it through Reduction_Type:
+///GridReduceMean, GridReduceMin, GridReduceMax, GridReduceMode or any functor
+///with the same two operator() overloads. Mean, min and max of float cells run
+///4 output cells at a time with SSE2. Build splits each level's rows into bands
+///over a GridExecution policy; Refresh recomputes only the ancestors of a
+///changed rectangle.
+template<typename Data_Type, typename Reduction_Type = GridReduceMean, typename Allocator_Type = std::allocator<Data_Type>>
+class GridPyramid
+{
+public:
+	typedef Data_Type value_type;
+	typedef Reduction_Type reduction_type;
+	typedef std::uint32_t dimension_type;
+	typedef Grid<Data_Type, RowMajorLayout, Allocator_Type, std::uint32_t> level_type;
+
+	explicit GridPyramid(const Reduction_Type& _reduction = Reduction_Type(), const Allocator_Type& _allocator = Allocator_Type())
+		:reduction(_reduction), allocator(_allocator), baseColumnCount(0), baseRowCount(0)
+	{
+
+	}
+
+	template<typename Base_Grid>
+	explicit GridPyramid(const Base_Grid& base, const Reduction_Type& _reduction = Reduction_Type(),
+		const Allocator_Type& _allocator = Allocator_Type())
+		:GridPyramid(_reduction, _allocator)
+	{
+		Build(GridExecution::seq, base);
+	}
+
+	template<typename Policy_Type, typename Base_Grid,
+		typename = typename std::enable_if<GridExecution::IsExecutionPolicy<Policy_Type>::value>::type>
+	GridPyramid(const Policy_Type& policy, const Base_Grid& base, const Reduction_Type& _reduction = Reduction_Type(),
+		const Allocator_Type& _allocator = Allocator_Type())
+		:GridPyramid(_reduction, _allocator)
+	{
+		Build(policy, base);
+	}
+
+	///Rebuilds every level from base
+	template<typename Policy_Type, typename Base_Grid>
+	void Build(const Policy_Type& policy, const Base_Grid& base)
+	{
+		if (std::uint64_t(base.GetColumnCount()) > std::numeric_limits<dimension_type>::max() ||
+			std::uint64_t(base.GetRowCount()) > std::numeric_limits<dimension_type>::max())
+			throw std::length_error("Grid too large for a GridPyramid");
+
+		this->baseColumnCount = dimension_type(base.GetColumnCount());
+		this->baseRowCount = dimension_type(base.GetRowCount());
+		this->levels.clear();
+
+		dimension_type columns = this->baseColumnCount;
+		dimension_type rows = this->baseRowCount;
+
+		//A base with no cells has no levels, whichever dimension is 0
+		while ((columns > 1 || rows > 1) && columns > 0 && rows > 0)
+		{
+			columns = (columns + 1) / 2;
+			rows = (rows + 1) / 2;
+
+			if constexpr (std::is_trivially_default_constructible<Data_Type>::value && std::is_trivially_destructible<Data_Type>::value)
+				this->levels.emplace_back(columns, rows, GridNoInit, this->allocator);
+			else
+				this->levels.emplace_back(columns, rows, Data_Type(), this->allocator);
+		}
+
+		for (std::size_t level = 0; level < this->levels.size(); level++)
+		{
+			level_type& target = this->levels[level];
+			std::size_t rowsPerBand = std::max<std::size_t>(1,
+				GridExecution::band_bytes / (std::size_t(target.GetColumnCount()) * 2 * sizeof(Data_Type)));
+
+			GridExecution::ForEachBand(policy, (std::size_t(target.GetRowCount()) + rowsPerBand - 1) / rowsPerBand, [&](std::size_t band)
+			{
+				std::size_t lastRow = std::min<std::size_t>((band + 1) * rowsPerBand, target.GetRowCount()) - 1;
+
+				if (level == 0)
+					ReduceBase(base, band * rowsPerBand, lastRow, 0, std::size_t(target.GetColumnCount()) - 1);
+				else
+					ReduceLevel(level, band * rowsPerBand, lastRow, 0, std::size_t(target.GetColumnCount()) - 1);
+			});
+		}
+	}
+
+	///Brings the levels up to date after the cells of base inside the inclusive
+	///rectangle changed: each level recomputes only the cells over the rectangle
+	///of the level below, so a single cell costs one cell per level.
+	template<typename Base_Grid>
+	void Refresh(const Base_Grid& base, dimension_type firstColumn, dimension_type firstRow,
+		dimension_type lastColumn, dimension_type lastRow)
+	{
+		if (std::uint64_t(base.GetColumnCount()) != this->baseColumnCount ||
+			std::uint64_t(base.GetRowCount()) != this->baseRowCount)
+			throw std::invalid_argument("GridPyramid base dimensions differ");
+
+		if (lastColumn >= this->baseColumnCount || lastRow >= this->baseRowCount)
+			throw std::out_of_range("GridPyramid rectangle outside the grid");
+
+		if (firstColumn > lastColumn || firstRow > lastRow)
+			throw std::invalid_argument("GridPyramid rectangle corners out of order");
+
+		for (std::size_t level = 0; level < this->levels.size(); level++)
+		{
+			firstColumn /= 2;
+			firstRow /= 2;
+			lastColumn /= 2;
+			lastRow /= 2;
+
+			if (level == 0)
+				ReduceBase(base, firstRow, lastRow, firstColumn, lastColumn);
+			else
+				ReduceLevel(level, firstRow, lastRow, firstColumn, lastColumn);
+		}
+	}
+
+	///Number of levels, 0 when the base is a single cell
+	inline std::size_t GetLevelCount() const
+	{
+		return this->levels.size();
+	}
+
+	///Level 0 halves the base, each next level halves again
+	const level_type& GetLevel(std::size_t level) const
+	{
+		if (level >= this->levels.size())
+			throw std::out_of_range("GridPyramid-GetLevel Argument Out of Range");
+
+		return this->levels[level];
+	}
+
+	///The single cell reducing the whole base
+	const Data_Type& GetTop() const
+	{
+		if (this->levels.empty())
+			throw std::out_of_range("GridPyramid has no levels");
+
+		return this->levels.back().GetCell(0);
+	}
+
+	inline dimension_type GetBaseColumnCount() const
+	{
+		return this->baseColumnCount;
+	}
+
+	inline dimension_type GetBaseRowCount() const
+	{
+		return this->baseRowCount;
+	}
+
+	inline const Reduction_Type& GetReduction() const
+	{
+		return this->reduction;
+	}
+
+private:
+	Reduction_Type reduction;
+	Allocator_Type allocator;
+
+	dimension_type baseColumnCount;
+	dimension_type baseRowCount;
+
+	std::vector<level_type> levels;
+
+	static inline Data_Type* GetRow(level_type& level, std::size_t row)
+	{
+		return &level.GetCell(row * level.GetColumnCount());
+	}
+
+	static inline const Data_Type* GetRow(const level_type& level, std::size_t row)
+	{
+		return &level.GetCell(row * level.GetColumnCount());
+	}
+
+	///Recomputes rows and columns firstRow..lastRow, firstColumn..lastColumn of
+	///level from the level below it
+	void ReduceLevel(std::size_t level, std::size_t firstRow, std::size_t lastRow,
+		std::size_t firstColumn, std::size_t lastColumn)
+	{
+		const level_type& source = this->levels[level - 1];
+		level_type& target = this->levels[level];
+
+		for (std::size_t row = firstRow; row <= lastRow; row++)
+		{
+			const Data_Type* bottom = 2 * row + 1 < source.GetRowCount() ? GetRow(source, 2 * row + 1) : nullptr;
+
+			GridPyramidDetail::ReduceRows(this->reduction, GetRow(source, 2 * row), bottom,
+				source.GetColumnCount(), GetRow(target, row), firstColumn, lastColumn);
+		}
+	}
+
+	///As ReduceLevel for level 0. Bases whose rows are not contiguous, or are
+	///not row major, are copied a row pair at a time first.
+	template<typename Base_Grid>
+	void ReduceBase(const Base_Grid& base, std::size_t firstRow, std::size_t lastRow,
+		std::size_t firstColumn, std::size_t lastColumn)
+	{
+		typedef typename Base_Grid::dimension_type base_dimension;
+
+		level_type& target = this->levels[0];
+		std::size_t sourceColumns = this->baseColumnCount;
+		std::size_t firstSource = 2 * firstColumn;
+		std::size_t lastSource = std::min(2 * lastColumn + 1, sourceColumns - 1);
+
+		bool contiguous = false;
+
+		if constexpr (std::is_same<typename Base_Grid::value_type, Data_Type>::value && Base_Grid::layout_type::is_strided)
+			contiguous = base.GetLayout().GetColumnStride() == 1;
+
+		std::vector<Data_Type> scratch;
+
+		if (!contiguous)
+			scratch.resize(2 * sourceColumns);
+
+		for (std::size_t row = firstRow; row <= lastRow; row++)
+		{
+			const Data_Type* rows[2] = { nullptr, nullptr };
+
+			for (std::size_t half = 0; half < 2 && 2 * row + half < this->baseRowCount; half++)
+			{
+				base_dimension sourceRow = base_dimension(2 * row + half);
+
+				if (contiguous)
+				{
+					rows[half] = &base.GetCell(base.GetOneDimensionIndex(0, sourceRow));
+					continue;
+				}
+
+				for (std::size_t column = firstSource; column <= lastSource; column++)
+				{
+					scratch[half * sourceColumns + column] =
+						Data_Type(base.GetCell(base.GetOneDimensionIndex(base_dimension(column), sourceRow)));
+				}
+
+				rows[half] = scratch.data() + half * sourceColumns;
+			}
+
+			GridPyramidDetail::ReduceRows(this->reduction, rows[0], rows[1], sourceColumns,
+				GetRow(target, row), firstColumn, lastColumn);
+		}
+	}
+};
@@ -0,0 +1,372 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Grid.h"
+#include "GridCodecs.h"
+
+///Binary format used by SaveGrid and LoadGrid. A file is a header followed
+///by bands of whole rows, each band compressed on its own, so neither side ever
+///holds more than one band besides the grid itself:
+///
+///	header	"GRIDBIN" magic, version, columnCount, rowCount, elementSize,
+///			codecId, bandRows (all little endian)
+///	band	rawSize, storedSize (u64 each), bandCodecId (u32) then storedSize bytes
+///
+///Version 1 files had u32 band sizes, which a band over 4GB would have wrapped;
+///they are still read.
+///
+///The cells are written in row by row order whatever the grid's layout, so a
+///file saved from one layout loads into any other. Cell bytes are written as
+///they are in memory, files only move between machines of the same endianness.
+
+///Reads and writes Grid_Type in the format above. SaveGrid and LoadGrid
+///forward here; it only uses Grid's public interface.
+template<typename Grid_Type>
+class GridSerializer
+{
+public:
+	typedef typename Grid_Type::value_type value_type;
+	typedef typename Grid_Type::dimension_type dimension_type;
+
+	static_assert(std::is_trivially_copyable<value_type>::value,
+		"Only trivially copyable cells can be written as raw bytes");
+
+	static constexpr std::uint32_t current_version = 2;
+
+	///Bands aim for this many bytes, always at least one row
+	static constexpr std::size_t band_bytes = std::size_t(1) << 18;
+
+	static void Write(const Grid_Type& grid, std::ostream& stream, const GridCodec& codec)
+	{
+		std::uint64_t columns = grid.GetColumnCount();
+		std::uint64_t rows = grid.GetRowCount();
+		std::size_t rowBytes = std::size_t(columns) * sizeof(value_type);
+		std::size_t bandRows = GetBandRows(rowBytes);
+
+		unsigned char header[header_size];
+		std::memcpy(header, magic, sizeof(magic));
+		Store32(header + 8, current_version);
+		Store64(header + 12, columns);
+		Store64(header + 20, rows);
+		Store32(header + 28, std::uint32_t(sizeof(value_type)));
+		Store32(header + 32, codec.GetId());
+		Store32(header + 36, std::uint32_t(bandRows));
+
+		WriteBytes(stream, header, header_size);
+
+		std::vector<unsigned char> band;
+		std::vector<unsigned char> stored;
+
+		for (std::uint64_t firstRow = 0; firstRow < rows; firstRow += bandRows)
+		{
+			std::size_t rowsInBand = std::size_t(std::min<std::uint64_t>(bandRows, rows - firstRow));
+
+			band.resize(rowsInBand * rowBytes);
+
+			for (std::size_t row = 0; row < rowsInBand; row++)
+				GatherRow(grid, dimension_type(firstRow + row), band.data() + row * rowBytes);
+
+			codec.Compress(band.data(), band.size(), stored);
+
+			//Incompressible bands are kept raw rather than grown
+			const unsigned char* payload = stored.data();
+			std::uint32_t bandCodec = codec.GetId();
+
+			if (stored.size() > band.size())
+			{
+				payload = band.data();
+				stored.resize(band.size());
+				bandCodec = GridRawCodec::id;
+			}
+
+			unsigned char bandHeader[band_header_size];
+			Store64(bandHeader, band.size());
+			Store64(bandHeader + 8, stored.size());
+			Store32(bandHeader + 16, bandCodec);
+
+			WriteBytes(stream, bandHeader, sizeof(bandHeader));
+			WriteBytes(stream, payload, stored.size());
+		}
+
+		if (!stream)
+			throw std::runtime_error("GridSerializer write failed");
+	}
+
+	///Builds the grid aside and only replaces grid once every band has been read
+	static void Read(Grid_Type& grid, std::istream& stream, const GridCodec* customCodec)
+	{
+		unsigned char header[header_size];
+		ReadBytes(stream, header, header_size);
+
+		if (std::memcmp(header, magic, sizeof(magic)) != 0)
+			throw std::runtime_error("GridSerializer not a grid file");
+
+		std::uint32_t version = Load32(header + 8);
+
+		if (version != 1 && version != current_version)
+			throw std::runtime_error("GridSerializer unsupported version");
+
+		std::uint64_t columns = Load64(header + 12);
+		std::uint64_t rows = Load64(header + 20);
+
+		if (Load32(header + 28) != sizeof(value_type))
+			throw std::runtime_error("GridSerializer element size mismatch");
+
+		//Save writes an empty grid as 0 x 0 and no bands
+		if (columns == 0 && rows == 0)
+		{
+			grid = Grid_Type(grid.get_allocator());
+			return;
+		}
+
+		if (columns == 0 || rows == 0 || columns > std::numeric_limits<dimension_type>::max() ||
+			rows > std::numeric_limits<dimension_type>::max())
+			throw std::runtime_error("GridSerializer dimensions do not fit dimension_type");
+
+		if (rows > std::numeric_limits<std::size_t>::max() / sizeof(value_type) / columns)
+			throw std::runtime_error("GridSerializer grid too large to load");
+
+		std::uint32_t fileCodec = Load32(header + 32);
+		std::size_t bandRows = Load32(header + 36);
+		std::size_t rowBytes = std::size_t(columns) * sizeof(value_type);
+
+		//Write always picks the band height from the row size, anything else is corrupt
+		if (bandRows != GetBandRows(rowBytes))
+			throw std::runtime_error("GridSerializer corrupt header");
+
+		//Every band costs at least its header, and the cells too when the file is not
+		//compressed, so on a seekable stream a truncated or corrupt header cannot make
+		//Read allocate far more than the stream could describe
+		std::uint64_t bandCount = (rows + bandRows - 1) / bandRows;
+		std::uint64_t bandHeaderSize = version == 1 ? 12 : band_header_size;
+		std::uint64_t remaining = GetRemainingBytes(stream);
+		std::uint64_t cellBytes = fileCodec == GridRawCodec::id ? rows * rowBytes : 0;
+
+		if (bandCount > remaining / bandHeaderSize || cellBytes > remaining - bandCount * bandHeaderSize)
+			throw std::runtime_error("GridSerializer unexpected end of data");
+
+		Grid_Type loaded(grid.get_allocator());
+
+		if constexpr (std::is_trivially_default_constructible<value_type>::value)
+			loaded.ResizeGrid(dimension_type(columns), dimension_type(rows), GridNoInit);
+		else
+			loaded.ResizeGrid(dimension_type(columns), dimension_type(rows));
+
+		std::vector<unsigned char> band;
+		std::vector<unsigned char> stored;
+
+		for (std::uint64_t firstRow = 0; firstRow < rows; firstRow += bandRows)
+		{
+			std::size_t rowsInBand = std::size_t(std::min<std::uint64_t>(bandRows, rows - firstRow));
+
+			unsigned char bandHeader[band_header_size];
+			std::uint64_t rawSize, storedSize;
+			std::uint32_t bandCodec;
+
+			if (version == 1)
+			{
+				ReadBytes(stream, bandHeader, 12);
+				rawSize = Load32(bandHeader);
+				storedSize = Load32(bandHeader + 4);
+				bandCodec = Load32(bandHeader + 8);
+			}
+			else
+			{
+				ReadBytes(stream, bandHeader, band_header_size);
+				rawSize = Load64(bandHeader);
+				storedSize = Load64(bandHeader + 8);
+				bandCodec = Load32(bandHeader + 16);
+			}
+
+			//Write never stores a band larger than it was raw
+			if (rawSize != rowsInBand * rowBytes || storedSize > rawSize)
+				throw std::runtime_error("GridSerializer corrupt band");
+
+			stored.resize(std::size_t(storedSize));
+			ReadBytes(stream, stored.data(), stored.size());
+
+			band.resize(std::size_t(rawSize));
+			FindCodec(bandCodec == GridRawCodec::id ? bandCodec : fileCodec, customCodec).Decompress(
+				stored.data(), stored.size(), band.data(), band.size());
+
+			for (std::size_t row = 0; row < rowsInBand; row++)
+				ScatterRow(loaded, dimension_type(firstRow + row), band.data() + row * rowBytes);
+		}
+
+		grid = std::move(loaded);
+	}
+
+	static void Write(const Grid_Type& grid, const std::string& path, const GridCodec& codec)
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+
+		if (!stream)
+			throw std::runtime_error("GridSerializer cannot create " + path);
+
+		Write(grid, stream, codec);
+	}
+
+	static void Read(Grid_Type& grid, const std::string& path, const GridCodec* customCodec)
+	{
+		std::ifstream stream(path, std::ios::binary);
+
+		if (!stream)
+			throw std::runtime_error("GridSerializer cannot open " + path);
+
+		Read(grid, stream, customCodec);
+	}
+
+private:
+	static constexpr std::size_t header_size = 40;
+	static constexpr std::size_t band_header_size = 20;
+	static constexpr char magic[8] = { 'G', 'R', 'I', 'D', 'B', 'I', 'N', 0 };
+
+	static std::size_t GetBandRows(std::size_t rowBytes)
+	{
+		return rowBytes == 0 ? 1 : std::max<std::size_t>(1, band_bytes / rowBytes);
+	}
+
+	///Bytes left in stream, or the largest value when it cannot seek
+	static std::uint64_t GetRemainingBytes(std::istream& stream)
+	{
+		std::streambuf* buffer = stream.rdbuf();
+		std::streampos position = buffer->pubseekoff(0, std::ios::cur, std::ios::in);
+
+		if (position == std::streampos(-1))
+			return std::numeric_limits<std::uint64_t>::max();
+
+		std::streampos end = buffer->pubseekoff(0, std::ios::end, std::ios::in);
+		buffer->pubseekpos(position, std::ios::in);
+
+		if (end == std::streampos(-1) || end < position)
+			return std::numeric_limits<std::uint64_t>::max();
+
+		return std::uint64_t(end - position);
+	}
+
+	static const GridCodec& FindCodec(std::uint32_t codecId, const GridCodec* customCodec)
+	{
+		static const GridRawCodec raw;
+		static const GridLzCodec lz;
+
+		if (customCodec && customCodec->GetId() == codecId)
+			return *customCodec;
+
+		if (codecId == GridRawCodec::id)
+			return raw;
+
+		if (codecId == GridLzCodec::id)
+			return lz;
+
+		throw std::runtime_error("GridSerializer unknown codec, pass it to Load");
+	}
+
+	static void GatherRow(const Grid_Type& grid, dimension_type row, unsigned char* output)
+	{
+		if constexpr (Grid_Type::layout_type::contiguous_rows)
+		{
+			std::memcpy(output, &grid.GetCell(0, row), std::size_t(grid.GetColumnCount()) * sizeof(value_type));
+		}
+		else
+		{
+			for (dimension_type column = 0; column < grid.GetColumnCount(); column++, output += sizeof(value_type))
+				std::memcpy(output, &grid.GetCell(column, row), sizeof(value_type));
+		}
+	}
+
+	static void ScatterRow(Grid_Type& grid, dimension_type row, const unsigned char* input)
+	{
+		if constexpr (Grid_Type::layout_type::contiguous_rows)
+		{
+			std::memcpy(&grid.GetCell(0, row), input, std::size_t(grid.GetColumnCount()) * sizeof(value_type));
+		}
+		else
+		{
+			for (dimension_type column = 0; column < grid.GetColumnCount(); column++, input += sizeof(value_type))
+				std::memcpy(&grid.GetCell(column, row), input, sizeof(value_type));
+		}
+	}
+
+	static void WriteBytes(std::ostream& stream, const unsigned char* data, std::size_t size)
+	{
+		stream.write(reinterpret_cast<const char*>(data), std::streamsize(size));
+	}
+
+	static void ReadBytes(std::istream& stream, unsigned char* data, std::size_t size)
+	{
+		if (!stream.read(reinterpret_cast<char*>(data), std::streamsize(size)))
+			throw std::runtime_error("GridSerializer unexpected end of data");
+	}
+
+	static void Store32(unsigned char* output, std::uint32_t value)
+	{
+		for (int byte = 0; byte < 4; byte++)
+			output[byte] = static_cast<unsigned char>(value >> (8 * byte));
+	}
+
+	static void Store64(unsigned char* output, std::uint64_t value)
+	{
+		for (int byte = 0; byte < 8; byte++)
+			output[byte] = static_cast<unsigned char>(value >> (8 * byte));
+	}
+
+	static std::uint32_t Load32(const unsigned char* input)
+	{
+		std::uint32_t value = 0;
+
+		for (int byte = 3; byte >= 0; byte--)
+			value = (value << 8) | input[byte];
+
+		return value;
+	}
+
+	static std::uint64_t Load64(const unsigned char* input)
+	{
+		std::uint64_t value = 0;
+
+		for (int byte = 7; byte >= 0; byte--)
+			value = (value << 8) | input[byte];
+
+		return value;
+	}
+};
+
+///Writes the cells in the band format above, compressing each band with codec
+///(GridLzCodec for example). Needs trivially copyable cells.
+template<typename Grid_Type>
+void SaveGrid(const Grid_Type& grid, std::ostream& stream, const GridCodec& codec = GridRawCodec())
+{
+	GridSerializer<Grid_Type>::Write(grid, stream, codec);
+}
+
+template<typename Grid_Type>
+void SaveGrid(const Grid_Type& grid, const std::string& path, const GridCodec& codec = GridRawCodec())
+{
+	GridSerializer<Grid_Type>::Write(grid, path, codec);
+}
+
+///Replaces grid with one written by SaveGrid, whatever layout it was saved
+///from. grid is unchanged if reading throws. codec is only needed when the
+///file uses one that is not built in.
+template<typename Grid_Type>
+void LoadGrid(Grid_Type& grid, std::istream& stream, const GridCodec* codec = nullptr)
+{
+	GridSerializer<Grid_Type>::Read(grid, stream, codec);
+}
+
+template<typename Grid_Type>
+void LoadGrid(Grid_Type& grid, const std::string& path, const GridCodec* codec = nullptr)
+{
+	GridSerializer<Grid_Type>::Read(grid, path, codec);
+}
@@ -0,0 +1,1089 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Grid.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define GRID_SIMD_SSE2 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+//AVX2 and AVX-512 kernels are compiled for their own instruction set and only
+//run when the CPU reports it, the rest of the program keeps its own flags
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define GRID_SIMD_AVX 1
+#endif
+#endif
+
+///Vectorised reductions and elementwise operations for Grids of float, double,
+///std::int32_t and std::uint8_t, and for raw spans of them such as the ranges
+///of Grid::GetRow.
+///
+///Every operation has an SSE2, AVX2 and AVX-512 (F + BW) kernel next to the
+///scalar one. The fastest the CPU supports is picked at first use and can be
+///lowered with SetActiveIsa, e.g. to compare against the scalar path. Tails
+///shorter than a register use masked loads and stores with AVX-512 and go
+///through a stack buffer otherwise, so no kernel reads or writes past a span.
+///
+///Results do not depend on the instruction set. Integer sums are exact. Float
+///sums and min/max add cell i of each contiguous run (the whole storage of hole
+///free layouts, each row of padded ones) into lane i % 16 of 16 running lanes,
+///on every instruction set, and fold the lanes in a fixed pairwise tree at the
+///end. That order differs from a left to right loop, so float sums can differ
+///from std::accumulate in the last bits, but never between machines.
+///
+///Min, Max and Clamp compare like the SSE instructions: Min(a, b) is
+///a < b ? a : b. NaN cells are skipped by MinMax and clamp to high in Clamp.
+///Integer Scale, Add and Multiply wrap around.
+namespace GridSimd
+{
+	enum class Isa
+	{
+		Scalar,
+		Sse2,
+		Avx2,
+		Avx512
+	};
+
+	inline const char* GetIsaName(Isa isa)
+	{
+		switch (isa)
+		{
+		case Isa::Sse2:
+			return "SSE2";
+		case Isa::Avx2:
+			return "AVX2";
+		case Isa::Avx512:
+			return "AVX-512";
+		default:
+			return "Scalar";
+		}
+	}
+
+	///Cell types with kernels
+	template<typename T>
+	struct IsSupported : std::integral_constant<bool, std::is_same<T, float>::value || std::is_same<T, double>::value ||
+		std::is_same<T, std::int32_t>::value || std::is_same<T, std::uint8_t>::value>
+	{
+
+	};
+
+	///What Sum returns: 64 bits for the integer types
+	template<typename T>
+	using SumType = typename std::conditional<std::is_floating_point<T>::value, T,
+		typename std::conditional<std::is_signed<T>::value, std::int64_t, std::uint64_t>::type>::type;
+
+	template<typename T>
+	struct MinMaxResult
+	{
+		T min;
+		T max;
+	};
+}
+
+namespace GridSimdDetail
+{
+	///Lanes of the float sums, the widest float register (AVX-512) holds 16
+	constexpr std::size_t sum_lanes = 16;
+
+	///Lanes of the min/max state, the widest byte register holds 64
+	constexpr std::size_t max_lanes = 64;
+
+	template<typename T>
+	inline T MinIdentity()
+	{
+		return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+	}
+
+	template<typename T>
+	inline T MaxIdentity()
+	{
+		return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+	}
+
+	inline GridSimd::Isa DetectIsa()
+	{
+#if !defined(GRID_SIMD_SSE2)
+		return GridSimd::Isa::Scalar;
+#elif !defined(GRID_SIMD_AVX)
+		return GridSimd::Isa::Sse2;
+#elif defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 0);
+
+		if (info[0] < 7)
+			return GridSimd::Isa::Sse2;
+
+		//The OS must save the wider registers too, not only the CPU have them
+		__cpuid(info, 1);
+
+		if ((info[2] & (1 << 27)) == 0)
+			return GridSimd::Isa::Sse2;
+
+		unsigned long long enabledState = _xgetbv(0);
+		__cpuidex(info, 7, 0);
+
+		if ((info[1] & (1 << 16)) && (info[1] & (1 << 30)) && (enabledState & 0xE6) == 0xE6)
+			return GridSimd::Isa::Avx512;
+
+		if ((info[1] & (1 << 5)) && (enabledState & 0x6) == 0x6)
+			return GridSimd::Isa::Avx2;
+
+		return GridSimd::Isa::Sse2;
+#else
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+			return GridSimd::Isa::Avx512;
+
+		if (__builtin_cpu_supports("avx2"))
+			return GridSimd::Isa::Avx2;
+
+		return GridSimd::Isa::Sse2;
+#endif
+	}
+
+	inline GridSimd::Isa GetSupportedIsa()
+	{
+		static const GridSimd::Isa supported = DetectIsa();
+		return supported;
+	}
+
+	inline std::atomic<GridSimd::Isa>& GetActiveIsaState()
+	{
+		static std::atomic<GridSimd::Isa> active(GetSupportedIsa());
+		return active;
+	}
+
+	///One cell per register, the reference the vector kernels must agree with
+	namespace Scalar
+	{
+		template<typename T>
+		struct Vector
+		{
+			typedef T reg;
+			static constexpr std::size_t lanes = 1;
+			static constexpr bool masked_tails = false;
+
+			typedef GridSimd::SumType<T> sum_type;
+			typedef sum_type sum_reg;
+
+			static inline reg Load(const T* cells) { return *cells; }
+			static inline void Store(T* cells, reg value) { *cells = value; }
+			static inline reg Set1(T value) { return value; }
+			static inline reg Min(reg a, reg b) { return a < b ? a : b; }
+			static inline reg Max(reg a, reg b) { return a > b ? a : b; }
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low) { return cell >= threshold ? high : low; }
+
+			//Integer arithmetic goes through the unsigned type to wrap around
+			static inline reg Add(reg a, reg b)
+			{
+				if constexpr (std::is_integral<T>::value)
+					return T(typename std::make_unsigned<T>::type(a) + typename std::make_unsigned<T>::type(b));
+				else
+					return a + b;
+			}
+
+			static inline reg Mul(reg a, reg b)
+			{
+				if constexpr (std::is_integral<T>::value)
+					return T(std::uint32_t(a) * std::uint32_t(b));
+				else
+					return a * b;
+			}
+
+			static inline sum_reg SumZero() { return 0; }
+			static inline sum_reg SumAdd(sum_reg sum, reg value) { return sum + value; }
+			static inline sum_type SumReduce(sum_reg sum) { return sum; }
+		};
+
+#include "GridSimdKernels.inl"
+	}
+
+#if defined(GRID_SIMD_SSE2)
+	namespace Sse2
+	{
+		template<typename T>
+		struct Vector;
+
+		template<>
+		struct Vector<float>
+		{
+			typedef __m128 reg;
+			static constexpr std::size_t lanes = 4;
+			static constexpr bool masked_tails = false;
+
+			static inline reg Load(const float* cells) { return _mm_loadu_ps(cells); }
+			static inline void Store(float* cells, reg value) { _mm_storeu_ps(cells, value); }
+			static inline reg Set1(float value) { return _mm_set1_ps(value); }
+			static inline reg Add(reg a, reg b) { return _mm_add_ps(a, b); }
+			static inline reg Mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm_min_ps(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm_max_ps(a, b); }
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				reg mask = _mm_cmpge_ps(cell, threshold);
+				return _mm_or_ps(_mm_and_ps(mask, high), _mm_andnot_ps(mask, low));
+			}
+		};
+
+		template<>
+		struct Vector<double>
+		{
+			typedef __m128d reg;
+			static constexpr std::size_t lanes = 2;
+			static constexpr bool masked_tails = false;
+
+			static inline reg Load(const double* cells) { return _mm_loadu_pd(cells); }
+			static inline void Store(double* cells, reg value) { _mm_storeu_pd(cells, value); }
+			static inline reg Set1(double value) { return _mm_set1_pd(value); }
+			static inline reg Add(reg a, reg b) { return _mm_add_pd(a, b); }
+			static inline reg Mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm_min_pd(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm_max_pd(a, b); }
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				reg mask = _mm_cmpge_pd(cell, threshold);
+				return _mm_or_pd(_mm_and_pd(mask, high), _mm_andnot_pd(mask, low));
+			}
+		};
+
+		template<>
+		struct Vector<std::int32_t>
+		{
+			typedef __m128i reg;
+			static constexpr std::size_t lanes = 4;
+			static constexpr bool masked_tails = false;
+
+			typedef std::int64_t sum_type;
+			typedef __m128i sum_reg;
+
+			static inline reg Load(const std::int32_t* cells) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells)); }
+			static inline void Store(std::int32_t* cells, reg value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(cells), value); }
+			static inline reg Set1(std::int32_t value) { return _mm_set1_epi32(value); }
+			static inline reg Add(reg a, reg b) { return _mm_add_epi32(a, b); }
+
+			//No 32 bit multiply before SSE4.1: even and odd lanes through the
+			//64 bit multiply, the low halves are the same signed or unsigned
+			static inline reg Mul(reg a, reg b)
+			{
+				reg even = _mm_mul_epu32(a, b);
+				reg odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+
+				return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+					_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+			}
+
+			static inline reg Min(reg a, reg b)
+			{
+				reg less = _mm_cmplt_epi32(a, b);
+				return _mm_or_si128(_mm_and_si128(less, a), _mm_andnot_si128(less, b));
+			}
+
+			static inline reg Max(reg a, reg b)
+			{
+				reg greater = _mm_cmpgt_epi32(a, b);
+				return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+			}
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				reg less = _mm_cmplt_epi32(cell, threshold);
+				return _mm_or_si128(_mm_and_si128(less, low), _mm_andnot_si128(less, high));
+			}
+
+			static inline sum_reg SumZero() { return _mm_setzero_si128(); }
+
+			static inline sum_reg SumAdd(sum_reg sum, reg value)
+			{
+				reg sign = _mm_srai_epi32(value, 31);
+				sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(value, sign));
+				return _mm_add_epi64(sum, _mm_unpackhi_epi32(value, sign));
+			}
+
+			static inline sum_type SumReduce(sum_reg sum)
+			{
+				std::int64_t parts[2];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(parts), sum);
+				return parts[0] + parts[1];
+			}
+		};
+
+		template<>
+		struct Vector<std::uint8_t>
+		{
+			typedef __m128i reg;
+			static constexpr std::size_t lanes = 16;
+			static constexpr bool masked_tails = false;
+
+			typedef std::uint64_t sum_type;
+			typedef __m128i sum_reg;
+
+			static inline reg Load(const std::uint8_t* cells) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells)); }
+			static inline void Store(std::uint8_t* cells, reg value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(cells), value); }
+			static inline reg Set1(std::uint8_t value) { return _mm_set1_epi8(char(value)); }
+			static inline reg Add(reg a, reg b) { return _mm_add_epi8(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm_min_epu8(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm_max_epu8(a, b); }
+
+			//No byte multiply: even and odd bytes through 16 bit multiplies
+			static inline reg Mul(reg a, reg b)
+			{
+				reg even = _mm_mullo_epi16(a, b);
+				reg odd = _mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+
+				return _mm_or_si128(_mm_and_si128(even, _mm_set1_epi16(0xFF)), _mm_slli_epi16(odd, 8));
+			}
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				reg greaterEqual = _mm_cmpeq_epi8(_mm_max_epu8(cell, threshold), cell);
+				return _mm_or_si128(_mm_and_si128(greaterEqual, high), _mm_andnot_si128(greaterEqual, low));
+			}
+
+			static inline sum_reg SumZero() { return _mm_setzero_si128(); }
+			static inline sum_reg SumAdd(sum_reg sum, reg value) { return _mm_add_epi64(sum, _mm_sad_epu8(value, _mm_setzero_si128())); }
+
+			static inline sum_type SumReduce(sum_reg sum)
+			{
+				std::uint64_t parts[2];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(parts), sum);
+				return parts[0] + parts[1];
+			}
+		};
+
+#include "GridSimdKernels.inl"
+	}
+#endif
+
+#if defined(GRID_SIMD_AVX)
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+	namespace Avx2
+	{
+		template<typename T>
+		struct Vector;
+
+		template<>
+		struct Vector<float>
+		{
+			typedef __m256 reg;
+			static constexpr std::size_t lanes = 8;
+			static constexpr bool masked_tails = false;
+
+			static inline reg Load(const float* cells) { return _mm256_loadu_ps(cells); }
+			static inline void Store(float* cells, reg value) { _mm256_storeu_ps(cells, value); }
+			static inline reg Set1(float value) { return _mm256_set1_ps(value); }
+			static inline reg Add(reg a, reg b) { return _mm256_add_ps(a, b); }
+			static inline reg Mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm256_min_ps(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm256_max_ps(a, b); }
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				return _mm256_blendv_ps(low, high, _mm256_cmp_ps(cell, threshold, _CMP_GE_OQ));
+			}
+		};
+
+		template<>
+		struct Vector<double>
+		{
+			typedef __m256d reg;
+			static constexpr std::size_t lanes = 4;
+			static constexpr bool masked_tails = false;
+
+			static inline reg Load(const double* cells) { return _mm256_loadu_pd(cells); }
+			static inline void Store(double* cells, reg value) { _mm256_storeu_pd(cells, value); }
+			static inline reg Set1(double value) { return _mm256_set1_pd(value); }
+			static inline reg Add(reg a, reg b) { return _mm256_add_pd(a, b); }
+			static inline reg Mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm256_min_pd(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm256_max_pd(a, b); }
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				return _mm256_blendv_pd(low, high, _mm256_cmp_pd(cell, threshold, _CMP_GE_OQ));
+			}
+		};
+
+		template<>
+		struct Vector<std::int32_t>
+		{
+			typedef __m256i reg;
+			static constexpr std::size_t lanes = 8;
+			static constexpr bool masked_tails = false;
+
+			typedef std::int64_t sum_type;
+			typedef __m256i sum_reg;
+
+			static inline reg Load(const std::int32_t* cells) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells)); }
+			static inline void Store(std::int32_t* cells, reg value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(cells), value); }
+			static inline reg Set1(std::int32_t value) { return _mm256_set1_epi32(value); }
+			static inline reg Add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+			static inline reg Mul(reg a, reg b) { return _mm256_mullo_epi32(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				return _mm256_blendv_epi8(high, low, _mm256_cmpgt_epi32(threshold, cell));
+			}
+
+			static inline sum_reg SumZero() { return _mm256_setzero_si256(); }
+
+			static inline sum_reg SumAdd(sum_reg sum, reg value)
+			{
+				sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(value)));
+				return _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(value, 1)));
+			}
+
+			static inline sum_type SumReduce(sum_reg sum)
+			{
+				std::int64_t parts[4];
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(parts), sum);
+				return (parts[0] + parts[1]) + (parts[2] + parts[3]);
+			}
+		};
+
+		template<>
+		struct Vector<std::uint8_t>
+		{
+			typedef __m256i reg;
+			static constexpr std::size_t lanes = 32;
+			static constexpr bool masked_tails = false;
+
+			typedef std::uint64_t sum_type;
+			typedef __m256i sum_reg;
+
+			static inline reg Load(const std::uint8_t* cells) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells)); }
+			static inline void Store(std::uint8_t* cells, reg value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(cells), value); }
+			static inline reg Set1(std::uint8_t value) { return _mm256_set1_epi8(char(value)); }
+			static inline reg Add(reg a, reg b) { return _mm256_add_epi8(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm256_min_epu8(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm256_max_epu8(a, b); }
+
+			static inline reg Mul(reg a, reg b)
+			{
+				reg even = _mm256_mullo_epi16(a, b);
+				reg odd = _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+
+				return _mm256_or_si256(_mm256_and_si256(even, _mm256_set1_epi16(0xFF)), _mm256_slli_epi16(odd, 8));
+			}
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				return _mm256_blendv_epi8(low, high, _mm256_cmpeq_epi8(_mm256_max_epu8(cell, threshold), cell));
+			}
+
+			static inline sum_reg SumZero() { return _mm256_setzero_si256(); }
+			static inline sum_reg SumAdd(sum_reg sum, reg value) { return _mm256_add_epi64(sum, _mm256_sad_epu8(value, _mm256_setzero_si256())); }
+
+			static inline sum_type SumReduce(sum_reg sum)
+			{
+				std::uint64_t parts[4];
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(parts), sum);
+				return (parts[0] + parts[1]) + (parts[2] + parts[3]);
+			}
+		};
+
+#include "GridSimdKernels.inl"
+	}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f,avx512bw"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw")
+//GCC 12's AVX-512 intrinsics pass _mm512_undefined_* as the unused merge
+//source of their full mask builtins, which -Wall -Wextra then reports as maybe
+//uninitialized in every caller, min and max included
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+	namespace Avx512
+	{
+		template<typename T>
+		struct Vector;
+
+		template<>
+		struct Vector<float>
+		{
+			typedef __m512 reg;
+			static constexpr std::size_t lanes = 16;
+			static constexpr bool masked_tails = true;
+
+			static inline reg Load(const float* cells) { return _mm512_loadu_ps(cells); }
+			static inline void Store(float* cells, reg value) { _mm512_storeu_ps(cells, value); }
+			static inline reg Set1(float value) { return _mm512_set1_ps(value); }
+			static inline reg Add(reg a, reg b) { return _mm512_add_ps(a, b); }
+			static inline reg Mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm512_min_ps(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm512_max_ps(a, b); }
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(cell, threshold, _CMP_GE_OQ), low, high);
+			}
+
+			static inline reg LoadPartial(const float* cells, std::size_t count, float fill)
+			{
+				return _mm512_mask_loadu_ps(_mm512_set1_ps(fill), __mmask16((1u << count) - 1), cells);
+			}
+
+			static inline void StorePartial(float* cells, std::size_t count, reg value)
+			{
+				_mm512_mask_storeu_ps(cells, __mmask16((1u << count) - 1), value);
+			}
+		};
+
+		template<>
+		struct Vector<double>
+		{
+			typedef __m512d reg;
+			static constexpr std::size_t lanes = 8;
+			static constexpr bool masked_tails = true;
+
+			static inline reg Load(const double* cells) { return _mm512_loadu_pd(cells); }
+			static inline void Store(double* cells, reg value) { _mm512_storeu_pd(cells, value); }
+			static inline reg Set1(double value) { return _mm512_set1_pd(value); }
+			static inline reg Add(reg a, reg b) { return _mm512_add_pd(a, b); }
+			static inline reg Mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm512_min_pd(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm512_max_pd(a, b); }
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(cell, threshold, _CMP_GE_OQ), low, high);
+			}
+
+			static inline reg LoadPartial(const double* cells, std::size_t count, double fill)
+			{
+				return _mm512_mask_loadu_pd(_mm512_set1_pd(fill), __mmask8((1u << count) - 1), cells);
+			}
+
+			static inline void StorePartial(double* cells, std::size_t count, reg value)
+			{
+				_mm512_mask_storeu_pd(cells, __mmask8((1u << count) - 1), value);
+			}
+		};
+
+		template<>
+		struct Vector<std::int32_t>
+		{
+			typedef __m512i reg;
+			static constexpr std::size_t lanes = 16;
+			static constexpr bool masked_tails = true;
+
+			typedef std::int64_t sum_type;
+			typedef __m512i sum_reg;
+
+			static inline reg Load(const std::int32_t* cells) { return _mm512_loadu_si512(cells); }
+			static inline void Store(std::int32_t* cells, reg value) { _mm512_storeu_si512(cells, value); }
+			static inline reg Set1(std::int32_t value) { return _mm512_set1_epi32(value); }
+			static inline reg Add(reg a, reg b) { return _mm512_add_epi32(a, b); }
+			static inline reg Mul(reg a, reg b) { return _mm512_mullo_epi32(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm512_min_epi32(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm512_max_epi32(a, b); }
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				return _mm512_mask_blend_epi32(_mm512_cmpge_epi32_mask(cell, threshold), low, high);
+			}
+
+			static inline reg LoadPartial(const std::int32_t* cells, std::size_t count, std::int32_t fill)
+			{
+				return _mm512_mask_loadu_epi32(_mm512_set1_epi32(fill), __mmask16((1u << count) - 1), cells);
+			}
+
+			static inline void StorePartial(std::int32_t* cells, std::size_t count, reg value)
+			{
+				_mm512_mask_storeu_epi32(cells, __mmask16((1u << count) - 1), value);
+			}
+
+			static inline sum_reg SumZero() { return _mm512_setzero_si512(); }
+
+			static inline sum_reg SumAdd(sum_reg sum, reg value)
+			{
+				sum = _mm512_add_epi64(sum, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(value)));
+				return _mm512_add_epi64(sum, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(value, 1)));
+			}
+
+			static inline sum_type SumReduce(sum_reg sum)
+			{
+				std::int64_t parts[8];
+				_mm512_storeu_si512(parts, sum);
+				return ((parts[0] + parts[1]) + (parts[2] + parts[3])) + ((parts[4] + parts[5]) + (parts[6] + parts[7]));
+			}
+		};
+
+		template<>
+		struct Vector<std::uint8_t>
+		{
+			typedef __m512i reg;
+			static constexpr std::size_t lanes = 64;
+			static constexpr bool masked_tails = true;
+
+			typedef std::uint64_t sum_type;
+			typedef __m512i sum_reg;
+
+			static inline reg Load(const std::uint8_t* cells) { return _mm512_loadu_si512(cells); }
+			static inline void Store(std::uint8_t* cells, reg value) { _mm512_storeu_si512(cells, value); }
+			static inline reg Set1(std::uint8_t value) { return _mm512_set1_epi8(char(value)); }
+			static inline reg Add(reg a, reg b) { return _mm512_add_epi8(a, b); }
+			static inline reg Min(reg a, reg b) { return _mm512_min_epu8(a, b); }
+			static inline reg Max(reg a, reg b) { return _mm512_max_epu8(a, b); }
+
+			static inline reg Mul(reg a, reg b)
+			{
+				reg even = _mm512_mullo_epi16(a, b);
+				reg odd = _mm512_mullo_epi16(_mm512_srli_epi16(a, 8), _mm512_srli_epi16(b, 8));
+
+				return _mm512_or_si512(_mm512_and_si512(even, _mm512_set1_epi16(0xFF)), _mm512_slli_epi16(odd, 8));
+			}
+
+			static inline reg SelectGe(reg cell, reg threshold, reg high, reg low)
+			{
+				return _mm512_mask_blend_epi8(_mm512_cmpge_epu8_mask(cell, threshold), low, high);
+			}
+
+			static inline reg LoadPartial(const std::uint8_t* cells, std::size_t count, std::uint8_t fill)
+			{
+				return _mm512_mask_loadu_epi8(_mm512_set1_epi8(char(fill)), __mmask64((std::uint64_t(1) << count) - 1), cells);
+			}
+
+			static inline void StorePartial(std::uint8_t* cells, std::size_t count, reg value)
+			{
+				_mm512_mask_storeu_epi8(cells, __mmask64((std::uint64_t(1) << count) - 1), value);
+			}
+
+			static inline sum_reg SumZero() { return _mm512_setzero_si512(); }
+			static inline sum_reg SumAdd(sum_reg sum, reg value) { return _mm512_add_epi64(sum, _mm512_sad_epu8(value, _mm512_setzero_si512())); }
+
+			static inline sum_type SumReduce(sum_reg sum)
+			{
+				std::uint64_t parts[8];
+				_mm512_storeu_si512(parts, sum);
+				return ((parts[0] + parts[1]) + (parts[2] + parts[3])) + ((parts[4] + parts[5]) + (parts[6] + parts[7]));
+			}
+		};
+
+#include "GridSimdKernels.inl"
+	}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+#endif
+#endif
+
+//Calls Namespace::call for the active instruction set
+#if defined(GRID_SIMD_AVX)
+#define GRID_SIMD_DISPATCH(call) \
+	switch (GridSimdDetail::GetActiveIsaState().load(std::memory_order_relaxed)) \
+	{ \
+	case GridSimd::Isa::Avx512: return GridSimdDetail::Avx512::call; \
+	case GridSimd::Isa::Avx2: return GridSimdDetail::Avx2::call; \
+	case GridSimd::Isa::Sse2: return GridSimdDetail::Sse2::call; \
+	default: return GridSimdDetail::Scalar::call; \
+	}
+#elif defined(GRID_SIMD_SSE2)
+#define GRID_SIMD_DISPATCH(call) \
+	if (GridSimdDetail::GetActiveIsaState().load(std::memory_order_relaxed) != GridSimd::Isa::Scalar) \
+		return GridSimdDetail::Sse2::call; \
+	return GridSimdDetail::Scalar::call;
+#else
+#define GRID_SIMD_DISPATCH(call) return GridSimdDetail::Scalar::call;
+#endif
+
+	template<typename T>
+	inline void SumRun(const T* cells, std::size_t count, T* lanes)
+	{
+		GRID_SIMD_DISPATCH(SumLanes(cells, count, lanes))
+	}
+
+	template<typename T>
+	inline GridSimd::SumType<T> SumWideRun(const T* cells, std::size_t count)
+	{
+		GRID_SIMD_DISPATCH(SumWide(cells, count))
+	}
+
+	template<typename T>
+	inline void MinMaxRun(const T* cells, std::size_t count, T* minLanes, T* maxLanes)
+	{
+		GRID_SIMD_DISPATCH(MinMaxLanes(cells, count, minLanes, maxLanes))
+	}
+
+	template<typename T>
+	inline void ScaleRun(T* cells, std::size_t count, T factor)
+	{
+		GRID_SIMD_DISPATCH(Scale(cells, count, factor))
+	}
+
+	template<typename T>
+	inline void ClampRun(T* cells, std::size_t count, T low, T high)
+	{
+		GRID_SIMD_DISPATCH(Clamp(cells, count, low, high))
+	}
+
+	template<typename T>
+	inline void ThresholdRun(T* cells, std::size_t count, T threshold, T low, T high)
+	{
+		GRID_SIMD_DISPATCH(Threshold(cells, count, threshold, low, high))
+	}
+
+	template<typename T>
+	inline void AddRun(const T* left, const T* right, T* target, std::size_t count)
+	{
+		GRID_SIMD_DISPATCH(Add(left, right, target, count))
+	}
+
+	template<typename T>
+	inline void MultiplyRun(const T* left, const T* right, T* target, std::size_t count)
+	{
+		GRID_SIMD_DISPATCH(Multiply(left, right, target, count))
+	}
+
+#undef GRID_SIMD_DISPATCH
+
+	///Folds the lanes pairwise, the same tree on every instruction set
+	template<typename T, typename Combine_Function>
+	inline T FoldLanes(T* lanes, std::size_t count, Combine_Function combine)
+	{
+		for (std::size_t width = count / 2; width > 0; width /= 2)
+		{
+			for (std::size_t i = 0; i < width; i++)
+				lanes[i] = combine(lanes[i], lanes[i + width]);
+		}
+
+		return lanes[0];
+	}
+
+	///Running state of a sum over several runs
+	template<typename T, bool = std::is_floating_point<T>::value>
+	struct SumState
+	{
+		T lanes[sum_lanes] = {};
+
+		inline void Add(const T* cells, std::size_t count)
+		{
+			SumRun(cells, count, this->lanes);
+		}
+
+		inline T Finish()
+		{
+			return FoldLanes(this->lanes, sum_lanes, [](T a, T b) { return a + b; });
+		}
+	};
+
+	template<typename T>
+	struct SumState<T, false>
+	{
+		GridSimd::SumType<T> total = 0;
+
+		inline void Add(const T* cells, std::size_t count)
+		{
+			this->total += SumWideRun(cells, count);
+		}
+
+		inline GridSimd::SumType<T> Finish()
+		{
+			return this->total;
+		}
+	};
+
+	template<typename T>
+	struct MinMaxState
+	{
+		T minLanes[max_lanes];
+		T maxLanes[max_lanes];
+
+		MinMaxState()
+		{
+			std::fill(this->minLanes, this->minLanes + max_lanes, MinIdentity<T>());
+			std::fill(this->maxLanes, this->maxLanes + max_lanes, MaxIdentity<T>());
+		}
+
+		inline void Add(const T* cells, std::size_t count)
+		{
+			MinMaxRun(cells, count, this->minLanes, this->maxLanes);
+		}
+
+		inline GridSimd::MinMaxResult<T> Finish()
+		{
+			return { FoldLanes(this->minLanes, max_lanes, [](T a, T b) { return b < a ? b : a; }),
+				FoldLanes(this->maxLanes, max_lanes, [](T a, T b) { return b > a ? b : a; }) };
+		}
+	};
+
+	///Four interleaved tables, so runs of equal bytes do not wait on their own
+	///increments. Scattered increments gain nothing from the vector units.
+	inline void HistogramRun(const std::uint8_t* cells, std::size_t count, std::array<std::uint64_t, 256>& bins)
+	{
+		//Flushed before any 32 bit counter can overflow
+		const std::size_t chunk = std::size_t(1) << 30;
+
+		while (count > 0)
+		{
+			std::uint32_t tables[4][256] = {};
+			std::size_t length = std::min(count, chunk);
+			std::size_t i = 0;
+
+			for (; i + 4 <= length; i += 4)
+			{
+				tables[0][cells[i]]++;
+				tables[1][cells[i + 1]]++;
+				tables[2][cells[i + 2]]++;
+				tables[3][cells[i + 3]]++;
+			}
+
+			for (; i < length; i++)
+				tables[0][cells[i]]++;
+
+			for (std::size_t bin = 0; bin < 256; bin++)
+				bins[bin] += std::uint64_t(tables[0][bin]) + tables[1][bin] + tables[2][bin] + tables[3][bin];
+
+			cells += length;
+			count -= length;
+		}
+	}
+
+	///Calls function(cells, count) for every contiguous run of grid's cells: the
+	///whole storage for hole free layouts, otherwise each row
+	template<typename Grid_Type, typename Function>
+	void ForEachRun(Grid_Type& grid, Function function)
+	{
+		if constexpr (Grid_Type::layout_type::has_padding)
+		{
+			for (typename Grid_Type::dimension_type row = 0; row < grid.GetRowCount(); row++)
+			{
+				auto cells = grid.GetRow(row);
+				function(cells.begin(), cells.size());
+			}
+		}
+		else if (!grid.isEmpty())
+		{
+			function(grid.data(), std::size_t(grid.size()));
+		}
+	}
+
+	///As ForEachRun over the matching runs of three grids of the same type and size
+	template<typename Grid_Type, typename Function>
+	void ForEachRun(const Grid_Type& left, const Grid_Type& right, Grid_Type& target, Function function)
+	{
+		if (left.GetColumnCount() != right.GetColumnCount() || left.GetRowCount() != right.GetRowCount() ||
+			left.GetColumnCount() != target.GetColumnCount() || left.GetRowCount() != target.GetRowCount())
+			throw std::invalid_argument("GridSimd grid dimensions differ");
+
+		if constexpr (Grid_Type::layout_type::has_padding)
+		{
+			for (typename Grid_Type::dimension_type row = 0; row < target.GetRowCount(); row++)
+				function(left.GetRow(row).begin(), right.GetRow(row).begin(), target.GetRow(row).begin(), std::size_t(target.GetColumnCount()));
+		}
+		else if (!target.isEmpty())
+		{
+			function(left.data(), right.data(), target.data(), std::size_t(target.size()));
+		}
+	}
+
+	template<typename Grid_Type>
+	inline void CheckCellType()
+	{
+		static_assert(GridSimd::IsSupported<typename Grid_Type::value_type>::value,
+			"GridSimd supports float, double, std::int32_t and std::uint8_t cells");
+	}
+}
+
+namespace GridSimd
+{
+	///The widest instruction set the CPU and OS support
+	inline Isa GetSupportedIsa()
+	{
+		return GridSimdDetail::GetSupportedIsa();
+	}
+
+	inline Isa GetActiveIsa()
+	{
+		return GridSimdDetail::GetActiveIsaState().load(std::memory_order_relaxed);
+	}
+
+	///Selects the kernels every later call uses, for all threads. Anything above
+	///GetSupportedIsa is lowered to it; returns the instruction set now active.
+	inline Isa SetActiveIsa(Isa isa)
+	{
+		isa = std::min(isa, GetSupportedIsa());
+		GridSimdDetail::GetActiveIsaState().store(isa, std::memory_order_relaxed);
+		return isa;
+	}
+
+	template<typename T>
+	SumType<T> Sum(const T* cells, std::size_t count)
+	{
+		static_assert(IsSupported<T>::value, "GridSimd supports float, double, std::int32_t and std::uint8_t cells");
+
+		GridSimdDetail::SumState<T> state;
+		state.Add(cells, count);
+		return state.Finish();
+	}
+
+	template<typename Grid_Type>
+	SumType<typename Grid_Type::value_type> Sum(const Grid_Type& grid)
+	{
+		GridSimdDetail::CheckCellType<Grid_Type>();
+
+		GridSimdDetail::SumState<typename Grid_Type::value_type> state;
+		GridSimdDetail::ForEachRun(grid, [&](auto cells, std::size_t count) { state.Add(cells, count); });
+		return state.Finish();
+	}
+
+	///An empty span gives min = +infinity (or the largest value) and max = -infinity
+	template<typename T>
+	MinMaxResult<T> MinMax(const T* cells, std::size_t count)
+	{
+		static_assert(IsSupported<T>::value, "GridSimd supports float, double, std::int32_t and std::uint8_t cells");
+
+		GridSimdDetail::MinMaxState<T> state;
+		state.Add(cells, count);
+		return state.Finish();
+	}
+
+	template<typename Grid_Type>
+	MinMaxResult<typename Grid_Type::value_type> MinMax(const Grid_Type& grid)
+	{
+		GridSimdDetail::CheckCellType<Grid_Type>();
+
+		GridSimdDetail::MinMaxState<typename Grid_Type::value_type> state;
+		GridSimdDetail::ForEachRun(grid, [&](auto cells, std::size_t count) { state.Add(cells, count); });
+		return state.Finish();
+	}
+
+	///Number of cells of each byte value
+	inline std::array<std::uint64_t, 256> Histogram(const std::uint8_t* cells, std::size_t count)
+	{
+		std::array<std::uint64_t, 256> bins = {};
+		GridSimdDetail::HistogramRun(cells, count, bins);
+		return bins;
+	}
+
+	template<typename Grid_Type>
+	std::array<std::uint64_t, 256> Histogram(const Grid_Type& grid)
+	{
+		static_assert(std::is_same<typename Grid_Type::value_type, std::uint8_t>::value,
+			"GridSimd-Histogram needs std::uint8_t cells");
+
+		std::array<std::uint64_t, 256> bins = {};
+		GridSimdDetail::ForEachRun(grid, [&](const std::uint8_t* cells, std::size_t count)
+		{
+			GridSimdDetail::HistogramRun(cells, count, bins);
+		});
+
+		return bins;
+	}
+
+	///cell = cell * factor
+	template<typename T>
+	void Scale(T* cells, std::size_t count, T factor)
+	{
+		static_assert(IsSupported<T>::value, "GridSimd supports float, double, std::int32_t and std::uint8_t cells");
+		GridSimdDetail::ScaleRun(cells, count, factor);
+	}
+
+	template<typename Grid_Type>
+	void Scale(Grid_Type& grid, typename Grid_Type::value_type factor)
+	{
+		GridSimdDetail::CheckCellType<Grid_Type>();
+		GridSimdDetail::ForEachRun(grid, [&](auto cells, std::size_t count) { GridSimdDetail::ScaleRun(cells, count, factor); });
+	}
+
+	///cell = Max(Min(cell, high), low)
+	template<typename T>
+	void Clamp(T* cells, std::size_t count, T low, T high)
+	{
+		static_assert(IsSupported<T>::value, "GridSimd supports float, double, std::int32_t and std::uint8_t cells");
+		GridSimdDetail::ClampRun(cells, count, low, high);
+	}
+
+	template<typename Grid_Type>
+	void Clamp(Grid_Type& grid, typename Grid_Type::value_type low, typename Grid_Type::value_type high)
+	{
+		GridSimdDetail::CheckCellType<Grid_Type>();
+		GridSimdDetail::ForEachRun(grid, [&](auto cells, std::size_t count) { GridSimdDetail::ClampRun(cells, count, low, high); });
+	}
+
+	///cell = cell >= threshold ? high : low
+	template<typename T>
+	void Threshold(T* cells, std::size_t count, T threshold, T low, T high)
+	{
+		static_assert(IsSupported<T>::value, "GridSimd supports float, double, std::int32_t and std::uint8_t cells");
+		GridSimdDetail::ThresholdRun(cells, count, threshold, low, high);
+	}
+
+	template<typename Grid_Type>
+	void Threshold(Grid_Type& grid, typename Grid_Type::value_type threshold,
+		typename Grid_Type::value_type low, typename Grid_Type::value_type high)
+	{
+		GridSimdDetail::CheckCellType<Grid_Type>();
+		GridSimdDetail::ForEachRun(grid, [&](auto cells, std::size_t count)
+		{
+			GridSimdDetail::ThresholdRun(cells, count, threshold, low, high);
+		});
+	}
+
+	///target = left + right, cell by cell. target may be left or right.
+	template<typename T>
+	void Add(const T* left, const T* right, T* target, std::size_t count)
+	{
+		static_assert(IsSupported<T>::value, "GridSimd supports float, double, std::int32_t and std::uint8_t cells");
+		GridSimdDetail::AddRun(left, right, target, count);
+	}
+
+	///Throws std::invalid_argument when the grids differ in size
+	template<typename Grid_Type>
+	void Add(const Grid_Type& left, const Grid_Type& right, Grid_Type& target)
+	{
+		GridSimdDetail::CheckCellType<Grid_Type>();
+		GridSimdDetail::ForEachRun(left, right, target, [](auto a, auto b, auto result, std::size_t count)
+		{
+			GridSimdDetail::AddRun(a, b, result, count);
+		});
+	}
+
+	///target = left * right, cell by cell. target may be left or right.
+	template<typename T>
+	void Multiply(const T* left, const T* right, T* target, std::size_t count)
+	{
+		static_assert(IsSupported<T>::value, "GridSimd supports float, double, std::int32_t and std::uint8_t cells");
+		GridSimdDetail::MultiplyRun(left, right, target, count);
+	}
+
+	template<typename Grid_Type>
+	void Multiply(const Grid_Type& left, const Grid_Type& right, Grid_Type& target)
+	{
+		GridSimdDetail::CheckCellType<Grid_Type>();
+		GridSimdDetail::ForEachRun(left, right, target, [](auto a, auto b, auto result, std::size_t count)
+		{
+			GridSimdDetail::MultiplyRun(a, b, result, count);
+		});
+	}
+}
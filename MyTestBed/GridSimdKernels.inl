@@ -0,0 +1,270 @@
+//GridSimdKernels.inl : the kernels behind GridSimd.h, written once against
+//Vector<T> and included by GridSimd.h inside each of its instruction set
+//namespaces (Scalar, Sse2, Avx2, Avx512), so every copy is compiled for that
+//instruction set. No include guard on purpose.
+//
+//Vector<T> wraps one register of T cells and provides
+//	reg, lanes, masked_tails
+//	Load, Store, Set1, Add, Mul, Min, Max, SelectGe
+//	LoadPartial, StorePartial when masked_tails
+//	sum_type, sum_reg, SumZero, SumAdd, SumReduce for the integer cell types
+
+///The first count cells of a register, the other lanes set to fill. Instruction
+///sets without masked loads go through a stack buffer.
+template<typename T>
+inline typename Vector<T>::reg LoadTail(const T* cells, std::size_t count, T fill)
+{
+	typedef Vector<T> V;
+
+	if constexpr (V::masked_tails)
+	{
+		return V::LoadPartial(cells, count, fill);
+	}
+	else
+	{
+		T buffer[V::lanes];
+		std::fill(buffer, buffer + V::lanes, fill);
+		std::memcpy(buffer, cells, count * sizeof(T));
+		return V::Load(buffer);
+	}
+}
+
+template<typename T>
+inline void StoreTail(T* cells, std::size_t count, typename Vector<T>::reg value)
+{
+	typedef Vector<T> V;
+
+	if constexpr (V::masked_tails)
+	{
+		V::StorePartial(cells, count, value);
+	}
+	else
+	{
+		T buffer[V::lanes];
+		V::Store(buffer, value);
+		std::memcpy(cells, buffer, count * sizeof(T));
+	}
+}
+
+///Adds count cells to the sum_lanes running lanes, cell i to lane i % sum_lanes.
+///Every instruction set adds in exactly this order, the tail included: padding
+///a lane with +0 leaves it unchanged since a lane starting at +0 is never -0.
+template<typename T>
+void SumLanes(const T* cells, std::size_t count, T* lanes)
+{
+	typedef Vector<T> V;
+	constexpr std::size_t registers = sum_lanes / V::lanes;
+
+	typename V::reg accumulators[registers];
+
+	for (std::size_t r = 0; r < registers; r++)
+		accumulators[r] = V::Load(lanes + r * V::lanes);
+
+	std::size_t i = 0;
+
+	for (; i + sum_lanes <= count; i += sum_lanes)
+	{
+		for (std::size_t r = 0; r < registers; r++)
+			accumulators[r] = V::Add(accumulators[r], V::Load(cells + i + r * V::lanes));
+	}
+
+	for (std::size_t r = 0; i < count; r++, i += V::lanes)
+	{
+		std::size_t remaining = count - i;
+
+		accumulators[r] = V::Add(accumulators[r], remaining >= V::lanes ?
+			V::Load(cells + i) : LoadTail(cells + i, remaining, T(0)));
+	}
+
+	for (std::size_t r = 0; r < registers; r++)
+		V::Store(lanes + r * V::lanes, accumulators[r]);
+}
+
+///Integer sums are exact, so any order gives the same total
+template<typename T>
+typename Vector<T>::sum_type SumWide(const T* cells, std::size_t count)
+{
+	typedef Vector<T> V;
+
+	typename V::sum_reg accumulator = V::SumZero();
+	std::size_t i = 0;
+
+	for (; i + V::lanes <= count; i += V::lanes)
+		accumulator = V::SumAdd(accumulator, V::Load(cells + i));
+
+	if (i < count)
+		accumulator = V::SumAdd(accumulator, LoadTail(cells + i, count - i, T(0)));
+
+	return V::SumReduce(accumulator);
+}
+
+///Folds count cells into the running minimum and maximum lanes, cell i into
+///lane i % block. NaN cells lose every comparison and are skipped.
+template<typename T>
+void MinMaxLanes(const T* cells, std::size_t count, T* minLanes, T* maxLanes)
+{
+	typedef Vector<T> V;
+	constexpr std::size_t block = V::lanes > sum_lanes ? V::lanes : sum_lanes;
+	constexpr std::size_t registers = block / V::lanes;
+
+	typename V::reg minimums[registers];
+	typename V::reg maximums[registers];
+
+	for (std::size_t r = 0; r < registers; r++)
+	{
+		minimums[r] = V::Load(minLanes + r * V::lanes);
+		maximums[r] = V::Load(maxLanes + r * V::lanes);
+	}
+
+	std::size_t i = 0;
+
+	for (; i + block <= count; i += block)
+	{
+		for (std::size_t r = 0; r < registers; r++)
+		{
+			typename V::reg cell = V::Load(cells + i + r * V::lanes);
+			minimums[r] = V::Min(cell, minimums[r]);
+			maximums[r] = V::Max(cell, maximums[r]);
+		}
+	}
+
+	for (std::size_t r = 0; i < count; r++, i += V::lanes)
+	{
+		std::size_t remaining = count - i;
+
+		if (remaining >= V::lanes)
+		{
+			typename V::reg cell = V::Load(cells + i);
+			minimums[r] = V::Min(cell, minimums[r]);
+			maximums[r] = V::Max(cell, maximums[r]);
+		}
+		else
+		{
+			minimums[r] = V::Min(LoadTail(cells + i, remaining, MinIdentity<T>()), minimums[r]);
+			maximums[r] = V::Max(LoadTail(cells + i, remaining, MaxIdentity<T>()), maximums[r]);
+		}
+	}
+
+	for (std::size_t r = 0; r < registers; r++)
+	{
+		V::Store(minLanes + r * V::lanes, minimums[r]);
+		V::Store(maxLanes + r * V::lanes, maximums[r]);
+	}
+}
+
+///target[i] = operation(source[i]), source may be target
+template<typename T, typename Operation>
+void TransformCells(const T* source, T* target, std::size_t count, Operation operation)
+{
+	typedef Vector<T> V;
+	std::size_t i = 0;
+
+	for (; i + V::lanes <= count; i += V::lanes)
+		V::Store(target + i, operation(V::Load(source + i)));
+
+	if (i < count)
+		StoreTail(target + i, count - i, operation(LoadTail(source + i, count - i, T(0))));
+}
+
+///target[i] = operation(left[i], right[i]), either source may be target
+template<typename T, typename Operation>
+void TransformPairs(const T* left, const T* right, T* target, std::size_t count, Operation operation)
+{
+	typedef Vector<T> V;
+	std::size_t i = 0;
+
+	for (; i + V::lanes <= count; i += V::lanes)
+		V::Store(target + i, operation(V::Load(left + i), V::Load(right + i)));
+
+	if (i < count)
+	{
+		StoreTail(target + i, count - i, operation(LoadTail(left + i, count - i, T(0)),
+			LoadTail(right + i, count - i, T(0))));
+	}
+}
+
+//Operations as named functors rather than lambdas, whose call operators do
+//not pick up the instruction set of the surrounding namespace with GCC
+template<typename T>
+struct ScaleCell
+{
+	typename Vector<T>::reg factors;
+
+	inline typename Vector<T>::reg operator()(typename Vector<T>::reg cell) const
+	{
+		return Vector<T>::Mul(cell, this->factors);
+	}
+};
+
+template<typename T>
+struct ClampCell
+{
+	typename Vector<T>::reg lows;
+	typename Vector<T>::reg highs;
+
+	inline typename Vector<T>::reg operator()(typename Vector<T>::reg cell) const
+	{
+		return Vector<T>::Max(Vector<T>::Min(cell, this->highs), this->lows);
+	}
+};
+
+template<typename T>
+struct ThresholdCell
+{
+	typename Vector<T>::reg thresholds;
+	typename Vector<T>::reg lows;
+	typename Vector<T>::reg highs;
+
+	inline typename Vector<T>::reg operator()(typename Vector<T>::reg cell) const
+	{
+		return Vector<T>::SelectGe(cell, this->thresholds, this->highs, this->lows);
+	}
+};
+
+template<typename T>
+struct AddCells
+{
+	inline typename Vector<T>::reg operator()(typename Vector<T>::reg a, typename Vector<T>::reg b) const
+	{
+		return Vector<T>::Add(a, b);
+	}
+};
+
+template<typename T>
+struct MultiplyCells
+{
+	inline typename Vector<T>::reg operator()(typename Vector<T>::reg a, typename Vector<T>::reg b) const
+	{
+		return Vector<T>::Mul(a, b);
+	}
+};
+
+template<typename T>
+void Scale(T* cells, std::size_t count, T factor)
+{
+	TransformCells(cells, cells, count, ScaleCell<T>{ Vector<T>::Set1(factor) });
+}
+
+template<typename T>
+void Clamp(T* cells, std::size_t count, T low, T high)
+{
+	TransformCells(cells, cells, count, ClampCell<T>{ Vector<T>::Set1(low), Vector<T>::Set1(high) });
+}
+
+template<typename T>
+void Threshold(T* cells, std::size_t count, T threshold, T low, T high)
+{
+	TransformCells(cells, cells, count, ThresholdCell<T>{ Vector<T>::Set1(threshold), Vector<T>::Set1(low), Vector<T>::Set1(high) });
+}
+
+template<typename T>
+void Add(const T* left, const T* right, T* target, std::size_t count)
+{
+	TransformPairs(left, right, target, count, AddCells<T>());
+}
+
+template<typename T>
+void Multiply(const T* left, const T* right, T* target, std::size_t count)
+{
+	TransformPairs(left, right, target, count, MultiplyCells<T>());
+}
@@ -0,0 +1,296 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "Grid.h"
+
+///What a GridStencil kernel sees past the edges of the grid
+enum class GridBorder
+{
+	///The nearest edge cell
+	Clamp,
+	///The cell on the opposite side, a torus
+	Wrap,
+	///A fixed value
+	Constant
+};
+
+///The neighbourhood of one cell as handed to a GridStencil kernel. Offsets up to
+///the stencil radius in either direction are always valid, border included,
+///and reading one is a single indexed load.
+template<typename Data_Type>
+class GridStencilWindow
+{
+public:
+	GridStencilWindow(const Data_Type* _center, std::ptrdiff_t _rowPitch, std::uint32_t _column, std::uint32_t _row)
+		:center(_center), rowPitch(_rowPitch), column(_column), row(_row)
+	{
+
+	}
+
+	inline const Data_Type& operator()(std::ptrdiff_t columnOffset, std::ptrdiff_t rowOffset) const
+	{
+		return this->center[rowOffset * this->rowPitch + columnOffset];
+	}
+
+	inline const Data_Type& Center() const
+	{
+		return *this->center;
+	}
+
+	inline std::uint32_t GetColumn() const
+	{
+		return this->column;
+	}
+
+	inline std::uint32_t GetRow() const
+	{
+		return this->row;
+	}
+
+private:
+	const Data_Type* center;
+	std::ptrdiff_t rowPitch;
+	std::uint32_t column;
+	std::uint32_t row;
+};
+
+///Applies a kernel to every cell of a grid, reading from the front buffer and
+///writing into the back buffer, which are then swapped by move. Both buffers
+///carry a Radius wide halo around the cells that is refreshed from the border
+///mode before every step, so kernels never branch on the edges.
+template<typename Data_Type, std::size_t Radius = 1, typename Allocator_Type = std::allocator<Data_Type>>
+class GridStencil
+{
+public:
+	typedef Data_Type value_type;
+	typedef std::uint32_t dimension_type;
+	typedef GridStencilWindow<Data_Type> window_type;
+
+	///Cells plus halo, row major
+	typedef Grid<Data_Type, RowMajorLayout, Allocator_Type, std::uint32_t> buffer_type;
+
+	static constexpr std::size_t radius = Radius;
+	static constexpr std::size_t diameter = 2 * Radius + 1;
+
+	static_assert(Radius > 0, "A stencil needs a radius of at least one cell");
+
+	GridStencil(dimension_type _columnCount, dimension_type _rowCount, GridBorder _border,
+		const value_type& initVal = value_type(), const value_type& _borderValue = value_type(),
+		const Allocator_Type& allocator = Allocator_Type())
+		:columnCount(_columnCount), rowCount(_rowCount), border(_border), borderValue(_borderValue),
+		front(PaddedCount(_columnCount), PaddedCount(_rowCount), initVal, allocator),
+		back(PaddedCount(_columnCount), PaddedCount(_rowCount), initVal, allocator)
+	{
+		if (_columnCount == 0 || _rowCount == 0)
+			throw std::invalid_argument("Dimension cannot be 0");
+	}
+
+	///Copies the cells of any grid, whatever its layout
+	template<typename Source_Grid>
+	GridStencil(const Source_Grid& source, GridBorder _border, const value_type& _borderValue = value_type(),
+		const Allocator_Type& allocator = Allocator_Type())
+		:GridStencil(source.GetColumnCount(), source.GetRowCount(), _border, value_type(), _borderValue, allocator)
+	{
+		Assign(source);
+	}
+
+	inline dimension_type GetColumnCount() const
+	{
+		return this->columnCount;
+	}
+
+	inline dimension_type GetRowCount() const
+	{
+		return this->rowCount;
+	}
+
+	inline GridBorder GetBorder() const
+	{
+		return this->border;
+	}
+
+	inline void SetBorder(GridBorder _border, const value_type& _borderValue = value_type())
+	{
+		this->border = _border;
+		this->borderValue = _borderValue;
+	}
+
+	///The cells of the current generation. No bounds checks beyond the halo.
+	inline value_type& GetCell(dimension_type column, dimension_type row)
+	{
+		return this->front.GetCell(column + Radius, row + Radius);
+	}
+
+	inline const value_type& GetCell(dimension_type column, dimension_type row) const
+	{
+		return this->front.GetCell(column + Radius, row + Radius);
+	}
+
+	///Both buffers including their halo, the cells start at (Radius, Radius)
+	inline const buffer_type& GetFrontBuffer() const
+	{
+		return this->front;
+	}
+
+	template<typename Source_Grid>
+	void Assign(const Source_Grid& source)
+	{
+		if (dimension_type(source.GetColumnCount()) != this->columnCount ||
+			dimension_type(source.GetRowCount()) != this->rowCount)
+			throw std::invalid_argument("Stencil source dimensions differ");
+
+		for (dimension_type row = 0; row < this->rowCount; row++)
+		{
+			for (dimension_type column = 0; column < this->columnCount; column++)
+				GetCell(column, row) = source.GetCell(typename Source_Grid::dimension_type(column),
+					typename Source_Grid::dimension_type(row));
+		}
+	}
+
+	template<typename Target_Grid>
+	void CopyTo(Target_Grid& target) const
+	{
+		if (dimension_type(target.GetColumnCount()) != this->columnCount ||
+			dimension_type(target.GetRowCount()) != this->rowCount)
+			throw std::invalid_argument("Stencil target dimensions differ");
+
+		for (dimension_type row = 0; row < this->rowCount; row++)
+		{
+			for (dimension_type column = 0; column < this->columnCount; column++)
+				target.GetCell(typename Target_Grid::dimension_type(column),
+					typename Target_Grid::dimension_type(row)) = GetCell(column, row);
+		}
+	}
+
+	///One generation: every cell of the back buffer becomes kernel(window) of the
+	///front buffer, bands of rows running under policy, then the buffers swap.
+	///kernel must only read the window, it may run on several threads at once.
+	template<typename Policy_Type, typename Kernel_Type>
+	void Step(const Policy_Type& policy, Kernel_Type kernel)
+	{
+		RefreshHalo();
+
+		std::size_t pitch = this->front.GetColumnCount();
+		std::size_t rowsPerBand = std::max<std::size_t>(1, GridExecution::band_bytes / (pitch * sizeof(value_type)));
+		std::size_t bandCount = (std::size_t(this->rowCount) + rowsPerBand - 1) / rowsPerBand;
+
+		const value_type* source = &static_cast<const buffer_type&>(this->front).GetCell(std::size_t(0));
+		value_type* target = &this->back.GetCell(std::size_t(0));
+
+		GridExecution::ForEachBand(policy, bandCount, [&](std::size_t band)
+		{
+			std::size_t lastRow = std::min<std::size_t>((band + 1) * rowsPerBand, this->rowCount);
+
+			for (std::size_t row = band * rowsPerBand; row < lastRow; row++)
+			{
+				std::size_t first = (row + Radius) * pitch + Radius;
+				const value_type* input = source + first;
+				value_type* output = target + first;
+
+				for (dimension_type column = 0; column < this->columnCount; column++)
+					output[column] = kernel(window_type(input + column, std::ptrdiff_t(pitch), column, dimension_type(row)));
+			}
+		});
+
+		std::swap(this->front, this->back);
+	}
+
+	///Step with a dense diameter x diameter kernel, weights[rowOffset + Radius][columnOffset + Radius]
+	template<typename Policy_Type, typename Weight_Type>
+	void Convolve(const Policy_Type& policy, const Weight_Type (&weights)[diameter][diameter])
+	{
+		Step(policy, [&weights](const window_type& window)
+		{
+			Weight_Type sum = Weight_Type();
+
+			for (std::size_t rowOffset = 0; rowOffset < diameter; rowOffset++)
+			{
+				for (std::size_t columnOffset = 0; columnOffset < diameter; columnOffset++)
+					sum += weights[rowOffset][columnOffset] * Weight_Type(window(std::ptrdiff_t(columnOffset) - std::ptrdiff_t(Radius),
+						std::ptrdiff_t(rowOffset) - std::ptrdiff_t(Radius)));
+			}
+
+			return value_type(sum);
+		});
+	}
+
+	///Rewrites the halo of the front buffer from its edge cells and the border
+	///mode. Step does this itself; only needed when reading the front buffer.
+	void RefreshHalo()
+	{
+		std::size_t paddedColumns = this->front.GetColumnCount();
+		value_type* cells = &this->front.GetCell(std::size_t(0));
+
+		for (std::size_t row = Radius; row < Radius + this->rowCount; row++)
+		{
+			value_type* line = cells + row * paddedColumns;
+
+			for (std::size_t offset = 1; offset <= Radius; offset++)
+			{
+				line[Radius - offset] = HaloValue(line + Radius, -std::ptrdiff_t(offset), this->columnCount);
+				line[Radius + this->columnCount - 1 + offset] = HaloValue(line + Radius,
+					std::ptrdiff_t(this->columnCount - 1 + offset), this->columnCount);
+			}
+		}
+
+		//Whole halo rows, corners included, come from the finished cell rows
+		for (std::size_t offset = 1; offset <= Radius; offset++)
+		{
+			FillHaloRow(cells, Radius - offset, -std::ptrdiff_t(offset), paddedColumns);
+			FillHaloRow(cells, Radius + this->rowCount - 1 + offset, std::ptrdiff_t(this->rowCount - 1 + offset), paddedColumns);
+		}
+	}
+
+private:
+	dimension_type columnCount;
+	dimension_type rowCount;
+	GridBorder border;
+	value_type borderValue;
+
+	buffer_type front;
+	buffer_type back;
+
+	static dimension_type PaddedCount(dimension_type count)
+	{
+		if (count > std::numeric_limits<dimension_type>::max() - 2 * Radius)
+			throw std::length_error("Stencil dimensions too large for the halo");
+
+		return dimension_type(count + 2 * Radius);
+	}
+
+	///Which cell index stands in for index outside [0, count)
+	std::size_t SourceIndex(std::ptrdiff_t index, std::size_t count) const
+	{
+		if (this->border == GridBorder::Wrap)
+		{
+			std::ptrdiff_t wrapped = index % std::ptrdiff_t(count);
+			return std::size_t(wrapped < 0 ? wrapped + std::ptrdiff_t(count) : wrapped);
+		}
+
+		return index < 0 ? 0 : count - 1;
+	}
+
+	value_type HaloValue(const value_type* firstCell, std::ptrdiff_t index, std::size_t count) const
+	{
+		if (this->border == GridBorder::Constant)
+			return this->borderValue;
+
+		return firstCell[SourceIndex(index, count)];
+	}
+
+	void FillHaloRow(value_type* cells, std::size_t haloRow, std::ptrdiff_t row, std::size_t paddedColumns)
+	{
+		value_type* target = cells + haloRow * paddedColumns;
+
+		if (this->border == GridBorder::Constant)
+			std::fill(target, target + paddedColumns, this->borderValue);
+		else
+			std::copy_n(cells + (Radius + SourceIndex(row, this->rowCount)) * paddedColumns, paddedColumns, target);
+	}
+};
@@ -0,0 +1,334 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GRID_TRANSFORMS_SSE2 1
+#endif
+
+#include "GridView.h"
+
+///Transpose, rotations and flips for Grids with strided layouts (row major,
+///padded, column major), out of place (Transposed, Rotated90...) and in place
+///(Transpose, Rotate90...). Rotations turn clockwise.
+///
+///Flips and Rotate180 copy through flipped GridViews. Transpose, Rotate90 and
+///Rotate270 split the grid in halves, cache obliviously, until both sides fit a
+///block that stays in L1, and copy that block with 4 x 4 SSE2 shuffles for
+///32 bit cells and a plain loop otherwise.
+namespace GridTransformDetail
+{
+	///Side of the blocks the recursion stops at, 32 x 32 x 8 bytes stays in L1
+	inline constexpr std::size_t block_side = 32;
+
+	template<typename Data_Type>
+	void TransposeBlock(const GridView<const Data_Type>& source, const GridView<Data_Type>& destination)
+	{
+		const Data_Type* from = source.GetOrigin();
+		Data_Type* to = destination.GetOrigin();
+
+		std::ptrdiff_t fromColumn = source.GetColumnStride();
+		std::ptrdiff_t fromRow = source.GetRowStride();
+		std::ptrdiff_t toColumn = destination.GetColumnStride();
+		std::ptrdiff_t toRow = destination.GetRowStride();
+
+		std::size_t columns = source.GetColumnCount();
+		std::size_t rows = source.GetRowCount();
+		std::size_t row = 0;
+
+#if defined(GRID_TRANSFORMS_SSE2)
+		if constexpr (sizeof(Data_Type) == 4 && std::is_trivially_copyable<Data_Type>::value)
+		{
+			if (fromColumn == 1 && toColumn == 1)
+			{
+				for (; row + 4 <= rows; row += 4)
+				{
+					std::size_t column = 0;
+
+					for (; column + 4 <= columns; column += 4)
+					{
+						const Data_Type* cell = from + std::ptrdiff_t(row) * fromRow + std::ptrdiff_t(column);
+
+						__m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cell));
+						__m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cell + fromRow));
+						__m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cell + 2 * fromRow));
+						__m128i row3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cell + 3 * fromRow));
+
+						__m128i low01 = _mm_unpacklo_epi32(row0, row1);
+						__m128i low23 = _mm_unpacklo_epi32(row2, row3);
+						__m128i high01 = _mm_unpackhi_epi32(row0, row1);
+						__m128i high23 = _mm_unpackhi_epi32(row2, row3);
+
+						Data_Type* target = to + std::ptrdiff_t(column) * toRow + std::ptrdiff_t(row);
+
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_unpacklo_epi64(low01, low23));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(target + toRow), _mm_unpackhi_epi64(low01, low23));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 2 * toRow), _mm_unpacklo_epi64(high01, high23));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(target + 3 * toRow), _mm_unpackhi_epi64(high01, high23));
+					}
+
+					//The columns left of a 4 row strip
+					for (std::size_t strip = row; strip < row + 4; strip++)
+					{
+						for (std::size_t rest = column; rest < columns; rest++)
+							to[std::ptrdiff_t(rest) * toRow + std::ptrdiff_t(strip) * toColumn] =
+								from[std::ptrdiff_t(strip) * fromRow + std::ptrdiff_t(rest) * fromColumn];
+					}
+				}
+			}
+		}
+#endif
+
+		for (; row < rows; row++)
+		{
+			for (std::size_t column = 0; column < columns; column++)
+				to[std::ptrdiff_t(column) * toRow + std::ptrdiff_t(row) * toColumn] =
+					from[std::ptrdiff_t(row) * fromRow + std::ptrdiff_t(column) * fromColumn];
+		}
+	}
+
+	template<typename Data_Type>
+	void TransposeRecursive(const GridView<const Data_Type>& source, const GridView<Data_Type>& destination)
+	{
+		std::size_t columns = source.GetColumnCount();
+		std::size_t rows = source.GetRowCount();
+
+		if (columns <= block_side && rows <= block_side)
+		{
+			TransposeBlock(source, destination);
+		}
+		else if (columns >= rows)
+		{
+			std::size_t half = columns / 2;
+
+			TransposeRecursive(source.SubView(0, 0, half, rows), destination.SubView(0, 0, rows, half));
+			TransposeRecursive(source.SubView(half, 0, columns - half, rows), destination.SubView(0, half, rows, columns - half));
+		}
+		else
+		{
+			std::size_t half = rows / 2;
+
+			TransposeRecursive(source.SubView(0, 0, columns, half), destination.SubView(0, 0, half, columns));
+			TransposeRecursive(source.SubView(0, half, columns, rows - half), destination.SubView(half, 0, rows - half, columns));
+		}
+	}
+
+	///An uninitialised grid for trivial cells, which are all overwritten anyway.
+	///An empty source gives an empty grid, Grid cannot be sized 0 x n
+	template<typename Grid_Type>
+	Grid_Type MakeResult(const Grid_Type& source, std::size_t columns, std::size_t rows)
+	{
+		typedef typename Grid_Type::dimension_type dimension_type;
+		typedef typename Grid_Type::value_type value_type;
+
+		if (source.isEmpty())
+			return Grid_Type(source.get_allocator());
+
+		if constexpr (std::is_trivially_default_constructible<value_type>::value &&
+			std::is_trivially_destructible<value_type>::value)
+			return Grid_Type(dimension_type(columns), dimension_type(rows), GridNoInit, source.get_allocator());
+		else
+			return Grid_Type(dimension_type(columns), dimension_type(rows), value_type(), source.get_allocator());
+	}
+
+	template<typename Grid_Type>
+	GridView<typename Grid_Type::value_type> WholeView(Grid_Type& grid)
+	{
+		return GridView<typename Grid_Type::value_type>(grid);
+	}
+
+	template<typename Grid_Type>
+	GridView<const typename Grid_Type::value_type> WholeView(const Grid_Type& grid)
+	{
+		return GridView<const typename Grid_Type::value_type>(grid);
+	}
+}
+
+///Sets destination(r, c) to source(c, r). destination must be rows x columns of
+///source and must not overlap it; either may be a flipped view.
+template<typename Source_Type, typename Source_Access, typename Destination_Type, typename Destination_Access>
+void CopyTransposed(const GridView<Source_Type, Source_Access>& source,
+	const GridView<Destination_Type, Destination_Access>& destination)
+{
+	static_assert(std::is_same<typename std::remove_const<Source_Type>::type, Destination_Type>::value,
+		"CopyTransposed needs a writable destination of the same cell type");
+
+	if (source.GetColumnCount() != destination.GetRowCount() || source.GetRowCount() != destination.GetColumnCount())
+		throw std::invalid_argument("CopyTransposed destination must have the transposed extent");
+
+	if (source.isEmpty())
+		return;
+
+	GridTransformDetail::TransposeRecursive(GridView<const Destination_Type>(source), GridView<Destination_Type>(destination));
+}
+
+template<typename Grid_Type>
+Grid_Type Transposed(const Grid_Type& source)
+{
+	Grid_Type result = GridTransformDetail::MakeResult(source, source.GetRowCount(), source.GetColumnCount());
+	CopyTransposed(GridTransformDetail::WholeView(source), GridTransformDetail::WholeView(result));
+	return result;
+}
+
+///Turned a quarter clockwise: the top row becomes the right column
+template<typename Grid_Type>
+Grid_Type Rotated90(const Grid_Type& source)
+{
+	Grid_Type result = GridTransformDetail::MakeResult(source, source.GetRowCount(), source.GetColumnCount());
+	CopyTransposed(GridTransformDetail::WholeView(source).FlippedVertically(), GridTransformDetail::WholeView(result));
+	return result;
+}
+
+template<typename Grid_Type>
+Grid_Type Rotated180(const Grid_Type& source)
+{
+	Grid_Type result = GridTransformDetail::MakeResult(source, source.GetColumnCount(), source.GetRowCount());
+	CopyRegion(GridTransformDetail::WholeView(source).FlippedVertically(),
+		GridTransformDetail::WholeView(result).FlippedHorizontally());
+	return result;
+}
+
+///Turned a quarter counter clockwise: the top row becomes the left column
+template<typename Grid_Type>
+Grid_Type Rotated270(const Grid_Type& source)
+{
+	Grid_Type result = GridTransformDetail::MakeResult(source, source.GetRowCount(), source.GetColumnCount());
+	CopyTransposed(GridTransformDetail::WholeView(source), GridTransformDetail::WholeView(result).FlippedVertically());
+	return result;
+}
+
+///Mirrored left to right
+template<typename Grid_Type>
+Grid_Type FlippedHorizontally(const Grid_Type& source)
+{
+	Grid_Type result = GridTransformDetail::MakeResult(source, source.GetColumnCount(), source.GetRowCount());
+	CopyRegion(GridTransformDetail::WholeView(source), GridTransformDetail::WholeView(result).FlippedHorizontally());
+	return result;
+}
+
+///Mirrored top to bottom
+template<typename Grid_Type>
+Grid_Type FlippedVertically(const Grid_Type& source)
+{
+	Grid_Type result = GridTransformDetail::MakeResult(source, source.GetColumnCount(), source.GetRowCount());
+	CopyRegion(GridTransformDetail::WholeView(source), GridTransformDetail::WholeView(result).FlippedVertically());
+	return result;
+}
+
+template<typename Grid_Type>
+void FlipHorizontal(Grid_Type& grid)
+{
+	auto view = GridTransformDetail::WholeView(grid);
+
+	for (std::size_t row = 0; row < view.GetRowCount(); row++)
+	{
+		auto line = view.GetRow(row);
+
+		if (view.HasContiguousRows())
+			std::reverse(&*line.begin(), &*line.begin() + line.size());
+		else
+			std::reverse(line.begin(), line.end());
+	}
+}
+
+template<typename Grid_Type>
+void FlipVertical(Grid_Type& grid)
+{
+	auto view = GridTransformDetail::WholeView(grid);
+	std::size_t rows = view.GetRowCount();
+
+	for (std::size_t row = 0; row < rows / 2; row++)
+	{
+		auto top = view.GetRow(row);
+		auto bottom = view.GetRow(rows - 1 - row);
+
+		if (view.HasContiguousRows())
+			std::swap_ranges(&*top.begin(), &*top.begin() + top.size(), &*bottom.begin());
+		else
+			std::swap_ranges(top.begin(), top.end(), bottom.begin());
+	}
+}
+
+///Square grids are transposed in place, block pair by block pair; other shapes
+///go through Transposed, as the cells would otherwise have to follow cycles
+///through the whole buffer
+template<typename Grid_Type>
+void Transpose(Grid_Type& grid)
+{
+	if (grid.GetColumnCount() != grid.GetRowCount())
+	{
+		grid = Transposed(grid);
+		return;
+	}
+
+	auto view = GridTransformDetail::WholeView(grid);
+	auto* origin = view.GetOrigin();
+	std::ptrdiff_t columnStride = view.GetColumnStride();
+	std::ptrdiff_t rowStride = view.GetRowStride();
+
+	auto cell = [&](std::size_t column, std::size_t row) -> decltype(*origin)
+	{
+		return origin[std::ptrdiff_t(column) * columnStride + std::ptrdiff_t(row) * rowStride];
+	};
+
+	std::size_t side = view.GetColumnCount();
+	const std::size_t block = GridTransformDetail::block_side;
+
+	for (std::size_t blockRow = 0; blockRow < side; blockRow += block)
+	{
+		std::size_t rowEnd = std::min(blockRow + block, side);
+
+		for (std::size_t blockColumn = blockRow; blockColumn < side; blockColumn += block)
+		{
+			std::size_t columnEnd = std::min(blockColumn + block, side);
+
+			for (std::size_t row = blockRow; row < rowEnd; row++)
+			{
+				//Only the cells above the diagonal, each swap handles a pair
+				for (std::size_t column = std::max(blockColumn, row + 1); column < columnEnd; column++)
+				{
+					using std::swap;
+					swap(cell(column, row), cell(row, column));
+				}
+			}
+		}
+	}
+}
+
+template<typename Grid_Type>
+void Rotate90(Grid_Type& grid)
+{
+	if (grid.GetColumnCount() != grid.GetRowCount())
+	{
+		grid = Rotated90(grid);
+		return;
+	}
+
+	Transpose(grid);
+	FlipHorizontal(grid);
+}
+
+template<typename Grid_Type>
+void Rotate180(Grid_Type& grid)
+{
+	FlipHorizontal(grid);
+	FlipVertical(grid);
+}
+
+template<typename Grid_Type>
+void Rotate270(Grid_Type& grid)
+{
+	if (grid.GetColumnCount() != grid.GetRowCount())
+	{
+		grid = Rotated270(grid);
+		return;
+	}
+
+	Transpose(grid);
+	FlipVertical(grid);
+}
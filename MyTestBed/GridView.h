@@ -0,0 +1,495 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Grid.h"
+
+///Non-owning view of a rectangle of cells: an origin cell, an extent and the
+///element distance between neighbouring columns and rows. Views are taken from
+///any Grid whose layout is strided (row major, padded, column major), from
+///raw storage or from another view, and never copy a cell. Data_Type is const
+///for read only views.
+///
+///The viewed grid must outlive the view and must not be resized while the view
+///is used. Iteration goes row by row and skips the cells between the end of one
+///row of the view and the start of the next.
+///
+///GetCell, operator[], GetRow, GetColumn and the Lines they return, iterators
+///included, check their arguments through Access_Policy, as Grid's accessors do
+///(see GridAccess.h).
+template<typename Data_Type, typename Access_Policy = GridDefaultAccess>
+class GridView
+{
+public:
+	typedef typename std::remove_const<Data_Type>::type value_type;
+	typedef Data_Type& reference;
+	typedef const Data_Type& const_reference;
+	typedef std::size_t dimension_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef Access_Policy access_policy;
+
+	typedef GridStrideIterator<Data_Type, Access_Policy> line_iterator;
+
+	///A single row or column of the view
+	class Line
+	{
+	public:
+		Line(line_iterator _first, line_iterator _last)
+			:first(_first), last(_last)
+		{
+
+		}
+
+		line_iterator begin() const
+		{
+			return this->first;
+		}
+
+		line_iterator end() const
+		{
+			return this->last;
+		}
+
+		std::size_t size() const
+		{
+			return std::size_t(this->last - this->first);
+		}
+
+		reference operator[](std::size_t index) const
+		{
+			Access_Policy::Check(index < size(), "GridView-Line Argument Out of Range");
+			return this->first[difference_type(index)];
+		}
+
+	private:
+		line_iterator first;
+		line_iterator last;
+	};
+
+	///Forward iterator over every cell, row by row
+	class iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef typename GridView::value_type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Data_Type* pointer;
+		typedef Data_Type& reference;
+
+		iterator()
+			:rowStart(nullptr), column(0), columnCount(0), columnStride(0), rowStride(0)
+		{
+
+		}
+
+		iterator(Data_Type* _rowStart, std::size_t _columnCount, std::ptrdiff_t _columnStride, std::ptrdiff_t _rowStride)
+			:rowStart(_rowStart), column(0), columnCount(_columnCount), columnStride(_columnStride), rowStride(_rowStride)
+		{
+
+		}
+
+		reference operator*() const
+		{
+			return this->rowStart[difference_type(this->column) * this->columnStride];
+		}
+
+		pointer operator->() const
+		{
+			return &**this;
+		}
+
+		iterator& operator++()
+		{
+			if (++this->column == this->columnCount)
+			{
+				this->column = 0;
+				this->rowStart += this->rowStride;
+			}
+
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator previous(*this);
+			++*this;
+			return previous;
+		}
+
+		bool operator==(const iterator& rhs) const
+		{
+			return this->rowStart == rhs.rowStart && this->column == rhs.column;
+		}
+
+		bool operator!=(const iterator& rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+	private:
+		Data_Type* rowStart;
+		std::size_t column;
+		std::size_t columnCount;
+		std::ptrdiff_t columnStride;
+		std::ptrdiff_t rowStride;
+	};
+
+	typedef iterator const_iterator;
+
+	template <typename Reference_Type>
+	class _Indexer
+	{
+		dimension_type columnIndex;
+		const GridView& data;
+
+	public:
+		_Indexer(dimension_type ColumnIndex, const GridView& Data)
+			: columnIndex(ColumnIndex), data(Data)
+		{
+
+		}
+
+		Reference_Type operator[](dimension_type RowIndex) const
+		{
+			return data.GetCell(columnIndex, RowIndex);
+		}
+	};
+
+	typedef _Indexer<reference> indexer;
+
+	GridView()
+		:origin(nullptr), columnCount(0), rowCount(0), columnStride(0), rowStride(0)
+	{
+
+	}
+
+	///Strides count elements; origin is the view's cell (0, 0)
+	GridView(Data_Type* _origin, dimension_type _columnCount, dimension_type _rowCount,
+		std::ptrdiff_t _columnStride, std::ptrdiff_t _rowStride)
+		:origin(_origin), columnCount(_columnCount), rowCount(_rowCount), columnStride(_columnStride), rowStride(_rowStride)
+	{
+
+	}
+
+	///The whole grid, or the columnCount x rowCount rectangle at (column, row)
+	template<typename Grid_Data_Type, typename Layout_Type, typename Allocator_Type, typename Dimension_Type, typename Grid_Access>
+	GridView(Grid<Grid_Data_Type, Layout_Type, Allocator_Type, Dimension_Type, Grid_Access>& grid)
+		:GridView(grid, 0, 0, grid.GetColumnCount(), grid.GetRowCount())
+	{
+
+	}
+
+	template<typename Grid_Data_Type, typename Layout_Type, typename Allocator_Type, typename Dimension_Type, typename Grid_Access>
+	GridView(const Grid<Grid_Data_Type, Layout_Type, Allocator_Type, Dimension_Type, Grid_Access>& grid)
+		:GridView(grid, 0, 0, grid.GetColumnCount(), grid.GetRowCount())
+	{
+
+	}
+
+	template<typename Grid_Type>
+	GridView(Grid_Type& grid, dimension_type column, dimension_type row, dimension_type _columnCount, dimension_type _rowCount)
+		:GridView()
+	{
+		static_assert(Grid_Type::layout_type::is_strided, "GridView needs a strided layout");
+
+		if (column + _columnCount > grid.GetColumnCount() || row + _rowCount > grid.GetRowCount())
+			throw std::out_of_range("GridView rectangle out of range");
+
+		if (_columnCount == 0 || _rowCount == 0)
+			return;
+
+		this->origin = &grid.GetCell(grid.GetOneDimensionIndex(typename Grid_Type::dimension_type(column),
+			typename Grid_Type::dimension_type(row)));
+		this->columnCount = _columnCount;
+		this->rowCount = _rowCount;
+		this->columnStride = std::ptrdiff_t(grid.GetLayout().GetColumnStride());
+		this->rowStride = std::ptrdiff_t(grid.GetLayout().GetRowStride());
+	}
+
+	///A writable view converts to a read only one, and any view to one with
+	///another access policy
+	template<typename Other_Data_Type, typename Other_Access, typename = typename std::enable_if<
+		std::is_same<const Other_Data_Type, Data_Type>::value || (std::is_same<Other_Data_Type, Data_Type>::value &&
+			!std::is_same<Other_Access, Access_Policy>::value)>::type>
+	GridView(const GridView<Other_Data_Type, Other_Access>& source)
+		:origin(source.GetOrigin()), columnCount(source.GetColumnCount()), rowCount(source.GetRowCount()),
+		columnStride(source.GetColumnStride()), rowStride(source.GetRowStride())
+	{
+
+	}
+
+	///The columnCount x rowCount rectangle at (column, row) of this view
+	GridView SubView(dimension_type column, dimension_type row, dimension_type _columnCount, dimension_type _rowCount) const
+	{
+		if (column + _columnCount > this->columnCount || row + _rowCount > this->rowCount)
+			throw std::out_of_range("GridView rectangle out of range");
+
+		if (_columnCount == 0 || _rowCount == 0)
+			return GridView();
+
+		return GridView(this->origin + difference_type(column) * this->columnStride + difference_type(row) * this->rowStride,
+			_columnCount, _rowCount, this->columnStride, this->rowStride);
+	}
+
+	///The same cells with columns and rows swapped, cell (c, r) is this view's (r, c)
+	GridView Transposed() const
+	{
+		return GridView(this->origin, this->rowCount, this->columnCount, this->rowStride, this->columnStride);
+	}
+
+	///The same cells mirrored left to right, cell (c, r) is this view's (columnCount - 1 - c, r)
+	GridView FlippedHorizontally() const
+	{
+		if (isEmpty())
+			return *this;
+
+		return GridView(this->origin + difference_type(this->columnCount - 1) * this->columnStride,
+			this->columnCount, this->rowCount, -this->columnStride, this->rowStride);
+	}
+
+	///The same cells mirrored top to bottom, cell (c, r) is this view's (c, rowCount - 1 - r)
+	GridView FlippedVertically() const
+	{
+		if (isEmpty())
+			return *this;
+
+		return GridView(this->origin + difference_type(this->rowCount - 1) * this->rowStride,
+			this->columnCount, this->rowCount, this->columnStride, -this->rowStride);
+	}
+
+	indexer operator [](dimension_type index) const
+	{
+		return indexer(index, *this);
+	}
+
+	reference GetCell(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		Access_Policy::Check(columnIndex < this->columnCount && rowIndex < this->rowCount,
+			"GridView-GetCell Arguments Out of Range");
+
+		return this->origin[difference_type(columnIndex) * this->columnStride + difference_type(rowIndex) * this->rowStride];
+	}
+
+	///An empty line when rowIndex is out of range and the policy does not throw
+	Line GetRow(dimension_type rowIndex) const
+	{
+		Access_Policy::Check(rowIndex < this->rowCount, "GridView-GetRow Argument Out of Range");
+
+		if (rowIndex >= this->rowCount)
+			return Line(line_iterator(nullptr, 1), line_iterator(nullptr, 1));
+
+		return MakeLine(this->origin + difference_type(rowIndex) * this->rowStride, this->columnStride, this->columnCount);
+	}
+
+	///An empty line when columnIndex is out of range and the policy does not throw
+	Line GetColumn(dimension_type columnIndex) const
+	{
+		Access_Policy::Check(columnIndex < this->columnCount, "GridView-GetColumn Argument Out of Range");
+
+		if (columnIndex >= this->columnCount)
+			return Line(line_iterator(nullptr, 1), line_iterator(nullptr, 1));
+
+		return MakeLine(this->origin + difference_type(columnIndex) * this->columnStride, this->rowStride, this->rowCount);
+	}
+
+	iterator begin() const
+	{
+		return iterator(this->origin, this->columnCount, this->columnStride, this->rowStride);
+	}
+
+	iterator end() const
+	{
+		return iterator(this->origin + difference_type(this->rowCount) * this->rowStride,
+			this->columnCount, this->columnStride, this->rowStride);
+	}
+
+	///Sets every cell of the view, a std::fill (memset for bytes) per row when
+	///rows are contiguous
+	void Fill(const value_type& value) const
+	{
+		for (dimension_type row = 0; row < this->rowCount; row++)
+		{
+			Data_Type* first = this->origin + difference_type(row) * this->rowStride;
+
+			if (this->columnStride == 1)
+			{
+				if constexpr (sizeof(value_type) == 1 && std::is_trivially_copyable<value_type>::value)
+				{
+					unsigned char byte;
+					std::memcpy(&byte, &value, 1);
+					std::memset(first, byte, this->columnCount);
+				}
+				else
+				{
+					std::fill(first, first + this->columnCount, value);
+				}
+			}
+			else
+			{
+				for (dimension_type column = 0; column < this->columnCount; column++)
+					first[difference_type(column) * this->columnStride] = value;
+			}
+		}
+	}
+
+	///Whether each row of the view is a contiguous run of cells
+	inline bool HasContiguousRows() const
+	{
+		return this->columnStride == 1;
+	}
+
+	inline Data_Type* GetOrigin() const
+	{
+		return this->origin;
+	}
+
+	inline dimension_type GetColumnCount() const
+	{
+		return this->columnCount;
+	}
+
+	inline dimension_type GetRowCount() const
+	{
+		return this->rowCount;
+	}
+
+	inline std::ptrdiff_t GetColumnStride() const
+	{
+		return this->columnStride;
+	}
+
+	inline std::ptrdiff_t GetRowStride() const
+	{
+		return this->rowStride;
+	}
+
+	inline bool isEmpty() const
+	{
+		return !(this->rowCount > 0 && this->columnCount > 0);
+	}
+
+	inline size_type size() const
+	{
+		return size_type(this->columnCount) * this->rowCount;
+	}
+
+private:
+	///The length cells stride apart from first, with the iterators bounded by
+	///the lowest and highest of them
+	static Line MakeLine(Data_Type* first, std::ptrdiff_t stride, dimension_type length)
+	{
+		Data_Type* lastCell = first + difference_type(length - 1) * stride;
+		Data_Type* lowest = stride < 0 ? lastCell : first;
+		Data_Type* highest = (stride < 0 ? first : lastCell) + 1;
+
+		return Line(line_iterator(first, stride, lowest, highest),
+			line_iterator(first, stride, lowest, highest) + difference_type(length));
+	}
+
+	Data_Type* origin;
+	dimension_type columnCount;
+	dimension_type rowCount;
+	std::ptrdiff_t columnStride;
+	std::ptrdiff_t rowStride;
+};
+
+///Copies source into destination, which must have the same extent. Rows are
+///copied with one memmove each when both views have contiguous rows and the
+///cells are trivially copyable. Overlapping views of the same grid copy as if
+///through a temporary, for scrolling a grid within itself.
+template<typename Source_Type, typename Source_Access, typename Destination_Type, typename Destination_Access>
+void CopyRegion(const GridView<Source_Type, Source_Access>& source, const GridView<Destination_Type, Destination_Access>& destination)
+{
+	static_assert(std::is_same<typename std::remove_const<Source_Type>::type, Destination_Type>::value,
+		"CopyRegion needs a writable destination of the same cell type");
+
+	if (source.GetColumnCount() != destination.GetColumnCount() || source.GetRowCount() != destination.GetRowCount())
+		throw std::invalid_argument("CopyRegion extents differ");
+
+	std::size_t rows = source.GetRowCount();
+	std::size_t columns = source.GetColumnCount();
+
+	if (rows == 0 || columns == 0)
+		return;
+
+	auto rowOrdered = [columns](std::ptrdiff_t columnStride, std::ptrdiff_t rowStride)
+	{
+		return columnStride > 0 && rowStride >= std::ptrdiff_t(columns) * columnStride;
+	};
+
+	const Destination_Type* sourceFirst = source.GetOrigin();
+	const Destination_Type* sourceLast = sourceFirst + std::ptrdiff_t(rows - 1) * source.GetRowStride() +
+		std::ptrdiff_t(columns - 1) * source.GetColumnStride();
+	const Destination_Type* destinationFirst = destination.GetOrigin();
+	const Destination_Type* destinationLast = destinationFirst + std::ptrdiff_t(rows - 1) * destination.GetRowStride() +
+		std::ptrdiff_t(columns - 1) * destination.GetColumnStride();
+
+	//Flipped views have negative strides, their last cell may come first in memory
+	std::less<const Destination_Type*> before;
+	bool overlaps = !(before(std::max(sourceFirst, sourceLast, before), std::min(destinationFirst, destinationLast, before)) ||
+		before(std::max(destinationFirst, destinationLast, before), std::min(sourceFirst, sourceLast, before)));
+
+	//Overlapping views that are not both walked in address order go through a copy
+	if (overlaps && !(rowOrdered(source.GetColumnStride(), source.GetRowStride()) &&
+		rowOrdered(destination.GetColumnStride(), destination.GetRowStride())))
+	{
+		std::vector<Destination_Type> cells(source.begin(), source.end());
+		GridView<const Destination_Type> temporary(cells.data(), columns, rows, 1, std::ptrdiff_t(columns));
+
+		CopyRegion(temporary, destination);
+		return;
+	}
+
+	//Moving towards higher addresses walks backwards so no source cell is
+	//overwritten before it is read
+	bool backwards = overlaps && destinationFirst > sourceFirst;
+
+	for (std::size_t step = 0; step < rows; step++)
+	{
+		std::size_t row = backwards ? rows - 1 - step : step;
+
+		const Destination_Type* from = sourceFirst + std::ptrdiff_t(row) * source.GetRowStride();
+		Destination_Type* to = destination.GetOrigin() + std::ptrdiff_t(row) * destination.GetRowStride();
+
+		if constexpr (std::is_trivially_copyable<Destination_Type>::value)
+		{
+			if (source.HasContiguousRows() && destination.HasContiguousRows())
+			{
+				std::memmove(to, from, columns * sizeof(Destination_Type));
+				continue;
+			}
+		}
+
+		for (std::size_t columnStep = 0; columnStep < columns; columnStep++)
+		{
+			std::size_t column = backwards ? columns - 1 - columnStep : columnStep;
+
+			to[std::ptrdiff_t(column) * destination.GetColumnStride()] = from[std::ptrdiff_t(column) * source.GetColumnStride()];
+		}
+	}
+}
+
+///Sets every cell of the view to value, see GridView::Fill
+template<typename Data_Type, typename Access_Policy>
+void FillRegion(const GridView<Data_Type, Access_Policy>& destination,
+	const typename GridView<Data_Type, Access_Policy>::value_type& value)
+{
+	destination.Fill(value);
+}
+
+///View of the columnCount x rowCount rectangle at (column, row) of grid
+template<typename Grid_Type>
+auto MakeGridView(Grid_Type& grid, std::size_t column, std::size_t row, std::size_t columnCount, std::size_t rowCount)
+{
+	typedef typename std::conditional<std::is_const<Grid_Type>::value,
+		const typename Grid_Type::value_type, typename Grid_Type::value_type>::type view_data_type;
+
+	return GridView<view_data_type, typename Grid_Type::access_policy>(grid, column, row, columnCount, rowCount);
+}
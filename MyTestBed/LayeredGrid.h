@@ -0,0 +1,374 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Grid.h"
+
+///Type of the field a data member pointer points at, and the struct it belongs to
+template<typename Member_Pointer>
+struct GridMemberTraits;
+
+template<typename Field_Type, typename Owner_Type>
+struct GridMemberTraits<Field_Type Owner_Type::*>
+{
+	typedef Field_Type field_type;
+	typedef Owner_Type owner_type;
+};
+
+///One layer of a LayeredGrid, handed out by LayeredGrid::GetLayer. Reads and
+///writes cells like a Grid and can be iterated or run through the bulk
+///operations, but cannot be resized on its own. Grid_Type is const for the
+///layers of a const LayeredGrid.
+template<typename Grid_Type>
+class GridLayer
+{
+public:
+	typedef typename std::remove_const<Grid_Type>::type grid_type;
+	typedef typename grid_type::value_type value_type;
+	typedef typename grid_type::dimension_type dimension_type;
+	typedef typename grid_type::size_type size_type;
+
+	explicit GridLayer(Grid_Type& _grid)
+		:grid(&_grid)
+	{
+
+	}
+
+	inline auto begin() const
+	{
+		return this->grid->begin();
+	}
+
+	inline auto end() const
+	{
+		return this->grid->end();
+	}
+
+	inline auto& GetCell(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		if (columnIndex >= this->grid->GetColumnCount() || rowIndex >= this->grid->GetRowCount())
+			throw std::out_of_range("GridLayer-GetCell Arguments Out of Range");
+
+		return this->grid->GetCell(this->grid->GetOneDimensionIndex(columnIndex, rowIndex));
+	}
+
+	template<typename Policy_Type, typename Function_Type>
+	void ForEach(const Policy_Type& policy, Function_Type function) const
+	{
+		this->grid->ForEach(policy, function);
+	}
+
+	template<typename Policy_Type>
+	void Fill(const Policy_Type& policy, const value_type& value) const
+	{
+		this->grid->Fill(policy, value);
+	}
+
+	template<typename Policy_Type, typename Function_Type>
+	void Transform(const Policy_Type& policy, Function_Type function) const
+	{
+		this->grid->Transform(policy, function);
+	}
+
+	template<typename Policy_Type, typename Source_Grid, typename Function_Type>
+	void Transform(const Policy_Type& policy, const Source_Grid& source, Function_Type function) const
+	{
+		this->grid->Transform(policy, source, function);
+	}
+
+	template<typename Policy_Type, typename Result_Type, typename... Function_Types>
+	Result_Type Reduce(const Policy_Type& policy, Result_Type init, Function_Types... functions) const
+	{
+		return this->grid->Reduce(policy, init, functions...);
+	}
+
+	///The layer's cells as a read only Grid, for anything that takes one
+	inline const grid_type& GetGrid() const
+	{
+		return *this->grid;
+	}
+
+	inline dimension_type GetColumnCount() const
+	{
+		return this->grid->GetColumnCount();
+	}
+
+	inline dimension_type GetRowCount() const
+	{
+		return this->grid->GetRowCount();
+	}
+
+	inline size_type size() const
+	{
+		return this->grid->size();
+	}
+
+private:
+	Grid_Type* grid;
+};
+
+///Grid of a struct cell type stored structure of arrays: every listed data
+///member of Cell_Type gets its own contiguous plane, a Grid with the shared
+///Layout_Type and dimensions. A pass over one field through GetLayer only
+///streams that field through the cache.
+///
+///	struct Cell { float height; float cost; std::uint8_t owner; std::uint8_t flags; };
+///	LayeredGrid<Cell, RowMajorLayout, &Cell::height, &Cell::cost, &Cell::owner, &Cell::flags> world(512, 512);
+///	world.GetLayer<&Cell::cost>().Fill(GridExecution::par, 1.0f);
+///	world.GetCell(3, 4) = Cell{ 2.0f, 1.0f, 7, 0 };
+///
+///Members left out of the list are not stored; whole cells read back with them
+///value initialised. GetCell returns a CellReference proxy, which converts to
+///Cell_Type and can be assigned one, or reaches a single field through Get.
+template<typename Cell_Type, typename Layout_Type, auto... Members>
+class LayeredGrid
+{
+	static_assert(sizeof...(Members) > 0, "LayeredGrid needs at least one member");
+	static_assert(std::conjunction<std::is_same<Cell_Type,
+		typename GridMemberTraits<decltype(Members)>::owner_type>...>::value,
+		"Every member must be a data member of Cell_Type");
+
+	template<auto Member>
+	using member_grid = Grid<typename GridMemberTraits<decltype(Member)>::field_type, Layout_Type>;
+
+	typedef std::tuple<member_grid<Members>...> layer_tuple;
+
+	template<auto Left, auto Right>
+	struct IsSameMember : std::is_same<std::integral_constant<decltype(Left), Left>,
+		std::integral_constant<decltype(Right), Right>>
+	{
+
+	};
+
+	template<auto Member>
+	static constexpr std::size_t LayerIndex()
+	{
+		constexpr bool matches[] = { IsSameMember<Member, Members>::value... };
+
+		for (std::size_t layer = 0; layer < sizeof...(Members); layer++)
+		{
+			if (matches[layer])
+				return layer;
+		}
+
+		return sizeof...(Members);
+	}
+
+	template<auto Member>
+	static constexpr std::size_t CheckedLayerIndex()
+	{
+		static_assert(LayerIndex<Member>() < sizeof...(Members), "Member is not a layer of this LayeredGrid");
+		return LayerIndex<Member>();
+	}
+
+public:
+	typedef Cell_Type value_type;
+	typedef Layout_Type layout_type;
+	typedef typename std::tuple_element<0, layer_tuple>::type::dimension_type dimension_type;
+	typedef typename std::tuple_element<0, layer_tuple>::type::size_type size_type;
+
+	static constexpr std::size_t layer_count = sizeof...(Members);
+
+	///A whole logical cell, read and written across every layer
+	class CellReference
+	{
+	public:
+		CellReference(LayeredGrid& _grid, dimension_type _column, dimension_type _row)
+			:grid(&_grid), column(_column), row(_row)
+		{
+
+		}
+
+		operator Cell_Type() const
+		{
+			return this->grid->Load(this->column, this->row);
+		}
+
+		const CellReference& operator=(const Cell_Type& cell) const
+		{
+			this->grid->Store(this->column, this->row, cell);
+			return *this;
+		}
+
+		const CellReference& operator=(const CellReference& source) const
+		{
+			return *this = Cell_Type(source);
+		}
+
+		template<auto Member>
+		auto& Get() const
+		{
+			return std::get<CheckedLayerIndex<Member>()>(this->grid->layers).GetCell(
+				std::get<CheckedLayerIndex<Member>()>(this->grid->layers).GetOneDimensionIndex(this->column, this->row));
+		}
+
+	private:
+		LayeredGrid* grid;
+		dimension_type column;
+		dimension_type row;
+	};
+
+	typedef CellReference reference;
+
+	LayeredGrid()
+		:columnCount(0), rowCount(0)
+	{
+
+	}
+
+	LayeredGrid(dimension_type _columnCount, dimension_type _rowCount, const Cell_Type& initVal = Cell_Type())
+		:columnCount(0), rowCount(0)
+	{
+		ResizeGrid(_columnCount, _rowCount, initVal);
+	}
+
+	///A proxy for the whole cell, see CellReference
+	reference GetCell(dimension_type columnIndex, dimension_type rowIndex)
+	{
+		CheckBounds(columnIndex, rowIndex);
+		return reference(*this, columnIndex, rowIndex);
+	}
+
+	Cell_Type GetCell(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		CheckBounds(columnIndex, rowIndex);
+		return Load(columnIndex, rowIndex);
+	}
+
+	void SetCell(dimension_type columnIndex, dimension_type rowIndex, const Cell_Type& cell)
+	{
+		CheckBounds(columnIndex, rowIndex);
+		Store(columnIndex, rowIndex, cell);
+	}
+
+	///The plane holding Member, e.g. GetLayer<&Cell::height>()
+	template<auto Member>
+	GridLayer<member_grid<Member>> GetLayer()
+	{
+		return GridLayer<member_grid<Member>>(std::get<CheckedLayerIndex<Member>()>(this->layers));
+	}
+
+	template<auto Member>
+	GridLayer<const member_grid<Member>> GetLayer() const
+	{
+		return GridLayer<const member_grid<Member>>(std::get<CheckedLayerIndex<Member>()>(this->layers));
+	}
+
+	///Resets every cell to initVal with the new dimensions
+	void ResizeGrid(dimension_type newColumnCount, dimension_type newRowCount, const Cell_Type& initVal = Cell_Type())
+	{
+		if (newRowCount == 0 || newColumnCount == 0)
+			throw std::invalid_argument("Dimension cannot be 0");
+
+		ForEachLayer([&](auto& layer, auto member)
+		{
+			layer.ResizeGrid(newColumnCount, newRowCount, initVal.*member);
+		});
+
+		this->columnCount = newColumnCount;
+		this->rowCount = newRowCount;
+	}
+
+	///Resizes every layer together, keeping the cells that fit and filling the
+	///new ones from emptyFiller, as Grid::ResizeGridPreserveData
+	void ResizeGridPreserveData(dimension_type newColumnCount, dimension_type newRowCount,
+		const Cell_Type& emptyFiller = Cell_Type())
+	{
+		if (newRowCount == 0 || newColumnCount == 0)
+			throw std::invalid_argument("Dimension cannot be 0");
+
+		ForEachLayer([&](auto& layer, auto member)
+		{
+			layer.ResizeGridPreserveData(newColumnCount, newRowCount, emptyFiller.*member);
+		});
+
+		this->columnCount = newColumnCount;
+		this->rowCount = newRowCount;
+	}
+
+	inline dimension_type GetColumnCount()const
+	{
+		return this->columnCount;
+	}
+
+	inline dimension_type GetRowCount()const
+	{
+		return this->rowCount;
+	}
+
+	inline bool isEmpty()const
+	{
+		return !(this->rowCount > 0 && this->columnCount > 0);
+	}
+
+	inline size_type size()const
+	{
+		return size_type(this->columnCount) * this->rowCount;
+	}
+
+	inline void swap(LayeredGrid& inGrid)
+	{
+		std::swap(*this, inGrid);
+	}
+
+private:
+	dimension_type columnCount;
+	dimension_type rowCount;
+
+	layer_tuple layers;
+
+	inline void CheckBounds(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		if (columnIndex >= this->columnCount || rowIndex >= this->rowCount)
+			throw std::out_of_range("LayeredGrid-GetCell Arguments Out of Range");
+	}
+
+	///Calls function(layer, member pointer) for every layer in order
+	template<typename Function_Type>
+	void ForEachLayer(Function_Type&& function)
+	{
+		ForEachLayer(std::forward<Function_Type>(function), std::make_index_sequence<sizeof...(Members)>());
+	}
+
+	template<typename Function_Type, std::size_t... Indices>
+	void ForEachLayer(Function_Type&& function, std::index_sequence<Indices...>)
+	{
+		(function(std::get<Indices>(this->layers), Members), ...);
+	}
+
+	template<typename Function_Type>
+	void ForEachLayer(Function_Type&& function) const
+	{
+		ForEachLayer(std::forward<Function_Type>(function), std::make_index_sequence<sizeof...(Members)>());
+	}
+
+	template<typename Function_Type, std::size_t... Indices>
+	void ForEachLayer(Function_Type&& function, std::index_sequence<Indices...>) const
+	{
+		(function(std::get<Indices>(this->layers), Members), ...);
+	}
+
+	///Layouts may pad rows by element size, so each layer finds its own index
+	Cell_Type Load(dimension_type column, dimension_type row) const
+	{
+		Cell_Type cell{};
+
+		ForEachLayer([&](const auto& layer, auto member)
+		{
+			cell.*member = layer.GetCell(layer.GetOneDimensionIndex(column, row));
+		});
+
+		return cell;
+	}
+
+	void Store(dimension_type column, dimension_type row, const Cell_Type& cell)
+	{
+		ForEachLayer([&](auto& layer, auto member)
+		{
+			layer.GetCell(layer.GetOneDimensionIndex(column, row)) = cell.*member;
+		});
+	}
+};
@@ -0,0 +1,535 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Grid.h"
+
+///How a MappedGrid maps its file
+enum class MappedGridMode
+{
+	///Cells can only be read. Every process opening the file shares the same pages.
+	ReadOnly,
+	///Cells can be written, the writes stay private to this mapping and never reach the file
+	CopyOnWrite,
+	///Writes go to the file and are seen by every process mapping it. Flush() makes them durable.
+	SharedWritable
+};
+
+///Identifies a layout in the file header so a file is only opened with the
+///layout it was written with
+template<typename Layout_Type>
+struct MappedGridLayoutCode;
+
+template<>
+struct MappedGridLayoutCode<RowMajorLayout>
+{
+	static constexpr std::uint32_t code = 1;
+	static constexpr std::uint32_t parameter = 0;
+};
+
+template<std::size_t Row_Alignment>
+struct MappedGridLayoutCode<PaddedRowMajorLayout<Row_Alignment>>
+{
+	static constexpr std::uint32_t code = 2;
+	static constexpr std::uint32_t parameter = std::uint32_t(Row_Alignment);
+};
+
+template<>
+struct MappedGridLayoutCode<ColumnMajorLayout>
+{
+	static constexpr std::uint32_t code = 3;
+	static constexpr std::uint32_t parameter = 0;
+};
+
+template<std::size_t Tile_Size>
+struct MappedGridLayoutCode<TiledLayout<Tile_Size>>
+{
+	static constexpr std::uint32_t code = 4;
+	static constexpr std::uint32_t parameter = std::uint32_t(Tile_Size);
+};
+
+template<std::size_t Tile_Size>
+struct MappedGridLayoutCode<MortonLayout<Tile_Size>>
+{
+	static constexpr std::uint32_t code = 5;
+	static constexpr std::uint32_t parameter = std::uint32_t(Tile_Size);
+};
+
+///First bytes of a mapped grid file. The cells follow at dataOffset, which is
+///page aligned so they satisfy any cell or row alignment.
+struct MappedGridHeader
+{
+	static constexpr std::uint32_t current_version = 1;
+	static constexpr std::uint64_t data_offset = 4096;
+
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t headerSize;
+	std::uint64_t columnCount;
+	std::uint64_t rowCount;
+	std::uint32_t elementSize;
+	std::uint32_t elementAlignment;
+	std::uint32_t layoutCode;
+	std::uint32_t layoutParameter;
+	std::uint64_t storageSize;
+	std::uint64_t dataOffset;
+	///Of the storageSize * elementSize bytes at dataOffset, see ComputeChecksum
+	std::uint64_t checksum;
+
+	static const char* Magic()
+	{
+		return "GRIDMAP";
+	}
+
+	///FNV-1a over 64 bit words, then over the bytes left at the end
+	static std::uint64_t ComputeChecksum(const void* data, std::size_t bytes)
+	{
+		const std::uint64_t prime = 0x100000001B3ull;
+		const unsigned char* input = static_cast<const unsigned char*>(data);
+
+		std::uint64_t hash = 0xCBF29CE484222325ull;
+		std::size_t word = 0;
+
+		for (; word + sizeof(std::uint64_t) <= bytes; word += sizeof(std::uint64_t))
+		{
+			std::uint64_t value;
+			std::memcpy(&value, input + word, sizeof(value));
+			hash = (hash ^ value) * prime;
+		}
+
+		for (; word < bytes; word++)
+			hash = (hash ^ input[word]) * prime;
+
+		return hash;
+	}
+};
+
+static_assert(sizeof(MappedGridHeader) <= MappedGridHeader::data_offset, "The header must fit before the cells");
+static_assert(std::is_trivially_copyable<MappedGridHeader>::value, "The header is written as raw bytes");
+
+///Grid whose cells live in a memory mapped file, so loading a precomputed grid
+///is O(1) and the OS page cache is shared between every process mapping it.
+///The file holds a MappedGridHeader (dimensions, element size, layout and a
+///checksum of the cells) followed by the cells in Layout_Type's storage order.
+///
+///GetGrid() returns an ordinary const Grid viewing the mapping, so every
+///accessor, iterator and algorithm works unchanged. GetWritableGrid() hands out
+///the same Grid for writing on Shared and CopyOnWrite mappings. That Grid must
+///not outlive the MappedGrid, and resizing it moves its cells off the file into
+///memory.
+///
+///Failures of the OS calls throw std::system_error, files that do not match the
+///cell type or layout throw std::runtime_error.
+template<typename Data_Type, typename Layout_Type = RowMajorLayout, typename Dimension_Type = std::uint16_t>
+class MappedGrid
+{
+	static_assert(std::is_trivially_copyable<Data_Type>::value,
+		"Only trivially copyable cells can be stored in a file as raw bytes");
+
+public:
+	typedef Grid<Data_Type, Layout_Type, std::allocator<Data_Type>, Dimension_Type> grid_type;
+	typedef typename grid_type::value_type value_type;
+	typedef typename grid_type::dimension_type dimension_type;
+	typedef Layout_Type layout_type;
+
+	MappedGrid()
+		:grid(), mode(MappedGridMode::ReadOnly), mapping(nullptr), mappingSize(0)
+#if defined(_WIN32)
+		, file(INVALID_HANDLE_VALUE), fileMapping(nullptr)
+#endif
+	{
+
+	}
+
+	MappedGrid(const MappedGrid&) = delete;
+	MappedGrid& operator=(const MappedGrid&) = delete;
+
+	MappedGrid(MappedGrid&& source)
+		:MappedGrid()
+	{
+		Swap(source);
+	}
+
+	MappedGrid& operator=(MappedGrid&& source)
+	{
+		if (this != &source)
+		{
+			Close();
+			Swap(source);
+		}
+
+		return *this;
+	}
+
+	~MappedGrid()
+	{
+		Close();
+	}
+
+	///Creates (or truncates) path to hold a columns x rows grid of initVal and maps
+	///it SharedWritable
+	static MappedGrid Create(const std::string& path, dimension_type columns, dimension_type rows,
+		const value_type& initVal = value_type())
+	{
+		if (columns == 0 || rows == 0)
+			throw std::invalid_argument("Dimension cannot be 0");
+
+		layout_type layout;
+		layout.SetDimensions(columns, rows, sizeof(value_type));
+
+		MappedGrid mapped;
+		mapped.MapFile(path, MappedGridMode::SharedWritable, MappedGridHeader::data_offset +
+			std::uint64_t(layout.GetStorageSize()) * sizeof(value_type), true);
+
+		MappedGridHeader header = MakeHeader(columns, rows, layout.GetStorageSize());
+		std::memcpy(mapped.mapping, &header, sizeof(header));
+
+		mapped.AttachGrid(header);
+
+		for (value_type& cell : mapped.grid)
+			cell = initVal;
+
+		mapped.Flush();
+
+		return mapped;
+	}
+
+	///Writes grid to path in the mapped format, ready to be opened with Open
+	static void Write(const std::string& path, const grid_type& source)
+	{
+		if (source.isEmpty())
+			throw std::invalid_argument("Dimension cannot be 0");
+
+		MappedGrid mapped = Create(path, source.GetColumnCount(), source.GetRowCount());
+
+		//Same layout on both sides, so the cells keep their storage index. Padding
+		//slots were never written and are left as the zeroes of the new file.
+		if constexpr (layout_type::has_padding)
+		{
+			for (dimension_type row = 0; row < source.GetRowCount(); row++)
+			{
+				std::memcpy(&mapped.grid.GetCell(0, row), &source.GetCell(0, row),
+					std::size_t(source.GetColumnCount()) * sizeof(value_type));
+			}
+		}
+		else
+		{
+			std::memcpy(&mapped.grid.GetCell(0), &source.GetCell(0), source.GetStorageSize() * sizeof(value_type));
+		}
+
+		mapped.Flush();
+	}
+
+	///Maps an existing file. Only the header is checked unless verifyChecksum is
+	///set, which reads every cell once and so gives up the O(1) open.
+	static MappedGrid Open(const std::string& path, MappedGridMode openMode, bool verifyChecksum = false)
+	{
+		MappedGrid mapped;
+		mapped.MapFile(path, openMode, 0, false);
+
+		MappedGridHeader header;
+
+		if (mapped.mappingSize < sizeof(header))
+			throw std::runtime_error("MappedGrid file is too small: " + path);
+
+		std::memcpy(&header, mapped.mapping, sizeof(header));
+
+		mapped.CheckHeader(header, path);
+
+		if (verifyChecksum && header.checksum != MappedGridHeader::ComputeChecksum(
+			static_cast<const unsigned char*>(mapped.mapping) + header.dataOffset,
+			std::size_t(header.storageSize) * sizeof(value_type)))
+		{
+			throw std::runtime_error("MappedGrid checksum mismatch: " + path);
+		}
+
+		mapped.AttachGrid(header);
+
+		return mapped;
+	}
+
+	///The cells, read only whatever the mode the file was opened in
+	const grid_type& GetGrid() const
+	{
+		return this->grid;
+	}
+
+	///Throws std::logic_error on a ReadOnly mapping, whose pages cannot be written
+	grid_type& GetWritableGrid()
+	{
+		if (this->mode == MappedGridMode::ReadOnly)
+			throw std::logic_error("MappedGrid-GetWritableGrid The mapping is read only");
+
+		return this->grid;
+	}
+
+	inline MappedGridMode GetMode() const
+	{
+		return this->mode;
+	}
+
+	inline bool IsOpen() const
+	{
+		return this->mapping != nullptr;
+	}
+
+	///SharedWritable only. Updates the header checksum and writes the dirty pages
+	///back to the file before returning.
+	void Flush()
+	{
+		if (this->mode != MappedGridMode::SharedWritable || !this->mapping)
+			throw std::logic_error("MappedGrid-Flush Only shared writable mappings can be flushed");
+
+		MappedGridHeader header;
+		std::memcpy(&header, this->mapping, sizeof(header));
+
+		header.checksum = MappedGridHeader::ComputeChecksum(
+			static_cast<const unsigned char*>(this->mapping) + header.dataOffset,
+			std::size_t(header.storageSize) * sizeof(value_type));
+
+		std::memcpy(this->mapping, &header, sizeof(header));
+
+#if defined(_WIN32)
+		if (!FlushViewOfFile(this->mapping, 0) || !FlushFileBuffers(this->file))
+			throw std::system_error(int(GetLastError()), std::system_category(), "MappedGrid-Flush");
+#else
+		if (msync(this->mapping, this->mappingSize, MS_SYNC) != 0)
+			throw std::system_error(errno, std::system_category(), "MappedGrid-Flush");
+#endif
+	}
+
+	///Unmaps the file. Unflushed writes of a SharedWritable mapping still reach
+	///the file eventually, but the checksum is only updated by Flush.
+	void Close()
+	{
+		this->grid = grid_type();
+
+		if (this->mapping)
+		{
+#if defined(_WIN32)
+			UnmapViewOfFile(this->mapping);
+#else
+			munmap(this->mapping, this->mappingSize);
+#endif
+			this->mapping = nullptr;
+			this->mappingSize = 0;
+		}
+
+#if defined(_WIN32)
+		if (this->fileMapping)
+		{
+			CloseHandle(this->fileMapping);
+			this->fileMapping = nullptr;
+		}
+
+		if (this->file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(this->file);
+			this->file = INVALID_HANDLE_VALUE;
+		}
+#endif
+	}
+
+protected:
+	grid_type grid;
+	MappedGridMode mode;
+
+	void* mapping;
+	std::size_t mappingSize;
+
+#if defined(_WIN32)
+	HANDLE file;
+	HANDLE fileMapping;
+#endif
+
+	static MappedGridHeader MakeHeader(std::uint64_t columns, std::uint64_t rows, std::uint64_t storageSize)
+	{
+		MappedGridHeader header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, MappedGridHeader::Magic(), sizeof(header.magic));
+
+		header.version = MappedGridHeader::current_version;
+		header.headerSize = sizeof(MappedGridHeader);
+		header.columnCount = columns;
+		header.rowCount = rows;
+		header.elementSize = sizeof(value_type);
+		header.elementAlignment = alignof(value_type);
+		header.layoutCode = MappedGridLayoutCode<layout_type>::code;
+		header.layoutParameter = MappedGridLayoutCode<layout_type>::parameter;
+		header.storageSize = storageSize;
+		header.dataOffset = MappedGridHeader::data_offset;
+
+		return header;
+	}
+
+	void CheckHeader(const MappedGridHeader& header, const std::string& path) const
+	{
+		if (std::memcmp(header.magic, MappedGridHeader::Magic(), sizeof(header.magic)) != 0)
+			throw std::runtime_error("Not a MappedGrid file: " + path);
+
+		if (header.version != MappedGridHeader::current_version || header.headerSize != sizeof(MappedGridHeader))
+			throw std::runtime_error("Unsupported MappedGrid version: " + path);
+
+		if (header.elementSize != sizeof(value_type) || header.elementAlignment != alignof(value_type))
+			throw std::runtime_error("MappedGrid element type mismatch: " + path);
+
+		if (header.layoutCode != MappedGridLayoutCode<layout_type>::code ||
+			header.layoutParameter != MappedGridLayoutCode<layout_type>::parameter)
+			throw std::runtime_error("MappedGrid layout mismatch: " + path);
+
+		if (header.columnCount == 0 || header.rowCount == 0 ||
+			header.columnCount > std::numeric_limits<dimension_type>::max() ||
+			header.rowCount > std::numeric_limits<dimension_type>::max())
+			throw std::runtime_error("MappedGrid dimensions do not fit dimension_type: " + path);
+
+		layout_type layout;
+		layout.SetDimensions(std::size_t(header.columnCount), std::size_t(header.rowCount), sizeof(value_type));
+
+		//Both sides of the size test come from the file, so it is done by division
+		//and cannot wrap around
+		if (header.dataOffset != MappedGridHeader::data_offset || header.dataOffset > this->mappingSize ||
+			header.storageSize != layout.GetStorageSize() ||
+			header.storageSize > (this->mappingSize - header.dataOffset) / sizeof(value_type))
+			throw std::runtime_error("MappedGrid file is truncated or corrupt: " + path);
+	}
+
+	void AttachGrid(const MappedGridHeader& header)
+	{
+		value_type* cells = reinterpret_cast<value_type*>(static_cast<unsigned char*>(this->mapping) + header.dataOffset);
+
+		this->grid = grid_type(GridExternalStorage, cells,
+			dimension_type(header.columnCount), dimension_type(header.rowCount));
+	}
+
+	///Opens path in openMode and maps all of it. When creating, the file is
+	///truncated and sized to fileSize first.
+	void MapFile(const std::string& path, MappedGridMode openMode, std::uint64_t fileSize, bool create)
+	{
+		if (fileSize > std::numeric_limits<std::size_t>::max())
+			throw std::length_error("MappedGrid file does not fit the address space");
+
+		this->mode = openMode;
+		bool writable = openMode == MappedGridMode::SharedWritable;
+
+#if defined(_WIN32)
+		this->file = CreateFileA(path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+			FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, create ? CREATE_ALWAYS : OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (this->file == INVALID_HANDLE_VALUE)
+			throw std::system_error(int(GetLastError()), std::system_category(), "MappedGrid open " + path);
+
+		if (!create)
+		{
+			LARGE_INTEGER size;
+
+			if (!GetFileSizeEx(this->file, &size))
+				throw std::system_error(int(GetLastError()), std::system_category(), "MappedGrid size " + path);
+
+			fileSize = std::uint64_t(size.QuadPart);
+		}
+
+		DWORD protection = openMode == MappedGridMode::ReadOnly ? PAGE_READONLY :
+			openMode == MappedGridMode::CopyOnWrite ? PAGE_WRITECOPY : PAGE_READWRITE;
+		DWORD access = openMode == MappedGridMode::ReadOnly ? FILE_MAP_READ :
+			openMode == MappedGridMode::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_WRITE;
+
+		//Creating the mapping with the full size also extends a new file to it
+		this->fileMapping = CreateFileMappingA(this->file, nullptr, protection,
+			DWORD(fileSize >> 32), DWORD(fileSize & 0xFFFFFFFFu), nullptr);
+
+		if (!this->fileMapping)
+			throw std::system_error(int(GetLastError()), std::system_category(), "MappedGrid map " + path);
+
+		this->mapping = MapViewOfFile(this->fileMapping, access, 0, 0, std::size_t(fileSize));
+
+		if (!this->mapping)
+			throw std::system_error(int(GetLastError()), std::system_category(), "MappedGrid map " + path);
+#else
+		int flags = writable ? O_RDWR : O_RDONLY;
+
+		if (create)
+			flags |= O_CREAT | O_TRUNC;
+
+		int descriptor = ::open(path.c_str(), flags, 0644);
+
+		if (descriptor < 0)
+			throw std::system_error(errno, std::system_category(), "MappedGrid open " + path);
+
+		//The mapping keeps the file referenced, the descriptor is not needed past this function
+		struct DescriptorCloser
+		{
+			int descriptor;
+
+			~DescriptorCloser()
+			{
+				::close(descriptor);
+			}
+		} closer{ descriptor };
+
+		if (create)
+		{
+			if (ftruncate(descriptor, off_t(fileSize)) != 0)
+				throw std::system_error(errno, std::system_category(), "MappedGrid size " + path);
+		}
+		else
+		{
+			struct stat status;
+
+			if (fstat(descriptor, &status) != 0)
+				throw std::system_error(errno, std::system_category(), "MappedGrid size " + path);
+
+			fileSize = std::uint64_t(status.st_size);
+		}
+
+		if (fileSize == 0)
+			throw std::runtime_error("MappedGrid file is empty: " + path);
+
+		int protection = openMode == MappedGridMode::ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+		int sharing = openMode == MappedGridMode::CopyOnWrite ? MAP_PRIVATE : MAP_SHARED;
+
+		void* address = mmap(nullptr, std::size_t(fileSize), protection, sharing, descriptor, 0);
+
+		if (address == MAP_FAILED)
+			throw std::system_error(errno, std::system_category(), "MappedGrid map " + path);
+
+		this->mapping = address;
+#endif
+
+		this->mappingSize = std::size_t(fileSize);
+	}
+
+	void Swap(MappedGrid& other)
+	{
+		std::swap(this->grid, other.grid);
+		std::swap(this->mode, other.mode);
+		std::swap(this->mapping, other.mapping);
+		std::swap(this->mappingSize, other.mappingSize);
+
+#if defined(_WIN32)
+		std::swap(this->file, other.file);
+		std::swap(this->fileMapping, other.fileMapping);
+#endif
+	}
+};
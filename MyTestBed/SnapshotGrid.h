@@ -0,0 +1,371 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Grid.h"
+
+template<typename Data_Type, std::size_t Chunk_Size, typename Allocator_Type>
+class SnapshotGrid;
+
+///Immutable view of a SnapshotGrid at the moment SnapshotGrid::Snapshot was
+///called. It shares the grid's chunks, so taking one copies no cells, and later
+///writes to the grid never show through. Snapshots are cheap to copy and safe
+///to read from any number of threads while the grid is being written.
+template<typename Data_Type, std::size_t Chunk_Size = 64, typename Allocator_Type = std::allocator<Data_Type>>
+class GridSnapshot
+{
+public:
+	typedef Data_Type value_type;
+	typedef const Data_Type& const_reference;
+	typedef std::uint32_t dimension_type;
+	typedef std::uint64_t size_type;
+
+	typedef Grid<Data_Type, RowMajorLayout, Allocator_Type> chunk_type;
+
+	static constexpr dimension_type chunk_size = dimension_type(Chunk_Size);
+
+	GridSnapshot()
+		:columnCount(0), rowCount(0), chunkColumnCount(0)
+	{
+
+	}
+
+	const_reference GetCell(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		if (columnIndex >= this->columnCount || rowIndex >= this->rowCount)
+			throw std::out_of_range("GridSnapshot-GetCell Arguments Out of Range");
+
+		const chunk_type& chunk = *this->chunks[std::size_t(rowIndex / chunk_size) * this->chunkColumnCount + columnIndex / chunk_size];
+
+		return chunk.GetCell(typename chunk_type::dimension_type(columnIndex % chunk_size),
+			typename chunk_type::dimension_type(rowIndex % chunk_size));
+	}
+
+	///The chunk at the given chunk coordinate. Its cell (0, 0) is at
+	///(chunkColumn * chunk_size, chunkRow * chunk_size); edge chunks hold cells
+	///past the grid's bounds, which mean nothing.
+	const chunk_type& GetChunk(dimension_type chunkColumn, dimension_type chunkRow) const
+	{
+		return *this->chunks[std::size_t(chunkRow) * this->chunkColumnCount + chunkColumn];
+	}
+
+	///Copies the cells into destination, resizing it to match
+	template<typename Layout_Type, typename Destination_Allocator, typename Dimension_Type, typename Access_Policy>
+	void CopyTo(Grid<Data_Type, Layout_Type, Destination_Allocator, Dimension_Type, Access_Policy>& destination) const
+	{
+		destination.ResizeGrid(Dimension_Type(this->columnCount), Dimension_Type(this->rowCount));
+
+		for (dimension_type row = 0; row < this->rowCount; row++)
+		{
+			for (dimension_type column = 0; column < this->columnCount; column++)
+				destination.GetCell(Dimension_Type(column), Dimension_Type(row)) = GetCell(column, row);
+		}
+	}
+
+	inline dimension_type GetColumnCount()const
+	{
+		return this->columnCount;
+	}
+
+	inline dimension_type GetRowCount()const
+	{
+		return this->rowCount;
+	}
+
+	inline std::size_t GetChunkCount()const
+	{
+		return this->chunks.size();
+	}
+
+	inline bool isEmpty()const
+	{
+		return !(this->rowCount > 0 && this->columnCount > 0);
+	}
+
+	inline size_type size()const
+	{
+		return size_type(this->columnCount) * this->rowCount;
+	}
+
+private:
+	friend class SnapshotGrid<Data_Type, Chunk_Size, Allocator_Type>;
+
+	dimension_type columnCount;
+	dimension_type rowCount;
+	std::size_t chunkColumnCount;
+
+	std::vector<std::shared_ptr<const chunk_type>> chunks;
+};
+
+///Grid kept as reference counted Chunk_Size x Chunk_Size chunks so it can hand
+///out snapshots without copying cells. Snapshot costs one pointer copy per
+///chunk; the first write to a chunk that a snapshot (or a copy of the grid)
+///still holds clones that one chunk, every other chunk stays shared. New grids
+///start with every chunk sharing a single one, so they only allocate what gets
+///written.
+///
+///The grid itself is written from one thread at a time. Snapshots may be read
+///and released on any thread meanwhile, the grid never writes a chunk another
+///owner can see.
+///
+///References returned by the non-const GetCell are only good until the next
+///Snapshot or copy of the grid, writing through them afterwards would change
+///the snapshot.
+template<typename Data_Type, std::size_t Chunk_Size = 64, typename Allocator_Type = std::allocator<Data_Type>>
+class SnapshotGrid
+{
+public:
+	typedef Data_Type value_type;
+	typedef Data_Type& reference;
+	typedef const Data_Type& const_reference;
+	typedef std::uint32_t dimension_type;
+	typedef std::uint64_t size_type;
+
+	typedef Allocator_Type allocator_type;
+	typedef Grid<Data_Type, RowMajorLayout, Allocator_Type> chunk_type;
+	typedef GridSnapshot<Data_Type, Chunk_Size, Allocator_Type> snapshot_type;
+
+	//Every chunk is a full Chunk_Size x Chunk_Size chunk_type, edge chunks included
+	static_assert(Chunk_Size > 0 && Chunk_Size <= std::numeric_limits<typename chunk_type::dimension_type>::max(),
+		"Chunk_Size is the column and row count of each chunk_type");
+
+	static constexpr dimension_type chunk_size = dimension_type(Chunk_Size);
+
+	SnapshotGrid()
+		:columnCount(0), rowCount(0), chunkColumnCount(0), chunkRowCount(0), allocator()
+	{
+
+	}
+
+	SnapshotGrid(dimension_type _columnCount, dimension_type _rowCount, const value_type& initVal = value_type(),
+		const allocator_type& _allocator = allocator_type())
+		:columnCount(0), rowCount(0), chunkColumnCount(0), chunkRowCount(0), allocator(_allocator)
+	{
+		ResizeGrid(_columnCount, _rowCount, initVal);
+	}
+
+	///Copies the cells of any Grid in, chunk by chunk
+	template<typename Layout_Type, typename Source_Allocator, typename Dimension_Type, typename Access_Policy>
+	explicit SnapshotGrid(const Grid<Data_Type, Layout_Type, Source_Allocator, Dimension_Type, Access_Policy>& source,
+		const allocator_type& _allocator = allocator_type())
+		:SnapshotGrid(dimension_type(source.GetColumnCount()), dimension_type(source.GetRowCount()), value_type(), _allocator)
+	{
+		for (dimension_type row = 0; row < this->rowCount; row++)
+		{
+			for (dimension_type column = 0; column < this->columnCount; column++)
+				GetCell(column, row) = source.GetCell(Dimension_Type(column), Dimension_Type(row));
+		}
+	}
+
+	///Copies share every chunk, both sides clone what they write afterwards
+	SnapshotGrid(const SnapshotGrid&) = default;
+	SnapshotGrid(SnapshotGrid&&) = default;
+	SnapshotGrid& operator=(const SnapshotGrid&) = default;
+	SnapshotGrid& operator=(SnapshotGrid&&) = default;
+
+	///An immutable view of the grid as it is now, O(chunks)
+	snapshot_type Snapshot() const
+	{
+		snapshot_type snapshot;
+
+		snapshot.columnCount = this->columnCount;
+		snapshot.rowCount = this->rowCount;
+		snapshot.chunkColumnCount = this->chunkColumnCount;
+		snapshot.chunks.assign(this->chunks.begin(), this->chunks.end());
+
+		return snapshot;
+	}
+
+	///Read access, never clones
+	const_reference GetCell(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		CheckBounds(columnIndex, rowIndex);
+
+		const chunk_type& chunk = *this->chunks[ChunkIndex(columnIndex, rowIndex)];
+
+		return chunk.GetCell(typename chunk_type::dimension_type(columnIndex % chunk_size),
+			typename chunk_type::dimension_type(rowIndex % chunk_size));
+	}
+
+	///Write access, clones the cell's chunk first if anything else still holds it
+	reference GetCell(dimension_type columnIndex, dimension_type rowIndex)
+	{
+		CheckBounds(columnIndex, rowIndex);
+
+		chunk_type& chunk = MakeChunkUnique(ChunkIndex(columnIndex, rowIndex));
+
+		return chunk.GetCell(typename chunk_type::dimension_type(columnIndex % chunk_size),
+			typename chunk_type::dimension_type(rowIndex % chunk_size));
+	}
+
+	void SetCell(dimension_type columnIndex, dimension_type rowIndex, const value_type& value)
+	{
+		GetCell(columnIndex, rowIndex) = value;
+	}
+
+	///Calls function(cell) for every cell, a chunk per task under policy. Every
+	///chunk is written, so every shared chunk gets cloned.
+	template<typename Policy_Type, typename Function_Type>
+	void ForEach(const Policy_Type& policy, Function_Type function)
+	{
+		GridExecution::ForEachBand(policy, this->chunks.size(), [&](std::size_t chunkIndex)
+		{
+			chunk_type& chunk = MakeChunkUnique(chunkIndex);
+
+			std::size_t columns = ChunkColumns(chunkIndex % this->chunkColumnCount);
+			std::size_t rows = ChunkRows(chunkIndex / this->chunkColumnCount);
+
+			for (std::size_t row = 0; row < rows; row++)
+			{
+				value_type* cells = &chunk.GetCell(0, typename chunk_type::dimension_type(row));
+
+				for (std::size_t column = 0; column < columns; column++)
+					function(cells[column]);
+			}
+		});
+	}
+
+	///Points every chunk at one new chunk holding value, whatever the policy.
+	///Nothing is cloned until the cells are written again.
+	template<typename Policy_Type>
+	void Fill(const Policy_Type& policy, const value_type& value)
+	{
+		static_assert(GridExecution::IsExecutionPolicy<Policy_Type>::value, "Expected a GridExecution policy");
+		(void)policy;
+
+		ShareOneChunk(value);
+	}
+
+	///Resets every cell to initVal with the new dimensions
+	void ResizeGrid(dimension_type newColumnCount, dimension_type newRowCount, const value_type& initVal = value_type())
+	{
+		if (newRowCount == 0 || newColumnCount == 0)
+			throw std::invalid_argument("Dimension cannot be 0");
+
+		this->columnCount = newColumnCount;
+		this->rowCount = newRowCount;
+		this->chunkColumnCount = (std::size_t(newColumnCount) + Chunk_Size - 1) / Chunk_Size;
+		this->chunkRowCount = (std::size_t(newRowCount) + Chunk_Size - 1) / Chunk_Size;
+
+		ShareOneChunk(initVal);
+	}
+
+	const chunk_type& GetChunk(dimension_type chunkColumn, dimension_type chunkRow) const
+	{
+		return *this->chunks[std::size_t(chunkRow) * this->chunkColumnCount + chunkColumn];
+	}
+
+	///Whether the chunk is still held by a snapshot, a copy of the grid or
+	///other chunks of this grid, so the next write to it clones
+	bool IsChunkShared(dimension_type chunkColumn, dimension_type chunkRow) const
+	{
+		return this->chunks[std::size_t(chunkRow) * this->chunkColumnCount + chunkColumn].use_count() > 1;
+	}
+
+	inline dimension_type GetColumnCount()const
+	{
+		return this->columnCount;
+	}
+
+	inline dimension_type GetRowCount()const
+	{
+		return this->rowCount;
+	}
+
+	inline std::size_t GetChunkColumnCount()const
+	{
+		return this->chunkColumnCount;
+	}
+
+	inline std::size_t GetChunkRowCount()const
+	{
+		return this->chunkRowCount;
+	}
+
+	inline allocator_type get_allocator() const
+	{
+		return this->allocator;
+	}
+
+	inline bool isEmpty()const
+	{
+		return !(this->rowCount > 0 && this->columnCount > 0);
+	}
+
+	inline size_type size()const
+	{
+		return size_type(this->columnCount) * this->rowCount;
+	}
+
+	inline void swap(SnapshotGrid& inGrid)
+	{
+		std::swap(*this, inGrid);
+	}
+
+protected:
+	dimension_type columnCount;
+	dimension_type rowCount;
+	std::size_t chunkColumnCount;
+	std::size_t chunkRowCount;
+
+	allocator_type allocator;
+
+	///Row major by chunk coordinate
+	std::vector<std::shared_ptr<chunk_type>> chunks;
+
+	inline void CheckBounds(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		if (columnIndex >= this->columnCount || rowIndex >= this->rowCount)
+			throw std::out_of_range("SnapshotGrid-GetCell Arguments Out of Range");
+	}
+
+	inline std::size_t ChunkIndex(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		return std::size_t(rowIndex / chunk_size) * this->chunkColumnCount + columnIndex / chunk_size;
+	}
+
+	///Cells of the chunk column or row that lie inside the grid
+	inline std::size_t ChunkColumns(std::size_t chunkColumn) const
+	{
+		return std::min<std::size_t>(Chunk_Size, this->columnCount - chunkColumn * Chunk_Size);
+	}
+
+	inline std::size_t ChunkRows(std::size_t chunkRow) const
+	{
+		return std::min<std::size_t>(Chunk_Size, this->rowCount - chunkRow * Chunk_Size);
+	}
+
+	void ShareOneChunk(const value_type& value)
+	{
+		std::shared_ptr<chunk_type> shared = std::make_shared<chunk_type>(
+			typename chunk_type::dimension_type(Chunk_Size), typename chunk_type::dimension_type(Chunk_Size),
+			value, this->allocator);
+
+		this->chunks.assign(this->chunkColumnCount * this->chunkRowCount, shared);
+	}
+
+	chunk_type& MakeChunkUnique(std::size_t chunkIndex)
+	{
+		std::shared_ptr<chunk_type>& chunk = this->chunks[chunkIndex];
+
+		if (chunk.use_count() != 1)
+		{
+			chunk = std::make_shared<chunk_type>(*chunk, this->allocator);
+		}
+		else
+		{
+			//The count is read relaxed; pairs with the release of the last other
+			//owner so its reads are done before the chunk is written
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+
+		return *chunk;
+	}
+};
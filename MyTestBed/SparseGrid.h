@@ -0,0 +1,505 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "Grid.h"
+
+///Grid for huge, mostly default valued worlds. The cells are split into
+///Chunk_Size x Chunk_Size chunks, each a dense Grid, kept in a hash map keyed by
+///chunk coordinate. A chunk is only created the first time one of its cells is
+///written; reading a cell of a missing chunk returns the shared default value.
+///
+///Non-const access (the non-const GetCell and indexer) counts as a write and
+///creates the chunk, use the const overloads or SetCell to avoid that.
+///Iteration only visits the cells of existing chunks, in no particular order.
+template<typename Data_Type, std::size_t Chunk_Size = 32, typename Chunk_Layout = RowMajorLayout,
+	typename Allocator_Type = std::allocator<Data_Type>>
+class SparseGrid
+{
+	static_assert(Chunk_Size > 0 && (Chunk_Size & (Chunk_Size - 1)) == 0,
+		"Chunk_Size must be a power of two");
+
+public:
+	typedef Data_Type value_type;
+	typedef Data_Type& reference;
+	typedef const Data_Type& const_reference;
+
+	///Worlds can be millions of cells per side, so the coordinates are wider than Grid's
+	typedef std::uint32_t dimension_type;
+	typedef std::uint64_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	typedef Allocator_Type allocator_type;
+	typedef Grid<Data_Type, Chunk_Layout, Allocator_Type> chunk_type;
+
+	static_assert(Chunk_Size <= std::numeric_limits<typename chunk_type::dimension_type>::max(),
+		"Chunk_Size must fit the chunk Grid's dimension_type");
+
+	static constexpr dimension_type chunk_size = dimension_type(Chunk_Size);
+
+private:
+	struct ChunkKeyHash
+	{
+		std::size_t operator()(std::uint64_t key) const
+		{
+			//Neighbouring chunks only differ in the low bits of each half, mix them through
+			key ^= key >> 33;
+			key *= 0xFF51AFD7ED558CCDull;
+			key ^= key >> 33;
+			return std::size_t(key);
+		}
+	};
+
+	typedef typename std::allocator_traits<Allocator_Type>::template
+		rebind_alloc<std::pair<const std::uint64_t, chunk_type>> chunk_map_allocator;
+
+	typedef std::unordered_map<std::uint64_t, chunk_type, ChunkKeyHash, std::equal_to<std::uint64_t>,
+		chunk_map_allocator> chunk_map;
+
+	static constexpr dimension_type chunk_shift = []
+	{
+		dimension_type shift = 0;
+
+		while ((std::size_t(1) << shift) < Chunk_Size)
+			shift++;
+
+		return shift;
+	}();
+
+	static constexpr dimension_type chunk_mask = chunk_size - 1;
+
+public:
+	///Forward iterator over the cells of the existing chunks, skipping the parts
+	///of edge chunks that lie outside the grid
+	template<typename Map_Iterator_Type, typename Iterator_Data_Type>
+	class ChunkCellIterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef typename std::remove_const<Iterator_Data_Type>::type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef Iterator_Data_Type* pointer;
+		typedef Iterator_Data_Type& reference;
+
+		ChunkCellIterator()
+			:chunk(), chunkEnd(), cell(0), columnCount(0), rowCount(0)
+		{
+
+		}
+
+		ChunkCellIterator(Map_Iterator_Type _chunk, Map_Iterator_Type _chunkEnd,
+			dimension_type _columnCount, dimension_type _rowCount)
+			:chunk(_chunk), chunkEnd(_chunkEnd), cell(0), columnCount(_columnCount), rowCount(_rowCount)
+		{
+			SkipOutsideCells();
+		}
+
+		///Lets a const_iterator be made from an iterator
+		template<typename Other_Map_Iterator_Type, typename Other_Data_Type>
+		ChunkCellIterator(const ChunkCellIterator<Other_Map_Iterator_Type, Other_Data_Type>& source)
+			:chunk(source.chunk), chunkEnd(source.chunkEnd), cell(source.cell),
+			columnCount(source.columnCount), rowCount(source.rowCount)
+		{
+
+		}
+
+		Iterator_Data_Type& operator*()const
+		{
+			return this->chunk->second.GetCell(this->chunk->second.GetOneDimensionIndex(
+				dimension_type(this->cell & chunk_mask), dimension_type(this->cell >> chunk_shift)));
+		}
+
+		Iterator_Data_Type* operator->()const
+		{
+			return &**this;
+		}
+
+		ChunkCellIterator& operator++()
+		{
+			this->cell++;
+			SkipOutsideCells();
+			return *this;
+		}
+
+		ChunkCellIterator operator++(int)
+		{
+			ChunkCellIterator previous(*this);
+			++*this;
+			return previous;
+		}
+
+		bool operator==(const ChunkCellIterator& rhs)const
+		{
+			return this->chunk == rhs.chunk && this->cell == rhs.cell;
+		}
+
+		bool operator!=(const ChunkCellIterator& rhs)const
+		{
+			return !(*this == rhs);
+		}
+
+		///Column of the current cell in the whole grid
+		dimension_type GetColumn()const
+		{
+			return dimension_type(ChunkColumn(this->chunk->first) * chunk_size + (this->cell & chunk_mask));
+		}
+
+		///Row of the current cell in the whole grid
+		dimension_type GetRow()const
+		{
+			return dimension_type(ChunkRow(this->chunk->first) * chunk_size + (this->cell >> chunk_shift));
+		}
+
+	protected:
+		template<typename, typename>
+		friend class ChunkCellIterator;
+
+		Map_Iterator_Type chunk;
+		Map_Iterator_Type chunkEnd;
+
+		///Row major position inside the current chunk
+		std::size_t cell;
+
+		dimension_type columnCount;
+		dimension_type rowCount;
+
+		///Moves on until the current cell lies inside the grid, or to the end
+		void SkipOutsideCells()
+		{
+			while (this->chunk != this->chunkEnd)
+			{
+				for (; this->cell < Chunk_Size * Chunk_Size; this->cell++)
+				{
+					if (GetColumn() < this->columnCount && GetRow() < this->rowCount)
+						return;
+				}
+
+				++this->chunk;
+				this->cell = 0;
+			}
+		}
+	};
+
+	typedef ChunkCellIterator<typename chunk_map::iterator, value_type> iterator;
+	typedef ChunkCellIterator<typename chunk_map::const_iterator, const value_type> const_iterator;
+
+	template <typename Grid_Type, typename Reference_Type>
+	class _Indexer
+	{
+		dimension_type columnIndex;
+		Grid_Type& data;
+
+	public:
+		_Indexer(dimension_type ColumnIndex, Grid_Type& Data)
+			: columnIndex(ColumnIndex), data(Data)
+		{
+
+		}
+
+		Reference_Type operator[](dimension_type RowIndex) const
+		{
+			return data.GetCell(columnIndex, RowIndex);
+		}
+	};
+
+	typedef _Indexer<SparseGrid, reference> indexer;
+	typedef _Indexer<const SparseGrid, const_reference> const_indexer;
+
+	SparseGrid()
+		:columnCount(0), rowCount(0), defaultValue(), allocator(), chunks(chunk_map_allocator(allocator))
+	{
+
+	}
+
+	SparseGrid(dimension_type _columnCount, dimension_type _rowCount, value_type _defaultValue = value_type(),
+		const allocator_type& _allocator = allocator_type())
+		:columnCount(_columnCount), rowCount(_rowCount), defaultValue(std::move(_defaultValue)),
+		allocator(_allocator), chunks(chunk_map_allocator(_allocator))
+	{
+		if (this->rowCount == 0 || this->columnCount == 0)
+			throw std::invalid_argument("Dimension cannot be 0");
+	}
+
+	const_indexer operator [](dimension_type index)const
+	{
+		return const_indexer(index, *this);
+	}
+
+	indexer operator [](dimension_type index)
+	{
+		return indexer(index, *this);
+	}
+
+	inline iterator begin()
+	{
+		return iterator(this->chunks.begin(), this->chunks.end(), this->columnCount, this->rowCount);
+	}
+
+	inline const_iterator begin() const
+	{
+		return cbegin();
+	}
+
+	inline const_iterator cbegin() const
+	{
+		return const_iterator(this->chunks.cbegin(), this->chunks.cend(), this->columnCount, this->rowCount);
+	}
+
+	inline iterator end()
+	{
+		return iterator(this->chunks.end(), this->chunks.end(), this->columnCount, this->rowCount);
+	}
+
+	inline const_iterator end() const
+	{
+		return cend();
+	}
+
+	inline const_iterator cend() const
+	{
+		return const_iterator(this->chunks.cend(), this->chunks.cend(), this->columnCount, this->rowCount);
+	}
+
+	///Write access, creates the chunk holding the cell if needed
+	reference GetCell(dimension_type columnIndex, dimension_type rowIndex)
+	{
+		CheckBounds(columnIndex, rowIndex);
+
+		chunk_type& chunk = MaterializeChunk(columnIndex >> chunk_shift, rowIndex >> chunk_shift);
+
+		return chunk.GetCell(chunk.GetOneDimensionIndex(
+			typename chunk_type::dimension_type(columnIndex & chunk_mask),
+			typename chunk_type::dimension_type(rowIndex & chunk_mask)));
+	}
+
+	///Read access, the shared default value when the chunk does not exist
+	const_reference GetCell(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		CheckBounds(columnIndex, rowIndex);
+
+		const chunk_type* chunk = FindChunk(columnIndex >> chunk_shift, rowIndex >> chunk_shift);
+
+		if (!chunk)
+			return this->defaultValue;
+
+		return chunk->GetCell(chunk->GetOneDimensionIndex(
+			typename chunk_type::dimension_type(columnIndex & chunk_mask),
+			typename chunk_type::dimension_type(rowIndex & chunk_mask)));
+	}
+
+	///Writing the default value into a missing chunk leaves it missing
+	void SetCell(dimension_type columnIndex, dimension_type rowIndex, const value_type& value)
+	{
+		CheckBounds(columnIndex, rowIndex);
+
+		if (value == this->defaultValue && !FindChunk(columnIndex >> chunk_shift, rowIndex >> chunk_shift))
+			return;
+
+		GetCell(columnIndex, rowIndex) = value;
+	}
+
+	///The chunk at the given chunk coordinate, nullptr if it does not exist
+	const chunk_type* FindChunk(dimension_type chunkColumn, dimension_type chunkRow) const
+	{
+		auto found = this->chunks.find(MakeChunkKey(chunkColumn, chunkRow));
+		return found == this->chunks.end() ? nullptr : &found->second;
+	}
+
+	chunk_type* FindChunk(dimension_type chunkColumn, dimension_type chunkRow)
+	{
+		auto found = this->chunks.find(MakeChunkKey(chunkColumn, chunkRow));
+		return found == this->chunks.end() ? nullptr : &found->second;
+	}
+
+	///Calls function(chunkColumn, chunkRow, chunk) for every existing chunk. The
+	///chunk's cell (0, 0) is at (chunkColumn * chunk_size, chunkRow * chunk_size).
+	template<typename Function>
+	void ForEachChunk(Function function)
+	{
+		for (auto& entry : this->chunks)
+			function(ChunkColumn(entry.first), ChunkRow(entry.first), entry.second);
+	}
+
+	template<typename Function>
+	void ForEachChunk(Function function) const
+	{
+		for (const auto& entry : this->chunks)
+			function(ChunkColumn(entry.first), ChunkRow(entry.first), entry.second);
+	}
+
+	///Drops a chunk, its cells read as the default value again
+	bool EraseChunk(dimension_type chunkColumn, dimension_type chunkRow)
+	{
+		return this->chunks.erase(MakeChunkKey(chunkColumn, chunkRow)) > 0;
+	}
+
+	///Drops every chunk whose cells all hold the default value. Returns how many went.
+	std::size_t ReleaseDefaultChunks()
+	{
+		std::size_t released = 0;
+
+		for (auto entry = this->chunks.begin(); entry != this->chunks.end();)
+		{
+			bool allDefault = true;
+
+			for (const value_type& cell : entry->second)
+			{
+				if (!(cell == this->defaultValue))
+				{
+					allDefault = false;
+					break;
+				}
+			}
+
+			if (allDefault)
+			{
+				entry = this->chunks.erase(entry);
+				released++;
+			}
+			else
+			{
+				++entry;
+			}
+		}
+
+		return released;
+	}
+
+	///Drops every chunk, all cells read as the default value again
+	void clear()
+	{
+		this->chunks.clear();
+	}
+
+	///Changes the bounds. Chunks that end up wholly outside are dropped and cells
+	///outside the new bounds in the edge chunks are reset to the default value, so
+	///growing back later shows default cells.
+	void ResizeGrid(dimension_type newColumnCount, dimension_type newRowCount)
+	{
+		if (newRowCount == 0 || newColumnCount == 0)
+			throw std::invalid_argument("Dimension cannot be 0");
+
+		for (auto entry = this->chunks.begin(); entry != this->chunks.end();)
+		{
+			std::uint64_t firstColumn = std::uint64_t(ChunkColumn(entry->first)) * chunk_size;
+			std::uint64_t firstRow = std::uint64_t(ChunkRow(entry->first)) * chunk_size;
+
+			if (firstColumn >= newColumnCount || firstRow >= newRowCount)
+			{
+				entry = this->chunks.erase(entry);
+				continue;
+			}
+
+			if (firstColumn + chunk_size > newColumnCount || firstRow + chunk_size > newRowCount)
+			{
+				for (dimension_type row = 0; row < chunk_size; row++)
+				{
+					for (dimension_type column = 0; column < chunk_size; column++)
+					{
+						if (firstColumn + column >= newColumnCount || firstRow + row >= newRowCount)
+							entry->second.GetCell(entry->second.GetOneDimensionIndex(
+								typename chunk_type::dimension_type(column),
+								typename chunk_type::dimension_type(row))) = this->defaultValue;
+					}
+				}
+			}
+
+			++entry;
+		}
+
+		this->columnCount = newColumnCount;
+		this->rowCount = newRowCount;
+	}
+
+	inline dimension_type GetColumnCount()const
+	{
+		return this->columnCount;
+	}
+
+	inline dimension_type GetRowCount()const
+	{
+		return this->rowCount;
+	}
+
+	inline const_reference GetDefaultValue()const
+	{
+		return this->defaultValue;
+	}
+
+	///Number of chunks that have been written to
+	inline std::size_t GetChunkCount()const
+	{
+		return this->chunks.size();
+	}
+
+	inline allocator_type get_allocator() const
+	{
+		return this->allocator;
+	}
+
+	inline bool isEmpty()const
+	{
+		return !(this->rowCount > 0 && this->columnCount > 0);
+	}
+
+	///Logical number of cells, populated or not
+	inline size_type size()const
+	{
+		return size_type(this->columnCount) * this->rowCount;
+	}
+
+	inline void swap(SparseGrid& inGrid)
+	{
+		std::swap(*this, inGrid);
+	}
+
+protected:
+	dimension_type columnCount;
+	dimension_type rowCount;
+
+	///Returned for every cell of a missing chunk and copied into new chunks
+	value_type defaultValue;
+
+	allocator_type allocator;
+
+	chunk_map chunks;
+
+	static inline std::uint64_t MakeChunkKey(dimension_type chunkColumn, dimension_type chunkRow)
+	{
+		return (std::uint64_t(chunkColumn) << 32) | chunkRow;
+	}
+
+	static inline dimension_type ChunkColumn(std::uint64_t key)
+	{
+		return dimension_type(key >> 32);
+	}
+
+	static inline dimension_type ChunkRow(std::uint64_t key)
+	{
+		return dimension_type(key & 0xFFFFFFFFu);
+	}
+
+	inline void CheckBounds(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		if (columnIndex >= this->columnCount || rowIndex >= this->rowCount)
+			throw std::out_of_range("SparseGrid-GetCell Arguments Out of Range");
+	}
+
+	chunk_type& MaterializeChunk(dimension_type chunkColumn, dimension_type chunkRow)
+	{
+		std::uint64_t key = MakeChunkKey(chunkColumn, chunkRow);
+		auto found = this->chunks.find(key);
+
+		if (found != this->chunks.end())
+			return found->second;
+
+		return this->chunks.emplace(key, chunk_type(chunk_size, chunk_size, this->defaultValue, this->allocator)).first->second;
+	}
+};
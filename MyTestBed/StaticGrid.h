@@ -0,0 +1,278 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Grid.h"
+
+///Grid with its dimensions fixed at compile time and its cells stored inline,
+///row after row, for small fixed grids such as boards, chunks and kernel masks.
+///It never allocates, every index is folded by the compiler when the coordinates
+///are constants, and it can be built and read in constant expressions:
+///
+///	constexpr StaticGrid<int, 3, 3> kernel{ 1, 2, 1, 2, 4, 2, 1, 2, 1 };
+///	static_assert(kernel.GetCell<1, 1>() == 4, "");
+///
+///The surface follows Grid: GetCell, grid[column][row], iterators over the cells
+///in storage order. ToGrid / FromGrid copy to and from a dynamic Grid, AsGrid
+///views the cells through a Grid without copying.
+template<typename Data_Type, std::size_t Columns, std::size_t Rows>
+class StaticGrid
+{
+	static_assert(Columns > 0 && Rows > 0, "Dimension cannot be 0");
+
+public:
+	typedef Data_Type value_type;
+	typedef Data_Type& reference;
+	typedef const Data_Type& const_reference;
+
+	typedef std::size_t dimension_type;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	///Contiguous storage, plain pointers are enough
+	typedef Data_Type* iterator;
+	typedef const Data_Type* const_iterator;
+
+	static constexpr dimension_type column_count = Columns;
+	static constexpr dimension_type row_count = Rows;
+
+	template <typename Grid_Type, typename Reference_Type>
+	class _Indexer
+	{
+		dimension_type columnIndex;
+		Grid_Type& data;
+
+	public:
+		constexpr _Indexer(dimension_type ColumnIndex, Grid_Type& Data)
+			: columnIndex(ColumnIndex), data(Data)
+		{
+
+		}
+
+		constexpr Reference_Type operator[](dimension_type RowIndex) const
+		{
+			CheckBounds(columnIndex, RowIndex);
+			return data.cells[GetOneDimensionIndex(columnIndex, RowIndex)];
+		}
+	};
+
+	typedef _Indexer<StaticGrid, reference> indexer;
+	typedef _Indexer<const StaticGrid, const_reference> const_indexer;
+
+	///Every cell value initialised
+	constexpr StaticGrid()
+		:cells()
+	{
+
+	}
+
+	///Every cell set to initVal, StaticGrid<int, 8, 8>{ 5 } included
+	constexpr explicit StaticGrid(const value_type& initVal)
+		:cells()
+	{
+		for (std::size_t index = 0; index < Columns * Rows; index++)
+			this->cells[index] = initVal;
+	}
+
+	///The cells in row major order; missing trailing cells are value initialised
+	template<typename... Value_Types, typename = typename std::enable_if<(sizeof...(Value_Types) > 1)>::type>
+	constexpr StaticGrid(const Value_Types&... values)
+		:cells{ value_type(values)... }
+	{
+		static_assert(sizeof...(Value_Types) <= Columns * Rows, "More values than cells");
+	}
+
+	constexpr const_indexer operator [](dimension_type index)const
+	{
+		return const_indexer(index, *this);
+	}
+
+	constexpr indexer operator [](dimension_type index)
+	{
+		return indexer(index, *this);
+	}
+
+	constexpr iterator begin()
+	{
+		return this->cells;
+	}
+
+	constexpr const_iterator begin() const
+	{
+		return this->cells;
+	}
+
+	constexpr const_iterator cbegin() const
+	{
+		return this->cells;
+	}
+
+	constexpr iterator end()
+	{
+		return this->cells + Columns * Rows;
+	}
+
+	constexpr const_iterator end() const
+	{
+		return this->cells + Columns * Rows;
+	}
+
+	constexpr const_iterator cend() const
+	{
+		return this->cells + Columns * Rows;
+	}
+
+	constexpr reference GetCell(dimension_type columnIndex, dimension_type rowIndex)
+	{
+		CheckBounds(columnIndex, rowIndex);
+		return this->cells[GetOneDimensionIndex(columnIndex, rowIndex)];
+	}
+
+	constexpr const_reference GetCell(dimension_type columnIndex, dimension_type rowIndex) const
+	{
+		CheckBounds(columnIndex, rowIndex);
+		return this->cells[GetOneDimensionIndex(columnIndex, rowIndex)];
+	}
+
+	///Coordinates checked at compile time
+	template<dimension_type Column, dimension_type Row>
+	constexpr reference GetCell()
+	{
+		static_assert(Column < Columns && Row < Rows, "StaticGrid-GetCell Arguments Out of Range");
+		return this->cells[Column + Row * Columns];
+	}
+
+	template<dimension_type Column, dimension_type Row>
+	constexpr const_reference GetCell() const
+	{
+		static_assert(Column < Columns && Row < Rows, "StaticGrid-GetCell Arguments Out of Range");
+		return this->cells[Column + Row * Columns];
+	}
+
+	///The cell at a storage index, as Grid::GetCell(size_t)
+	constexpr reference GetCell(std::size_t index)
+	{
+		return this->cells[index];
+	}
+
+	constexpr const_reference GetCell(std::size_t index) const
+	{
+		return this->cells[index];
+	}
+
+	static constexpr std::size_t GetOneDimensionIndex(dimension_type ColumnIndex, dimension_type RowIndex)
+	{
+		return ColumnIndex + RowIndex * Columns;
+	}
+
+	constexpr void Fill(const value_type& value)
+	{
+		for (std::size_t index = 0; index < Columns * Rows; index++)
+			this->cells[index] = value;
+	}
+
+	constexpr value_type* data()
+	{
+		return this->cells;
+	}
+
+	constexpr const value_type* data() const
+	{
+		return this->cells;
+	}
+
+	static constexpr dimension_type GetColumnCount()
+	{
+		return Columns;
+	}
+
+	static constexpr dimension_type GetRowCount()
+	{
+		return Rows;
+	}
+
+	static constexpr bool isEmpty()
+	{
+		return false;
+	}
+
+	static constexpr size_type size()
+	{
+		return Columns * Rows;
+	}
+
+	///Copies the cells into a dynamic Grid of any layout
+	template<typename Grid_Type = Grid<Data_Type>>
+	Grid_Type ToGrid() const
+	{
+		typedef typename Grid_Type::dimension_type grid_dimension;
+		Grid_Type grid{ grid_dimension(Columns), grid_dimension(Rows) };
+
+		for (std::size_t row = 0; row < Rows; row++)
+		{
+			for (std::size_t column = 0; column < Columns; column++)
+			{
+				grid.GetCell(grid.GetOneDimensionIndex(grid_dimension(column), grid_dimension(row))) =
+					this->cells[column + row * Columns];
+			}
+		}
+
+		return grid;
+	}
+
+	///Copies a dynamic Grid of matching dimensions in
+	template<typename Grid_Type>
+	static StaticGrid FromGrid(const Grid_Type& grid)
+	{
+		if (std::size_t(grid.GetColumnCount()) != Columns || std::size_t(grid.GetRowCount()) != Rows)
+			throw std::invalid_argument("FromGrid dimensions differ");
+
+		StaticGrid result;
+
+		for (std::size_t row = 0; row < Rows; row++)
+		{
+			for (std::size_t column = 0; column < Columns; column++)
+				result.cells[column + row * Columns] = grid.GetCell(typename Grid_Type::dimension_type(column),
+					typename Grid_Type::dimension_type(row));
+		}
+
+		return result;
+	}
+
+	///A row major Grid over these cells, nothing copied. The view must not
+	///outlive this StaticGrid; resizing it moves it into storage of its own.
+	Grid<Data_Type> AsGrid()
+	{
+		static_assert(Columns <= 0xFFFF && Rows <= 0xFFFF, "Too large for Grid's 16 bit dimensions");
+
+		return Grid<Data_Type>(GridExternalStorage, this->cells,
+			typename Grid<Data_Type>::dimension_type(Columns), typename Grid<Data_Type>::dimension_type(Rows));
+	}
+
+	friend constexpr bool operator==(const StaticGrid& left, const StaticGrid& right)
+	{
+		for (std::size_t index = 0; index < Columns * Rows; index++)
+		{
+			if (!(left.cells[index] == right.cells[index]))
+				return false;
+		}
+
+		return true;
+	}
+
+	friend constexpr bool operator!=(const StaticGrid& left, const StaticGrid& right)
+	{
+		return !(left == right);
+	}
+
+private:
+	value_type cells[Columns * Rows];
+
+	static constexpr void CheckBounds(dimension_type columnIndex, dimension_type rowIndex)
+	{
+		if (columnIndex >= Columns || rowIndex >= Rows)
+			throw std::out_of_range("StaticGrid-GetCell Arguments Out of Range");
+	}
+};
@@ -0,0 +1,284 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Grid.h"
+
+///Type SummedAreaTable sums Data_Type cells in: 64 bit integers for integral
+///cells, so a table over any 16 bit grid of 32 bit values cannot overflow, and
+///at least double for floating point cells
+template<typename Data_Type, typename = void>
+struct SummedAreaAccumulator
+{
+	typedef Data_Type type;
+};
+
+template<typename Data_Type>
+struct SummedAreaAccumulator<Data_Type, typename std::enable_if<std::is_integral<Data_Type>::value>::type>
+{
+	typedef typename std::conditional<std::is_signed<Data_Type>::value, std::int64_t, std::uint64_t>::type type;
+};
+
+template<typename Data_Type>
+struct SummedAreaAccumulator<Data_Type, typename std::enable_if<std::is_floating_point<Data_Type>::value>::type>
+{
+	typedef typename std::conditional<(sizeof(Data_Type) > sizeof(double)), Data_Type, double>::type type;
+};
+
+///Answers sum, count and mean over any rectangle of a grid in O(1). Entry
+///(column, row) holds the sum of every cell above and to the left of it, with
+///an extra row and column of zeros in front so queries need no edge cases.
+///
+///Built in two passes that both split over threads: each source row added to
+///the table row above it, then prefix sums along each row. The first pass reads
+///whole source rows straight from memory when the source has contiguous rows and
+///vectorises; only the running sums of the second are serial. Values are taken
+///through a transform, so the same table can count cells matching a predicate.
+template<typename Data_Type, typename Accumulator_Type = typename SummedAreaAccumulator<Data_Type>::type,
+	typename Allocator_Type = std::allocator<Accumulator_Type>>
+class SummedAreaTable
+{
+public:
+	typedef Data_Type value_type;
+	typedef Accumulator_Type accumulator_type;
+	typedef std::uint32_t dimension_type;
+	typedef Grid<Accumulator_Type, RowMajorLayout, Allocator_Type, std::uint32_t> table_type;
+
+	///Columns summed per task in the first pass
+	static constexpr std::size_t column_strip = 1024;
+
+	explicit SummedAreaTable(const Allocator_Type& allocator = Allocator_Type())
+		:columnCount(0), rowCount(0), table(allocator)
+	{
+
+	}
+
+	template<typename Source_Grid>
+	explicit SummedAreaTable(const Source_Grid& source, const Allocator_Type& allocator = Allocator_Type())
+		:SummedAreaTable(allocator)
+	{
+		Build(GridExecution::seq, source);
+	}
+
+	template<typename Policy_Type, typename Source_Grid>
+	SummedAreaTable(const Policy_Type& policy, const Source_Grid& source, const Allocator_Type& allocator = Allocator_Type())
+		:SummedAreaTable(allocator)
+	{
+		Build(policy, source);
+	}
+
+	template<typename Policy_Type, typename Source_Grid>
+	void Build(const Policy_Type& policy, const Source_Grid& source)
+	{
+		Build(policy, source, [](const typename Source_Grid::value_type& cell) { return accumulator_type(cell); });
+	}
+
+	///Rebuilds the table over transform(cell) of every cell of source
+	template<typename Policy_Type, typename Source_Grid, typename Transform_Function>
+	void Build(const Policy_Type& policy, const Source_Grid& source, Transform_Function transform)
+	{
+		if (std::uint64_t(source.GetColumnCount()) >= std::numeric_limits<dimension_type>::max() ||
+			std::uint64_t(source.GetRowCount()) >= std::numeric_limits<dimension_type>::max())
+			throw std::length_error("Grid too large for a SummedAreaTable");
+
+		this->columnCount = dimension_type(source.GetColumnCount());
+		this->rowCount = dimension_type(source.GetRowCount());
+
+		if (source.isEmpty())
+		{
+			this->table = table_type(this->table.get_allocator());
+			return;
+		}
+
+		this->table.ResizeGrid(this->columnCount + 1, this->rowCount + 1, accumulator_type());
+
+		//Down each strip of columns first: every entry becomes its cell plus the
+		//entry above, a whole source row at a time, which vectorises across the strip
+		GridExecution::ForEachBand(policy, (std::size_t(this->columnCount) + column_strip - 1) / column_strip, [&](std::size_t strip)
+		{
+			std::size_t firstColumn = strip * column_strip;
+			std::size_t lastColumn = std::min<std::size_t>(firstColumn + column_strip, this->columnCount);
+
+			for (std::size_t row = 0; row < this->rowCount; row++)
+			{
+				const accumulator_type* above = GetTableRow(row) + 1;
+				accumulator_type* target = GetTableRow(row + 1) + 1;
+
+				if constexpr (HasContiguousRows<Source_Grid>::value)
+				{
+					const auto* cells = source.GetRow(typename Source_Grid::dimension_type(row)).begin();
+
+					for (std::size_t column = firstColumn; column < lastColumn; column++)
+						target[column] = above[column] + transform(cells[column]);
+				}
+				else
+				{
+					for (std::size_t column = firstColumn; column < lastColumn; column++)
+						target[column] = above[column] + transform(GetSourceCell(source, column, row));
+				}
+			}
+		});
+
+		//Then the running sum along each row, the only serial part, rows are independent
+		std::size_t rowsPerBand = std::max<std::size_t>(1,
+			GridExecution::band_bytes / ((std::size_t(this->columnCount) + 1) * sizeof(accumulator_type)));
+
+		GridExecution::ForEachBand(policy, (std::size_t(this->rowCount) + rowsPerBand - 1) / rowsPerBand, [&](std::size_t band)
+		{
+			std::size_t lastRow = std::min<std::size_t>((band + 1) * rowsPerBand, this->rowCount);
+
+			for (std::size_t row = band * rowsPerBand; row < lastRow; row++)
+			{
+				accumulator_type* target = GetTableRow(row + 1) + 1;
+				accumulator_type running = accumulator_type();
+
+				for (std::size_t column = 0; column < this->columnCount; column++)
+				{
+					running += target[column];
+					target[column] = running;
+				}
+			}
+		});
+	}
+
+	template<typename Source_Grid>
+	void Update(const Source_Grid& source, dimension_type firstColumn, dimension_type firstRow,
+		dimension_type lastColumn, dimension_type lastRow)
+	{
+		Update(source, firstColumn, firstRow, lastColumn, lastRow,
+			[](const typename Source_Grid::value_type& cell) { return accumulator_type(cell); });
+	}
+
+	///Brings the table up to date after the cells of source inside the inclusive
+	///rectangle changed. Only entries below and right of its first corner are
+	///rewritten, which is far cheaper than Build for changes near the bottom right.
+	///transform must be the one the table was built with. Floating point sums may
+	///round differently from a fresh Build in the last bits.
+	template<typename Source_Grid, typename Transform_Function>
+	void Update(const Source_Grid& source, dimension_type firstColumn, dimension_type firstRow,
+		dimension_type lastColumn, dimension_type lastRow, Transform_Function transform)
+	{
+		CheckRectangle(firstColumn, firstRow, lastColumn, lastRow);
+
+		if (std::uint64_t(source.GetColumnCount()) != this->columnCount ||
+			std::uint64_t(source.GetRowCount()) != this->rowCount)
+			throw std::invalid_argument("SummedAreaTable source dimensions differ");
+
+		for (std::size_t row = firstRow; row < this->rowCount; row++)
+		{
+			const accumulator_type* above = GetTableRow(row);
+			accumulator_type* target = GetTableRow(row + 1);
+
+			//Sum of this row's cells left of firstColumn, which did not change
+			accumulator_type running = target[firstColumn] - above[firstColumn];
+
+			for (std::size_t column = firstColumn; column < this->columnCount; column++)
+			{
+				running += transform(GetSourceCell(source, column, row));
+				target[column + 1] = above[column + 1] + running;
+			}
+		}
+	}
+
+	///Sum over the inclusive rectangle
+	accumulator_type Sum(dimension_type firstColumn, dimension_type firstRow,
+		dimension_type lastColumn, dimension_type lastRow) const
+	{
+		CheckRectangle(firstColumn, firstRow, lastColumn, lastRow);
+
+		const accumulator_type* top = GetTableRow(firstRow);
+		const accumulator_type* bottom = GetTableRow(std::size_t(lastRow) + 1);
+
+		return bottom[std::size_t(lastColumn) + 1] - bottom[firstColumn] - top[std::size_t(lastColumn) + 1] + top[firstColumn];
+	}
+
+	///Number of cells in the inclusive rectangle
+	std::uint64_t Count(dimension_type firstColumn, dimension_type firstRow,
+		dimension_type lastColumn, dimension_type lastRow) const
+	{
+		CheckRectangle(firstColumn, firstRow, lastColumn, lastRow);
+
+		return std::uint64_t(lastColumn - firstColumn + 1) * (lastRow - firstRow + 1);
+	}
+
+	double Mean(dimension_type firstColumn, dimension_type firstRow,
+		dimension_type lastColumn, dimension_type lastRow) const
+	{
+		return double(Sum(firstColumn, firstRow, lastColumn, lastRow)) /
+			double(Count(firstColumn, firstRow, lastColumn, lastRow));
+	}
+
+	///Sum of every cell
+	accumulator_type Total() const
+	{
+		if (this->table.isEmpty())
+			return accumulator_type();
+
+		return GetTableRow(this->rowCount)[this->columnCount];
+	}
+
+	inline dimension_type GetColumnCount() const
+	{
+		return this->columnCount;
+	}
+
+	inline dimension_type GetRowCount() const
+	{
+		return this->rowCount;
+	}
+
+	///The prefix sums including the leading row and column of zeros
+	inline const table_type& GetTable() const
+	{
+		return this->table;
+	}
+
+private:
+	///Sources whose rows GetRow hands out as one pointer range
+	template<typename Source_Grid, typename = void>
+	struct HasContiguousRows : std::false_type
+	{
+	};
+
+	template<typename Source_Grid>
+	struct HasContiguousRows<Source_Grid, std::void_t<decltype(Source_Grid::layout_type::contiguous_rows)>>
+		: std::bool_constant<Source_Grid::layout_type::contiguous_rows>
+	{
+	};
+
+	dimension_type columnCount;
+	dimension_type rowCount;
+	table_type table;
+
+	inline accumulator_type* GetTableRow(std::size_t row)
+	{
+		return &this->table.GetCell(row * (std::size_t(this->columnCount) + 1));
+	}
+
+	inline const accumulator_type* GetTableRow(std::size_t row) const
+	{
+		return &this->table.GetCell(row * (std::size_t(this->columnCount) + 1));
+	}
+
+	template<typename Source_Grid>
+	static inline const typename Source_Grid::value_type& GetSourceCell(const Source_Grid& source,
+		std::size_t column, std::size_t row)
+	{
+		return source.GetCell(typename Source_Grid::dimension_type(column), typename Source_Grid::dimension_type(row));
+	}
+
+	void CheckRectangle(dimension_type firstColumn, dimension_type firstRow,
+		dimension_type lastColumn, dimension_type lastRow) const
+	{
+		if (lastColumn >= this->columnCount || lastRow >= this->rowCount)
+			throw std::out_of_range("SummedAreaTable rectangle outside the grid");
+
+		if (firstColumn > lastColumn || firstRow > lastRow)
+			throw std::invalid_argument("SummedAreaTable rectangle corners out of order");
+	}
+};
@@ -0,0 +1,323 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Grid.h"
+
+///A rectangle of cells, as handed out by TrackedGrid::ConsumeDirty. TrackedGrid
+///only wraps grids whose dimension_type fits these fields.
+struct GridDirtyRect
+{
+	std::uint32_t column;
+	std::uint32_t row;
+	std::uint32_t columnCount;
+	std::uint32_t rowCount;
+
+	friend bool operator==(const GridDirtyRect& left, const GridDirtyRect& right)
+	{
+		return left.column == right.column && left.row == right.row &&
+			left.columnCount == right.columnCount && left.rowCount == right.rowCount;
+	}
+};
+
+///Wraps a Grid so that every write goes through it and is recorded. Written
+///cells mark their Tile_Size x Tile_Size tile in a bitmask; ConsumeDirty hands
+///back the marked tiles merged into rectangles and clears the marks, so a
+///renderer or a derived grid only redoes the parts that changed.
+///
+///Reads are free. Only the const grid is exposed, writes go through SetCell,
+///Modify, ModifyRegion and the bulk operations. Marking is not synchronised,
+///write from one thread or use the bulk operations.
+template<typename Grid_Type, std::size_t Tile_Size = 32>
+class TrackedGrid
+{
+	static_assert(Tile_Size > 0, "Tile_Size cannot be 0");
+
+public:
+	typedef Grid_Type grid_type;
+	typedef typename Grid_Type::value_type value_type;
+	typedef typename Grid_Type::reference reference;
+	typedef typename Grid_Type::const_reference const_reference;
+	typedef typename Grid_Type::dimension_type dimension_type;
+
+	static_assert(std::numeric_limits<dimension_type>::max() <= std::numeric_limits<std::uint32_t>::max(),
+		"GridDirtyRect coordinates are 32 bit, dimension_type must fit them");
+
+	static constexpr std::size_t tile_size = Tile_Size;
+
+	TrackedGrid()
+	{
+
+	}
+
+	///Takes the grid over; every cell starts clean
+	explicit TrackedGrid(Grid_Type _grid)
+		:grid(std::move(_grid))
+	{
+		ResetTiles();
+	}
+
+	TrackedGrid(dimension_type columnCount, dimension_type rowCount, const value_type& initVal = value_type())
+		:grid(columnCount, rowCount, initVal)
+	{
+		ResetTiles();
+	}
+
+	inline const Grid_Type& GetGrid() const
+	{
+		return this->grid;
+	}
+
+	inline dimension_type GetColumnCount() const
+	{
+		return this->grid.GetColumnCount();
+	}
+
+	inline dimension_type GetRowCount() const
+	{
+		return this->grid.GetRowCount();
+	}
+
+	inline const_reference GetCell(dimension_type column, dimension_type row) const
+	{
+		return this->grid.GetCell(column, row);
+	}
+
+	void SetCell(dimension_type column, dimension_type row, const value_type& value)
+	{
+		Modify(column, row) = value;
+	}
+
+	///Marks the cell and returns it for writing. Writing through the reference
+	///after a later ConsumeDirty goes unrecorded.
+	reference Modify(dimension_type column, dimension_type row)
+	{
+		CheckCell(column, row);
+		MarkTile(column / Tile_Size, row / Tile_Size);
+
+		return this->grid.GetCell(column, row);
+	}
+
+	///Calls function(column, row, cell) for every cell of the rectangle, which is
+	///marked as a whole
+	template<typename Function_Type>
+	void ModifyRegion(dimension_type column, dimension_type row, dimension_type columnCount,
+		dimension_type rowCount, Function_Type function)
+	{
+		MarkDirty(column, row, columnCount, rowCount);
+
+		for (std::size_t cellRow = row; cellRow < std::size_t(row) + rowCount; cellRow++)
+		{
+			for (std::size_t cellColumn = column; cellColumn < std::size_t(column) + columnCount; cellColumn++)
+			{
+				function(dimension_type(cellColumn), dimension_type(cellRow),
+					this->grid.GetCell(dimension_type(cellColumn), dimension_type(cellRow)));
+			}
+		}
+	}
+
+	///Grid::ForEach, marking the whole grid
+	template<typename Policy_Type, typename Function_Type>
+	void ForEach(const Policy_Type& policy, Function_Type function)
+	{
+		this->grid.ForEach(policy, function);
+		MarkAllDirty();
+	}
+
+	template<typename Policy_Type>
+	void Fill(const Policy_Type& policy, const value_type& value)
+	{
+		this->grid.Fill(policy, value);
+		MarkAllDirty();
+	}
+
+	///Resizing changes every tile, the whole new grid starts dirty
+	void ResizeGrid(dimension_type columnCount, dimension_type rowCount, const value_type& initVal = value_type())
+	{
+		this->grid.ResizeGrid(columnCount, rowCount, initVal);
+		ResetTiles();
+		MarkAllDirty();
+	}
+
+	///For cells written some other way
+	void MarkDirty(dimension_type column, dimension_type row, dimension_type columnCount, dimension_type rowCount)
+	{
+		if (columnCount == 0 || rowCount == 0)
+			return;
+
+		if (std::size_t(column) + columnCount > this->grid.GetColumnCount() ||
+			std::size_t(row) + rowCount > this->grid.GetRowCount())
+			throw std::out_of_range("TrackedGrid rectangle out of range");
+
+		std::size_t lastTileColumn = (std::size_t(column) + columnCount - 1) / Tile_Size;
+		std::size_t lastTileRow = (std::size_t(row) + rowCount - 1) / Tile_Size;
+
+		for (std::size_t tileRow = row / Tile_Size; tileRow <= lastTileRow; tileRow++)
+		{
+			for (std::size_t tileColumn = column / Tile_Size; tileColumn <= lastTileColumn; tileColumn++)
+				MarkTile(tileColumn, tileRow);
+		}
+	}
+
+	void MarkAllDirty()
+	{
+		if (!this->grid.isEmpty())
+			MarkDirty(0, 0, this->grid.GetColumnCount(), this->grid.GetRowCount());
+	}
+
+	inline bool IsDirty() const
+	{
+		return std::any_of(this->dirtyWords.begin(), this->dirtyWords.end(),
+			[](std::uint64_t word) { return word != 0; });
+	}
+
+	inline bool IsTileDirty(std::size_t tileColumn, std::size_t tileRow) const
+	{
+		return (this->dirtyWords[tileRow * this->wordsPerTileRow + tileColumn / 64] >> (tileColumn % 64)) & 1;
+	}
+
+	inline std::size_t GetTileColumnCount() const
+	{
+		return this->tileColumnCount;
+	}
+
+	inline std::size_t GetTileRowCount() const
+	{
+		return this->tileRowCount;
+	}
+
+	///Replaces dirty with the marked tiles merged into rectangles, clipped to the
+	///grid, and clears every mark. Runs of tiles in a tile row form a rectangle,
+	///which grows downwards while the rows below have a run with the same span.
+	void ConsumeDirty(std::vector<GridDirtyRect>& dirty)
+	{
+		dirty.clear();
+
+		std::vector<OpenRect> open;
+		std::vector<OpenRect> next;
+
+		for (std::size_t tileRow = 0; tileRow <= this->tileRowCount; tileRow++)
+		{
+			next.clear();
+			std::size_t openIndex = 0;
+
+			if (tileRow < this->tileRowCount)
+			{
+				std::size_t tileColumn = 0;
+
+				while (FindRun(tileRow, tileColumn))
+				{
+					std::size_t runStart = tileColumn;
+
+					while (tileColumn < this->tileColumnCount && IsTileDirty(tileColumn, tileRow))
+						tileColumn++;
+
+					//Both lists are sorted by column, rectangles passed over end here
+					while (openIndex < open.size() && open[openIndex].firstColumn < runStart)
+						Emit(open[openIndex++], tileRow, dirty);
+
+					if (openIndex < open.size() && open[openIndex].firstColumn == runStart &&
+						open[openIndex].endColumn == tileColumn)
+						next.push_back(open[openIndex++]);
+					else
+						next.push_back(OpenRect{ runStart, tileColumn, tileRow });
+				}
+			}
+
+			while (openIndex < open.size())
+				Emit(open[openIndex++], tileRow, dirty);
+
+			std::swap(open, next);
+		}
+
+		std::fill(this->dirtyWords.begin(), this->dirtyWords.end(), std::uint64_t(0));
+	}
+
+	std::vector<GridDirtyRect> ConsumeDirty()
+	{
+		std::vector<GridDirtyRect> dirty;
+		ConsumeDirty(dirty);
+		return dirty;
+	}
+
+private:
+	///A rectangle of tiles still growing downwards
+	struct OpenRect
+	{
+		std::size_t firstColumn;
+		std::size_t endColumn;
+		std::size_t firstRow;
+	};
+
+	Grid_Type grid;
+
+	std::size_t tileColumnCount = 0;
+	std::size_t tileRowCount = 0;
+	std::size_t wordsPerTileRow = 0;
+
+	///One bit per tile, every tile row starting on a fresh word
+	std::vector<std::uint64_t> dirtyWords;
+
+	void ResetTiles()
+	{
+		this->tileColumnCount = (std::size_t(this->grid.GetColumnCount()) + Tile_Size - 1) / Tile_Size;
+		this->tileRowCount = (std::size_t(this->grid.GetRowCount()) + Tile_Size - 1) / Tile_Size;
+		this->wordsPerTileRow = (this->tileColumnCount + 63) / 64;
+
+		this->dirtyWords.assign(this->wordsPerTileRow * this->tileRowCount, 0);
+	}
+
+	void CheckCell(dimension_type column, dimension_type row) const
+	{
+		if (column >= this->grid.GetColumnCount() || row >= this->grid.GetRowCount())
+			throw std::out_of_range("TrackedGrid cell out of range");
+	}
+
+	inline void MarkTile(std::size_t tileColumn, std::size_t tileRow)
+	{
+		this->dirtyWords[tileRow * this->wordsPerTileRow + tileColumn / 64] |= std::uint64_t(1) << (tileColumn % 64);
+	}
+
+	///Moves tileColumn to the next dirty tile of the row, skipping clean words whole
+	bool FindRun(std::size_t tileRow, std::size_t& tileColumn) const
+	{
+		const std::uint64_t* words = this->dirtyWords.data() + tileRow * this->wordsPerTileRow;
+
+		while (tileColumn < this->tileColumnCount)
+		{
+			std::uint64_t word = words[tileColumn / 64] >> (tileColumn % 64);
+
+			if (word == 0)
+			{
+				tileColumn = (tileColumn / 64 + 1) * 64;
+				continue;
+			}
+
+			while ((word & 1) == 0)
+			{
+				word >>= 1;
+				tileColumn++;
+			}
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void Emit(const OpenRect& rect, std::size_t endTileRow, std::vector<GridDirtyRect>& dirty) const
+	{
+		std::size_t column = rect.firstColumn * Tile_Size;
+		std::size_t row = rect.firstRow * Tile_Size;
+		std::size_t endColumn = std::min<std::size_t>(rect.endColumn * Tile_Size, this->grid.GetColumnCount());
+		std::size_t endRow = std::min<std::size_t>(endTileRow * Tile_Size, this->grid.GetRowCount());
+
+		dirty.push_back(GridDirtyRect{ std::uint32_t(column), std::uint32_t(row),
+			std::uint32_t(endColumn - column), std::uint32_t(endRow - row) });
+	}
+};